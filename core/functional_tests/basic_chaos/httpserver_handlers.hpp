@@ -49,6 +49,19 @@ public:
             return request.RequestBody();
         }
 
+        if (type == "log-debug") {
+            LOG_DEBUG() << "Debug record of the request";
+            const auto& outcome = request.GetArg("outcome");
+            if (outcome == "sleep") {
+                engine::SleepFor(std::chrono::milliseconds{200});
+            } else if (outcome == "error") {
+                request.SetResponseStatus(server::http::HttpStatus::kInternalServerError);
+            } else if (outcome == "throw") {
+                throw std::runtime_error("Request failed");
+            }
+            return kDefaultAnswer;
+        }
+
         if (type == "echo-and-check-args") {
             UASSERT_MSG(!request.IsBodyCompressed(), "Body was not decompressed by userver");
             if (request.GetArg("srv") != "mt-dev") throw std::runtime_error("Failed arg 'srv'");
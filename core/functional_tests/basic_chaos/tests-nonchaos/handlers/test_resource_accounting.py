@@ -0,0 +1,33 @@
+import asyncio
+
+
+async def _echo(service_client):
+    response = await service_client.get(
+        '/chaos/httpserver', params={'type': 'echo'},
+    )
+    assert response.status == 200
+
+
+async def test_resource_accounting(service_client, monitor_client):
+    # The metrics of the accounted resources appear after the first
+    # accounted request
+    await _echo(service_client)
+    # Give metrics and logs of the previous requests some time
+    # to be written out asynchronously.
+    await asyncio.sleep(0.1)
+
+    metrics = monitor_client.metrics_diff(prefix='http.handler.total')
+    async with metrics:
+        async with service_client.capture_logs() as capture:
+            await _echo(service_client)
+
+    assert metrics.value_at('resource-accounted') == 1
+    assert metrics.value_at('cpu-time-us') >= 0
+    assert metrics.value_at('allocated-bytes') >= 0
+
+    logs = capture.select(
+        _type='request', meta_type='/chaos/httpserver', level='INFO',
+    )
+    assert len(logs) == 1
+    assert int(logs[0]['cpu_time_us']) >= 0
+    assert int(logs[0]['allocated_bytes']) >= 0
@@ -0,0 +1,57 @@
+import pytest
+
+
+@pytest.fixture(name='buffering')
+async def _buffering(service_client, dynamic_config):
+    dynamic_config.set(
+        USERVER_LOG_REQUEST_BUFFERING={
+            'enabled': True,
+            'level': 'debug',
+            'max-request-bytes': 262144,
+            'max-total-bytes': 67108864,
+            'emit-slower-than-ms': 100,
+        },
+    )
+    await service_client.update_server_state()
+
+
+async def _log_debug(service_client, monitor_client, outcome):
+    # The records below INFO are buffered only if they are disabled
+    async with service_client.capture_logs(log_level='INFO'):
+        metrics = monitor_client.metrics_diff(
+            prefix='logger.request-log-buffers',
+        )
+        async with metrics:
+            response = await service_client.get(
+                '/chaos/httpserver',
+                params={'type': 'log-debug', 'outcome': outcome},
+            )
+    return response, metrics
+
+
+async def test_discard_on_success(service_client, monitor_client, buffering):
+    response, metrics = await _log_debug(service_client, monitor_client, '')
+    assert response.status == 200
+    assert metrics.value_at('emitted') == 0
+    assert metrics.value_at('discarded') >= 1
+
+
+@pytest.mark.parametrize('outcome', ['error', 'throw'])
+async def test_emit_on_server_error(
+    service_client, monitor_client, buffering, outcome,
+):
+    response, metrics = await _log_debug(
+        service_client, monitor_client, outcome,
+    )
+    assert response.status == 500
+    assert metrics.value_at('emitted') >= 1
+
+
+async def test_emit_on_slow_request(
+    service_client, monitor_client, buffering,
+):
+    response, metrics = await _log_debug(
+        service_client, monitor_client, 'sleep',
+    )
+    assert response.status == 200
+    assert metrics.value_at('emitted') >= 1
@@ -3,9 +3,12 @@
 /// @file userver/cache/cache_statistics.hpp
 /// @brief Statistics collection for components::CachingComponentBase
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <string_view>
 
 #include <userver/cache/update_type.hpp>
 #include <userver/utils/impl/internal_tag.hpp>
@@ -16,6 +19,22 @@ USERVER_NAMESPACE_BEGIN
 
 namespace cache {
 
+/// Stages of the `Update`, see UpdateStatisticsScope::AddStageDuration
+enum class UpdateStage {
+    /// Copying of the current data for an incremental update
+    kCopy,
+    /// Waiting for the data from the data source
+    kFetch,
+    /// Parsing of the received data
+    kParse,
+    /// Merging of the concurrently fetched shards into the new data
+    kMerge,
+};
+
+inline constexpr std::size_t kUpdateStagesCount = 4;
+
+std::string_view ToString(UpdateStage stage);
+
 namespace impl {
 
 struct UpdateStatistics final {
@@ -29,6 +48,7 @@ struct UpdateStatistics final {
     std::atomic<std::chrono::steady_clock::time_point> last_update_start_time{{}};
     std::atomic<std::chrono::steady_clock::time_point> last_successful_update_start_time{{}};
     std::atomic<std::chrono::milliseconds> last_update_duration{{}};
+    std::array<std::atomic<std::chrono::milliseconds>, kUpdateStagesCount> last_update_stage_durations{};
 };
 
 void DumpMetric(utils::statistics::Writer& writer, const UpdateStatistics& stats);
@@ -86,6 +106,13 @@ public:
     /// @param add the number of non-valid items newly received
     void IncreaseDocumentsParseFailures(std::size_t add);
 
+    /// @brief Accounts the time spent in a stage of the `Update`, the times of
+    /// the stages of the last update are reported in the metrics
+    /// @note This method can be called multiple times per `Update` and
+    /// concurrently, e.g. by the concurrent fetches of the shards of the data.
+    /// Times of the concurrent fetches are summed up.
+    void AddStageDuration(UpdateStage stage, std::chrono::steady_clock::duration duration);
+
 private:
     void DoFinish(impl::UpdateState new_state);
 
@@ -93,6 +120,7 @@ private:
     impl::UpdateStatistics& update_stats_;
     impl::UpdateState state_{impl::UpdateState::kNotFinished};
     const std::chrono::steady_clock::time_point update_start_time_;
+    std::array<std::atomic<std::int64_t>, kUpdateStagesCount> stage_durations_ns_{};
 };
 
 }  // namespace cache
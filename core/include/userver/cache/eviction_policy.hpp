@@ -0,0 +1,24 @@
+#pragma once
+
+/// @file userver/cache/eviction_policy.hpp
+/// @brief @copybrief cache::EvictionPolicy
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+/// @brief Which elements cache::NWayLRU evicts when a way is full
+enum class EvictionPolicy {
+    /// The least recently used element is evicted
+    kLru,
+    /// W-TinyLFU: new elements pass a small LRU window and then are admitted
+    /// to the main SLRU region only if they were accessed more often than the
+    /// element they would evict. The access frequencies are estimated with a
+    /// count-min sketch that is periodically aged. Use for caches that suffer
+    /// from scans over many rarely used keys.
+    kWTinyLfu,
+};
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
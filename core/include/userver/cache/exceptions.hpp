@@ -1,7 +1,8 @@
 #pragma once
 
 /// @file userver/cache/exceptions.hpp
-/// @brief Exceptions thrown by components::CachingComponentBase
+/// @brief Exceptions thrown by components::CachingComponentBase and
+/// cache::LruCacheComponent
 
 #include <stdexcept>
 #include <string>
@@ -29,6 +30,12 @@ public:
     explicit EmptyDataError(std::string_view cache_name);
 };
 
+/// Thrown by cache::LruCacheComponent if the deadline of the request expires
+/// while waiting for a batched lookup of a missing key.
+class LookupTimeoutError final : public std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
 }  // namespace cache
 
 USERVER_NAMESPACE_END
@@ -30,6 +30,11 @@ struct ExpirableValue final {
     std::chrono::steady_clock::time_point update_time;
 };
 
+template <typename Value>
+std::size_t EstimateSize(const ExpirableValue<Value>& value) {
+    return sizeof(value.update_time) + GetEstimatedSize(value.value);
+}
+
 template <typename Value>
 void Write(dump::Writer& writer, const impl::ExpirableValue<Value>& value) {
     const auto [now, steady_now] = utils::impl::GetGlobalTime();
@@ -65,9 +70,16 @@ public:
         kUseCache,   ///< Cache value got from update function
     };
 
-    /// For the description of `ways` and `way_size`,
+    /// For the description of `ways`, `way_size`, `recency` and `policy`,
     /// see the cache::NWayLRU::NWayLRU constructor.
-    ExpirableLruCache(size_t ways, size_t way_size, const Hash& hash = Hash(), const Equal& equal = Equal());
+    ExpirableLruCache(
+        size_t ways,
+        size_t way_size,
+        const Hash& hash = Hash(),
+        const Equal& equal = Equal(),
+        LruRecency recency = LruRecency::kExact,
+        EvictionPolicy policy = EvictionPolicy::kLru
+    );
 
     ~ExpirableLruCache();
 
@@ -75,6 +87,10 @@ public:
     /// see the cache::NWayLRU::NWayLRU constructor.
     void SetWaySize(size_t way_size);
 
+    /// For the description of `way_max_bytes`,
+    /// see cache::NWayLRU::UpdateWayMaxBytes.
+    void SetWayMaxBytes(std::optional<size_t> way_max_bytes);
+
     std::chrono::milliseconds GetMaxLifetime() const noexcept;
 
     void SetMaxLifetime(std::chrono::milliseconds max_lifetime);
@@ -128,6 +144,10 @@ public:
 
     size_t GetSizeApproximate() const;
 
+    /// Estimated size of the elements in bytes, std::nullopt if the cache is
+    /// not bounded by bytes. See cache::GetEstimatedSize.
+    std::optional<size_t> GetSizeBytesApproximate() const;
+
     /// Clear cache
     void Invalidate();
 
@@ -164,9 +184,11 @@ ExpirableLruCache<Key, Value, Hash, Equal>::ExpirableLruCache(
     size_t ways,
     size_t way_size,
     const Hash& hash,
-    const Equal& equal
+    const Equal& equal,
+    LruRecency recency,
+    EvictionPolicy policy
 )
-    : lru_(ways, way_size, hash, equal), mutex_set_{ways, way_size, hash, equal} {}
+    : lru_(ways, way_size, hash, equal, recency, policy), mutex_set_{ways, way_size, hash, equal} {}
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 ExpirableLruCache<Key, Value, Hash, Equal>::~ExpirableLruCache() {
@@ -178,6 +200,11 @@ void ExpirableLruCache<Key, Value, Hash, Equal>::SetWaySize(size_t way_size) {
     lru_.UpdateWaySize(way_size);
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+void ExpirableLruCache<Key, Value, Hash, Equal>::SetWayMaxBytes(std::optional<size_t> way_max_bytes) {
+    lru_.UpdateWayMaxBytes(way_max_bytes);
+}
+
 template <typename Key, typename Value, typename Hash, typename Equal>
 std::chrono::milliseconds ExpirableLruCache<Key, Value, Hash, Equal>::GetMaxLifetime() const noexcept {
     return max_lifetime_.load();
@@ -319,6 +346,11 @@ size_t ExpirableLruCache<Key, Value, Hash, Equal>::GetSizeApproximate() const {
     return lru_.GetSize();
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+std::optional<size_t> ExpirableLruCache<Key, Value, Hash, Equal>::GetSizeBytesApproximate() const {
+    return lru_.GetSizeBytes();
+}
+
 template <typename Key, typename Value, typename Hash, typename Equal>
 void ExpirableLruCache<Key, Value, Hash, Equal>::Invalidate() {
     lru_.Invalidate();
@@ -417,7 +449,7 @@ void ExpirableLruCache<Key, Value, Hash, Equal>::SetDumper(std::shared_ptr<dump:
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 void DumpMetric(utils::statistics::Writer& writer, const ExpirableLruCache<Key, Value, Hash, Equal>& cache) {
-    writer["current-documents-count"] = cache.GetSizeApproximate();
+    writer = impl::LruCacheSize{cache.GetSizeApproximate(), cache.GetSizeBytesApproximate()};
     writer = cache.GetStatistics();
 }
 
@@ -0,0 +1,266 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <userver/engine/mutex.hpp>
+#include <userver/rcu/rcu.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+/// A single way of cache::NWayLRU with cache::LruRecency::kApproximate.
+///
+/// Lookups of the elements are served from an RCU snapshot of the hash index
+/// without taking any locks. Instead of reordering the LRU list, a lookup
+/// stamps the element with the current generation of the way.
+///
+/// Writes go to a small pending map under the mutex and are merged into the
+/// snapshot in batches of about 1/8 of the way size. Each merge evicts the
+/// elements with the oldest generations and starts a new generation. The size
+/// of the way may exceed max_size by the size of a batch between the merges.
+template <typename T, typename U, typename Hash, typename Equal>
+class ApproximateLruWay final {
+public:
+    ApproximateLruWay(std::size_t max_size, const Hash& hash, const Equal& equal);
+
+    ApproximateLruWay(ApproximateLruWay&&) = delete;
+    ApproximateLruWay& operator=(ApproximateLruWay&&) = delete;
+
+    void Put(const T& key, U value);
+
+    template <typename Validator>
+    std::optional<U> Get(const T& key, Validator validator);
+
+    void Erase(const T& key);
+
+    void Clear();
+
+    template <typename Function>
+    void VisitAll(Function func) const;
+
+    /// Calls `size_func` with the number of elements and then `func` for
+    /// each of them, consistently
+    template <typename SizeFunction, typename Function>
+    void VisitAllWithSize(SizeFunction size_func, Function func) const;
+
+    std::size_t GetSize() const;
+
+    void SetMaxSize(std::size_t max_size);
+
+private:
+    struct Entry final {
+        Entry(U value, std::uint64_t generation) : value(std::move(value)), generation(generation) {}
+
+        const U value;
+        std::atomic<std::uint64_t> generation;
+        std::atomic<bool> removed{false};
+    };
+
+    using EntryPtr = std::shared_ptr<Entry>;
+    using Index = std::unordered_map<T, EntryPtr, Hash, Equal>;
+
+    void Touch(Entry& entry) const noexcept;
+
+    // All the methods below require mutex_ to be locked
+    EntryPtr FindLocked(const T& key) const;
+    void EraseLocked(const T& key);
+    std::size_t GetBatchSizeLocked() const noexcept;
+    void MergeLocked();
+
+    mutable engine::Mutex mutex_;
+    rcu::Variable<Index> index_;
+    Index pending_;
+    std::size_t max_size_;
+    std::size_t size_{0};
+    std::atomic<std::uint64_t> generation_{0};
+};
+
+template <typename T, typename U, typename Hash, typename Equal>
+ApproximateLruWay<T, U, Hash, Equal>::ApproximateLruWay(std::size_t max_size, const Hash& hash, const Equal& equal)
+    : index_(0, hash, equal), pending_(0, hash, equal), max_size_(max_size) {}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ApproximateLruWay<T, U, Hash, Equal>::Put(const T& key, U value) {
+    std::lock_guard lock(mutex_);
+
+    auto old_entry = FindLocked(key);
+    pending_.insert_or_assign(key, std::make_shared<Entry>(std::move(value), generation_.load()));
+    if (old_entry) {
+        // Lookups that see the flag go for the new value to pending_
+        old_entry->removed.store(true, std::memory_order_release);
+    } else {
+        ++size_;
+    }
+
+    if (pending_.size() >= GetBatchSizeLocked()) MergeLocked();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename Validator>
+std::optional<U> ApproximateLruWay<T, U, Hash, Equal>::Get(const T& key, Validator validator) {
+    {
+        const auto index = index_.Read();
+        const auto it = index->find(key);
+        if (it != index->end() && !it->second->removed.load(std::memory_order_acquire)) {
+            auto& entry = *it->second;
+            if (validator(entry.value)) {
+                Touch(entry);
+                return entry.value;
+            }
+        }
+    }
+
+    // Slow path for the recent writes, misses and invalid elements
+    std::lock_guard lock(mutex_);
+    const auto entry = FindLocked(key);
+    if (!entry) return std::nullopt;
+
+    if (!validator(entry->value)) {
+        EraseLocked(key);
+        return std::nullopt;
+    }
+
+    Touch(*entry);
+    return entry->value;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ApproximateLruWay<T, U, Hash, Equal>::Erase(const T& key) {
+    std::lock_guard lock(mutex_);
+    EraseLocked(key);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ApproximateLruWay<T, U, Hash, Equal>::Clear() {
+    std::lock_guard lock(mutex_);
+    pending_.clear();
+    index_.Assign(Index{0, pending_.hash_function(), pending_.key_eq()});
+    size_ = 0;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename Function>
+void ApproximateLruWay<T, U, Hash, Equal>::VisitAll(Function func) const {
+    VisitAllWithSize([](std::size_t) {}, std::move(func));
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename SizeFunction, typename Function>
+void ApproximateLruWay<T, U, Hash, Equal>::VisitAllWithSize(SizeFunction size_func, Function func) const {
+    std::lock_guard lock(mutex_);
+    size_func(size_);
+
+    const auto index = index_.Read();
+    for (const auto& [key, entry] : *index) {
+        if (entry->removed.load(std::memory_order_relaxed) || pending_.count(key)) continue;
+        func(key, entry->value);
+    }
+    for (const auto& [key, entry] : pending_) {
+        func(key, entry->value);
+    }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+std::size_t ApproximateLruWay<T, U, Hash, Equal>::GetSize() const {
+    std::lock_guard lock(mutex_);
+    return size_;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ApproximateLruWay<T, U, Hash, Equal>::SetMaxSize(std::size_t max_size) {
+    std::lock_guard lock(mutex_);
+    max_size_ = max_size;
+    MergeLocked();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ApproximateLruWay<T, U, Hash, Equal>::Touch(Entry& entry) const noexcept {
+    // Store only on the first access in a generation to keep the cache line
+    // of a hot element shared between the readers
+    const auto generation = generation_.load(std::memory_order_relaxed);
+    if (entry.generation.load(std::memory_order_relaxed) != generation) {
+        entry.generation.store(generation, std::memory_order_relaxed);
+    }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+auto ApproximateLruWay<T, U, Hash, Equal>::FindLocked(const T& key) const -> EntryPtr {
+    const auto pending_it = pending_.find(key);
+    if (pending_it != pending_.end()) return pending_it->second;
+
+    const auto index = index_.Read();
+    const auto it = index->find(key);
+    if (it == index->end() || it->second->removed.load(std::memory_order_relaxed)) return {};
+    return it->second;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ApproximateLruWay<T, U, Hash, Equal>::EraseLocked(const T& key) {
+    auto entry = FindLocked(key);
+    if (!entry) return;
+
+    pending_.erase(key);
+    // The entry may be both in pending_ and in the snapshot
+    const auto index = index_.Read();
+    const auto it = index->find(key);
+    if (it != index->end()) it->second->removed.store(true, std::memory_order_release);
+    entry->removed.store(true, std::memory_order_release);
+    --size_;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+std::size_t ApproximateLruWay<T, U, Hash, Equal>::GetBatchSizeLocked() const noexcept {
+    return std::max(max_size_ / 8, std::size_t{1});
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ApproximateLruWay<T, U, Hash, Equal>::MergeLocked() {
+    Index index{0, pending_.hash_function(), pending_.key_eq()};
+    {
+        const auto old_index = index_.Read();
+        index.reserve(old_index->size() + pending_.size());
+        for (const auto& [key, entry] : *old_index) {
+            if (!entry->removed.load(std::memory_order_relaxed)) index.emplace(key, entry);
+        }
+    }
+    for (auto& [key, entry] : pending_) {
+        index.insert_or_assign(key, std::move(entry));
+    }
+    pending_.clear();
+
+    if (index.size() > max_size_) {
+        std::vector<std::pair<std::uint64_t, typename Index::const_iterator>> candidates;
+        candidates.reserve(index.size());
+        for (auto it = index.cbegin(); it != index.cend(); ++it) {
+            candidates.emplace_back(it->second->generation.load(std::memory_order_relaxed), it);
+        }
+
+        const auto evicted_count = index.size() - max_size_;
+        std::nth_element(
+            candidates.begin(),
+            candidates.begin() + evicted_count,
+            candidates.end(),
+            [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; }
+        );
+        for (auto it = candidates.begin(); it != candidates.begin() + evicted_count; ++it) {
+            index.erase(it->second);
+        }
+    }
+    size_ = index.size();
+
+    index_.Assign(std::move(index));
+    generation_.fetch_add(1, std::memory_order_relaxed);
+}
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
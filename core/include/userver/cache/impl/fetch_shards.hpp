@@ -0,0 +1,74 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <userver/cache/cache_statistics.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
+#include <userver/utils/cpu_relax.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+/// The default number of shards that are fetched concurrently
+inline constexpr std::size_t kMaxShardsInFlight = 4;
+
+/// Calls `fetch_shard(shard)` for each of the `shard_count` shards concurrently
+/// on the current task processor, at most `max_shards_in_flight` at a time.
+/// Calls `merge(std::move(value))` for each of the fetched values on the
+/// current coroutine, in the order of the shards.
+///
+/// The shard is merged as soon as it and all the shards before it are
+/// fetched, the next shard is started only after that. So at most
+/// `max_shards_in_flight` fetched shards are kept in memory at once. Time of
+/// the merge is accounted as UpdateStage::kMerge, times of the fetches should
+/// be accounted by `fetch_shard`.
+///
+/// The first exception of `fetch_shard` or `merge` is rethrown, the fetches
+/// that are still running are cancelled.
+template <typename FetchShard, typename Merge>
+void FetchShardsAndMerge(
+    std::size_t shard_count,
+    std::size_t max_shards_in_flight,
+    const FetchShard& fetch_shard,
+    Merge&& merge,
+    UpdateStatisticsScope& stats_scope
+) {
+    using Values = std::invoke_result_t<const FetchShard&, std::size_t>;
+    UASSERT(max_shards_in_flight > 0);
+
+    std::vector<engine::TaskWithResult<Values>> tasks(shard_count);
+    std::size_t started_shards = 0;
+    const auto start_next_shard = [&] {
+        if (started_shards == shard_count) return;
+        tasks[started_shards] = utils::Async("cache_fetch_shard", [&fetch_shard, shard = started_shards] {
+            return fetch_shard(shard);
+        });
+        ++started_shards;
+    };
+    while (started_shards < std::min(shard_count, max_shards_in_flight)) start_next_shard();
+
+    for (auto& task : tasks) {
+        auto values = task.Get();
+        start_next_shard();
+
+        const auto merge_start = std::chrono::steady_clock::now();
+        utils::StreamingCpuRelax relax{1, nullptr};
+        for (auto& value : values) {
+            relax.Relax(1);
+            merge(std::move(value));
+        }
+        stats_scope.AddStageDuration(UpdateStage::kMerge, std::chrono::steady_clock::now() - merge_start);
+    }
+}
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <userver/cache/exceptions.hpp>
+#include <userver/concurrent/background_task_storage.hpp>
+#include <userver/engine/condition_variable.hpp>
+#include <userver/engine/exception.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task_base.hpp>
+#include <userver/server/request/task_inherited_data.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
+#include <userver/utils/result_store.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+/// Collects the keys that are requested concurrently within `window` and
+/// fetches each of the batches by a single call of `fetch`.
+///
+/// A batch is fetched once its window passes or once it reaches
+/// `max_batch_size` keys. The fetch ignores the deadlines of the waiters,
+/// each waiter stops waiting at its own task inherited deadline. The fetch is
+/// cancelled, but not waited for, if all the waiters of the batch stop waiting.
+/// Stop() cancels the fetches and waits for them.
+template <typename Key, typename Value, typename Hash, typename Equal>
+class MissBatcher final {
+public:
+    /// The value or the exception of the lookup for each of the keys
+    using Results = std::vector<utils::ResultStore<Value>>;
+    using FetchFunc = std::function<Results(const std::vector<Key>&)>;
+
+    MissBatcher(FetchFunc fetch, std::chrono::milliseconds window, std::size_t max_batch_size);
+
+    MissBatcher(MissBatcher&&) = delete;
+    MissBatcher& operator=(MissBatcher&&) = delete;
+
+    /// @throws LookupTimeoutError if the task inherited deadline expires
+    /// @throws engine::WaitInterruptedException if the current task is
+    /// cancelled
+    /// @throws any exception of `fetch` or of the lookup of `key`
+    Value Get(const Key& key);
+
+    /// Cancels the fetches and waits for them, the waiters of the unfinished
+    /// batches get engine::WaitInterruptedException. After that Get calls
+    /// `fetch` for its key in the current task.
+    void Stop() noexcept;
+
+private:
+    struct Batch final {
+        std::vector<Key> keys;
+        std::unordered_map<Key, std::size_t, Hash, Equal> positions;
+        bool closed{false};
+        engine::SingleConsumerEvent full;
+
+        // Set once under MissBatcher::mutex_, immutable after that
+        bool finished{false};
+        Results results;
+        std::exception_ptr error;
+    };
+
+    // Owned by the waiters of the batch, cancels the fetch once they are gone
+    struct Waiters final {
+        ~Waiters() { fetch_token.RequestCancel(); }
+
+        std::shared_ptr<Batch> batch;
+        engine::TaskCancellationToken fetch_token;
+    };
+
+    void Fetch(Batch& batch);
+
+    void Finish(Batch& batch, Results results, std::exception_ptr error);
+
+    const FetchFunc fetch_;
+    const std::chrono::milliseconds window_;
+    const std::size_t max_batch_size_;
+
+    engine::Mutex mutex_;
+    engine::ConditionVariable finished_;
+    std::weak_ptr<Waiters> current_;
+    bool is_stopped_{false};
+
+    // Must be the last field, the fetches use the fields above
+    concurrent::BackgroundTaskStorageCore fetches_;
+};
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+MissBatcher<Key, Value, Hash, Equal>::MissBatcher(
+    FetchFunc fetch,
+    std::chrono::milliseconds window,
+    std::size_t max_batch_size
+)
+    : fetch_(std::move(fetch)), window_(window), max_batch_size_(max_batch_size) {
+    UINVARIANT(max_batch_size_ != 0, "Batch size must be positive");
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+Value MissBatcher<Key, Value, Hash, Equal>::Get(const Key& key) {
+    std::unique_lock lock(mutex_);
+    if (is_stopped_) {
+        lock.unlock();
+        auto results = fetch_({key});
+        UINVARIANT(results.size() == 1, "Batched lookup must return a single result for a single key");
+        return results[0].Get();
+    }
+
+    auto waiters = current_.lock();
+    if (!waiters || waiters->batch->closed) {
+        waiters = std::make_shared<Waiters>();
+        waiters->batch = std::make_shared<Batch>();
+
+        // The batch is shared by the requests with different deadlines
+        const server::request::DeadlinePropagationBlocker blocker;
+        auto fetch = utils::CriticalAsync("lru_cache_miss_batch", [this, batch = waiters->batch] { Fetch(*batch); });
+        waiters->fetch_token = engine::TaskCancellationToken(fetch);
+        fetches_.Detach(std::move(fetch));
+        current_ = waiters;
+    }
+
+    auto& batch = *waiters->batch;
+    const auto [it, inserted] = batch.positions.try_emplace(key, batch.keys.size());
+    if (inserted) batch.keys.push_back(key);
+    const auto position = it->second;
+
+    if (batch.keys.size() >= max_batch_size_) {
+        batch.closed = true;
+        batch.full.Send();
+    }
+
+    const bool is_finished =
+        finished_.WaitUntil(lock, server::request::GetTaskInheritedDeadline(), [&batch] { return batch.finished; });
+    lock.unlock();
+
+    if (!is_finished) {
+        if (engine::current_task::ShouldCancel()) {
+            throw engine::WaitInterruptedException(engine::current_task::CancellationReason());
+        }
+        server::request::MarkTaskInheritedDeadlineExpired();
+        throw LookupTimeoutError("Deadline expired while waiting for a batched lookup of a missing key");
+    }
+
+    if (batch.error) std::rethrow_exception(batch.error);
+    return batch.results[position].Get();
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void MissBatcher<Key, Value, Hash, Equal>::Stop() noexcept {
+    {
+        std::lock_guard lock(mutex_);
+        is_stopped_ = true;
+    }
+    fetches_.CancelAndWait();
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void MissBatcher<Key, Value, Hash, Equal>::Fetch(Batch& batch) {
+    [[maybe_unused]] const bool is_full = batch.full.WaitForEventFor(window_);
+    // All the waiters are gone or the batcher is stopped
+    if (engine::current_task::ShouldCancel()) {
+        Finish(
+            batch,
+            {},
+            std::make_exception_ptr(engine::WaitInterruptedException(engine::current_task::CancellationReason()))
+        );
+        return;
+    }
+
+    std::vector<Key> keys;
+    {
+        std::lock_guard lock(mutex_);
+        batch.closed = true;
+        keys = std::move(batch.keys);
+    }
+
+    Results results;
+    std::exception_ptr error;
+    try {
+        results = fetch_(keys);
+        if (results.size() != keys.size()) {
+            throw std::logic_error(fmt::format(
+                "Batched lookup returned {} results for {} keys, the results must match the keys",
+                results.size(),
+                keys.size()
+            ));
+        }
+    } catch (const std::exception&) {
+        error = std::current_exception();
+    }
+
+    Finish(batch, std::move(results), std::move(error));
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void MissBatcher<Key, Value, Hash, Equal>::Finish(Batch& batch, Results results, std::exception_ptr error) {
+    {
+        std::lock_guard lock(mutex_);
+        batch.closed = true;
+        batch.results = std::move(results);
+        batch.error = std::move(error);
+        batch.finished = true;
+    }
+    finished_.NotifyAll();
+}
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
@@ -4,8 +4,11 @@
 /// @brief @copybrief cache::LruCacheComponent
 
 #include <functional>
+#include <memory>
+#include <vector>
 
 #include <userver/cache/expirable_lru_cache.hpp>
+#include <userver/cache/impl/miss_batcher.hpp>
 #include <userver/cache/lru_cache_config.hpp>
 #include <userver/components/component_base.hpp>
 #include <userver/concurrent/async_event_source.hpp>
@@ -13,8 +16,11 @@
 #include <userver/dump/meta.hpp>
 #include <userver/dump/operations.hpp>
 #include <userver/dynamic_config/source.hpp>
+#include <userver/engine/task/task_with_result.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/testsuite/cache_control.hpp>
+#include <userver/utils/async.hpp>
+#include <userver/utils/result_store.hpp>
 #include <userver/utils/statistics/entry.hpp>
 #include <userver/yaml_config/schema.hpp>
 
@@ -47,6 +53,16 @@ yaml_config::Schema GetLruCacheComponentBaseSchema();
 /// Provides facilities for creating LRU caches.
 /// You need to override LruCacheComponent::DoGetByKey to handle cache misses.
 ///
+/// If `miss-batch-window` is set, the misses of different keys that happen
+/// concurrently within the window are collected into a single call of
+/// LruCacheComponent::DoGetByKeys. Override it to look up all the keys with
+/// a single request to the data source, the default implementation calls
+/// DoGetByKey for each of the keys concurrently. Each of the waiters stops
+/// waiting at the deadline of its request and gets cache::LookupTimeoutError.
+/// The batched lookups outlive their waiters, so they are stopped in
+/// OnAllComponentsAreStopping and StopMissBatching must be called in the
+/// destructor of the derived class.
+///
 /// Caching components must be configured in service config (see options below)
 /// and may be reconfigured dynamically via components::DynamicConfig.
 ///
@@ -59,6 +75,11 @@ yaml_config::Schema GetLruCacheComponentBaseSchema();
 /// size | max amount of items to store in cache | --
 /// ways | number of ways for associative cache | --
 /// lifetime | TTL for cache entries (0 is unlimited) | 0
+/// max-size-bytes | max total size of the items in bytes as estimated by cache::GetEstimatedSize, requires `recency: exact` and `eviction-policy: lru` | unlimited
+/// recency | `exact` or `approximate` LRU, the latter serves lookups without locks under contention, see cache::LruRecency | exact
+/// eviction-policy | `lru` or `w-tinylfu`, the latter keeps the frequently used items on scans over many keys, requires `recency: exact`, see cache::EvictionPolicy | lru
+/// miss-batch-window | time to collect the concurrent misses into a single call of DoGetByKeys, 0 disables the batching | 0
+/// miss-batch-max-size | max amount of keys in a single call of DoGetByKeys | 100
 /// config-settings | enables dynamic reconfiguration with CacheConfigSet | true
 ///
 /// ## Example usage:
@@ -85,13 +106,28 @@ public:
 
     CacheWrapper GetCache();
 
+    void OnAllComponentsAreStopping() final;
+
     static yaml_config::Schema GetStaticConfigSchema();
 
 protected:
     virtual Value DoGetByKey(const Key& key) = 0;
 
+    /// @brief Looks up the values of the missing keys, used with
+    /// `miss-batch-window`
+    /// @returns the values or the exceptions of the lookups in the order of
+    /// `keys`, an exception fails only the waiters of its key
+    /// @note The default implementation calls DoGetByKey for each of the keys
+    /// concurrently
+    virtual std::vector<utils::ResultStore<Value>> DoGetByKeys(const std::vector<Key>& keys);
+
     std::shared_ptr<Cache> GetCacheRaw() { return cache_; }
 
+    /// @brief Cancels the batched lookups of `miss-batch-window` and waits
+    /// for them, the next misses are looked up without batching
+    /// @warning Should be called in destructor of derived class.
+    void StopMissBatching();
+
 private:
     void DropCache();
 
@@ -110,6 +146,7 @@ private:
     const LruCacheConfigStatic static_config_;
     std::shared_ptr<dump::Dumper> dumper_;
     const std::shared_ptr<Cache> cache_;
+    std::unique_ptr<impl::MissBatcher<Key, Value, Hash, Equal>> miss_batcher_;
 
     // Subscriptions must be the last fields.
     concurrent::AsyncEventSubscriberScope config_subscription_;
@@ -126,7 +163,22 @@ LruCacheComponent<Key, Value, Hash, Equal>::LruCacheComponent(
     : ComponentBase(config, context),
       name_(components::GetCurrentComponentName(config)),
       static_config_(config),
-      cache_(std::make_shared<Cache>(static_config_.ways, static_config_.GetWaySize())) {
+      cache_(std::make_shared<Cache>(
+          static_config_.ways,
+          static_config_.GetWaySize(),
+          Hash{},
+          Equal{},
+          static_config_.recency,
+          static_config_.eviction_policy
+      )) {
+    if (static_config_.miss_batch_window.count() != 0) {
+        miss_batcher_ = std::make_unique<impl::MissBatcher<Key, Value, Hash, Equal>>(
+            [this](const std::vector<Key>& keys) { return DoGetByKeys(keys); },
+            static_config_.miss_batch_window,
+            static_config_.miss_batch_max_size
+        );
+    }
+
     if (impl::IsDumpSupportEnabled(config)) {
         dumper_ = std::make_shared<dump::Dumper>(config, context, static_cast<dump::DumpableEntity&>(*this));
         cache_->SetDumper(dumper_);
@@ -135,6 +187,7 @@ LruCacheComponent<Key, Value, Hash, Equal>::LruCacheComponent(
 
     cache_->SetMaxLifetime(static_config_.config.lifetime);
     cache_->SetBackgroundUpdate(static_config_.config.background_update);
+    cache_->SetWayMaxBytes(static_config_.config.GetWayMaxBytes(static_config_.ways));
 
     if (static_config_.use_dynamic_config) {
         LOG_INFO() << "Dynamic LRU cache config is enabled, subscribing on "
@@ -172,6 +225,16 @@ typename LruCacheComponent<Key, Value, Hash, Equal>::CacheWrapper LruCacheCompon
     return CacheWrapper(cache_, [this](const Key& key) { return GetByKey(key); });
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+void LruCacheComponent<Key, Value, Hash, Equal>::OnAllComponentsAreStopping() {
+    StopMissBatching();
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void LruCacheComponent<Key, Value, Hash, Equal>::StopMissBatching() {
+    if (miss_batcher_) miss_batcher_->Stop();
+}
+
 template <typename Key, typename Value, typename Hash, typename Equal>
 void LruCacheComponent<Key, Value, Hash, Equal>::DropCache() {
     cache_->Invalidate();
@@ -179,9 +242,30 @@ void LruCacheComponent<Key, Value, Hash, Equal>::DropCache() {
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 Value LruCacheComponent<Key, Value, Hash, Equal>::GetByKey(const Key& key) {
+    if (miss_batcher_) return miss_batcher_->Get(key);
     return DoGetByKey(key);
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+std::vector<utils::ResultStore<Value>>
+LruCacheComponent<Key, Value, Hash, Equal>::DoGetByKeys(const std::vector<Key>& keys) {
+    std::vector<engine::TaskWithResult<Value>> tasks;
+    tasks.reserve(keys.size());
+    for (const auto& key : keys) {
+        tasks.push_back(utils::Async("lru_cache_get_by_key", [this, &key] { return DoGetByKey(key); }));
+    }
+
+    std::vector<utils::ResultStore<Value>> results(keys.size());
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        try {
+            results[i].SetValue(tasks[i].Get());
+        } catch (const std::exception&) {
+            results[i].SetException(std::current_exception());
+        }
+    }
+    return results;
+}
+
 template <typename Key, typename Value, typename Hash, typename Equal>
 void LruCacheComponent<Key, Value, Hash, Equal>::OnConfigUpdate(const dynamic_config::Snapshot& cfg) {
     const auto config = GetLruConfig(cfg, name_);
@@ -199,6 +283,13 @@ void LruCacheComponent<Key, Value, Hash, Equal>::UpdateConfig(const LruCacheConf
     cache_->SetWaySize(config.GetWaySize(static_config_.ways));
     cache_->SetMaxLifetime(config.lifetime);
     cache_->SetBackgroundUpdate(config.background_update);
+
+    if (!config.max_size_bytes || static_config_.IsMaxSizeBytesSupported()) {
+        cache_->SetWayMaxBytes(config.GetWayMaxBytes(static_config_.ways));
+    } else {
+        LOG_ERROR() << "max-size-bytes of the dynamic config is ignored for LRU cache " << name_
+                    << ", it requires 'exact' recency and 'lru' eviction-policy";
+    }
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
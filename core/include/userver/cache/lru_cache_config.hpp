@@ -5,6 +5,8 @@
 #include <optional>
 #include <unordered_map>
 
+#include <userver/cache/eviction_policy.hpp>
+#include <userver/cache/lru_recency.hpp>
 #include <userver/components/component_fwd.hpp>
 #include <userver/dynamic_config/snapshot.hpp>
 #include <userver/formats/json_fwd.hpp>
@@ -27,9 +29,12 @@ struct LruCacheConfig final {
 
     std::size_t GetWaySize(std::size_t ways) const;
 
+    std::optional<std::size_t> GetWayMaxBytes(std::size_t ways) const;
+
     std::size_t size;
     std::chrono::milliseconds lifetime;
     BackgroundUpdateMode background_update;
+    std::optional<std::size_t> max_size_bytes;
 };
 
 LruCacheConfig Parse(const formats::json::Value& value, formats::parse::To<LruCacheConfig>);
@@ -40,8 +45,15 @@ struct LruCacheConfigStatic final {
 
     std::size_t GetWaySize() const;
 
+    /// Whether the ways of the cache may be bounded by bytes
+    bool IsMaxSizeBytesSupported() const;
+
     LruCacheConfig config;
     std::size_t ways;
+    LruRecency recency;
+    EvictionPolicy eviction_policy;
+    std::chrono::milliseconds miss_batch_window;
+    std::size_t miss_batch_max_size;
     bool use_dynamic_config;
 };
 
@@ -3,6 +3,7 @@
 #include <atomic>
 #include <chrono>
 #include <cstddef>
+#include <optional>
 
 #include <userver/utils/statistics/recentperiod.hpp>
 #include <userver/utils/statistics/writer.hpp>
@@ -33,6 +34,12 @@ struct ExpirableLruCacheStatistics final {
         std::chrono::seconds(60)};
 };
 
+struct LruCacheSize final {
+    std::size_t documents;
+    // Set only for the caches bounded by bytes
+    std::optional<std::size_t> bytes;
+};
+
 void CacheHit(ExpirableLruCacheStatistics& stats);
 
 void CacheMiss(ExpirableLruCacheStatistics& stats);
@@ -41,6 +48,8 @@ void CacheStale(ExpirableLruCacheStatistics& stats);
 
 void DumpMetric(utils::statistics::Writer& writer, const ExpirableLruCacheStatistics& stats);
 
+void DumpMetric(utils::statistics::Writer& writer, const LruCacheSize& size);
+
 }  // namespace cache::impl
 
 USERVER_NAMESPACE_END
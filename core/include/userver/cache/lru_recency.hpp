@@ -0,0 +1,25 @@
+#pragma once
+
+/// @file userver/cache/lru_recency.hpp
+/// @brief @copybrief cache::LruRecency
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+/// @brief How cache::NWayLRU tracks the recency of its elements
+enum class LruRecency {
+    /// Every lookup moves the element to the head of the LRU list under the
+    /// mutex of the way. Exact LRU order, but concurrent lookups in the same way
+    /// contend on the mutex.
+    kExact,
+    /// Lookups of the elements do not take any locks and only stamp them with
+    /// the current generation of the way, the elements of the oldest
+    /// generations are evicted first. Writes are applied in batches. Use for
+    /// read-heavy caches that see contention on the ways.
+    kApproximate,
+};
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
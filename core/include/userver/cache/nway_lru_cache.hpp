@@ -1,15 +1,24 @@
 #pragma once
 
+#include <algorithm>
 #include <functional>
+#include <memory>
 #include <optional>
+#include <variant>
 #include <vector>
 
 #include <boost/container_hash/hash.hpp>
 
-#include <userver/cache/lru_map.hpp>
+#include <userver/cache/eviction_policy.hpp>
+#include <userver/cache/impl/approximate_lru_way.hpp>
+#include <userver/cache/impl/lru.hpp>
+#include <userver/cache/impl/tinylfu.hpp>
+#include <userver/cache/lru_recency.hpp>
+#include <userver/cache/weigher.hpp>
 #include <userver/dump/dumper.hpp>
 #include <userver/dump/operations.hpp>
 #include <userver/engine/mutex.hpp>
+#include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -19,6 +28,9 @@ namespace cache {
 template <typename T, typename U, typename Hash = std::hash<T>, typename Equal = std::equal_to<T>>
 class NWayLRU final {
 public:
+    /// Estimates the size of an element in bytes
+    using Weigher = std::function<std::size_t(const T&, const U&)>;
+
     /// @param ways is the number of ways (a.k.a. shards, internal hash-maps),
     /// into which elements are distributed based on their hash. Each shard is
     /// protected by an individual mutex. Larger `ways` means more internal
@@ -32,7 +44,23 @@ public:
     /// according to the LRU policy.
     ///
     /// The maximum total number of elements is `ways * way_size`.
-    NWayLRU(size_t ways, size_t way_size, const Hash& hash = Hash(), const Equal& equal = Equal());
+    ///
+    /// @param recency is the way to track the recency of elements, see
+    /// cache::LruRecency. With cache::LruRecency::kApproximate the lookups of
+    /// the present elements take no locks, and the size of a way may exceed
+    /// `way_size` by 1/8 between the batched updates.
+    ///
+    /// @param policy is the policy to evict the elements from the full ways,
+    /// see cache::EvictionPolicy. cache::EvictionPolicy::kWTinyLfu is only
+    /// supported with cache::LruRecency::kExact.
+    NWayLRU(
+        size_t ways,
+        size_t way_size,
+        const Hash& hash = Hash(),
+        const Equal& equal = Equal(),
+        LruRecency recency = LruRecency::kExact,
+        EvictionPolicy policy = EvictionPolicy::kLru
+    );
 
     void Put(const T& key, U value);
 
@@ -59,6 +87,26 @@ public:
     /// see the cache::NWayLRU::NWayLRU constructor.
     void UpdateWaySize(size_t way_size);
 
+    /// @brief Bounds each way by the total size of its elements in bytes in
+    /// addition to `way_size`, std::nullopt removes the bound.
+    ///
+    /// The least recently used elements are evicted until the way fits, an
+    /// element larger than the limit is not stored at all. The sizes are
+    /// estimated by the weigher, see SetWeigher.
+    ///
+    /// @throws std::logic_error unless the cache uses cache::LruRecency::kExact
+    /// and cache::EvictionPolicy::kLru
+    void UpdateWayMaxBytes(std::optional<size_t> way_max_bytes);
+
+    /// Returns the total estimated size of the elements in bytes, or
+    /// std::nullopt if the ways are not bounded by bytes
+    std::optional<size_t> GetSizeBytes() const;
+
+    /// Sets the function to estimate the size of the elements for
+    /// UpdateWayMaxBytes, cache::DefaultWeigher is used by default. This method
+    /// is not thread-safe.
+    void SetWeigher(Weigher weigher);
+
     void Write(dump::Writer& writer) const;
     void Read(dump::Reader& reader);
 
@@ -68,40 +116,100 @@ public:
 
 private:
     struct Way {
-        Way(Way&& other) noexcept : cache(std::move(other.cache)) {}
+        using Lru = impl::LruBase<T, U, Hash, Equal, impl::NodeWeight>;
+        using Storage = std::variant<Lru, impl::WTinyLfuBase<T, U, Hash, Equal>>;
+
+        Way(Way&& other) noexcept
+            : cache(std::move(other.cache)), max_bytes(other.max_bytes), bytes(other.bytes) {}
 
         // max_size is not used, will be reset by Resize() in NWayLRU::NWayLRU
-        Way(const Hash& hash, const Equal& equal) : cache(1, hash, equal) {}
+        Way(const Hash& hash, const Equal& equal, EvictionPolicy policy)
+            : cache(
+                  policy == EvictionPolicy::kWTinyLfu ? Storage{std::in_place_index<1>, 1, hash, equal}
+                                                      : Storage{std::in_place_index<0>, 1, hash, equal}
+              ) {}
+
+        // Both storages have the same Put/Get/Erase/Clear/VisitAll/GetSize/SetMaxSize
+        template <typename Function>
+        decltype(auto) Visit(Function&& func) {
+            return std::visit(std::forward<Function>(func), cache);
+        }
+
+        template <typename Function>
+        decltype(auto) Visit(Function&& func) const {
+            return std::visit(std::forward<Function>(func), cache);
+        }
 
         mutable engine::Mutex mutex;
-        LruMap<T, U, Hash, Equal> cache;
+        Storage cache;
+        // Set only for the Lru storage
+        std::optional<size_t> max_bytes;
+        size_t bytes{0};
     };
 
+    using ApproximateWay = impl::ApproximateLruWay<T, U, Hash, Equal>;
+
+    size_t GetWayIndex(const T& key) const;
+
     Way& GetWay(const T& key);
 
+    ApproximateWay& GetApproximateWay(const T& key);
+
+    // The methods below require the mutex of the way to be locked
+    void PutLocked(Way& way, const T& key, U value);
+    void EraseLocked(Way& way, const T& key);
+    void ShrinkLocked(Way& way, size_t max_size);
+    void RecountBytesLocked(Way& way);
+
     void NotifyDumper();
 
+    // Only one of the vectors is non-empty, depending on the LruRecency
     std::vector<Way> caches_;
+    std::vector<std::unique_ptr<ApproximateWay>> approximate_caches_;
     Hash hash_fn_;
+    Weigher weigher_;
     std::shared_ptr<dump::Dumper> dumper_{nullptr};
 };
 
 template <typename T, typename U, typename Hash, typename Eq>
-NWayLRU<T, U, Hash, Eq>::NWayLRU(size_t ways, size_t way_size, const Hash& hash, const Eq& equal)
+NWayLRU<T, U, Hash, Eq>::NWayLRU(
+    size_t ways,
+    size_t way_size,
+    const Hash& hash,
+    const Eq& equal,
+    LruRecency recency,
+    EvictionPolicy policy
+)
     : caches_(), hash_fn_(hash) {
-    caches_.reserve(ways);
-    for (size_t i = 0; i < ways; ++i) caches_.emplace_back(hash, equal);
     if (ways == 0) throw std::logic_error("Ways must be positive");
+    if (recency == LruRecency::kApproximate && policy != EvictionPolicy::kLru) {
+        throw std::logic_error("Approximate recency supports only the LRU eviction policy");
+    }
+
+    if (recency == LruRecency::kApproximate) {
+        approximate_caches_.reserve(ways);
+        for (size_t i = 0; i < ways; ++i) {
+            approximate_caches_.push_back(std::make_unique<ApproximateWay>(way_size, hash, equal));
+        }
+        return;
+    }
+
+    caches_.reserve(ways);
+    for (size_t i = 0; i < ways; ++i) caches_.emplace_back(hash, equal, policy);
 
-    for (auto& way : caches_) way.cache.SetMaxSize(way_size);
+    for (auto& way : caches_) {
+        way.Visit([way_size](auto& cache) { cache.SetMaxSize(way_size); });
+    }
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 void NWayLRU<T, U, Hash, Eq>::Put(const T& key, U value) {
-    auto& way = GetWay(key);
-    {
+    if (!approximate_caches_.empty()) {
+        GetApproximateWay(key).Put(key, std::move(value));
+    } else {
+        auto& way = GetWay(key);
         std::unique_lock<engine::Mutex> lock(way.mutex);
-        way.cache.Put(key, std::move(value));
+        PutLocked(way, key, std::move(value));
     }
     NotifyDumper();
 }
@@ -109,13 +217,17 @@ void NWayLRU<T, U, Hash, Eq>::Put(const T& key, U value) {
 template <typename T, typename U, typename Hash, typename Eq>
 template <typename Validator>
 std::optional<U> NWayLRU<T, U, Hash, Eq>::Get(const T& key, Validator validator) {
+    if (!approximate_caches_.empty()) {
+        return GetApproximateWay(key).Get(key, std::move(validator));
+    }
+
     auto& way = GetWay(key);
     std::unique_lock<engine::Mutex> lock(way.mutex);
-    auto* value = way.cache.Get(key);
+    auto* value = way.Visit([&key](auto& cache) { return cache.Get(key); });
 
     if (value) {
         if (validator(*value)) return *value;
-        way.cache.Erase(key);
+        EraseLocked(way, key);
     }
 
     return std::nullopt;
@@ -123,26 +235,39 @@ std::optional<U> NWayLRU<T, U, Hash, Eq>::Get(const T& key, Validator validator)
 
 template <typename T, typename U, typename Hash, typename Eq>
 void NWayLRU<T, U, Hash, Eq>::InvalidateByKey(const T& key) {
-    auto& way = GetWay(key);
-    {
+    if (!approximate_caches_.empty()) {
+        GetApproximateWay(key).Erase(key);
+    } else {
+        auto& way = GetWay(key);
         std::unique_lock<engine::Mutex> lock(way.mutex);
-        way.cache.Erase(key);
+        EraseLocked(way, key);
     }
     NotifyDumper();
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 U NWayLRU<T, U, Hash, Eq>::GetOr(const T& key, const U& default_value) {
+    if (!approximate_caches_.empty()) {
+        return Get(key).value_or(default_value);
+    }
+
     auto& way = GetWay(key);
     std::unique_lock<engine::Mutex> lock(way.mutex);
-    return way.cache.GetOr(key, default_value);
+    return way.Visit([&](auto& cache) {
+        auto* value = cache.Get(key);
+        return value ? *value : default_value;
+    });
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 void NWayLRU<T, U, Hash, Eq>::Invalidate() {
+    for (auto& way : approximate_caches_) {
+        way->Clear();
+    }
     for (auto& way : caches_) {
         std::unique_lock<engine::Mutex> lock(way.mutex);
-        way.cache.Clear();
+        way.Visit([](auto& cache) { cache.Clear(); });
+        way.bytes = 0;
     }
     NotifyDumper();
 }
@@ -150,54 +275,196 @@ void NWayLRU<T, U, Hash, Eq>::Invalidate() {
 template <typename T, typename U, typename Hash, typename Eq>
 template <typename Function>
 void NWayLRU<T, U, Hash, Eq>::VisitAll(Function func) const {
+    for (const auto& way : approximate_caches_) {
+        way->VisitAll(std::ref(func));
+    }
     for (const auto& way : caches_) {
         std::unique_lock<engine::Mutex> lock(way.mutex);
-        way.cache.VisitAll(func);
+        way.Visit([&func](const auto& cache) { cache.VisitAll(func); });
     }
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 size_t NWayLRU<T, U, Hash, Eq>::GetSize() const {
     size_t size{0};
+    for (const auto& way : approximate_caches_) {
+        size += way->GetSize();
+    }
     for (const auto& way : caches_) {
         std::unique_lock<engine::Mutex> lock(way.mutex);
-        size += way.cache.GetSize();
+        size += way.Visit([](const auto& cache) { return cache.GetSize(); });
     }
     return size;
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 void NWayLRU<T, U, Hash, Eq>::UpdateWaySize(size_t way_size) {
+    for (auto& way : approximate_caches_) {
+        way->SetMaxSize(way_size);
+    }
     for (auto& way : caches_) {
         std::unique_lock<engine::Mutex> lock(way.mutex);
-        way.cache.SetMaxSize(way_size);
+        // Evict here rather than inside SetMaxSize to account for the evicted bytes
+        if (way.max_bytes) ShrinkLocked(way, way_size);
+        way.Visit([way_size](auto& cache) { cache.SetMaxSize(way_size); });
     }
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
-typename NWayLRU<T, U, Hash, Eq>::Way& NWayLRU<T, U, Hash, Eq>::GetWay(const T& key) {
+void NWayLRU<T, U, Hash, Eq>::UpdateWayMaxBytes(std::optional<size_t> way_max_bytes) {
+    if (way_max_bytes && (caches_.empty() || !std::holds_alternative<typename Way::Lru>(caches_.front().cache))) {
+        throw std::logic_error("Only exact LRU caches may be bounded by bytes");
+    }
+    if (way_max_bytes && !weigher_) weigher_ = DefaultWeigher{};
+
+    for (auto& way : caches_) {
+        std::unique_lock<engine::Mutex> lock(way.mutex);
+        const bool was_bounded = way.max_bytes.has_value();
+        way.max_bytes = way_max_bytes;
+        if (!way_max_bytes) {
+            way.bytes = 0;
+            continue;
+        }
+
+        if (!was_bounded) RecountBytesLocked(way);
+        ShrinkLocked(way, std::get<typename Way::Lru>(way.cache).GetCapacity());
+    }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+std::optional<size_t> NWayLRU<T, U, Hash, Eq>::GetSizeBytes() const {
+    std::optional<size_t> size;
+    for (const auto& way : caches_) {
+        std::unique_lock<engine::Mutex> lock(way.mutex);
+        if (!way.max_bytes) return std::nullopt;
+        size = size.value_or(0) + way.bytes;
+    }
+    return size;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayLRU<T, U, Hash, Eq>::SetWeigher(Weigher weigher) {
+    weigher_ = std::move(weigher);
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayLRU<T, U, Hash, Eq>::PutLocked(Way& way, const T& key, U value) {
+    if (!way.max_bytes) {
+        way.Visit([&](auto& cache) { cache.Put(key, std::move(value)); });
+        return;
+    }
+
+    auto& cache = std::get<typename Way::Lru>(way.cache);
+    const auto weight = weigher_(key, value);
+    auto node = cache.ExtractNode(key);
+    if (node) way.bytes -= node->weight;
+    if (weight > *way.max_bytes) {
+        // Storing the element would evict everything else, the old value is
+        // dropped as it is outdated
+        return;
+    }
+
+    if (node) {
+        node->SetValue(std::move(value));
+    } else {
+        // Evict here rather than inside Put to account for the evicted bytes
+        if (cache.GetSize() >= cache.GetCapacity()) {
+            node = cache.ExtractLeastUsedNode();
+            way.bytes -= node->weight;
+            node->SetKey(key);
+            node->SetValue(std::move(value));
+        } else {
+            node = std::make_unique<typename Way::Lru::NodeType::element_type>(T{key}, std::move(value));
+        }
+    }
+    node->weight = weight;
+    way.bytes += weight;
+    cache.InsertNode(std::move(node));
+
+    ShrinkLocked(way, cache.GetCapacity());
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayLRU<T, U, Hash, Eq>::EraseLocked(Way& way, const T& key) {
+    if (!way.max_bytes) {
+        way.Visit([&key](auto& cache) { cache.Erase(key); });
+        return;
+    }
+
+    auto node = std::get<typename Way::Lru>(way.cache).ExtractNode(key);
+    if (node) way.bytes -= node->weight;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayLRU<T, U, Hash, Eq>::ShrinkLocked(Way& way, size_t max_size) {
+    UASSERT(way.max_bytes);
+    auto& cache = std::get<typename Way::Lru>(way.cache);
+    while (way.bytes > *way.max_bytes || cache.GetSize() > max_size) {
+        auto node = cache.ExtractLeastUsedNode();
+        if (!node) {
+            UASSERT(way.bytes == 0);
+            break;
+        }
+        way.bytes -= node->weight;
+    }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayLRU<T, U, Hash, Eq>::RecountBytesLocked(Way& way) {
+    // The elements put while the way was not bounded are weighed here, the
+    // weight is stored in the node and is never recalculated
+    way.bytes = 0;
+    std::get<typename Way::Lru>(way.cache).VisitAllNodes([this, &way](auto& node) {
+        node.weight = weigher_(node.GetKey(), node.GetValue());
+        way.bytes += node.weight;
+    });
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+size_t NWayLRU<T, U, Hash, Eq>::GetWayIndex(const T& key) const {
     /// It is needed to twist hash because there is hash map in LruMap. Otherwise
     /// nodes will fall into one bucket. According to
     /// https://www.boost.org/doc/libs/1_83_0/libs/container_hash/doc/html/hash.html#notes_hash_combine
     /// hash_combine can be treated as hash itself
     auto seed = hash_fn_(key);
     boost::hash_combine(seed, 0);
-    auto n = seed % caches_.size();
-    return caches_[n];
+    return seed % (caches_.size() + approximate_caches_.size());
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+typename NWayLRU<T, U, Hash, Eq>::Way& NWayLRU<T, U, Hash, Eq>::GetWay(const T& key) {
+    return caches_[GetWayIndex(key)];
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+typename NWayLRU<T, U, Hash, Eq>::ApproximateWay& NWayLRU<T, U, Hash, Eq>::GetApproximateWay(const T& key) {
+    return *approximate_caches_[GetWayIndex(key)];
 }
 
 template <typename T, typename U, typename Hash, typename Equal>
 void NWayLRU<T, U, Hash, Equal>::Write(dump::Writer& writer) const {
-    writer.Write(caches_.size());
+    writer.Write(caches_.size() + approximate_caches_.size());
+
+    for (const auto& way : approximate_caches_) {
+        way->VisitAllWithSize(
+            [&writer](std::size_t size) { writer.Write(size); },
+            [&writer](const T& key, const U& value) {
+                writer.Write(key);
+                writer.Write(value);
+            }
+        );
+    }
 
     for (const Way& way : caches_) {
         std::unique_lock<engine::Mutex> lock(way.mutex);
 
-        writer.Write(way.cache.GetSize());
+        way.Visit([&writer](const auto& cache) {
+            writer.Write(cache.GetSize());
 
-        way.cache.VisitAll([&writer](const T& key, const U& value) {
-            writer.Write(key);
-            writer.Write(value);
+            cache.VisitAll([&writer](const T& key, const U& value) {
+                writer.Write(key);
+                writer.Write(value);
+            });
         });
     }
 }
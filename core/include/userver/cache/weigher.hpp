@@ -0,0 +1,76 @@
+#pragma once
+
+/// @file userver/cache/weigher.hpp
+/// @brief @copybrief cache::GetEstimatedSize
+
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+
+#include <userver/dump/operations.hpp>
+#include <userver/utils/meta_light.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+namespace impl {
+
+/// Writer that only counts the bytes of a dump
+class SizeCountingWriter final : public dump::Writer {
+public:
+    void Finish() override {}
+
+    std::size_t GetSize() const noexcept { return size_; }
+
+private:
+    void WriteRaw(std::string_view data) override { size_ += data.size(); }
+
+    std::size_t size_{0};
+};
+
+template <typename T>
+using EstimateSizeResult = decltype(EstimateSize(std::declval<const T&>()));
+
+}  // namespace impl
+
+/// Check if ADL-found `std::size_t EstimateSize(const T&)` is available
+template <typename T>
+inline constexpr bool kHasEstimateSize =
+    std::is_same_v<meta::DetectedType<impl::EstimateSizeResult, T>, std::size_t>;
+
+/// @brief Estimates the memory usage of `value` in bytes
+///
+/// Calls ADL-found `std::size_t EstimateSize(const T& value)` if it is
+/// available. Otherwise for the types that can be written to dumps (see
+/// @ref scripts/docs/en/userver/cache_dumps.md) returns `sizeof(T)` plus the
+/// size of the dump of `value`, which accounts for the dynamic memory of the
+/// strings and containers. For all the other types returns `sizeof(T)`.
+///
+/// To make the estimation precise or faster, define `EstimateSize` in the
+/// namespace of `T`.
+template <typename T>
+std::size_t GetEstimatedSize(const T& value) {
+    if constexpr (kHasEstimateSize<T>) {
+        return EstimateSize(value);
+    } else if constexpr (dump::kIsWritable<T>) {
+        impl::SizeCountingWriter writer;
+        writer.Write(value);
+        return sizeof(T) + writer.GetSize();
+    } else {
+        return sizeof(T);
+    }
+}
+
+/// @brief Default weigher of the cache entries, the sum of
+/// cache::GetEstimatedSize of the key and the value
+struct DefaultWeigher final {
+    template <typename Key, typename Value>
+    std::size_t operator()(const Key& key, const Value& value) const {
+        return GetEstimatedSize(key) + GetEstimatedSize(value);
+    }
+};
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
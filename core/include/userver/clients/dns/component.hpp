@@ -33,6 +33,7 @@ namespace clients::dns {
 /// cache-size-per-way | size of each way of network cache | 256
 /// cache-max-reply-ttl | TTL limit for network replies caching | 5m
 /// cache-failure-ttl | TTL for network failures caching | 5s
+/// prefetch-names | names to resolve in parallel on component load, results for them are kept in a separate cache that is never evicted | []
 ///
 /// ## Static configuration example:
 ///
@@ -52,6 +53,12 @@ public:
     static yaml_config::Schema GetStaticConfigSchema();
 
 private:
+    Component(
+        const components::ComponentConfig&,
+        const components::ComponentContext&,
+        const ResolverConfig& resolver_config
+    );
+
     void Write(utils::statistics::Writer& writer);
 
     Resolver resolver_;
@@ -39,6 +39,10 @@ struct ResolverConfig {
 
     /// Network cache failure TTL
     std::chrono::milliseconds cache_failure_ttl{std::chrono::seconds{5}};
+
+    /// Names to resolve in parallel by Resolver::Prefetch(). Results for these
+    /// names are kept in a separate read-mostly cache, that is never evicted.
+    std::vector<std::string> prefetch_names;
 };
 
 }  // namespace clients::dns
@@ -50,6 +50,11 @@ public:
     /// a result within the specified deadline.
     AddrVector Resolve(const std::string& name, engine::Deadline deadline);
 
+    /// Resolves all the ResolverConfig::prefetch_names in parallel and waits
+    /// for the results, but no longer than the specified deadline.
+    /// Resolution failures are logged and are not reported to the caller.
+    void Prefetch(engine::Deadline deadline);
+
     /// Returns lookup source counters.
     const LookupSourceCounters& GetLookupSourceCounters() const;
 
@@ -64,7 +69,7 @@ public:
 
 private:
     class Impl;
-    constexpr static size_t kSize = 1728;
+    constexpr static size_t kSize = 1984;
     constexpr static size_t kAlignment = 16;
     utils::FastPimpl<Impl, kSize, kAlignment> impl_;
 };
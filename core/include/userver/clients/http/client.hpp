@@ -32,6 +32,7 @@ class TracingManagerBase;
 namespace curl {
 class easy;
 class multi;
+class share;
 class ConnectRateLimiter;
 }  // namespace curl
 
@@ -169,6 +170,7 @@ private:
     rcu::Variable<std::vector<std::string>> allowed_urls_extra_;
 
     std::shared_ptr<curl::ConnectRateLimiter> connect_rate_limiter_;
+    std::shared_ptr<curl::share> ssl_session_share_;
 
     clients::dns::Resolver* resolver_{nullptr};
     utils::NotNull<const tracing::TracingManagerBase*> tracing_manager_;
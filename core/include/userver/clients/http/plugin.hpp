@@ -4,9 +4,15 @@
 /// @brief @copybrief clients::http::Plugin
 
 #include <chrono>
+#include <exception>
+#include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include <userver/engine/future.hpp>
+#include <userver/utils/any_storage.hpp>
 #include <userver/utils/not_null.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -16,6 +22,10 @@ namespace clients::http {
 class RequestState;
 class Response;
 
+/// @brief AnyStorage tag for the per-request data of the plugins
+/// @see PluginRequest::GetStorageContext
+struct PluginStorageContext {};
+
 /// @brief Auxiliary entity that allows editing request to a client
 /// from plugins
 class PluginRequest final {
@@ -30,10 +40,43 @@ public:
 
     void SetTimeout(std::chrono::milliseconds ms);
 
+    /// @brief Returns the URL of the request, including the query parameters
+    const std::string& GetOriginalUrl() const;
+
+    /// @brief Returns the HTTP method name of the request, e.g. "GET"
+    std::string_view GetHttpMethod() const;
+
+    /// @brief Returns the value of the request header if it was set
+    std::optional<std::string_view> FindHeaderByName(std::string_view name) const;
+
+    /// @brief Returns the timeout of a single attempt
+    std::chrono::milliseconds GetTimeout() const;
+
+    /// @brief Returns true for the requests of the Stream API. Such requests
+    /// are not passed to HookLookupResponse and HookOnError.
+    bool IsStreamed() const;
+
+    /// @brief Returns an identifier of the request that is the same in all the
+    /// hooks of a single request and differs between the requests in flight
+    const void* GetRequestId() const noexcept;
+
+    /// @brief Returns the storage for the data that a plugin passes between
+    /// the hooks of a single request. The data lives as long as the request.
+    utils::AnyStorage<PluginStorageContext>& GetStorageContext();
+
 private:
     RequestState& state_;
 };
 
+/// @brief The exception to set into the future returned from
+/// Plugin::HookLookupResponse to make the request look up its response again,
+/// e.g. to send the request itself because the request it was waiting for
+/// was cancelled. The request keeps its own deadline.
+class LookupRetryException final : public std::exception {
+public:
+    const char* what() const noexcept override;
+};
+
 /// @brief Base class for HTTP Client plugins
 class Plugin {
 public:
@@ -60,6 +103,36 @@ public:
     ///          not do any heavy work here, offload it to other hooks.
     virtual void HookOnCompleted(PluginRequest& request, Response& response) = 0;
 
+    /// @brief The hook is called instead of HookOnCompleted if the request
+    ///        has failed without a response (network error, deadline,
+    ///        cancellation). Is not called for streamed requests.
+    ///
+    /// @warning The hook may be called in libev thread, not in coroutine
+    ///          context! Do not do any heavy work here.
+    virtual void HookOnError(PluginRequest& request, std::exception_ptr error);
+
+    /// @brief The hook is called in coroutine context after HookCreateSpan and
+    ///        before the request is sent. If the hook returns a future, the
+    ///        request is not sent at all and the caller gets the response from
+    ///        that future, still respecting its own deadline and cancellation.
+    ///        Plugins after the one that returned a future are not called.
+    ///        If the future holds LookupRetryException, the request looks up
+    ///        its response again. Is not called for streamed requests.
+    virtual std::optional<engine::Future<std::shared_ptr<Response>>> HookLookupResponse(PluginRequest& request);
+
+    /// @brief The hook is called in coroutine context instead of
+    ///        HookOnCompleted and HookOnError if HookLookupResponse of one of
+    ///        the next plugins has provided the response, so the request is not
+    ///        sent. Use it to release what was acquired in HookLookupResponse.
+    virtual void HookOnRequestNotSent(PluginRequest& request);
+
+    /// @brief The hook is called in coroutine context when the response is
+    ///        returned to the caller by ResponseFuture::Get(). Unlike
+    ///        HookOnCompleted, coroutine synchronization primitives may be used
+    ///        here. Is not called for detached and streamed requests and for the
+    ///        plugin that provided the response from HookLookupResponse.
+    virtual void HookOnResponse(PluginRequest& request, Response& response);
+
 private:
     const std::string name_;
 };
@@ -76,6 +149,12 @@ public:
 
     void HookOnCompleted(RequestState& request, Response& response);
 
+    void HookOnError(RequestState& request, std::exception_ptr error);
+
+    std::optional<engine::Future<std::shared_ptr<Response>>> HookLookupResponse(RequestState& request);
+
+    void HookOnResponse(RequestState& request, Response& response);
+
 private:
     const std::vector<utils::NotNull<Plugin*>> plugins_;
 };
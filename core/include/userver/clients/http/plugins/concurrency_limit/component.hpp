@@ -0,0 +1,78 @@
+#pragma once
+
+/// @file userver/clients/http/plugins/concurrency_limit/component.hpp
+/// @brief @copybrief clients::http::plugins::concurrency_limit::Component
+
+#include <memory>
+
+#include <userver/clients/http/plugin_component.hpp>
+#include <userver/utils/statistics/entry.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http::plugins::concurrency_limit {
+
+class Plugin;
+
+// clang-format off
+
+/// @ingroup userver_components
+///
+/// @brief HTTP client plugin that adaptively limits the number of concurrent
+/// requests to each destination ("host:port" of the URL).
+///
+/// The limit is computed once per second by
+/// congestion_control::v2::LinearController from the observed timings, network
+/// errors, timeouts and 5xx/429 responses of the destination. While the
+/// destination is healthy there is no limit. Requests over the limit fail
+/// fast with clients::http::NetworkProblemException without being sent.
+///
+/// The plugin is enabled by adding `concurrency-limit` to the `plugins` option
+/// of components::HttpClient. List it after the plugins that respond without
+/// sending a request (`single-flight`, `response-cache`), so that only the
+/// requests that actually reach the destination are accounted.
+///
+/// The heuristics are tuned by the
+/// @ref HTTP_CLIENT_CONGESTION_CONTROL_SETTINGS dynamic config.
+///
+/// ## Static options:
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
+/// congestion-control.enabled | set to `false` to never limit the requests | true
+/// congestion-control.fake-mode | compute the limits, but do not apply them | false
+/// max-destinations | max number of destinations with own limits, requests to other destinations are not limited | 100
+///
+/// ## Statistics:
+/// `httpclient.concurrency-limit` with the `http_destination` label:
+/// `in-flight` - requests being sent,
+/// `rejected` - requests rejected by the limit,
+/// `congestion-control.current-limit` - the current limit, if any.
+
+// clang-format on
+
+class Component final : public plugin::ComponentBase {
+public:
+    /// @ingroup userver_component_names
+    /// @brief The default name of
+    /// clients::http::plugins::concurrency_limit::Component component
+    static constexpr std::string_view kName = "http-client-plugin-concurrency-limit";
+
+    Component(const components::ComponentConfig&, const components::ComponentContext&);
+
+    ~Component() override;
+
+    http::Plugin& GetPlugin() override;
+
+    static yaml_config::Schema GetStaticConfigSchema();
+
+private:
+    std::unique_ptr<concurrency_limit::Plugin> plugin_;
+    utils::statistics::Entry statistics_holder_;
+};
+
+}  // namespace clients::http::plugins::concurrency_limit
+
+template <>
+inline constexpr bool components::kHasValidate<clients::http::plugins::concurrency_limit::Component> = true;
+
+USERVER_NAMESPACE_END
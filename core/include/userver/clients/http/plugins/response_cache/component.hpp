@@ -0,0 +1,74 @@
+#pragma once
+
+/// @file userver/clients/http/plugins/response_cache/component.hpp
+/// @brief @copybrief clients::http::plugins::response_cache::Component
+
+#include <memory>
+
+#include <userver/clients/http/plugin_component.hpp>
+#include <userver/utils/statistics/entry.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http::plugins::response_cache {
+
+class Plugin;
+
+// clang-format off
+
+/// @ingroup userver_components
+///
+/// @brief HTTP client plugin that caches responses to GET requests on the
+/// client side honouring `Cache-Control` and `ETag` response headers.
+///
+/// Fresh responses (`Cache-Control: max-age`) are served without any network
+/// interaction. Stale responses with an `ETag` are revalidated with
+/// `If-None-Match`, and `304 Not Modified` is replaced with the cached
+/// response. Conditional requests of the caller get `304 Not Modified` as is.
+///
+/// The cache is shared by all the callers: responses with
+/// `Cache-Control: no-store` or `Cache-Control: private` and `Vary: *` are
+/// never cached, and the requests with `Authorization` bypass the cache unless
+/// `Authorization` is listed in `headers`. The request headers listed in
+/// `Vary` must match the ones of the cached response.
+///
+/// The plugin is enabled by adding `response-cache` to the `plugins` option of
+/// components::HttpClient.
+///
+/// ## Static options:
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
+/// ways | number of cache shards, see cache::NWayLRU | 16
+/// max-memory-bytes | upper bound for memory used by cached responses, see cache::DefaultWeigher | 64Mb
+/// max-entry-bytes | responses larger than that are not cached | 1Mb
+/// max-lifetime | stale responses older than that are not revalidated but evicted | 10m
+/// headers | request headers that are a part of the cache key | []
+
+// clang-format on
+
+class Component final : public plugin::ComponentBase {
+public:
+    /// @ingroup userver_component_names
+    /// @brief The default name of
+    /// clients::http::plugins::response_cache::Component component
+    static constexpr std::string_view kName = "http-client-plugin-response-cache";
+
+    Component(const components::ComponentConfig&, const components::ComponentContext&);
+
+    ~Component() override;
+
+    http::Plugin& GetPlugin() override;
+
+    static yaml_config::Schema GetStaticConfigSchema();
+
+private:
+    std::unique_ptr<response_cache::Plugin> plugin_;
+    utils::statistics::Entry statistics_holder_;
+};
+
+}  // namespace clients::http::plugins::response_cache
+
+template <>
+inline constexpr bool components::kHasValidate<clients::http::plugins::response_cache::Component> = true;
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,70 @@
+#pragma once
+
+/// @file userver/clients/http/plugins/single_flight/component.hpp
+/// @brief @copybrief clients::http::plugins::single_flight::Component
+
+#include <memory>
+
+#include <userver/clients/http/plugin_component.hpp>
+#include <userver/utils/statistics/entry.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http::plugins::single_flight {
+
+class Plugin;
+
+// clang-format off
+
+/// @ingroup userver_components
+///
+/// @brief HTTP client plugin that merges identical in-flight GET requests
+/// into a single network request and shares the response with all the callers.
+///
+/// Requests are considered identical if they have the same URL and the same
+/// values of the headers listed in the `headers` option. Each caller still
+/// waits for the response with its own deadline and cancellation. If the
+/// request that was actually sent fails, all the merged callers get the same
+/// error.
+///
+/// The plugin is enabled by adding `single-flight` to the `plugins` option of
+/// components::HttpClient.
+///
+/// ## Static options:
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
+/// headers | request headers that are a part of the request identity | []
+///
+/// ## Statistics:
+/// `httpclient.single-flight.sent` - requests that were actually sent,
+/// `httpclient.single-flight.coalesced` - requests that were merged into
+/// an in-flight one.
+
+// clang-format on
+
+class Component final : public plugin::ComponentBase {
+public:
+    /// @ingroup userver_component_names
+    /// @brief The default name of
+    /// clients::http::plugins::single_flight::Component component
+    static constexpr std::string_view kName = "http-client-plugin-single-flight";
+
+    Component(const components::ComponentConfig&, const components::ComponentContext&);
+
+    ~Component() override;
+
+    http::Plugin& GetPlugin() override;
+
+    static yaml_config::Schema GetStaticConfigSchema();
+
+private:
+    std::unique_ptr<single_flight::Plugin> plugin_;
+    utils::statistics::Entry statistics_holder_;
+};
+
+}  // namespace clients::http::plugins::single_flight
+
+template <>
+inline constexpr bool components::kHasValidate<clients::http::plugins::single_flight::Component> = true;
+
+USERVER_NAMESPACE_END
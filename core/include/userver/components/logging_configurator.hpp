@@ -8,6 +8,7 @@
 #include <userver/concurrent/async_event_source.hpp>
 #include <userver/dynamic_config/source.hpp>
 #include <userver/rcu/rcu.hpp>
+#include <userver/utils/periodic_task.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -29,12 +30,13 @@ namespace components {
 /// ## Dynamic config
 /// * @ref USERVER_LOG_DYNAMIC_DEBUG
 /// * @ref USERVER_NO_LOG_SPANS
+/// * @ref USERVER_TRACE_SAMPLING
 ///
 /// ## Static options:
 /// Name | Description | Default value
 /// ---- | ----------- | -------------
 /// limited-logging-enable | set to true to make LOG_LIMITED drop repeated logs | -
-/// limited-logging-interval | utils::StringToDuration suitable duration string to group repeated logs into one message | -
+/// limited-logging-interval | utils::StringToDuration suitable duration string to group repeated logs into one message, the count of the dropped logs is reported at the end of each interval | -
 ///
 /// ## Config example:
 ///
@@ -58,6 +60,7 @@ private:
 
     concurrent::AsyncEventSubscriberScope config_subscription_;
     rcu::Variable<logging::DynamicDebugConfig> dynamic_debug_;
+    utils::PeriodicTask log_limited_summaries_task_;
 };
 
 /// }@
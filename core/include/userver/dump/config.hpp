@@ -42,6 +42,8 @@ struct Config final {
     std::optional<std::chrono::milliseconds> max_dump_age;
     bool max_dump_age_set;
     bool dump_is_encrypted;
+    bool dump_is_mmapped;
+    bool dump_is_compressed;
 
     bool static_dumps_enabled;
     std::chrono::milliseconds static_min_dump_interval;
@@ -85,6 +85,8 @@ enum class UpdateType {
 /// `min-interval` | `string` (duration) | `WriteDumpAsync` calls performed in a fast succession are ignored | `0s`
 /// `fs-task-processor` | `string` | `TaskProcessor` for blocking disk IO | `fs-task-processor`
 /// `encrypted` | `boolean` | Whether to encrypt the dump | `false`
+/// `mmap` | `boolean` | Whether to map the dump into memory on read, allows dump::MappedArray to be used in place; incompatible with `encrypted` | `false`
+/// `compressed` | `boolean` | Whether to compress the dump with zstd in chunks, that are compressed and decompressed in parallel on `fs-task-processor`; incompatible with `encrypted` and `mmap` | `false`
 ///
 /// ## Sample usage
 /// @snippet core/src/dump/dumper_test.cpp  Sample Dumper usage
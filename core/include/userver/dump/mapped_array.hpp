@@ -0,0 +1,155 @@
+#pragma once
+
+/// @file userver/dump/mapped_array.hpp
+/// @brief @copybrief dump::MappedArray
+///
+/// @ingroup userver_dump_read_write
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <userver/dump/common.hpp>
+#include <userver/dump/operations.hpp>
+#include <userver/dump/unsafe.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+/// @brief An immutable array of trivially copyable elements that can be
+/// used in place when the dump is mapped into memory
+///
+/// When the dump is read by `MmapFileReader` (`dump.mmap: true`), reading
+/// a `MappedArray` does not copy or parse its elements, the array points
+/// into the mapped file and its pages are loaded on the first access. Other
+/// readers copy the elements into a heap buffer, so the dump format does not
+/// depend on the reader.
+///
+/// The elements are stored with their in-memory representation. The dump
+/// records the layout of `T` and the byte order, reading a dump written with
+/// a different layout throws `dump::Error`, so the cache falls back to
+/// a regular update. Bump `format-version` of the dump if the meaning of
+/// the fields of `T` changes. `T` must not contain pointers.
+///
+/// Sorted arrays can be searched with `std::lower_bound`; strings can be
+/// stored as offsets into a `MappedArray<char>`.
+///
+/// Copies share the elements.
+template <typename T>
+class MappedArray final {
+    static_assert(std::is_trivially_copyable_v<T>, "MappedArray elements must be trivially copyable");
+
+public:
+    using value_type = T;
+    using const_iterator = const T*;
+
+    MappedArray() = default;
+
+    /// Copies the elements into the heap
+    explicit MappedArray(std::vector<T> data) {
+        auto storage = std::make_shared<const std::vector<T>>(std::move(data));
+        data_ = storage->data();
+        size_ = storage->size();
+        owner_ = std::move(storage);
+    }
+
+    /// Uses `size` elements at `data` in place, `owner` keeps them alive
+    MappedArray(const T* data, std::size_t size, std::shared_ptr<const void> owner) noexcept
+        : data_(data), size_(size), owner_(std::move(owner)) {}
+
+    const T* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    const_iterator begin() const noexcept { return data_; }
+    const_iterator end() const noexcept { return data_ + size_; }
+
+    const T& operator[](std::size_t index) const noexcept { return data_[index]; }
+
+private:
+    const T* data_{nullptr};
+    std::size_t size_{0};
+    std::shared_ptr<const void> owner_;
+};
+
+namespace impl {
+
+inline constexpr std::uint64_t kMappedArrayVersion = 1;
+inline constexpr std::uint32_t kMappedArrayByteOrderMark = 0x01020304;
+
+template <typename T>
+MappedArray<T> CopyMappedArray(const char* data, std::size_t size) {
+    std::vector<T> result(size);
+    if (size != 0) std::memcpy(static_cast<void*>(result.data()), data, size * sizeof(T));
+    return MappedArray<T>(std::move(result));
+}
+
+}  // namespace impl
+
+/// @brief `MappedArray` serialization support
+template <typename T>
+void Write(Writer& writer, const MappedArray<T>& array) {
+    writer.Write(impl::kMappedArrayVersion);
+    impl::WriteTrivial(writer, impl::kMappedArrayByteOrderMark);
+    writer.Write(sizeof(T));
+    writer.Write(alignof(T));
+    writer.Write(array.size());
+
+    WritePaddingUnsafe(writer, alignof(T));
+    WriteStringViewUnsafe(writer, {reinterpret_cast<const char*>(array.data()), array.size() * sizeof(T)});
+}
+
+/// @brief `MappedArray` deserialization support
+template <typename T>
+MappedArray<T> Read(Reader& reader, To<MappedArray<T>>) {
+    const auto version = reader.Read<std::uint64_t>();
+    const auto byte_order_mark = impl::ReadTrivial<std::uint32_t>(reader);
+    const auto size_of = reader.Read<std::size_t>();
+    const auto align_of = reader.Read<std::size_t>();
+    if (version != impl::kMappedArrayVersion || byte_order_mark != impl::kMappedArrayByteOrderMark ||
+        size_of != sizeof(T) || align_of != alignof(T)) {
+        throw Error(fmt::format(
+            "Incompatible layout of MappedArray in the dump: version={}, byte-order-mark={:#x}, sizeof={}, "
+            "alignof={}; expected version={}, byte-order-mark={:#x}, sizeof={}, alignof={}",
+            version,
+            byte_order_mark,
+            size_of,
+            align_of,
+            impl::kMappedArrayVersion,
+            impl::kMappedArrayByteOrderMark,
+            sizeof(T),
+            alignof(T)
+        ));
+    }
+
+    const auto size = reader.Read<std::size_t>();
+    if (size > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+        throw Error(fmt::format("Invalid size of MappedArray in the dump: size={}", size));
+    }
+    SkipPaddingUnsafe(reader, alignof(T));
+
+    const auto byte_size = size * sizeof(T);
+    if (auto mapped = ReadMappedUnsafe(reader, byte_size)) {
+        const auto* data = mapped->data.data();
+        if (reinterpret_cast<std::uintptr_t>(data) % alignof(T) == 0) {
+            return MappedArray<T>(reinterpret_cast<const T*>(data), size, std::move(mapped->owner));
+        }
+        // Unaligned data can only be copied out
+        return impl::CopyMappedArray<T>(data, size);
+    }
+
+    return impl::CopyMappedArray<T>(ReadStringViewUnsafe(reader, byte_size).data(), size);
+}
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstddef>
+#include <memory>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <string_view>
@@ -35,13 +38,30 @@ public:
     /// @throws `Error` on write operation failure
     virtual void Finish() = 0;
 
+    /// @brief Returns the amount of data written so far, before any
+    /// compression or encryption
+    std::size_t GetWrittenSize() const noexcept { return written_size_; }
+
 protected:
     /// @brief Writes binary data
     /// @details Unlike `Write`, doesn't write the size of `data`
     /// @throws `Error` on write operation failure
     virtual void WriteRaw(std::string_view data) = 0;
 
+private:
+    std::size_t written_size_{0};
+
     friend void WriteStringViewUnsafe(Writer& writer, std::string_view value);
+    friend void WritePaddingUnsafe(Writer& writer, std::size_t alignment);
+};
+
+/// @brief Binary data that stays valid after further reads
+/// @see ReadMappedUnsafe
+struct MappedData final {
+    std::string_view data;
+
+    /// Keeps `data` alive
+    std::shared_ptr<const void> owner;
 };
 
 /// A general interface for binary data input
@@ -60,6 +80,10 @@ public:
     /// @throws `Error` on read operation failure or if there is leftover data
     virtual void Finish() = 0;
 
+    /// @brief Returns the amount of data read so far, after any
+    /// decompression or decryption
+    std::size_t GetReadSize() const noexcept { return read_size_; }
+
 protected:
     /// @brief Reads binary data
     /// @note Invalidates the memory returned by the previous call of `ReadRaw`
@@ -68,7 +92,19 @@ protected:
     /// @throws `Error` on read operation failure
     virtual std::string_view ReadRaw(std::size_t max_size) = 0;
 
+    /// @brief Reads exactly `size` bytes of binary data without copying them
+    /// @details Returns `std::nullopt` without consuming any data if
+    /// the `Reader` does not support it, in that case the data should be read
+    /// by `ReadRaw`. The default implementation does not support it.
+    /// @throws `Error` on read operation failure or on end-of-file
+    virtual std::optional<MappedData> ReadMapped(std::size_t size);
+
+private:
+    std::size_t read_size_{0};
+
     friend std::string_view ReadUnsafeAtMost(Reader& reader, std::size_t size);
+    friend std::optional<MappedData> ReadMappedUnsafe(Reader& reader, std::size_t size);
+    friend void SkipPaddingUnsafe(Reader& reader, std::size_t alignment);
 };
 
 namespace impl {
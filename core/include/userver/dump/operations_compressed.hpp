@@ -0,0 +1,115 @@
+#pragma once
+
+/// @file userver/dump/operations_compressed.hpp
+/// @brief @copybrief dump::CompressedWriter
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <string>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <userver/compression/zstd.hpp>
+#include <userver/dump/factory.hpp>
+#include <userver/dump/operations.hpp>
+#include <userver/dump/operations_file.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+/// Settings of dump::CompressedWriter
+struct CompressedWriterSettings final {
+    /// Size of the data before compression in a chunk
+    std::size_t chunk_size{4 * 1024 * 1024};
+
+    /// Maximum number of chunks that are compressed concurrently
+    std::size_t max_parallel_chunks{4};
+
+    int compression_level{compression::zstd::kDefaultCompressionLevel};
+};
+
+/// @brief A handle to a compressed dump file
+///
+/// The data is split into chunks that are zstd-compressed independently
+/// by the tasks on the current task processor, while the serialization goes
+/// on. Each chunk carries a checksum that is verified by `CompressedReader`.
+///
+/// File operations block the thread.
+class CompressedWriter final : public Writer {
+public:
+    /// @brief Creates a new dump file and opens it
+    /// @throws `Error` on a filesystem error
+    CompressedWriter(
+        std::string path,
+        boost::filesystem::perms perms,
+        tracing::ScopeTime& scope,
+        const CompressedWriterSettings& settings = {}
+    );
+
+    ~CompressedWriter() override;
+
+    void Finish() override;
+
+private:
+    void WriteRaw(std::string_view data) override;
+
+    void FlushChunk();
+    void WriteOldestChunk();
+
+    FileWriter file_;
+    const CompressedWriterSettings settings_;
+    std::string chunk_;
+    std::deque<engine::TaskWithResult<std::string>> compressed_chunks_;
+};
+
+/// @brief A handle to a dump file written by `CompressedWriter`
+///
+/// Chunks are read ahead and decompressed by the tasks on the current task
+/// processor, while the deserialization goes on.
+///
+/// File operations block the thread.
+class CompressedReader final : public Reader {
+public:
+    /// @brief Opens an existing dump file
+    /// @throws `Error` on a filesystem error or if the file is not compressed
+    explicit CompressedReader(std::string path, std::size_t max_parallel_chunks = 4);
+
+    ~CompressedReader() override;
+
+    void Finish() override;
+
+private:
+    std::string_view ReadRaw(std::size_t max_size) override;
+
+    std::string_view TakeFromChunk(std::size_t max_size);
+    bool NextChunk();
+    void ScheduleChunks();
+
+    FileReader file_;
+    std::string path_;
+    const std::size_t max_parallel_chunks_;
+    bool file_finished_{false};
+    std::string chunk_;
+    std::size_t chunk_position_{0};
+    std::string buffer_;
+    std::deque<engine::TaskWithResult<std::string>> decompressed_chunks_;
+};
+
+class CompressedOperationsFactory final : public OperationsFactory {
+public:
+    explicit CompressedOperationsFactory(boost::filesystem::perms perms);
+
+    std::unique_ptr<Reader> CreateReader(std::string full_path) override;
+
+    std::unique_ptr<Writer> CreateWriter(std::string full_path, tracing::ScopeTime& scope) override;
+
+private:
+    const boost::filesystem::perms perms_;
+};
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,64 @@
+#pragma once
+
+/// @file userver/dump/operations_mmap.hpp
+/// @brief @copybrief dump::MmapFileReader
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <userver/dump/factory.hpp>
+#include <userver/dump/operations.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+/// @brief A handle to a dump file that is mapped into memory
+///
+/// Reads the files written by `FileWriter`. The pages of the file are loaded
+/// lazily on the first access. The data read by `ReadMappedUnsafe` is not
+/// copied and stays valid as long as its `MappedData::owner` is alive,
+/// e.g. `MappedArray` uses the dumped data in place.
+///
+/// File operations block the thread.
+class MmapFileReader final : public Reader {
+public:
+    /// @brief Opens an existing dump file and maps it into memory
+    /// @throws `Error` on a filesystem error
+    explicit MmapFileReader(std::string path);
+
+    ~MmapFileReader() override;
+
+    void Finish() override;
+
+private:
+    class Mapping;
+
+    std::string_view ReadRaw(std::size_t max_size) override;
+
+    std::optional<MappedData> ReadMapped(std::size_t size) override;
+
+    std::string path_;
+    std::shared_ptr<const Mapping> mapping_;
+    std::size_t position_{0};
+};
+
+/// Reads the dumps with `MmapFileReader` and writes them with `FileWriter`
+class MmapOperationsFactory final : public OperationsFactory {
+public:
+    explicit MmapOperationsFactory(boost::filesystem::perms perms);
+
+    std::unique_ptr<Reader> CreateReader(std::string full_path) override;
+
+    std::unique_ptr<Writer> CreateWriter(std::string full_path, tracing::ScopeTime& scope) override;
+
+private:
+    const boost::filesystem::perms perms_;
+};
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <optional>
 #include <string_view>
 
 #include <userver/dump/operations.hpp>
@@ -27,6 +29,26 @@ std::string_view ReadStringViewUnsafe(Reader& reader, std::size_t size);
 /// @warning The `string_view` will be invalidated on the next `Read` operation
 std::string_view ReadUnsafeAtMost(Reader& reader, std::size_t max_size);
 
+/// @brief Writes zero bytes until the amount of data written
+/// is a multiple of `alignment`
+/// @note Allows the readers that map the dump into memory to return data
+/// aligned to `alignment`, see `ReadMappedUnsafe`
+void WritePaddingUnsafe(Writer& writer, std::size_t alignment);
+
+/// @brief Skips the bytes written by `WritePaddingUnsafe` with the same
+/// `alignment`
+void SkipPaddingUnsafe(Reader& reader, std::size_t alignment);
+
+/// @brief Reads a non-size-prefixed data without copying it, if the `Reader`
+/// supports it, e.g. if the dump is mapped into memory
+/// @details Returns `std::nullopt` without consuming any data otherwise,
+/// in that case `ReadStringViewUnsafe` should be used instead.
+/// The data is aligned to `alignment` if it was preceded by
+/// `WritePaddingUnsafe` with that `alignment`.
+/// @note The returned data is kept alive by `MappedData::owner`, regardless
+/// of further `Read` operations and of the `Reader` lifetime
+std::optional<MappedData> ReadMappedUnsafe(Reader& reader, std::size_t size);
+
 }  // namespace dump
 
 USERVER_NAMESPACE_END
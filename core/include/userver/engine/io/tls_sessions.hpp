@@ -0,0 +1,102 @@
+#pragma once
+
+/// @file userver/engine/io/tls_sessions.hpp
+/// @brief TLS session resumption support for engine::io::TlsWrapper
+
+#include <cstddef>
+#include <memory>
+
+#include <userver/utils/statistics/rate_counter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+class Writer;
+}  // namespace utils::statistics
+
+namespace engine::io {
+
+/// Counters of TLS handshakes
+struct TlsHandshakeStats final {
+    /// Handshakes that established a new session
+    utils::statistics::RateCounter full;
+    /// Handshakes that resumed a previously established session
+    utils::statistics::RateCounter resumed;
+};
+
+void DumpMetric(utils::statistics::Writer& writer, const TlsHandshakeStats& stats);
+
+/// @brief Client side cache of TLS sessions keyed by destination.
+///
+/// Pass it to engine::io::TlsWrapper::StartTlsClient to resume the sessions
+/// to the previously visited destinations with an abbreviated handshake.
+/// Sessions are stored as soon as the server issues them, including the
+/// TLS 1.3 tickets that arrive after the handshake. The cache must outlive
+/// all the engine::io::TlsWrapper instances that use it.
+///
+/// Thread safe.
+class TlsSessionCache final {
+public:
+    /// @param max_size maximum number of destinations to keep sessions for,
+    /// least recently used sessions are evicted first
+    explicit TlsSessionCache(std::size_t max_size = 1000);
+    ~TlsSessionCache();
+
+    TlsSessionCache(const TlsSessionCache&) = delete;
+    TlsSessionCache& operator=(const TlsSessionCache&) = delete;
+
+    /// Forgets all the stored sessions
+    void Clear();
+
+    /// Number of destinations with a stored session
+    std::size_t GetSize() const;
+
+    /// Handshakes of the client connections that used this cache
+    const TlsHandshakeStats& GetStats() const noexcept;
+
+    /// @cond
+    // For internal use only
+    class Impl;
+    Impl& GetImpl() noexcept;
+    /// @endcond
+
+private:
+    std::unique_ptr<Impl> impl_;
+};
+
+/// @brief Server side keys for stateless TLS session tickets.
+///
+/// Pass it to engine::io::TlsWrapper::StartTlsServer to allow the clients
+/// to resume sessions with the tickets encrypted by these keys. Tickets
+/// encrypted with the previous key are still accepted after Rotate(), the
+/// clients that present them get a new ticket encrypted with the current key.
+///
+/// Keys are generated randomly and never leave the process memory, so the
+/// tickets are valid only for the servers that share the same instance.
+///
+/// Thread safe.
+class TlsTicketKeys final {
+public:
+    TlsTicketKeys();
+    ~TlsTicketKeys();
+
+    TlsTicketKeys(const TlsTicketKeys&) = delete;
+    TlsTicketKeys& operator=(const TlsTicketKeys&) = delete;
+
+    /// @brief Generates a new key for the new tickets and drops the previous
+    /// one. Must be called from a coroutine.
+    void Rotate();
+
+    /// @cond
+    // For internal use only
+    class Impl;
+    Impl& GetImpl() noexcept;
+    /// @endcond
+
+private:
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace engine::io
+
+USERVER_NAMESPACE_END
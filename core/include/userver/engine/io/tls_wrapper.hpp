@@ -11,6 +11,7 @@
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/io/common.hpp>
 #include <userver/engine/io/socket.hpp>
+#include <userver/engine/io/tls_sessions.hpp>
 #include <userver/utils/fast_pimpl.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -29,6 +30,16 @@ public:
     /// Starts a TLS client on an opened socket
     static TlsWrapper StartTlsClient(Socket&& socket, const std::string& server_name, Deadline deadline);
 
+    /// @brief Starts a TLS client on an opened socket, resuming the session
+    /// from the `session_cache` if there is one for this destination.
+    /// @see engine::io::TlsSessionCache
+    static TlsWrapper StartTlsClient(
+        Socket&& socket,
+        const std::string& server_name,
+        TlsSessionCache& session_cache,
+        Deadline deadline
+    );
+
     /// Starts a TLS client with client cert on an opened socket
     static TlsWrapper StartTlsClient(
         Socket&& socket,
@@ -48,6 +59,18 @@ public:
         const std::vector<crypto::Certificate>& extra_cert_authorities = {}
     );
 
+    /// @brief Starts a TLS server on an opened socket, issuing the session
+    /// tickets encrypted with `ticket_keys` and accepting them for resumption.
+    /// @see engine::io::TlsTicketKeys
+    static TlsWrapper StartTlsServer(
+        Socket&& socket,
+        const crypto::Certificate& cert,
+        const crypto::PrivateKey& key,
+        TlsTicketKeys& ticket_keys,
+        Deadline deadline,
+        const std::vector<crypto::Certificate>& extra_cert_authorities = {}
+    );
+
     ~TlsWrapper() override;
 
     TlsWrapper(const TlsWrapper&) = delete;
@@ -59,6 +82,9 @@ public:
     /// Whether the socket is valid.
     bool IsValid() const override;
 
+    /// Whether the handshake resumed a previously established session.
+    bool IsSessionReused() const;
+
     /// Suspends current task until the socket has data available.
     [[nodiscard]] bool WaitReadable(Deadline) override;
 
@@ -109,11 +135,20 @@ public:
 private:
     explicit TlsWrapper(Socket&&);
 
+    static TlsWrapper DoStartTlsServer(
+        Socket&& socket,
+        const crypto::Certificate& cert,
+        const crypto::PrivateKey& key,
+        TlsTicketKeys::Impl* ticket_keys,
+        Deadline deadline,
+        const std::vector<crypto::Certificate>& extra_cert_authorities
+    );
+
     void SetupContextAccessors();
 
     class Impl;
     class ReadContextAccessor;
-    constexpr static size_t kSize = 336;
+    constexpr static size_t kSize = 344;
     constexpr static size_t kAlignment = 8;
     utils::FastPimpl<Impl, kSize, kAlignment> impl_;
 };
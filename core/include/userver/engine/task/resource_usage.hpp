@@ -0,0 +1,47 @@
+#pragma once
+
+/// @file userver/engine/task/resource_usage.hpp
+/// @brief @copybrief engine::TaskResourceUsage
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+/// @brief Resources consumed by a task while it was running on the
+/// task processor threads.
+///
+/// The time the task spends waiting (sleeping, in a queue) is not accounted.
+struct TaskResourceUsage {
+    /// On-CPU time of the task
+    std::chrono::nanoseconds cpu_time{0};
+
+    /// Bytes allocated by the task, always 0 if userver is built without
+    /// jemalloc. Deallocations are not subtracted.
+    std::uint64_t allocated_bytes{0};
+};
+
+namespace current_task {
+
+/// @brief Starts accounting of the resources consumed by the current task.
+///
+/// The accounting is done on each context switch of the task and costs
+/// a couple of system calls, so it is disabled by default. The resources
+/// consumed by the subtasks of the current task are not accounted.
+///
+/// Calling the function again does not reset the accumulated values.
+void EnableResourceAccounting() noexcept;
+
+/// @returns the resources consumed by the current task since the
+/// EnableResourceAccounting() call, or std::nullopt if the accounting is
+/// not enabled for the current task.
+std::optional<TaskResourceUsage> GetResourceUsage() noexcept;
+
+}  // namespace current_task
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
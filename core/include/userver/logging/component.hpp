@@ -43,10 +43,14 @@ namespace components {
 /// ---- | ----------- | -------------
 /// file_path | path to the log file | -
 /// level | log verbosity | info
-/// format | log output format, either `tskv` or `ltsv` | tskv
+/// format | log output format, either `tskv`, `ltsv` or `binary`, see logging::Format | tskv
 /// flush_level | messages of this and higher levels get flushed to the file immediately | warning
 /// message_queue_size | the size of internal message queue, must be a power of 2 | 65536
 /// overflow_behavior | message handling policy while the queue is full: `discard` drops messages, `block` waits until message gets into the queue | discard
+/// batch_max_bytes | the records are written to the sinks in batches of up to this size, with a single `writev` for file and unix-socket sinks | 65536
+/// batch_max_delay | time to wait for a batch of records to accumulate after the queue was empty, trades the log latency for fewer writes | 0ms
+/// rate_limit_bytes_per_second | limits the bytes of the records written by the logger, the records over the limit are dropped before formatting and accounted in the `rate_limited` metric; 0 disables the limit | 0
+/// rate_limit_burst_bytes | how many bytes the logger may write at once over the rate_limit_bytes_per_second limit | rate_limit_bytes_per_second
 /// testsuite-capture | if exists, setups additional TCP log sink for testing purposes | {}
 /// fs-task-processor | task processor for disk I/O operations for this logger | fs-task-processor of the loggers component
 ///
@@ -15,6 +15,10 @@ using Counter = utils::statistics::RateCounter;
 
 struct LogStatistics final {
     Counter dropped{};
+    // Records rejected before formatting because the logger byte budget is exhausted
+    Counter rate_limited{};
+    // Records dropped by the LOG_LIMITED_* call sites
+    Counter log_limited_dropped{};
 
     std::array<Counter, kLevelMax + 1> by_level{};
     std::atomic<bool> has_reopening_error{false};
@@ -5,6 +5,7 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 
 #include <userver/logging/format.hpp>
 #include <userver/logging/fwd.hpp>
@@ -38,6 +39,7 @@ LoggerPtr MakeStdoutLogger(const std::string& name, Format format, Level level =
 LoggerPtr MakeFileLogger(const std::string& name, const std::string& path, Format format, Level level = Level::kInfo);
 
 namespace impl {
+class LoggerBase;
 class TagWriter;
 }
 
@@ -45,6 +47,10 @@ namespace impl::default_ {
 
 bool DoShouldLog(Level) noexcept;
 
+bool DoShouldBuffer(Level) noexcept;
+
+void Buffer(LoggerBase& logger, Level level, std::string_view msg) noexcept;
+
 void PrependCommonTags(TagWriter writer);
 
 }  // namespace impl::default_
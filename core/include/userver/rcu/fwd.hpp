@@ -1,8 +1,10 @@
 #pragma once
 
 /// @file userver/rcu/fwd.hpp
-/// @brief Forward declarations for rcu::Variable and rcu::RcuMap
+/// @brief Forward declarations for rcu::Variable, rcu::RcuMap and
+/// rcu::ShardedRcuMap
 
+#include <cstddef>
 #include <functional>
 #include <unordered_map>
 
@@ -34,6 +36,13 @@ class WritablePtr;
 template <typename Key, typename Value, typename RcuMapTraits = DefaultRcuMapTraits<Key, Value>>
 class RcuMap;
 
+template <
+    typename Key,
+    typename Value,
+    typename RcuMapTraits = DefaultRcuMapTraits<Key, Value>,
+    std::size_t ShardCount = 64>
+class ShardedRcuMap;
+
 }  // namespace rcu
 
 USERVER_NAMESPACE_END
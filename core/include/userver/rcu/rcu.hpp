@@ -4,8 +4,10 @@
 /// @brief @copybrief rcu::Variable
 
 #include <atomic>
+#include <cstdint>
 #include <cstdlib>
 #include <optional>
+#include <type_traits>
 #include <utility>
 
 #include <userver/concurrent/impl/asymmetric_fence.hpp>
@@ -81,14 +83,64 @@ private:
 
 }  // namespace impl
 
+/// @brief Memory reclamation schemes of rcu::Variable, selected by
+/// the optional `kReclamation` member of the Rcu traits.
+enum class Reclamation {
+    /// Each snapshot has its own read indicator. Readers retry if the current
+    /// snapshot changes while they lock it, writers check the indicators of
+    /// all the retired snapshots on each update.
+    kPerSnapshot,
+
+    /// Readers lock one of the two read indicators of the current epoch.
+    /// Writers check a single indicator of the previous epoch and free all the
+    /// snapshots retired in it at once. Readers retry only if the epoch
+    /// changes. Better suited for frequently updated variables with many
+    /// readers, but a long-living reader delays the reclamation of all the
+    /// snapshots retired after it started.
+    kEpochs,
+};
+
+namespace impl {
+
+template <typename RcuTraits, typename = void>
+inline constexpr Reclamation kReclamationOf = Reclamation::kPerSnapshot;
+
+template <typename RcuTraits>
+inline constexpr Reclamation kReclamationOf<RcuTraits, std::void_t<decltype(RcuTraits::kReclamation)>> =
+    RcuTraits::kReclamation;
+
+template <typename T>
+struct EpochState final {
+    // Only the writers change the epoch, under the Variable's mutex
+    std::atomic<std::uint64_t> current{0};
+    // Readers of the epoch `e` lock `indicators[e % 2]`
+    mutable concurrent::impl::StripedReadIndicator indicators[2];
+    // Snapshots retired in the previous epoch
+    SnapshotRecordRetiredList<T> retired_previous;
+};
+
+struct NoEpochState final {};
+
+}  // namespace impl
+
 /// Default Rcu traits.
 /// - `MutexType` is a writer's mutex type that has to be used to protect
 /// structure on update
+/// - optional `kReclamation` of type rcu::Reclamation selects the memory
+/// reclamation scheme, rcu::Reclamation::kPerSnapshot if missing
 template <typename T>
 struct DefaultRcuTraits {
     using MutexType = engine::Mutex;
 };
 
+/// Rcu traits for the frequently updated variables with many readers,
+/// see rcu::Reclamation::kEpochs
+template <typename T>
+struct EpochRcuTraits {
+    using MutexType = engine::Mutex;
+    static constexpr Reclamation kReclamation = Reclamation::kEpochs;
+};
+
 /// Reader smart pointer for rcu::Variable<T>. You may use operator*() or
 /// operator->() to do something with the stored value. Once created,
 /// ReadablePtr references the same immutable value: if Variable's value is
@@ -98,6 +150,34 @@ template <typename T, typename RcuTraits>
 class [[nodiscard]] ReadablePtr final {
 public:
     explicit ReadablePtr(const Variable<T, RcuTraits>& ptr) {
+        if constexpr (impl::kReclamationOf<RcuTraits> == Reclamation::kEpochs) {
+            LockEpoch(ptr);
+        } else {
+            LockSnapshot(ptr);
+        }
+    }
+
+    ReadablePtr(ReadablePtr&& other) noexcept = default;
+    ReadablePtr& operator=(ReadablePtr&& other) noexcept = default;
+    ReadablePtr(const ReadablePtr& other) = default;
+    ReadablePtr& operator=(const ReadablePtr& other) = default;
+    ~ReadablePtr() = default;
+
+    const T* Get() const& {
+        UASSERT(ptr_);
+        return ptr_;
+    }
+
+    const T* Get() && { return GetOnRvalue(); }
+
+    const T* operator->() const& { return Get(); }
+    const T* operator->() && { return GetOnRvalue(); }
+
+    const T& operator*() const& { return *Get(); }
+    const T& operator*() && { return *GetOnRvalue(); }
+
+private:
+    void LockSnapshot(const Variable<T, RcuTraits>& ptr) {
         auto* record = ptr.current_.load();
 
         while (true) {
@@ -139,26 +219,30 @@ public:
         ptr_ = &*record->data;
     }
 
-    ReadablePtr(ReadablePtr&& other) noexcept = default;
-    ReadablePtr& operator=(ReadablePtr&& other) noexcept = default;
-    ReadablePtr(const ReadablePtr& other) = default;
-    ReadablePtr& operator=(const ReadablePtr& other) = default;
-    ~ReadablePtr() = default;
+    void LockEpoch(const Variable<T, RcuTraits>& ptr) {
+        auto& epochs = ptr.epochs_;
+        auto epoch = epochs.current.load();
 
-    const T* Get() const& {
-        UASSERT(ptr_);
-        return ptr_;
-    }
+        while (true) {
+            lock_ = epochs.indicators[epoch % 2].Lock();
 
-    const T* Get() && { return GetOnRvalue(); }
+            // Pairs with AsymmetricThreadFenceHeavy in Variable::ScanRetiredList,
+            // see the explanation in LockSnapshot. Either the writer sees our lock,
+            // or we see the epoch it has started before checking the indicator.
+            concurrent::impl::AsymmetricThreadFenceLight();
 
-    const T* operator->() const& { return Get(); }
-    const T* operator->() && { return GetOnRvalue(); }
+            // The writer never frees the snapshots retired in the epoch that is
+            // still locked by a reader, nor in any later epoch.
+            const auto new_epoch = epochs.current.load(std::memory_order_seq_cst);
+            if (new_epoch == epoch) break;
 
-    const T& operator*() const& { return *Get(); }
-    const T& operator*() && { return *GetOnRvalue(); }
+            // The epoch has changed, our indicator could have been checked already
+            epoch = new_epoch;
+        }
+
+        ptr_ = &*ptr.current_.load()->data;
+    }
 
-private:
     const T* GetOnRvalue() {
         static_assert(!sizeof(T), "Don't use temporary ReadablePtr, store it to a variable");
         std::abort();
@@ -304,13 +388,16 @@ public:
             delete record;
         }
 
-        retired_list_.RemoveAndDisposeIf(
-            [](impl::SnapshotRecord<T>&) { return true; },
-            [](impl::SnapshotRecord<T>& record) {
-                UASSERT_MSG(record.indicator.IsFree(), "RCU variable is destroyed while being used");
-                delete &record;
-            }
-        );
+        const auto dispose_retired = [](impl::SnapshotRecord<T>& record) {
+            UASSERT_MSG(record.indicator.IsFree(), "RCU variable is destroyed while being used");
+            delete &record;
+        };
+        retired_list_.RemoveAndDisposeIf([](impl::SnapshotRecord<T>&) { return true; }, dispose_retired);
+        if constexpr (kEpochs) {
+            epochs_.retired_previous.RemoveAndDisposeIf(
+                [](impl::SnapshotRecord<T>&) { return true; }, dispose_retired
+            );
+        }
 
         if (destruction_type_ == DestructionType::kAsync) {
             wait_token_storage_.WaitForAllTokens();
@@ -399,6 +486,10 @@ private:
 
     void ScanRetiredList(std::unique_lock<MutexType>& lock) noexcept {
         UASSERT(lock.owns_lock());
+        if constexpr (kEpochs) {
+            AdvanceEpoch();
+            return;
+        }
         if (retired_list_.IsEmpty()) return;
 
         concurrent::impl::AsymmetricThreadFenceHeavy();
@@ -409,6 +500,29 @@ private:
         );
     }
 
+    // Frees the snapshots retired in the previous epoch if it has no readers
+    // left, then starts a new epoch for the snapshots retired in the current one.
+    // retired_list_ holds the snapshots retired in the current epoch.
+    void AdvanceEpoch() noexcept {
+        if (retired_list_.IsEmpty() && epochs_.retired_previous.IsEmpty()) return;
+
+        const auto epoch = epochs_.current.load(std::memory_order_relaxed);
+        concurrent::impl::AsymmetricThreadFenceHeavy();
+
+        // The readers of the epochs before the previous one have left before
+        // the current epoch started
+        if (!epochs_.indicators[(epoch + 1) % 2].IsFree()) return;
+
+        epochs_.retired_previous.RemoveAndDisposeIf(
+            [](impl::SnapshotRecord<T>&) { return true; },
+            [&](impl::SnapshotRecord<T>& record) { DeleteSnapshot(record); }
+        );
+        if (retired_list_.IsEmpty()) return;
+
+        std::swap(epochs_.retired_previous, retired_list_);
+        epochs_.current.store(epoch + 1, std::memory_order_seq_cst);
+    }
+
     void DeleteSnapshot(impl::SnapshotRecord<T>& record) {
         switch (destruction_type_) {
             case DestructionType::kSync:
@@ -427,12 +541,15 @@ private:
         free_list_.Push(record);
     }
 
+    static constexpr bool kEpochs = impl::kReclamationOf<RcuTraits> == Reclamation::kEpochs;
+
     const DestructionType destruction_type_;
-    // Covers current_ writes, free_list_.Pop, retired_list_
+    // Covers current_ writes, free_list_.Pop, retired_list_, epochs_ writes
     MutexType mutex_;
     impl::SnapshotRecordFreeList<T> free_list_;
     impl::SnapshotRecordRetiredList<T> retired_list_;
     std::atomic<impl::SnapshotRecord<T>*> current_;
+    std::conditional_t<kEpochs, impl::EpochState<T>, impl::NoEpochState> epochs_;
     utils::impl::WaitTokenStorage wait_token_storage_;
 };
 
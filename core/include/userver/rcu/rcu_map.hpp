@@ -21,6 +21,7 @@ namespace impl {
 template <typename RcuMapTraits>
 struct RcuTraitsFromRcuMapTraits {
     using MutexType = typename RcuMapTraits::MutexType;
+    static constexpr Reclamation kReclamation = kReclamationOf<RcuMapTraits>;
 };
 }  // namespace impl
 
@@ -37,6 +38,8 @@ public:
 /// type `Key`
 /// - `MutexType` is a writer's mutex type that has to be used to protect
 /// structure on update
+/// - optional `kReclamation` selects the memory reclamation scheme of the
+/// underlying rcu::Variable, see rcu::Reclamation
 template <typename Key, typename Value>
 struct DefaultRcuMapTraits {
     using Hash = std::hash<Key>;
@@ -0,0 +1,248 @@
+#pragma once
+
+/// @file userver/rcu/sharded_rcu_map.hpp
+/// @brief @copybrief rcu::ShardedRcuMap
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include <userver/rcu/rcu_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace rcu {
+
+/// @brief Forward iterator for the rcu::ShardedRcuMap
+///
+/// Use member functions of rcu::ShardedRcuMap to retrieve the iterator.
+template <typename Shards, typename ShardIterator>
+class ShardedRcuMapIterator final {
+    static constexpr std::size_t kShardCount = std::tuple_size_v<std::remove_const_t<Shards>>;
+
+public:
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = ptrdiff_t;
+    using value_type = typename ShardIterator::value_type;
+    using reference = typename ShardIterator::reference;
+    using pointer = typename ShardIterator::pointer;
+
+    ShardedRcuMapIterator() = default;
+
+    ShardedRcuMapIterator operator++(int) {
+        ShardedRcuMapIterator tmp(*this);
+        ++*this;
+        return tmp;
+    }
+
+    ShardedRcuMapIterator& operator++() {
+        ++it_;
+        SkipEmptyShards();
+        return *this;
+    }
+
+    reference operator*() const { return *it_; }
+    pointer operator->() const { return it_.operator->(); }
+
+    bool operator==(const ShardedRcuMapIterator& rhs) const {
+        if (shards_ && rhs.shards_) return shard_index_ == rhs.shard_index_ && it_ == rhs.it_;
+        // Only the end iterators have no shards
+        return !shards_ && !rhs.shards_;
+    }
+
+    bool operator!=(const ShardedRcuMapIterator& rhs) const { return !(*this == rhs); }
+
+    /// @cond
+    /// For internal use only
+    explicit ShardedRcuMapIterator(Shards& shards) : shards_(&shards), it_(shards[0].begin()) {
+        SkipEmptyShards();
+    }
+    /// @endcond
+
+private:
+    void SkipEmptyShards() {
+        while (it_ == ShardIterator{}) {
+            if (++shard_index_ == kShardCount) {
+                *this = {};
+                return;
+            }
+            it_ = (*shards_)[shard_index_].begin();
+        }
+    }
+
+    Shards* shards_{nullptr};
+    std::size_t shard_index_{0};
+    ShardIterator it_;
+};
+
+/// @ingroup userver_concurrency userver_containers
+///
+/// @brief Map-like structure allowing RCU keyset updates, that splits the
+/// keys into `ShardCount` independent rcu::RcuMap shards.
+///
+/// Has the same interface and guarantees as rcu::RcuMap, but a keyset change
+/// copies only the shard of the key, so the maps with a lot of keys and
+/// frequent insertions are updated `ShardCount` times cheaper. Readers stay
+/// wait-free, writers to different shards do not block each other.
+///
+/// Iteration and GetSnapshot() see each of the shards in a consistent state,
+/// but the changes to different shards are not atomic with respect to
+/// each other. Use rcu::RcuMap if the whole keyset must be updated atomically.
+///
+/// @note No synchronization is provided for value access, it must be
+/// implemented by Value when necessary.
+///
+/// ## Example usage:
+///
+/// @snippet rcu/sharded_rcu_map_test.cpp  Sample rcu::ShardedRcuMap usage
+///
+/// @see @ref scripts/docs/en/userver/synchronization.md
+template <typename Key, typename Value, typename RcuMapTraits, std::size_t ShardCount>
+class ShardedRcuMap final {
+    using Shard = RcuMap<Key, Value, RcuMapTraits>;
+
+public:
+    static_assert(ShardCount > 0);
+
+    using Hash = typename Shard::Hash;
+    using KeyEqual = typename Shard::KeyEqual;
+    using ValuePtr = typename Shard::ValuePtr;
+    using ConstValuePtr = typename Shard::ConstValuePtr;
+    using Iterator = ShardedRcuMapIterator<std::array<Shard, ShardCount>, typename Shard::Iterator>;
+    using ConstIterator = ShardedRcuMapIterator<const std::array<Shard, ShardCount>, typename Shard::ConstIterator>;
+    using RawMap = typename Shard::RawMap;
+    using Snapshot = typename Shard::Snapshot;
+    using InsertReturnType = typename Shard::InsertReturnType;
+
+    ShardedRcuMap() = default;
+
+    ShardedRcuMap(const ShardedRcuMap&) = delete;
+    ShardedRcuMap(ShardedRcuMap&&) = delete;
+    ShardedRcuMap& operator=(const ShardedRcuMap&) = delete;
+    ShardedRcuMap& operator=(ShardedRcuMap&&) = delete;
+
+    /// Returns an estimated size of the map at some point in time
+    size_t SizeApprox() const {
+        std::size_t result = 0;
+        for (const auto& shard : shards_) result += shard.SizeApprox();
+        return result;
+    }
+
+    /// @name Iteration support
+    /// @details Keyset of a shard is fixed at the start of the shard iteration
+    /// and is not affected by concurrent changes.
+    /// @{
+    ConstIterator begin() const { return ConstIterator{shards_}; }
+    ConstIterator end() const { return {}; }
+    Iterator begin() { return Iterator{shards_}; }
+    Iterator end() { return {}; }
+    /// @}
+
+    /// @brief Returns a readonly value pointer by its key if exists
+    /// @throws MissingKeyException if the key is not present
+    // NOLINTNEXTLINE(readability-const-return-type)
+    const ConstValuePtr operator[](const Key& key) const { return GetShard(key)[key]; }
+
+    /// @brief Returns a modifiable value pointer by key if exists or
+    /// default-creates one
+    /// @note Copies the shard of the key if the key doesn't exist.
+    // NOLINTNEXTLINE(readability-const-return-type)
+    const ValuePtr operator[](const Key& key) { return GetShard(key)[key]; }
+
+    /// @copydoc rcu::RcuMap::Insert
+    /// @note Copies the shard of the key if the key doesn't exist.
+    InsertReturnType Insert(const Key& key, ValuePtr value) { return GetShard(key).Insert(key, std::move(value)); }
+
+    /// @copydoc rcu::RcuMap::Emplace
+    /// @note Copies the shard of the key if the key doesn't exist.
+    template <typename... Args>
+    InsertReturnType Emplace(const Key& key, Args&&... args) {
+        return GetShard(key).Emplace(key, std::forward<Args>(args)...);
+    }
+
+    /// @copydoc rcu::RcuMap::TryEmplace
+    template <typename... Args>
+    InsertReturnType TryEmplace(const Key& key, Args&&... args) {
+        return GetShard(key).TryEmplace(key, std::forward<Args>(args)...);
+    }
+
+    /// @copydoc rcu::RcuMap::InsertOrAssign
+    template <typename RawKey>
+    void InsertOrAssign(RawKey&& key, ValuePtr value) {
+        auto& shard = GetShard(key);
+        shard.InsertOrAssign(std::forward<RawKey>(key), std::move(value));
+    }
+
+    /// @brief Returns a readonly value pointer by its key or an empty pointer
+    // NOLINTNEXTLINE(readability-const-return-type)
+    const ConstValuePtr Get(const Key& key) const { return GetShard(key).Get(key); }
+
+    /// @brief Returns a modifiable value pointer by key or an empty pointer
+    // NOLINTNEXTLINE(readability-const-return-type)
+    const ValuePtr Get(const Key& key) { return GetShard(key).Get(key); }
+
+    /// @brief Removes a key from the map
+    /// @returns whether the key was present
+    /// @note Copies the shard of the key.
+    bool Erase(const Key& key) { return GetShard(key).Erase(key); }
+
+    /// @brief Removes a key from the map returning its value
+    /// @returns a value if the key was present, empty pointer otherwise
+    /// @note Copies the shard of the key.
+    ValuePtr Pop(const Key& key) { return GetShard(key).Pop(key); }
+
+    /// Resets the map to an empty state, shard by shard
+    void Clear() {
+        for (auto& shard : shards_) shard.Clear();
+    }
+
+    /// @brief Replace current data by data from `new_map`.
+    /// @note The shards are replaced one by one, not atomically.
+    void Assign(RawMap new_map) {
+        std::array<RawMap, ShardCount> new_shards;
+        while (!new_map.empty()) {
+            auto node = new_map.extract(new_map.begin());
+            new_shards[GetShardIndex(node.key())].insert(std::move(node));
+        }
+        for (std::size_t i = 0; i < ShardCount; ++i) {
+            shards_[i].Assign(std::move(new_shards[i]));
+        }
+    }
+
+    /// @brief Starts a transaction over the shard of `key`, used to perform
+    /// a series of arbitrary changes to the keys of that shard.
+    /// @details The shard is copied. Don't forget to `Commit` to apply the
+    /// changes. Only the keys for which IsSameShard() with `key` is true may be
+    /// inserted in the transaction.
+    auto StartWrite(const Key& key) { return GetShard(key).StartWrite(); }
+
+    /// @brief Returns whether the keys are stored in the same shard and could
+    /// be changed in a single transaction
+    bool IsSameShard(const Key& lhs, const Key& rhs) const { return GetShardIndex(lhs) == GetShardIndex(rhs); }
+
+    /// @brief Returns a readonly copy of the map
+    /// @note Equivalent to `{begin(), end()}` construct, preferable
+    /// for long-running operations.
+    Snapshot GetSnapshot() const { return {begin(), end()}; }
+
+private:
+    std::size_t GetShardIndex(const Key& key) const {
+        // The high bits of the mixed hash are used, so that the shards are
+        // independent of the bucket choice inside a shard.
+        const auto hash = static_cast<std::uint64_t>(Hash{}(key)) * 0x9E3779B97F4A7C15ULL;
+        return static_cast<std::size_t>((hash >> 32) % ShardCount);
+    }
+
+    Shard& GetShard(const Key& key) { return shards_[GetShardIndex(key)]; }
+
+    const Shard& GetShard(const Key& key) const { return shards_[GetShardIndex(key)]; }
+
+    std::array<Shard, ShardCount> shards_;
+};
+
+}  // namespace rcu
+
+USERVER_NAMESPACE_END
@@ -29,6 +29,7 @@ namespace components {
 ///
 /// ## Dynamic config
 /// * @ref USERVER_LOG_REQUEST
+/// * @ref USERVER_LOG_REQUEST_BUFFERING
 /// * @ref USERVER_LOG_REQUEST_HEADERS
 /// * @ref USERVER_DEADLINE_PROPAGATION_ENABLED
 /// * @ref USERVER_CANCEL_HANDLE_REQUEST_BY_DEADLINE
@@ -66,6 +67,8 @@ namespace components {
 /// tls.cert | path to TLS server certificate | -
 /// tls.private-key | path to TLS server certificate private key | -
 /// tls.private-key-passphrase-name | passphrase name located in secdist's "passphrases" section | -
+/// tls.session-tickets | whether to issue and accept TLS session tickets, so that the clients could resume their sessions with an abbreviated handshake | false
+/// tls.session-ticket-key-rotation-period | period of the session ticket key rotation, tickets stay valid for up to two periods; 0 to never rotate | 1h
 /// handler-defaults.max_url_size | max path/URL size or empty to not limit | 8192
 /// handler-defaults.max_request_size | max size of the whole request | 1024 * 1024
 /// handler-defaults.max_headers_size | max request headers size | 65536
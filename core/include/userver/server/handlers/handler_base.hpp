@@ -44,6 +44,7 @@ namespace server::handlers {
 /// set_tracing_headers | whether to set http tracing headers (X-YaTraceId, X-YaSpanId, X-RequestId) | true
 /// deadline_propagation_enabled | when `false`, disables HTTP handler @ref scripts/docs/en/userver/deadline_propagation.md "deadline propagation" | true
 /// deadline_expired_status_code | the HTTP status code to return if the request @ref scripts/docs/en/userver/deadline_propagation.md "deadline expires" | 498
+/// resource_accounting_enabled | account CPU time and allocated bytes (with jemalloc) of the request processing task, see engine::current_task::EnableResourceAccounting() | false
 
 // clang-format on
 class HandlerBase : public components::ComponentBase {
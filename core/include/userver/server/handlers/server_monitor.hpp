@@ -3,8 +3,13 @@
 /// @file userver/server/handlers/server_monitor.hpp
 /// @brief @copybrief server::handlers::ServerMonitor
 
+#include <memory>
+#include <optional>
+#include <utility>
+
 #include <userver/server/handlers/http_handler_base.hpp>
 #include <userver/utils/statistics/fwd.hpp>
+#include <userver/utils/statistics/prometheus.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -43,11 +48,18 @@ enum class StatsFormat;
 ///   be a JSON dictionary in the form '{"label1":"value1", "label2":"value2"}'.
 /// * path - return metrics on for the following path
 /// * prefix - return metrics whose path starts from the specified prefix.
+///
+/// The handler keeps the rendered Prometheus metric and label names between
+/// the scrapes. With `response-body-stream: true` the Prometheus formats are
+/// sent in chunks as they are serialized, so the client starts receiving the
+/// response before it is fully formatted. The chunks are not throttled, a
+/// slow client may still get the whole response buffered.
 
 // clang-format on
 class ServerMonitor final : public HttpHandlerBase {
 public:
     ServerMonitor(const components::ComponentConfig& config, const components::ComponentContext& component_context);
+    ~ServerMonitor() override;
 
     /// @ingroup userver_component_names
     /// @brief The default name of server::handlers::ServerMonitor
@@ -55,6 +67,12 @@ public:
 
     std::string HandleRequestThrow(const http::HttpRequest& request, request::RequestContext&) const override;
 
+    void HandleStreamRequest(
+        const http::HttpRequest& request,
+        request::RequestContext& context,
+        http::ResponseBodyStream& response_body_stream
+    ) const override;
+
     static yaml_config::Schema GetStaticConfigSchema();
 
 private:
@@ -64,11 +82,28 @@ private:
         const std::string& response_data
     ) const override;
 
+    struct PrometheusFormatters;
+
+    std::pair<impl::StatsFormat, utils::statistics::Request> ParseRequest(const http::HttpRequest& request) const;
+
+    std::string FormatResponse(
+        const http::HttpRequest& request,
+        impl::StatsFormat format,
+        const utils::statistics::Request& statistics_request
+    ) const;
+
+    std::string FormatPrometheus(
+        impl::StatsFormat format,
+        const utils::statistics::Request& statistics_request,
+        std::optional<utils::statistics::PrometheusFormatter::ChunkConsumer> consumer
+    ) const;
+
     utils::statistics::Storage& statistics_storage_;
 
     using CommonLabels = std::unordered_map<std::string, std::string>;
     const CommonLabels common_labels_;
     const std::optional<impl::StatsFormat> default_format_;
+    const std::unique_ptr<PrometheusFormatters> prometheus_formatters_;
 };
 
 }  // namespace server::handlers
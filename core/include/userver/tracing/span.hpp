@@ -3,6 +3,7 @@
 /// @file userver/tracing/span.hpp
 /// @brief @copybrief tracing::Span
 
+#include <memory>
 #include <optional>
 #include <string_view>
 
@@ -15,6 +16,10 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace logging::impl {
+class RequestLogBuffer;
+}  // namespace logging::impl
+
 namespace tracing {
 
 class SpanBuilder;
@@ -196,6 +201,11 @@ public:
     /// global log levels to the default logger.
     bool ShouldLogDefault() const noexcept;
 
+    /// @returns true if the trace of this span is sampled. Spans of the
+    /// unsampled traces are not logged, unless they are kept by the tail
+    /// sampling rules of @ref USERVER_TRACE_SAMPLING.
+    bool IsSampled() const noexcept;
+
     /// Detach the Span from current engine::Task so it is not
     /// returned by CurrentSpan() any more.
     void DetachFromCoroStack();
@@ -215,6 +225,12 @@ public:
 
     // For internal use only.
     void LogTo(logging::impl::TagWriter writer) const&;
+
+    // For internal use only. The buffer is inherited by the child spans.
+    void SetRequestLogBuffer(std::shared_ptr<logging::impl::RequestLogBuffer> buffer, utils::impl::InternalTag);
+
+    // For internal use only.
+    logging::impl::RequestLogBuffer* GetRequestLogBuffer(utils::impl::InternalTag) const noexcept;
     /// @endcond
 
 private:
@@ -27,6 +27,8 @@ public:
     void SetParentLink(std::string parent_link);
     void AddTagFrozen(std::string key, logging::LogExtra::Value value);
     void AddNonInheritableTag(std::string key, logging::LogExtra::Value value);
+    /// Overrides the sampling decision, e.g. with the upstream one
+    void SetSampled(bool sampled);
     Span Build() &&;
 
 private:
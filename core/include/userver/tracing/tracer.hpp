@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <unordered_set>
 
@@ -16,12 +17,19 @@ class TagWriter;
 namespace tracing {
 
 struct NoLogSpans;
+struct TraceSampling;
 
 class Tracer : public std::enable_shared_from_this<Tracer> {
 public:
     static void SetNoLogSpans(NoLogSpans&& spans);
     static bool IsNoLogSpan(const std::string& name);
 
+    static void SetTraceSampling(TraceSampling&& sampling);
+    // Head sampling decision for a new trace started by the root span
+    static bool ShouldSampleTrace(const std::string& root_span_name);
+    // Tail sampling decision for a finished span of an unsampled trace
+    static bool ShouldKeepUnsampledSpan(std::chrono::steady_clock::duration duration, bool is_error);
+
     static void SetTracer(TracerPtr tracer);
 
     static TracerPtr GetTracer();
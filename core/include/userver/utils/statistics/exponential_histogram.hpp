@@ -0,0 +1,193 @@
+#pragma once
+
+/// @file userver/utils/statistics/exponential_histogram.hpp
+/// @brief @copybrief utils::statistics::ExponentialHistogram
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <userver/utils/span.hpp>
+#include <userver/utils/statistics/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+namespace impl::exponential_histogram {
+struct CounterLine;
+}  // namespace impl::exponential_histogram
+
+/// @brief Contents of an exponential histogram, that could be exactly merged
+/// with other exponential histograms and used to compute percentiles.
+///
+/// The buckets follow the OpenTelemetry base-2 exponential histogram layout:
+/// with `base = 2^(2^-scale)` the bucket with index `i` contains the values
+/// in `(base^i, base^(i+1)]`. Values that are not greater than the zero
+/// threshold are counted in a separate zero bucket.
+///
+/// The number of buckets is limited by `max_bucket_count`. When the accounted
+/// values do not fit, the scale is decreased ("downscaling"), each step merges
+/// pairs of adjacent buckets and halves the precision. Downscaling is exact,
+/// so histograms with different scales are merged without losing any counts.
+///
+/// Values that were greater than the range of the recording
+/// utils::statistics::ExponentialHistogram are counted in a separate overflow
+/// bucket without bounds.
+///
+/// Not thread-safe, use utils::statistics::ExponentialHistogram for recording.
+class ExponentialHistogramSnapshot final {
+public:
+    static constexpr int kMaxScale = 6;
+    static constexpr int kMinScale = -10;
+    static constexpr std::size_t kDefaultMaxBucketCount = 160;
+
+    explicit ExponentialHistogramSnapshot(
+        int scale = kMaxScale,
+        double zero_threshold = 0,
+        std::size_t max_bucket_count = kDefaultMaxBucketCount
+    );
+
+    /// Increments the bucket corresponding to the given value, downscaling
+    /// if necessary.
+    void Account(double value, std::uint64_t count = 1);
+
+    /// Increments the bucket `index` of the histogram with the given `scale`,
+    /// downscaling if necessary.
+    void AccountBucket(int scale, std::int32_t index, std::uint64_t count);
+
+    /// Increments the overflow bucket, that holds the values greater than the
+    /// recorded range.
+    void AccountOverflow(std::uint64_t count);
+
+    /// Exactly merges `other` into this histogram. The resulting scale is at
+    /// most the smaller of the two scales, the zero threshold is the larger
+    /// of the two thresholds.
+    void Add(const ExponentialHistogramSnapshot& other);
+
+    /// Decreases the scale by `by`, merging the adjacent buckets.
+    void Downscale(int by);
+
+    int GetScale() const noexcept { return scale_; }
+
+    double GetZeroThreshold() const noexcept { return zero_threshold_; }
+
+    std::uint64_t GetZeroCount() const noexcept { return zero_count_; }
+
+    std::uint64_t GetOverflowCount() const noexcept { return overflow_count_; }
+
+    /// Index of the first bucket in GetBuckets()
+    std::int32_t GetOffset() const noexcept { return offset_; }
+
+    /// Counters of the buckets with indices starting from GetOffset()
+    utils::span<const std::uint64_t> GetBuckets() const noexcept { return buckets_; }
+
+    std::uint64_t GetTotalCount() const noexcept;
+
+    /// @returns the lower bound of the bucket `index` at the current scale
+    double GetLowerBound(std::int32_t index) const noexcept;
+
+    /// @returns the upper bound of the bucket `index` at the current scale
+    double GetUpperBound(std::int32_t index) const noexcept;
+
+    /// @brief Get X percentile - the upper bound of the first bucket, such that
+    /// at least X percent of the values are not greater than it.
+    ///
+    /// The relative error of the result is not greater than `base - 1`.
+    /// @param percent - value in [0..100] - requested percentile.
+    /// @returns 0 for an empty histogram, the zero threshold if the percentile
+    /// falls into the zero bucket, infinity if it falls into the overflow
+    /// bucket.
+    double GetPercentile(double percent) const noexcept;
+
+private:
+    void Extend(std::int32_t min_index, std::int32_t max_index);
+
+    int scale_;
+    double zero_threshold_;
+    std::size_t max_bucket_count_;
+    std::uint64_t zero_count_{0};
+    std::uint64_t overflow_count_{0};
+    std::int32_t offset_{0};
+    std::vector<std::uint64_t> buckets_;
+};
+
+/// @brief A histogram with exponentially growing buckets, that is cheap to
+/// record into from many threads at once.
+///
+/// Unlike utils::statistics::Histogram, the buckets are not specified
+/// manually: values in `[min_value, max_value]` are recorded with a relative
+/// error not greater than `2^(2^-scale) - 1` (~4.4% for the default scale 3),
+/// values less than `min_value` are counted in the zero bucket, values greater
+/// than `max_value` are counted in the overflow bucket.
+///
+/// The counters are split into stripes, each thread records into its own
+/// stripe, so the concurrent recording does not contend on cache lines.
+/// Reading sums up the stripes and is approx. `stripe count` times slower
+/// than with a plain histogram.
+///
+/// Use GetSnapshot() to compute percentiles or to merge the data of several
+/// histograms, for example of several service instances.
+///
+/// When serialized to statistics, the histogram is represented as a
+/// utils::statistics::HistogramView with at most 50 buckets, which bounds are
+/// powers of 2 independent of the data, and the overflow bucket is the `+Inf`
+/// bucket. So the metric is supported by all
+/// the formats that support utils::statistics::Histogram and stays summable
+/// across hosts.
+///
+/// Usage example:
+/// @snippet utils/statistics/exponential_histogram_test.cpp  sample
+class ExponentialHistogram final {
+public:
+    static constexpr int kDefaultScale = 3;
+
+    /// @param min_value the lower bound of the precisely recorded values,
+    /// rounded down to a power of 2, must be positive
+    /// @param max_value the upper bound of the precisely recorded values,
+    /// rounded up to a power of 2
+    /// @param scale the recording precision in [0, ExponentialHistogramSnapshot::kMaxScale]
+    ExponentialHistogram(double min_value, double max_value, int scale = kDefaultScale);
+
+    ExponentialHistogram(const ExponentialHistogram&) = delete;
+    ExponentialHistogram& operator=(const ExponentialHistogram&) = delete;
+    ~ExponentialHistogram();
+
+    /// Atomically increment the bucket corresponding to the given value.
+    void Account(double value, std::uint64_t count = 1) noexcept;
+
+    /// Reads the current contents of the histogram, downscaling them to fit
+    /// into `max_bucket_count` buckets.
+    ExponentialHistogramSnapshot GetSnapshot(
+        std::size_t max_bucket_count = ExponentialHistogramSnapshot::kDefaultMaxBucketCount
+    ) const;
+
+    /// Atomically reset all counters to zero.
+    friend void ResetMetric(ExponentialHistogram& histogram) noexcept;
+
+    /// Metric serialization support for ExponentialHistogram.
+    friend void DumpMetric(Writer& writer, const ExponentialHistogram& histogram);
+
+private:
+    std::size_t GetSlot(double value) const noexcept;
+
+    template <typename Func>
+    void ForEachSlotTotal(Func func) const;
+
+    int scale_;
+    std::int32_t min_index_;
+    std::int32_t max_index_;
+    double zero_threshold_;
+    double max_threshold_;
+    // Mantissa boundaries of the buckets within an octave, see GetSlot.
+    std::vector<double> sub_bucket_bounds_;
+    std::size_t slot_count_;
+    std::size_t lines_per_stripe_;
+    std::size_t stripe_count_;
+    std::unique_ptr<impl::exponential_histogram::CounterLine[]> counters_;
+};
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
@@ -58,6 +58,10 @@ struct BoundsBlock;
 /// Histogram metrics can be summed using
 /// utils::statistics::HistogramAggregator.
 ///
+/// If the bounds are not known beforehand, or the histogram is recorded
+/// into from a lot of threads at once, consider using
+/// utils::statistics::ExponentialHistogram.
+///
 /// Histogram can be used in utils::statistics::MetricTag:
 /// @snippet utils/statistics/histogram_test.cpp  metric tag
 class Histogram final {
@@ -3,8 +3,11 @@
 /// @file userver/utils/statistics/prometheus.hpp
 /// @brief Statistics output in Prometheus format.
 
+#include <cstddef>
+#include <memory>
 #include <string>
 
+#include <userver/utils/function_ref.hpp>
 #include <userver/utils/statistics/storage.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -26,6 +29,48 @@ std::string ToPrometheusLabel(std::string_view name);
 
 }  // namespace impl
 
+/// @brief Serializes statistics in Prometheus format, reusing the rendered
+/// metric and label names between the calls.
+///
+/// Storing a PrometheusFormatter between the scrapes avoids converting the
+/// names of all the metrics on each scrape. The output could be passed to a
+/// consumer in chunks as it is serialized, e.g. to send it to the client
+/// before the whole output is formatted.
+///
+/// Not thread-safe.
+class PrometheusFormatter final {
+public:
+    enum class Types {
+        kTyped,    ///< as in ToPrometheusFormat
+        kUntyped,  ///< as in ToPrometheusFormatUntyped
+    };
+
+    using ChunkConsumer = utils::function_ref<void(std::string&& chunk)>;
+
+    explicit PrometheusFormatter(Types types = Types::kTyped);
+
+    PrometheusFormatter(PrometheusFormatter&&) noexcept;
+    PrometheusFormatter& operator=(PrometheusFormatter&&) noexcept;
+    ~PrometheusFormatter();
+
+    /// Output `statistics` in Prometheus format
+    std::string Format(const utils::statistics::Storage& statistics, const utils::statistics::Request& request = {});
+
+    /// Output `statistics` in Prometheus format, passing the output to
+    /// `consumer` in chunks of at least `chunk_size` bytes, except for the
+    /// last one. Chunks always end with a complete line.
+    void Format(
+        const utils::statistics::Storage& statistics,
+        const utils::statistics::Request& request,
+        std::size_t chunk_size,
+        ChunkConsumer consumer
+    );
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
 /// Output `statistics` in Prometheus format, each metric has `gauge` type.
 std::string
 ToPrometheusFormat(const utils::statistics::Storage& statistics, const utils::statistics::Request& request = {});
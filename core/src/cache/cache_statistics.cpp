@@ -1,5 +1,7 @@
 #include <userver/cache/cache_statistics.hpp>
 
+#include <array>
+
 #include <userver/utils/assert.hpp>
 #include <userver/utils/datetime.hpp>
 #include <userver/utils/statistics/writer.hpp>
@@ -15,6 +17,14 @@ constexpr const char* kStatisticsNameIncremental = "incremental";
 constexpr const char* kStatisticsNameAny = "any";
 constexpr const char* kStatisticsNameCurrentDocumentsCount = "current-documents-count";
 
+constexpr std::array kUpdateStages{
+    UpdateStage::kCopy,
+    UpdateStage::kFetch,
+    UpdateStage::kParse,
+    UpdateStage::kMerge,
+};
+static_assert(kUpdateStages.size() == kUpdateStagesCount);
+
 template <typename Clock, typename Duration>
 std::int64_t TimeStampToMillisecondsFromNow(std::chrono::time_point<Clock, Duration> time) {
     const auto diff =
@@ -37,10 +47,30 @@ void CombineStatistics(
     result.last_successful_update_start_time =
         std::max(a.last_successful_update_start_time.load(), b.last_successful_update_start_time.load());
     result.last_update_duration = std::max(a.last_update_duration.load(), b.last_update_duration.load());
+
+    // Stages of the most recent update
+    const auto& latest = a.last_update_start_time.load() >= b.last_update_start_time.load() ? a : b;
+    for (std::size_t i = 0; i < kUpdateStagesCount; ++i) {
+        result.last_update_stage_durations[i] = latest.last_update_stage_durations[i].load();
+    }
 }
 
 }  // namespace
 
+std::string_view ToString(UpdateStage stage) {
+    switch (stage) {
+        case UpdateStage::kCopy:
+            return "copy_data";
+        case UpdateStage::kFetch:
+            return "fetch";
+        case UpdateStage::kParse:
+            return "parse";
+        case UpdateStage::kMerge:
+            return "merge";
+    }
+    UINVARIANT(false, "Unexpected cache update stage");
+}
+
 namespace impl {
 
 void DumpMetric(utils::statistics::Writer& writer, const UpdateStatistics& stats) {
@@ -72,6 +102,11 @@ void DumpMetric(utils::statistics::Writer& writer, const UpdateStatistics& stats
             TimeStampToMillisecondsFromNow(stats.last_successful_update_start_time.load());
         age["last-update-duration-ms"] =
             std::chrono::duration_cast<std::chrono::milliseconds>(stats.last_update_duration.load()).count();
+
+        for (const auto stage : kUpdateStages) {
+            const auto duration = stats.last_update_stage_durations[static_cast<std::size_t>(stage)].load();
+            age["last-update-stage-duration-ms"].ValueWithLabels(duration.count(), {"stage", ToString(stage)});
+        }
     }
 }
 
@@ -129,6 +164,14 @@ void UpdateStatisticsScope::IncreaseDocumentsParseFailures(std::size_t add) {
     update_stats_.documents_parse_failures += utils::statistics::Rate{add};
 }
 
+void UpdateStatisticsScope::AddStageDuration(UpdateStage stage, std::chrono::steady_clock::duration duration) {
+    const auto index = static_cast<std::size_t>(stage);
+    UASSERT(index < kUpdateStagesCount);
+    stage_durations_ns_[index].fetch_add(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count(), std::memory_order_relaxed
+    );
+}
+
 void UpdateStatisticsScope::DoFinish(impl::UpdateState new_state) {
     UASSERT(new_state != impl::UpdateState::kNotFinished);
     // TODO Some production caches call Finish multiple times. We should fix those
@@ -141,6 +184,11 @@ void UpdateStatisticsScope::DoFinish(impl::UpdateState new_state) {
     }
     update_stats_.last_update_duration =
         std::chrono::duration_cast<std::chrono::milliseconds>(update_stop_time - update_start_time_);
+    for (std::size_t i = 0; i < kUpdateStagesCount; ++i) {
+        update_stats_.last_update_stage_durations[i] = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::nanoseconds{stage_durations_ns_[i].load(std::memory_order_relaxed)}
+        );
+    }
 
     state_ = new_state;
 }
@@ -15,11 +15,13 @@
 #include <cache/internal_helpers_test.hpp>
 #include <dump/internal_helpers_test.hpp>
 #include <userver/cache/cache_config.hpp>
+#include <userver/cache/impl/fetch_shards.hpp>
 #include <userver/cache/update_type.hpp>
 #include <userver/components/component.hpp>
 #include <userver/dump/common.hpp>
 #include <userver/dump/test_helpers.hpp>
 #include <userver/dynamic_config/storage_mock.hpp>
+#include <userver/engine/deadline.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/formats/yaml/serialize.hpp>
 #include <userver/formats/yaml/value_builder.hpp>
@@ -29,6 +31,7 @@
 #include <userver/testsuite/dump_control.hpp>
 #include <userver/utest/utest.hpp>
 #include <userver/utils/enumerate.hpp>
+#include <userver/utils/statistics/testing.hpp>
 #include <userver/utils/underlying_value.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
 
@@ -1118,4 +1121,147 @@ UTEST(CacheUpdateTrait, FinishWithError) {
     );
 }
 
+namespace {
+
+class ShardedCache final : public cache::CacheMockBase {
+public:
+    static constexpr std::string_view kName = "sharded-cache";
+    static constexpr std::size_t kShardCount = 4;
+    static constexpr int kValuesPerShard = 100;
+    static constexpr std::chrono::milliseconds kFetchDuration{10};
+
+    ShardedCache(
+        const yaml_config::YamlConfig& config,
+        cache::MockEnvironment& environment,
+        std::size_t max_shards_in_flight = kShardCount
+    )
+        : CacheMockBase(kName, config, environment), max_shards_in_flight_(max_shards_in_flight) {
+        StartPeriodicUpdates(cache::CacheUpdateTrait::Flag::kNoFirstUpdate);
+    }
+
+    ~ShardedCache() override { StopPeriodicUpdates(); }
+
+    const std::unordered_map<int, std::size_t>& GetData() const { return data_; }
+
+    std::size_t GetMaxRunningShards() const { return max_running_shards_; }
+
+    void SetFailingShard(std::optional<std::size_t> shard) { failing_shard_ = shard; }
+
+private:
+    void Update(
+        cache::UpdateType /*type*/,
+        const std::chrono::system_clock::time_point& /*last_update*/,
+        const std::chrono::system_clock::time_point& /*now*/,
+        cache::UpdateStatisticsScope& stats_scope
+    ) override {
+        std::unordered_map<int, std::size_t> data;
+        std::atomic<std::size_t> started_shards{0};
+        std::atomic<std::size_t> running_shards{0};
+
+        const auto fetch_shard = [&](std::size_t shard) {
+            // The first `max_shards_in_flight_` shards are expected to be fetched concurrently
+            ++started_shards;
+            const auto running = ++running_shards;
+            const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+            while (started_shards < max_shards_in_flight_ && !deadline.IsReached()) engine::Yield();
+            max_running_shards_ = std::max(max_running_shards_, running);
+            --running_shards;
+
+            if (failing_shard_ == shard) throw cache::MockError();
+
+            std::vector<std::pair<int, std::size_t>> values;
+            for (int i = 0; i < kValuesPerShard; ++i) {
+                // Later shards overwrite the duplicates of the earlier ones
+                values.emplace_back(i * static_cast<int>(kShardCount) + static_cast<int>(shard) % 2, shard);
+            }
+            stats_scope.IncreaseDocumentsReadCount(values.size());
+            stats_scope.AddStageDuration(cache::UpdateStage::kFetch, kFetchDuration);
+            return values;
+        };
+
+        cache::impl::FetchShardsAndMerge(
+            kShardCount,
+            max_shards_in_flight_,
+            fetch_shard,
+            [&data](std::pair<int, std::size_t>&& value) { data.insert_or_assign(value.first, value.second); },
+            stats_scope
+        );
+
+        data_ = std::move(data);
+        OnCacheModified();
+        stats_scope.Finish(data_.size());
+    }
+
+    const std::size_t max_shards_in_flight_;
+    std::unordered_map<int, std::size_t> data_;
+    std::size_t max_running_shards_{0};
+    std::optional<std::size_t> failing_shard_;
+};
+
+std::int64_t GetStageDurationMs(const cache::MockEnvironment& environment, cache::UpdateStage stage) {
+    const utils::statistics::Snapshot snapshot{
+        environment.statistics_storage, "cache", {{"cache_name", std::string{ShardedCache::kName}}}};
+    return snapshot
+        .SingleMetric("full.time.last-update-stage-duration-ms", {{"stage", std::string{cache::ToString(stage)}}})
+        .AsInt();
+}
+
+}  // namespace
+
+UTEST(CacheUpdateTrait, FetchShardsAndMerge) {
+    const yaml_config::YamlConfig config{formats::yaml::FromString(kFakeCacheConfig), {}};
+    cache::MockEnvironment environment;
+
+    ShardedCache test_cache(config, environment);
+    environment.cache_control.ResetCaches(cache::UpdateType::kFull, {test_cache.Name()}, {});
+
+    EXPECT_EQ(test_cache.GetMaxRunningShards(), ShardedCache::kShardCount);
+
+    // Shards 0, 2 and 1, 3 share the keys, the last shard wins
+    const auto& data = test_cache.GetData();
+    ASSERT_EQ(data.size(), 2 * ShardedCache::kValuesPerShard);
+    for (const auto& [key, shard] : data) {
+        EXPECT_EQ(shard, key % 2 == 0 ? 2 : 3) << key;
+    }
+
+    // Fetch times of the shards are summed up
+    EXPECT_EQ(
+        GetStageDurationMs(environment, cache::UpdateStage::kFetch),
+        (ShardedCache::kFetchDuration * ShardedCache::kShardCount).count()
+    );
+    EXPECT_EQ(GetStageDurationMs(environment, cache::UpdateStage::kCopy), 0);
+    EXPECT_GE(GetStageDurationMs(environment, cache::UpdateStage::kMerge), 0);
+}
+
+UTEST(CacheUpdateTrait, FetchShardsAndMergeLimited) {
+    const yaml_config::YamlConfig config{formats::yaml::FromString(kFakeCacheConfig), {}};
+    cache::MockEnvironment environment;
+
+    ShardedCache test_cache(config, environment, 2);
+    environment.cache_control.ResetCaches(cache::UpdateType::kFull, {test_cache.Name()}, {});
+
+    EXPECT_EQ(test_cache.GetMaxRunningShards(), 2);
+
+    const auto& data = test_cache.GetData();
+    ASSERT_EQ(data.size(), 2 * ShardedCache::kValuesPerShard);
+    for (const auto& [key, shard] : data) {
+        EXPECT_EQ(shard, key % 2 == 0 ? 2 : 3) << key;
+    }
+}
+
+UTEST(CacheUpdateTrait, FetchShardsAndMergeFailure) {
+    const yaml_config::YamlConfig config{formats::yaml::FromString(kFakeCacheConfig), {}};
+    cache::MockEnvironment environment;
+
+    ShardedCache test_cache(config, environment);
+    environment.cache_control.ResetCaches(cache::UpdateType::kFull, {test_cache.Name()}, {});
+    ASSERT_EQ(test_cache.GetData().size(), 2 * ShardedCache::kValuesPerShard);
+
+    test_cache.SetFailingShard(1);
+    UEXPECT_THROW(
+        environment.cache_control.ResetCaches(cache::UpdateType::kFull, {test_cache.Name()}, {}), std::exception
+    );
+    EXPECT_EQ(test_cache.GetData().size(), 2 * ShardedCache::kValuesPerShard);
+}
+
 USERVER_NAMESPACE_END
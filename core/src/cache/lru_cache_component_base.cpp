@@ -55,6 +55,11 @@ properties:
     ways:
         type: integer
         description: number of ways for associative cache
+    max-size-bytes:
+        type: integer
+        description: max total size of items in bytes as estimated by cache::GetEstimatedSize
+        defaultDescription: unlimited
+        minimum: 1
     lifetime:
         type: string
         description: TTL for cache entries (0 is unlimited)
@@ -63,6 +68,29 @@ properties:
         type: boolean
         description: enables asynchronous updates for expiring values
         defaultDescription: false
+    recency:
+        type: string
+        description: exact LRU or approximate LRU with lock-free lookups
+        defaultDescription: exact
+        enum:
+          - exact
+          - approximate
+    eviction-policy:
+        type: string
+        description: LRU or W-TinyLFU that keeps the frequently used items on scans over many keys
+        defaultDescription: lru
+        enum:
+          - lru
+          - w-tinylfu
+    miss-batch-window:
+        type: string
+        description: time to collect the concurrent misses into a single call of DoGetByKeys, 0 disables the batching
+        defaultDescription: 0
+    miss-batch-max-size:
+        type: integer
+        description: max amount of keys in a single call of DoGetByKeys
+        defaultDescription: 100
+        minimum: 1
     config-settings:
         type: boolean
         description: enables dynamic reconfiguration with CacheConfigSet
@@ -1,12 +1,20 @@
 #include <cache/lru_cache_component_base_test.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <string>
+
 #include <components/component_list_test.hpp>
 #include <userver/components/minimal_component_list.hpp>
 #include <userver/components/run.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
 #include <userver/formats/yaml/serialize.hpp>
 #include <userver/fs/blocking/temp_directory.hpp>
 #include <userver/fs/blocking/write.hpp>
 #include <userver/testsuite/testsuite_support.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/async.hpp>
 #include <userver/yaml_config/impl/validate_static_config.hpp>
 
 #include <gtest/gtest.h>
@@ -40,6 +48,60 @@ components_manager:
     testsuite-support:
 )";
 
+constexpr std::string_view kBatchingStaticConfig = R"(
+components_manager:
+  default_task_processor: main-task-processor
+  event_thread_pool:
+    threads: 1
+  task_processors:
+    main-task-processor:
+      worker_threads: 1
+  components:
+    batching-cache:
+      size: 1
+      ways: 1
+      miss-batch-window: 1ms
+      config-settings: false
+    logging:
+      fs-task-processor: main-task-processor
+      loggers:
+        default:
+          file_path: '@null'
+    testsuite-support:
+)";
+
+class BatchingCacheComponent final : public cache::LruCacheComponent<std::string, std::string> {
+public:
+    static constexpr std::string_view kName = "batching-cache";
+
+    BatchingCacheComponent(const components::ComponentConfig& config, const components::ComponentContext& context)
+        : cache::LruCacheComponent<std::string, std::string>(config, context) {}
+
+    ~BatchingCacheComponent() override {
+        StopMissBatching();
+        EXPECT_TRUE(is_fetch_finished_) << "The fetch in flight should be waited for";
+    }
+
+    void OnAllComponentsLoaded() override {
+        // The lookup gives up waiting, but its fetch keeps running until the stop
+        auto lookup = utils::Async("lookup", [this] { return GetCache().Get("key"); });
+        ASSERT_TRUE(fetch_started_.WaitForEventFor(utest::kMaxTestWaitTime));
+        lookup.SyncCancel();
+    }
+
+private:
+    std::string DoGetByKey(const std::string& key) override {
+        fetch_started_.Send();
+        engine::SleepFor(std::chrono::milliseconds{100});
+        is_fetch_finished_ = true;
+        return prefix_ + key;
+    }
+
+    const std::string prefix_{"value-"};
+    engine::SingleConsumerEvent fetch_started_;
+    std::atomic<bool> is_fetch_finished_{false};
+};
+
 void ValidateExampleCacheConfig(const formats::yaml::Value& static_config) {
     yaml_config::impl::Validate(
         yaml_config::YamlConfig(static_config["example-cache"], {}), ExampleCacheComponent::GetStaticConfigSchema()
@@ -60,6 +122,15 @@ TEST_F(ComponentList, LruCacheComponentSample) {
     components::RunOnce(components::InMemoryConfig{kStaticConfig}, component_list);
 }
 
+TEST_F(ComponentList, LruCacheComponentMissBatchingShutdown) {
+    auto component_list = components::MinimalComponentList();
+    component_list.Append<BatchingCacheComponent>();
+    component_list.Append<components::TestsuiteSupport>();
+
+    // The components are stopped with the batched lookup in flight
+    components::RunOnce(components::InMemoryConfig{kBatchingStaticConfig}, component_list);
+}
+
 TEST(StaticConfigValidator, ValidConfig) {
     ValidateExampleCacheConfig(formats::yaml::FromString(std::string{kStaticConfig})["components_manager"]["components"]
     );
@@ -5,6 +5,7 @@
 #include <userver/components/component_config.hpp>
 #include <userver/dump/config.hpp>
 #include <userver/dynamic_config/value.hpp>
+#include <userver/formats/parse/common_containers.hpp>
 #include <userver/utils/algo.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -18,6 +19,27 @@ constexpr std::string_view kSize = "size";
 constexpr std::string_view kLifetime = "lifetime";
 constexpr std::string_view kBackgroundUpdate = "background-update";
 constexpr std::string_view kLifetimeMs = "lifetime-ms";
+constexpr std::string_view kRecency = "recency";
+constexpr std::string_view kEvictionPolicy = "eviction-policy";
+constexpr std::string_view kMaxSizeBytes = "max-size-bytes";
+constexpr std::string_view kMissBatchWindow = "miss-batch-window";
+constexpr std::string_view kMissBatchMaxSize = "miss-batch-max-size";
+
+constexpr std::size_t kDefaultMissBatchMaxSize = 100;
+
+LruRecency ParseRecency(const yaml_config::YamlConfig& value) {
+    const auto recency = value.As<std::string>("exact");
+    if (recency == "exact") return LruRecency::kExact;
+    if (recency == "approximate") return LruRecency::kApproximate;
+    throw std::runtime_error("Invalid LRU recency '" + recency + "' at " + value.GetPath());
+}
+
+EvictionPolicy ParseEvictionPolicy(const yaml_config::YamlConfig& value) {
+    const auto policy = value.As<std::string>("lru");
+    if (policy == "lru") return EvictionPolicy::kLru;
+    if (policy == "w-tinylfu") return EvictionPolicy::kWTinyLfu;
+    throw std::runtime_error("Invalid eviction policy '" + policy + "' at " + value.GetPath());
+}
 
 }  // namespace
 
@@ -28,8 +50,10 @@ LruCacheConfig::LruCacheConfig(const yaml_config::YamlConfig& config)
       lifetime(config[kLifetime].As<std::chrono::milliseconds>(0)),
       background_update(
           config[kBackgroundUpdate].As<bool>(false) ? BackgroundUpdateMode::kEnabled : BackgroundUpdateMode::kDisabled
-      ) {
+      ),
+      max_size_bytes(config[kMaxSizeBytes].As<std::optional<std::size_t>>()) {
     if (size == 0) throw std::runtime_error("cache-size is non-positive");
+    if (max_size_bytes == 0) throw std::runtime_error("max-size-bytes is non-positive");
 }
 
 LruCacheConfig::LruCacheConfig(const components::ComponentConfig& config)
@@ -40,8 +64,10 @@ LruCacheConfig::LruCacheConfig(const formats::json::Value& value)
       lifetime(ParseMs(value[kLifetimeMs])),
       background_update(
           value[kBackgroundUpdate].As<bool>(false) ? BackgroundUpdateMode::kEnabled : BackgroundUpdateMode::kDisabled
-      ) {
+      ),
+      max_size_bytes(value[kMaxSizeBytes].As<std::optional<std::size_t>>()) {
     if (size == 0) throw std::runtime_error("cache-size is non-positive");
+    if (max_size_bytes == 0) throw std::runtime_error("max-size-bytes is non-positive");
 }
 
 std::size_t LruCacheConfig::GetWaySize(std::size_t ways) const {
@@ -49,6 +75,12 @@ std::size_t LruCacheConfig::GetWaySize(std::size_t ways) const {
     return way_size == 0 ? 1 : way_size;
 }
 
+std::optional<std::size_t> LruCacheConfig::GetWayMaxBytes(std::size_t ways) const {
+    if (!max_size_bytes) return std::nullopt;
+    const auto way_max_bytes = *max_size_bytes / ways;
+    return way_max_bytes == 0 ? 1 : way_max_bytes;
+}
+
 LruCacheConfig Parse(const formats::json::Value& value, formats::parse::To<LruCacheConfig>) {
     return LruCacheConfig{value};
 }
@@ -56,8 +88,19 @@ LruCacheConfig Parse(const formats::json::Value& value, formats::parse::To<LruCa
 LruCacheConfigStatic::LruCacheConfigStatic(const yaml_config::YamlConfig& config)
     : config(config),
       ways(config[kWays].As<std::size_t>()),
+      recency(ParseRecency(config[kRecency])),
+      eviction_policy(ParseEvictionPolicy(config[kEvictionPolicy])),
+      miss_batch_window(config[kMissBatchWindow].As<std::chrono::milliseconds>(0)),
+      miss_batch_max_size(config[kMissBatchMaxSize].As<std::size_t>(kDefaultMissBatchMaxSize)),
       use_dynamic_config(config["config-settings"].As<bool>(true)) {
     if (ways <= 0) throw std::runtime_error("cache-ways is non-positive");
+    if (miss_batch_max_size == 0) throw std::runtime_error("miss-batch-max-size is non-positive");
+    if (recency == LruRecency::kApproximate && eviction_policy != EvictionPolicy::kLru) {
+        throw std::runtime_error("eviction-policy other than 'lru' requires 'exact' recency");
+    }
+    if (this->config.max_size_bytes && !IsMaxSizeBytesSupported()) {
+        throw std::runtime_error("max-size-bytes requires 'exact' recency and 'lru' eviction-policy");
+    }
 }
 
 LruCacheConfigStatic::LruCacheConfigStatic(const components::ComponentConfig& config)
@@ -65,6 +108,10 @@ LruCacheConfigStatic::LruCacheConfigStatic(const components::ComponentConfig& co
 
 std::size_t LruCacheConfigStatic::GetWaySize() const { return config.GetWaySize(ways); }
 
+bool LruCacheConfigStatic::IsMaxSizeBytesSupported() const {
+    return recency == LruRecency::kExact && eviction_policy == EvictionPolicy::kLru;
+}
+
 const dynamic_config::Key<std::unordered_map<std::string, LruCacheConfig>> kLruCacheConfigSet{
     "USERVER_LRU_CACHES",
     dynamic_config::DefaultAsJsonString{"{}"}};
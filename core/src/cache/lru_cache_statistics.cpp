@@ -61,6 +61,11 @@ void DumpMetric(utils::statistics::Writer& writer, const ExpirableLruCacheStatis
     writer["hit_ratio"]["1min"] = s1min_hits / static_cast<double>(s1min_total ? s1min_total : 1);
 }
 
+void DumpMetric(utils::statistics::Writer& writer, const LruCacheSize& size) {
+    writer["current-documents-count"] = size.documents;
+    if (size.bytes) writer["current-size-bytes"] = *size.bytes;
+}
+
 }  // namespace cache::impl
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,195 @@
+#include <userver/cache/impl/miss_batcher.hpp>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <userver/engine/exception.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/server/request/task_inherited_data.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Batcher = cache::impl::MissBatcher<int, std::string, std::hash<int>, std::equal_to<int>>;
+
+constexpr std::chrono::milliseconds kWindow{50};
+
+class BatchRecorder final {
+public:
+    Batcher::Results operator()(const std::vector<int>& keys) {
+        ++calls_;
+        keys_count_ += keys.size();
+        Batcher::Results results(keys.size());
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            if (keys[i] < 0) {
+                results[i].SetException(std::make_exception_ptr(std::runtime_error("negative key")));
+            } else {
+                results[i].SetValue(std::to_string(keys[i]));
+            }
+        }
+        return results;
+    }
+
+    std::size_t GetCalls() const { return calls_; }
+    std::size_t GetKeysCount() const { return keys_count_; }
+
+private:
+    std::atomic<std::size_t> calls_{0};
+    std::atomic<std::size_t> keys_count_{0};
+};
+
+std::vector<engine::TaskWithResult<std::string>> GetConcurrently(Batcher& batcher, const std::vector<int>& keys) {
+    std::vector<engine::TaskWithResult<std::string>> tasks;
+    for (const auto key : keys) {
+        tasks.push_back(utils::Async("get", [&batcher, key] { return batcher.Get(key); }));
+    }
+    return tasks;
+}
+
+}  // namespace
+
+UTEST(LruCacheMissBatcher, CoalescesMisses) {
+    BatchRecorder recorder;
+    Batcher batcher{std::ref(recorder), kWindow, 100};
+
+    const std::vector<int> keys{1, 2, 3, 2, 4, 1};
+    auto tasks = GetConcurrently(batcher, keys);
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        EXPECT_EQ(tasks[i].Get(), std::to_string(keys[i]));
+    }
+
+    EXPECT_EQ(recorder.GetCalls(), 1);
+    EXPECT_EQ(recorder.GetKeysCount(), 4) << "Duplicate keys should be looked up once";
+
+    // The next miss starts a new batch
+    EXPECT_EQ(batcher.Get(5), "5");
+    EXPECT_EQ(recorder.GetCalls(), 2);
+}
+
+UTEST_MT(LruCacheMissBatcher, MaxBatchSize, 4) {
+    BatchRecorder recorder;
+    Batcher batcher{std::ref(recorder), std::chrono::hours{1}, 3};
+
+    // Full batches are looked up without waiting for the window
+    auto tasks = GetConcurrently(batcher, {1, 2, 3, 4, 5, 6});
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        EXPECT_EQ(tasks[i].Get(), std::to_string(i + 1));
+    }
+    EXPECT_EQ(recorder.GetCalls(), 2);
+}
+
+UTEST(LruCacheMissBatcher, Exception) {
+    Batcher batcher{[](const std::vector<int>&) -> Batcher::Results { throw std::runtime_error("fail"); }, kWindow, 100};
+    UEXPECT_THROW_MSG(batcher.Get(1), std::runtime_error, "fail");
+
+    Batcher wrong_size_batcher{[](const std::vector<int>&) { return Batcher::Results{}; }, kWindow, 100};
+    UEXPECT_THROW(wrong_size_batcher.Get(1), std::logic_error);
+}
+
+UTEST(LruCacheMissBatcher, ExceptionOfKey) {
+    BatchRecorder recorder;
+    Batcher batcher{std::ref(recorder), kWindow, 100};
+
+    auto tasks = GetConcurrently(batcher, {1, -1, 2});
+    EXPECT_EQ(tasks[0].Get(), "1");
+    UEXPECT_THROW_MSG(tasks[1].Get(), std::runtime_error, "negative key");
+    EXPECT_EQ(tasks[2].Get(), "2");
+    EXPECT_EQ(recorder.GetCalls(), 1);
+}
+
+UTEST(LruCacheMissBatcher, Cancellation) {
+    BatchRecorder recorder;
+    Batcher batcher{std::ref(recorder), std::chrono::hours{1}, 100};
+
+    auto waiter = utils::Async("waiter", [&batcher] {
+        UEXPECT_THROW(batcher.Get(1), engine::WaitInterruptedException);
+    });
+    engine::Yield();
+    waiter.RequestCancel();
+    waiter.WaitFor(utest::kMaxTestWaitTime);
+    ASSERT_TRUE(waiter.IsFinished());
+
+    // The fetch is cancelled as all of its waiters are gone
+    EXPECT_EQ(recorder.GetCalls(), 0);
+}
+
+UTEST(LruCacheMissBatcher, LastWaiterDoesNotWaitForFetch) {
+    engine::SingleConsumerEvent fetch_started;
+    engine::SingleConsumerEvent fetch_may_finish;
+    Batcher batcher{
+        [&](const std::vector<int>& keys) {
+            fetch_started.Send();
+            const engine::TaskCancellationBlocker blocker;
+            [[maybe_unused]] const bool is_sent = fetch_may_finish.WaitForEventFor(utest::kMaxTestWaitTime);
+            return Batcher::Results(keys.size());
+        },
+        std::chrono::milliseconds{1},
+        100};
+
+    auto impatient_waiter = utils::Async("impatient_waiter", [&batcher] {
+        server::request::TaskInheritedData data;
+        data.deadline = engine::Deadline::FromDuration(std::chrono::milliseconds{50});
+        server::request::kTaskInheritedData.Set(std::move(data));
+
+        UEXPECT_THROW(batcher.Get(1), cache::LookupTimeoutError);
+    });
+    ASSERT_TRUE(fetch_started.WaitForEventFor(utest::kMaxTestWaitTime));
+
+    // The waiter leaves while the fetch ignores the cancellation
+    impatient_waiter.WaitFor(utest::kMaxTestWaitTime);
+    EXPECT_TRUE(impatient_waiter.IsFinished());
+
+    fetch_may_finish.Send();
+    impatient_waiter.Get();
+}
+
+UTEST(LruCacheMissBatcher, Stop) {
+    BatchRecorder recorder;
+    Batcher batcher{std::ref(recorder), std::chrono::hours{1}, 100};
+
+    auto waiter = utils::Async("waiter", [&batcher] {
+        UEXPECT_THROW(batcher.Get(1), engine::WaitInterruptedException);
+    });
+    engine::Yield();
+
+    // The pending fetch is cancelled and its waiters are released
+    batcher.Stop();
+    UEXPECT_NO_THROW(waiter.Get());
+    EXPECT_EQ(recorder.GetCalls(), 0);
+
+    // The keys are looked up without batching after the stop
+    EXPECT_EQ(batcher.Get(2), "2");
+    EXPECT_EQ(recorder.GetCalls(), 1);
+}
+
+UTEST(LruCacheMissBatcher, Deadline) {
+    BatchRecorder recorder;
+    Batcher batcher{std::ref(recorder), kWindow, 100};
+
+    // The tasks start in order on a single thread, so both keys get into the same batch
+    auto waiter = utils::Async("waiter", [&batcher] { return batcher.Get(1); });
+
+    auto impatient_waiter = utils::Async("impatient_waiter", [&batcher] {
+        server::request::TaskInheritedData data;
+        data.deadline = engine::Deadline::FromDuration(std::chrono::milliseconds{1});
+        server::request::kTaskInheritedData.Set(std::move(data));
+
+        UEXPECT_THROW(batcher.Get(2), cache::LookupTimeoutError);
+        EXPECT_TRUE(server::request::kTaskInheritedData.Get().deadline_signal.IsExpired());
+    });
+    impatient_waiter.Get();
+
+    // The batch is still looked up for the other waiters
+    EXPECT_EQ(waiter.Get(), "1");
+    EXPECT_EQ(recorder.GetCalls(), 1);
+    EXPECT_EQ(recorder.GetKeysCount(), 2);
+}
+
+USERVER_NAMESPACE_END
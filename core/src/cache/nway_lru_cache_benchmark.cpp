@@ -0,0 +1,82 @@
+#include <userver/cache/nway_lru_cache.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/engine/run_standalone.hpp>
+#include <userver/utils/rand.hpp>
+#include <utils/impl/parallelize_benchmark.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Cache = cache::NWayLRU<std::uint64_t, std::uint64_t>;
+
+constexpr std::size_t kWays = 16;
+constexpr std::size_t kWaySize = 1024;
+constexpr std::uint64_t kElementsCount = kWays * kWaySize / 2;
+
+void FillCache(Cache& cache) {
+    for (std::uint64_t i = 0; i < kElementsCount; ++i) {
+        cache.Put(i, i);
+    }
+}
+
+}  // namespace
+
+// Hit-heavy workload: all the threads look up present elements, one lookup out
+// of `state.range(1)` is a miss followed by a Put
+template <cache::LruRecency Recency>
+void NWayLruGetParallel(benchmark::State& state) {
+    engine::RunStandalone(state.range(0), [&] {
+        Cache cache(kWays, kWaySize, {}, {}, Recency);
+        FillCache(cache);
+        const auto miss_period = static_cast<std::uint64_t>(state.range(1));
+        std::atomic<std::uint64_t> next_missing_key{kElementsCount};
+
+        RunParallelBenchmark(state, [&](auto& range) {
+            std::uint64_t i = utils::RandRange(kElementsCount);
+            for ([[maybe_unused]] auto _ : range) {
+                if (miss_period != 0 && i % miss_period == 0) {
+                    const auto key = next_missing_key++;
+                    benchmark::DoNotOptimize(cache.Get(key));
+                    cache.Put(key, key);
+                } else {
+                    benchmark::DoNotOptimize(cache.Get(i % kElementsCount));
+                }
+                ++i;
+            }
+        });
+    });
+}
+
+BENCHMARK_TEMPLATE(NWayLruGetParallel, cache::LruRecency::kExact)
+    ->ArgNames({"threads", "miss_period"})
+    ->ArgsProduct({{1, 2, 4, 8, 16, 32}, {0, 100}});
+BENCHMARK_TEMPLATE(NWayLruGetParallel, cache::LruRecency::kApproximate)
+    ->ArgNames({"threads", "miss_period"})
+    ->ArgsProduct({{1, 2, 4, 8, 16, 32}, {0, 100}});
+
+// Worst case for the lookups: all the threads hammer the same few elements
+template <cache::LruRecency Recency>
+void NWayLruGetHotKeysParallel(benchmark::State& state) {
+    engine::RunStandalone(state.range(0), [&] {
+        Cache cache(kWays, kWaySize, {}, {}, Recency);
+        FillCache(cache);
+
+        RunParallelBenchmark(state, [&](auto& range) {
+            std::uint64_t i = 0;
+            for ([[maybe_unused]] auto _ : range) {
+                benchmark::DoNotOptimize(cache.Get(i++ % 4));
+            }
+        });
+    });
+}
+
+BENCHMARK_TEMPLATE(NWayLruGetHotKeysParallel, cache::LruRecency::kExact)->RangeMultiplier(2)->Range(1, 32);
+BENCHMARK_TEMPLATE(NWayLruGetHotKeysParallel, cache::LruRecency::kApproximate)->RangeMultiplier(2)->Range(1, 32);
+
+USERVER_NAMESPACE_END
@@ -2,6 +2,12 @@
 
 #include <userver/cache/nway_lru_cache.hpp>
 
+#include <string>
+#include <vector>
+
+#include <userver/dump/common.hpp>
+#include <userver/engine/async.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 using Cache = cache::NWayLRU<int, int>;
@@ -10,6 +16,9 @@ UTEST(NWayLRU, Ctr) {
     UEXPECT_NO_THROW(Cache(1, 10));
     UEXPECT_NO_THROW(Cache(10, 10));
     UEXPECT_THROW(Cache(0, 10), std::logic_error);
+    UEXPECT_THROW(
+        Cache(1, 10, {}, {}, cache::LruRecency::kApproximate, cache::EvictionPolicy::kWTinyLfu), std::logic_error
+    );
 }
 
 UTEST(NWayLRU, Set) {
@@ -64,4 +73,207 @@ UTEST(NWayLRU, HashCombine) {
     }
 }
 
+UTEST(NWayLRU, ApproximateSet) {
+    Cache cache(1, 1, {}, {}, cache::LruRecency::kApproximate);
+    EXPECT_EQ(0, cache.GetSize());
+
+    cache.Put(1, 1);
+    EXPECT_EQ(1, cache.GetSize());
+    EXPECT_EQ(1, cache.Get(1));
+
+    cache.Put(1, 10);
+    EXPECT_EQ(1, cache.GetSize());
+    EXPECT_EQ(10, cache.Get(1));
+
+    cache.Put(2, 2);
+    EXPECT_EQ(2, cache.Get(2));
+    EXPECT_EQ(1, cache.GetSize());
+    EXPECT_FALSE(cache.Get(1).has_value());
+}
+
+UTEST(NWayLRU, ApproximateGetExpired) {
+    Cache cache(1, 2, {}, {}, cache::LruRecency::kApproximate);
+    cache.Put(1, 1);
+    cache.Put(2, 2);
+
+    EXPECT_EQ(1, cache.Get(1));
+    EXPECT_EQ(2, cache.GetSize());
+
+    EXPECT_FALSE(cache.Get(1, [](int) { return false; }).has_value());
+    EXPECT_EQ(1, cache.GetSize());
+
+    cache.InvalidateByKey(2);
+    EXPECT_FALSE(cache.Get(2).has_value());
+    EXPECT_EQ(0, cache.GetSize());
+}
+
+UTEST(NWayLRU, ApproximateEvictsLeastRecent) {
+    constexpr int kWaySize = 64;
+    Cache cache(1, kWaySize, {}, {}, cache::LruRecency::kApproximate);
+
+    for (int i = 0; i < kWaySize; ++i) cache.Put(i, i);
+    for (int round = 0; round < 8; ++round) {
+        // keep the first half hot while the new elements push the others out
+        for (int i = 0; i < kWaySize / 2; ++i) EXPECT_EQ(i, cache.Get(i));
+        for (int i = 0; i < kWaySize / 8; ++i) cache.Put(kWaySize * (round + 1) + i, i);
+    }
+
+    for (int i = 0; i < kWaySize / 2; ++i) EXPECT_EQ(i, cache.Get(i));
+    EXPECT_LE(cache.GetSize(), kWaySize + kWaySize / 8);
+
+    std::size_t visited = 0;
+    cache.VisitAll([&visited](int, int) { ++visited; });
+    EXPECT_EQ(visited, cache.GetSize());
+
+    cache.Invalidate();
+    EXPECT_EQ(0, cache.GetSize());
+    EXPECT_FALSE(cache.Get(0).has_value());
+}
+
+UTEST_MT(NWayLRU, ApproximateConcurrentReads, 4) {
+    constexpr int kSize = 100;
+    Cache cache(2, kSize, {}, {}, cache::LruRecency::kApproximate);
+    for (int i = 0; i < kSize; ++i) cache.Put(i, i);
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    for (int task = 0; task < 3; ++task) {
+        tasks.push_back(engine::AsyncNoSpan([&cache] {
+            for (int round = 0; round < 100; ++round) {
+                for (int i = 0; i < kSize; ++i) {
+                    const auto value = cache.Get(i);
+                    if (value) EXPECT_EQ(*value % kSize, i);
+                }
+            }
+        }));
+    }
+    for (int round = 1; round < 100; ++round) {
+        for (int i = 0; i < kSize; ++i) cache.Put(i, round * kSize + i);
+    }
+    for (auto& task : tasks) task.Get();
+
+    for (int i = 0; i < kSize; ++i) EXPECT_EQ(99 * kSize + i, cache.Get(i));
+}
+
+UTEST(NWayLRU, WTinyLfuKeepsFrequent) {
+    constexpr int kWaySize = 100;
+    Cache cache(1, kWaySize, {}, {}, cache::LruRecency::kExact, cache::EvictionPolicy::kWTinyLfu);
+
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < kWaySize / 2; ++i) {
+            if (!cache.Get(i)) cache.Put(i, i);
+        }
+    }
+
+    // a scan over many keys does not flush the frequently used ones
+    for (int i = kWaySize; i < 4 * kWaySize; ++i) {
+        if (!cache.Get(i)) cache.Put(i, i);
+    }
+    EXPECT_LE(cache.GetSize(), kWaySize);
+
+    for (int i = 0; i < kWaySize / 2; ++i) EXPECT_EQ(i, cache.Get(i));
+    EXPECT_EQ(-1, cache.GetOr(kWaySize / 2, -1));
+
+    EXPECT_FALSE(cache.Get(0, [](int) { return false; }).has_value());
+    cache.InvalidateByKey(1);
+    EXPECT_FALSE(cache.Get(1).has_value());
+
+    cache.UpdateWaySize(kWaySize / 4);
+    EXPECT_LE(cache.GetSize(), kWaySize / 4);
+
+    cache.Invalidate();
+    EXPECT_EQ(0, cache.GetSize());
+}
+
+UTEST(NWayLRU, MaxBytes) {
+    using StringCache = cache::NWayLRU<int, std::string>;
+    StringCache cache(1, 100);
+    cache.SetWeigher([](int, const std::string& value) { return value.size(); });
+    EXPECT_EQ(std::nullopt, cache.GetSizeBytes());
+
+    cache.Put(1, std::string(10, 'a'));
+    cache.UpdateWayMaxBytes(25);
+    EXPECT_EQ(10, cache.GetSizeBytes());
+
+    cache.Put(2, std::string(10, 'b'));
+    EXPECT_EQ(20, cache.GetSizeBytes());
+
+    // the least recently used element is evicted to fit the new one
+    EXPECT_TRUE(cache.Get(1).has_value());
+    cache.Put(3, std::string(10, 'c'));
+    EXPECT_EQ(20, cache.GetSizeBytes());
+    EXPECT_FALSE(cache.Get(2).has_value());
+    EXPECT_TRUE(cache.Get(1).has_value());
+
+    // rewrites account for the new size
+    cache.Put(3, std::string(5, 'c'));
+    EXPECT_EQ(15, cache.GetSizeBytes());
+
+    // elements larger than the limit are not stored and do not evict others
+    cache.Put(4, std::string(30, 'd'));
+    EXPECT_FALSE(cache.Get(4).has_value());
+    EXPECT_EQ(15, cache.GetSizeBytes());
+    EXPECT_EQ(2, cache.GetSize());
+
+    cache.InvalidateByKey(3);
+    EXPECT_EQ(10, cache.GetSizeBytes());
+
+    cache.Put(5, std::string(10, 'e'));
+    cache.UpdateWayMaxBytes(15);
+    EXPECT_EQ(10, cache.GetSizeBytes());
+    EXPECT_FALSE(cache.Get(1).has_value());
+    EXPECT_TRUE(cache.Get(5).has_value());
+
+    cache.Invalidate();
+    EXPECT_EQ(0, cache.GetSizeBytes());
+
+    cache.UpdateWayMaxBytes(std::nullopt);
+    EXPECT_EQ(std::nullopt, cache.GetSizeBytes());
+}
+
+UTEST(NWayLRU, MaxBytesWeighsOnce) {
+    using StringCache = cache::NWayLRU<int, std::string>;
+    StringCache cache(1, 2);
+    std::size_t weigher_calls = 0;
+    cache.SetWeigher([&weigher_calls](int, const std::string& value) {
+        ++weigher_calls;
+        return value.size();
+    });
+    cache.UpdateWayMaxBytes(100);
+
+    cache.Put(1, std::string(10, 'a'));
+    cache.Put(1, std::string(20, 'a'));
+    cache.Put(2, std::string(10, 'b'));
+    // evicts 1 by the size of the way
+    cache.Put(3, std::string(10, 'c'));
+    cache.InvalidateByKey(2);
+    EXPECT_EQ(weigher_calls, 4);
+    EXPECT_EQ(10, cache.GetSizeBytes());
+
+    cache.UpdateWaySize(1);
+    cache.Put(4, std::string(5, 'd'));
+    EXPECT_EQ(weigher_calls, 5);
+    EXPECT_EQ(5, cache.GetSizeBytes());
+    EXPECT_EQ(1, cache.GetSize());
+}
+
+UTEST(NWayLRU, MaxBytesUnsupported) {
+    Cache approximate(1, 10, {}, {}, cache::LruRecency::kApproximate);
+    UEXPECT_THROW(approximate.UpdateWayMaxBytes(100), std::logic_error);
+
+    Cache tinylfu(1, 10, {}, {}, cache::LruRecency::kExact, cache::EvictionPolicy::kWTinyLfu);
+    UEXPECT_THROW(tinylfu.UpdateWayMaxBytes(100), std::logic_error);
+    UEXPECT_NO_THROW(tinylfu.UpdateWayMaxBytes(std::nullopt));
+}
+
+TEST(GetEstimatedSize, Basic) {
+    EXPECT_EQ(sizeof(int), cache::GetEstimatedSize(42));
+
+    // dumpable types account for the dynamic memory
+    const std::string value(1000, 'a');
+    EXPECT_GE(cache::GetEstimatedSize(value), sizeof(std::string) + value.size());
+    EXPECT_LT(cache::GetEstimatedSize(value), sizeof(std::string) + value.size() + 16);
+
+    EXPECT_EQ(cache::DefaultWeigher{}(42, value), sizeof(int) + cache::GetEstimatedSize(value));
+}
+
 USERVER_NAMESPACE_END
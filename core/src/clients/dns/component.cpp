@@ -28,14 +28,26 @@ ResolverConfig ParseResolverConfig(const components::ComponentConfig& component_
         component_config["cache_max_reply_ttl"].As<std::chrono::milliseconds>(config.cache_max_reply_ttl);
     config.cache_failure_ttl =
         component_config["cache_failure_ttl"].As<std::chrono::milliseconds>(config.cache_failure_ttl);
+    config.prefetch_names = component_config["prefetch-names"].As<std::vector<std::string>>(config.prefetch_names);
     return config;
 }
 
 }  // namespace
 
 Component::Component(const components::ComponentConfig& config, const components::ComponentContext& context)
+    : Component(config, context, ParseResolverConfig(config)) {}
+
+Component::Component(
+    const components::ComponentConfig& config,
+    const components::ComponentContext& context,
+    const ResolverConfig& resolver_config
+)
     : ComponentBase{config, context},
-      resolver_{context.GetTaskProcessor(config["fs-task-processor"].As<std::string>()), ParseResolverConfig(config)} {
+      resolver_{context.GetTaskProcessor(config["fs-task-processor"].As<std::string>()), resolver_config} {
+    resolver_.Prefetch(
+        engine::Deadline::FromDuration(resolver_config.network_timeout * resolver_config.network_attempts)
+    );
+
     auto& storage = context.FindComponent<components::StatisticsStorage>().GetStorage();
     statistics_holder_ = storage.RegisterWriter(config.Name() + ".replies", [this](auto& writer) { Write(writer); });
 }
@@ -100,6 +112,15 @@ properties:
         type: string
         description: TTL for network failures caching
         defaultDescription: 5s
+    prefetch-names:
+        type: array
+        description: |
+            names to resolve in parallel on component load, results for them are
+            kept in a separate cache that is never evicted
+        defaultDescription: []
+        items:
+            type: string
+            description: domain name
 )");
 }
 
@@ -5,6 +5,7 @@
 #include <cctype>
 #include <chrono>
 #include <string_view>
+#include <unordered_set>
 
 #include <clients/dns/file_resolver.hpp>
 #include <clients/dns/helpers.hpp>
@@ -13,7 +14,9 @@
 #include <userver/clients/dns/exception.hpp>
 #include <userver/concurrent/mutex_set.hpp>
 #include <userver/engine/async.hpp>
+#include <userver/engine/wait_all_checked.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/rcu/rcu_map.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/from_string.hpp>
 #include <userver/utils/impl/wait_token_storage.hpp>
@@ -134,6 +137,8 @@ public:
 
     const LookupSourceCounters& GetLookupSourceCounters() const;
 
+    const std::vector<std::string>& GetPrefetchNames() const;
+
     void ReloadHosts();
     void FlushNetworkCache();
     void FlushNetworkCache(const std::string& name);
@@ -158,6 +163,10 @@ private:
         bool is_failure{false};
     };
 
+    bool IsPrefetched(const std::string& name) const;
+    NetCacheResult ToNetCacheResult(const NetCacheEntry* cached);
+    void PutNetCache(const std::string& name, NetCacheEntry&& entry);
+
     template <typename Mutex>
     void MoveQueryToBackground(
         std::unique_lock<Mutex>& lock,
@@ -183,6 +192,10 @@ private:
     const std::chrono::milliseconds net_cache_max_reply_ttl_;
     const std::chrono::milliseconds net_cache_failure_ttl_;
     cache::NWayLRU<std::string, NetCacheEntry> net_cache_;
+    const std::vector<std::string> prefetch_names_;
+    const std::unordered_set<std::string> prefetch_names_set_;
+    // Read-mostly and never evicted, does not take locks on lookups
+    rcu::RcuMap<std::string, NetCacheEntry> prefetched_cache_;
     concurrent::MutexSet<std::string> net_cache_update_mutexes_;
     utils::impl::WaitTokenStorage wait_token_storage_;
 };
@@ -194,17 +207,40 @@ Resolver::Impl::Impl(engine::TaskProcessor& fs_task_processor, const ResolverCon
       net_cache_max_reply_ttl_{config.cache_max_reply_ttl},
       net_cache_failure_ttl_{config.cache_failure_ttl},
       net_cache_{config.cache_ways, config.cache_size_per_way},
+      prefetch_names_{config.prefetch_names},
+      prefetch_names_set_{config.prefetch_names.begin(), config.prefetch_names.end()},
       net_cache_update_mutexes_(config.cache_ways) {}
 
 Resolver::Impl::~Impl() { wait_token_storage_.WaitForAllTokens(); }
 
 const Resolver::LookupSourceCounters& Resolver::Impl::GetLookupSourceCounters() const { return source_counters_; }
 
+const std::vector<std::string>& Resolver::Impl::GetPrefetchNames() const { return prefetch_names_; }
+
 void Resolver::Impl::ReloadHosts() { file_resolver_.ReloadHosts(); }
 
-void Resolver::Impl::FlushNetworkCache() { net_cache_.Invalidate(); }
+void Resolver::Impl::FlushNetworkCache() {
+    net_cache_.Invalidate();
+    prefetched_cache_.Clear();
+}
+
+void Resolver::Impl::FlushNetworkCache(const std::string& name) {
+    if (IsPrefetched(name)) {
+        prefetched_cache_.Erase(name);
+    } else {
+        net_cache_.InvalidateByKey(name);
+    }
+}
+
+bool Resolver::Impl::IsPrefetched(const std::string& name) const { return prefetch_names_set_.count(name) != 0; }
 
-void Resolver::Impl::FlushNetworkCache(const std::string& name) { net_cache_.InvalidateByKey(name); }
+void Resolver::Impl::PutNetCache(const std::string& name, NetCacheEntry&& entry) {
+    if (IsPrefetched(name)) {
+        prefetched_cache_.InsertOrAssign(name, std::make_shared<NetCacheEntry>(std::move(entry)));
+    } else {
+        net_cache_.Put(name, std::move(entry));
+    }
+}
 
 AddrVector Resolver::Impl::QueryFileCache(const std::string& name) {
     auto addrs = file_resolver_.Resolve(name);
@@ -215,12 +251,21 @@ AddrVector Resolver::Impl::QueryFileCache(const std::string& name) {
 }
 
 Resolver::Impl::NetCacheResult Resolver::Impl::QueryNetCache(const std::string& name) {
-    NetCacheResult result;
+    if (IsPrefetched(name)) {
+        const auto cached = prefetched_cache_.Get(name);
+        return ToNetCacheResult(cached.get());
+    }
 
-    const auto now = utils::datetime::MockSteadyNow();
     const auto cached = net_cache_.Get(name);
+    return ToNetCacheResult(cached ? &*cached : nullptr);
+}
+
+Resolver::Impl::NetCacheResult Resolver::Impl::ToNetCacheResult(const NetCacheEntry* cached) {
+    NetCacheResult result;
     if (!cached) return result;
 
+    const auto now = utils::datetime::MockSteadyNow();
+
     if (cached->is_failure) {
         if (cached->expiration >= now) {
             ++source_counters_.cached_failure;
@@ -331,7 +376,7 @@ void Resolver::Impl::FinishNetUpdate(
         LOG_LIMITED_ERROR() << "Resolving of '" << name << "' failed: " << ex;
         if (failure_mode == FailureMode::kCache) {
             LOG_TRACE() << "Caching failure for '" << name << '\'';
-            net_cache_.Put(name, NetCacheEntry{{}, utils::datetime::MockSteadyNow() + net_cache_failure_ttl_, true});
+            PutNetCache(name, NetCacheEntry{{}, utils::datetime::MockSteadyNow() + net_cache_failure_ttl_, true});
         }
         ++source_counters_.network_failure;
         throw;
@@ -342,9 +387,7 @@ void Resolver::Impl::FinishNetUpdate(
     if (addrs) *addrs = response.addrs;
     if (effective_ttl.count() > 0) {
         LOG_TRACE() << "Updating cache for '" << name << '\'';
-        net_cache_.Put(
-            name, NetCacheEntry{std::move(response.addrs), utils::datetime::MockSteadyNow() + effective_ttl}
-        );
+        PutNetCache(name, NetCacheEntry{std::move(response.addrs), utils::datetime::MockSteadyNow() + effective_ttl});
     } else {
         LOG_TRACE() << "Skipping cache update for '" << name << '\'';
     }
@@ -417,6 +460,25 @@ AddrVector Resolver::Resolve(const std::string& name, engine::Deadline deadline)
     UINVARIANT(false, "Unexpected cache result status");
 }
 
+void Resolver::Prefetch(engine::Deadline deadline) {
+    const auto& names = impl_->GetPrefetchNames();
+    if (names.empty()) return;
+
+    LOG_INFO() << "Prefetching " << names.size() << " DNS names";
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(names.size());
+    for (const auto& name : names) {
+        tasks.push_back(engine::AsyncNoSpan([this, &name, deadline] {
+            try {
+                Resolve(name, deadline);
+            } catch (const ResolverException& ex) {
+                LOG_WARNING() << "Failed to prefetch '" << name << "': " << ex;
+            }
+        }));
+    }
+    engine::WaitAllChecked(tasks);
+}
+
 const Resolver::LookupSourceCounters& Resolver::GetLookupSourceCounters() const {
     return impl_->GetLookupSourceCounters();
 }
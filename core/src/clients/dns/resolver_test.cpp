@@ -58,7 +58,7 @@ constexpr auto kNetV6String{"2a02:6b8:a::a"};
 struct MockedResolver {
     using ServerMock = utest::DnsServerMock;
 
-    MockedResolver(size_t cache_max_ttl, size_t cache_size_per_way)
+    MockedResolver(size_t cache_max_ttl, size_t cache_size_per_way, std::vector<std::string> prefetch_names = {})
         : hosts_file{[] {
               auto file = fs::blocking::TempFile::Create();
               fs::blocking::RewriteFileContents(file.GetPath(), kTestHosts);
@@ -85,6 +85,7 @@ struct MockedResolver {
                        config.cache_failure_ttl = std::chrono::seconds{cache_max_ttl}, config.cache_ways = 1;
                        config.cache_size_per_way = cache_size_per_way;
                        config.network_custom_servers = {server_mock.GetServerAddress()};
+                       config.prefetch_names = std::move(prefetch_names);
                        return config;
                    }()} {}
 
@@ -449,4 +450,34 @@ UTEST(Resolver, FirstUpdateCombines) {
     EXPECT_EQ(counters.network_failure, 1);
 }
 
+UTEST(Resolver, Prefetch) {
+    const auto test_deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+    MockedResolver resolver{1000, 1, {"first", "second", "fail"}};
+    resolver.reply_delay = std::chrono::milliseconds{50};
+
+    resolver->Prefetch(test_deadline);
+
+    const auto& counters = resolver->GetLookupSourceCounters();
+    EXPECT_EQ(counters.network, 2);
+    EXPECT_EQ(counters.network_failure, 1);
+
+    // Other names do not evict the prefetched ones from a single-entry cache
+    EXPECT_PRED_FORMAT2(CheckAddrs, resolver->Resolve("other", test_deadline), (Expected{kNetV6String, kNetV4String}));
+    EXPECT_PRED_FORMAT2(
+        CheckAddrs, resolver->Resolve("another", test_deadline), (Expected{kNetV6String, kNetV4String})
+    );
+    EXPECT_PRED_FORMAT2(CheckAddrs, resolver->Resolve("first", test_deadline), (Expected{kNetV6String, kNetV4String}));
+    EXPECT_PRED_FORMAT2(CheckAddrs, resolver->Resolve("second", test_deadline), (Expected{kNetV6String, kNetV4String}));
+    UEXPECT_THROW(resolver->Resolve("fail", test_deadline), clients::dns::NotResolvedException);
+
+    EXPECT_EQ(counters.cached, 2);
+    EXPECT_EQ(counters.cached_failure, 1);
+    EXPECT_EQ(counters.network, 4);
+
+    resolver->FlushNetworkCache("first");
+    EXPECT_PRED_FORMAT2(CheckAddrs, resolver->Resolve("first", test_deadline), (Expected{kNetV6String, kNetV4String}));
+    EXPECT_EQ(counters.network, 5);
+}
+
 USERVER_NAMESPACE_END
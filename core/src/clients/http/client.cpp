@@ -19,6 +19,7 @@
 #include <clients/http/testsuite.hpp>
 #include <curl-ev/multi.hpp>
 #include <curl-ev/ratelimit.hpp>
+#include <curl-ev/share.hpp>
 #include <engine/ev/thread_pool.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -52,6 +53,7 @@ Client::Client(
       fs_task_processor_(fs_task_processor),
       user_agent_(utils::GetUserverIdentifier()),
       connect_rate_limiter_(std::make_shared<curl::ConnectRateLimiter>()),
+      ssl_session_share_(std::make_shared<curl::share>()),
       tracing_manager_(GetTracingManager(settings)),
       plugin_pipeline_(std::move(plugin_pipeline)) {
     const auto io_threads = settings.io_threads;
@@ -64,6 +66,10 @@ Client::Client(
 
     ReinitEasy();
 
+    // Resume TLS sessions on new connections to the hosts that any of the
+    // handles has already visited
+    ssl_session_share_->set_share_ssl_session(true);
+
     multis_.reserve(io_threads);
 
     // libcurl synchronously reads some of /etc/* files.
@@ -112,6 +118,7 @@ Request Client::CreateRequest() {
         if (easy) {
             auto idx = FindMultiIndex(easy->GetMulti());
             auto wrapper = impl::EasyWrapper{std::move(easy), *this};
+            wrapper.Easy().set_share(ssl_session_share_);
             return Request{
                 std::move(wrapper),
                 statistics_[idx].CreateRequestStats(),
@@ -127,6 +134,7 @@ Request Client::CreateRequest() {
                 auto wrapper = engine::AsyncNoSpan(fs_task_processor_, [this, &multi] {
                                    return impl::EasyWrapper{easy_.Get()->GetBoundBlocking(*multi), *this};
                                }).Get();
+                wrapper.Easy().set_share(ssl_session_share_);
                 return Request{
                     std::move(wrapper),
                     statistics_[i].CreateRequestStats(),
@@ -2,6 +2,7 @@
 
 #include <clients/http/request_state.hpp>
 #include <userver/clients/http/request.hpp>
+#include <userver/logging/log.hpp>
 #include <userver/utils/algo.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -30,10 +31,40 @@ void PluginRequest::SetTimeout(std::chrono::milliseconds ms) {
     state_.SetEasyTimeout(ms);
 }
 
+const std::string& PluginRequest::GetOriginalUrl() const { return state_.easy().get_original_url(); }
+
+std::string_view PluginRequest::GetHttpMethod() const { return state_.GetHttpMethod(); }
+
+std::optional<std::string_view> PluginRequest::FindHeaderByName(std::string_view name) const {
+    return state_.easy().FindHeaderByName(name);
+}
+
+std::chrono::milliseconds PluginRequest::GetTimeout() const { return std::chrono::milliseconds{state_.timeout()}; }
+
+bool PluginRequest::IsStreamed() const { return state_.IsStreamed(); }
+
+const void* PluginRequest::GetRequestId() const noexcept { return &state_; }
+
+utils::AnyStorage<PluginStorageContext>& PluginRequest::GetStorageContext() {
+    return state_.GetPluginStorageContext();
+}
+
+const char* LookupRetryException::what() const noexcept { return "HTTP client plugin requested the response lookup retry"; }
+
 Plugin::Plugin(std::string name) : name_(std::move(name)) {}
 
 const std::string& Plugin::GetName() const { return name_; }
 
+void Plugin::HookOnError(PluginRequest&, std::exception_ptr) {}
+
+std::optional<engine::Future<std::shared_ptr<Response>>> Plugin::HookLookupResponse(PluginRequest&) {
+    return std::nullopt;
+}
+
+void Plugin::HookOnRequestNotSent(PluginRequest&) {}
+
+void Plugin::HookOnResponse(PluginRequest&, Response&) {}
+
 namespace impl {
 
 PluginPipeline::PluginPipeline(const std::vector<utils::NotNull<Plugin*>>& plugins) : plugins_(plugins) {}
@@ -64,6 +95,49 @@ void PluginPipeline::HookPerformRequest(RequestState& request_state) {
     }
 }
 
+void PluginPipeline::HookOnError(RequestState& request_state, std::exception_ptr error) {
+    PluginRequest req(request_state);
+
+    // NOLINTNEXTLINE(modernize-loop-convert)
+    for (auto it = plugins_.rbegin(); it != plugins_.rend(); ++it) {
+        const auto& plugin = *it;
+        plugin->HookOnError(req, error);
+    }
+}
+
+std::optional<engine::Future<std::shared_ptr<Response>>> PluginPipeline::HookLookupResponse(
+    RequestState& request_state
+) {
+    PluginRequest req(request_state);
+
+    for (auto it = plugins_.begin(); it != plugins_.end(); ++it) {
+        auto future = (*it)->HookLookupResponse(req);
+        if (future) {
+            LOG_DEBUG() << "Response for " << req.GetOriginalUrl() << " is provided by plugin " << (*it)->GetName();
+            request_state.SetResponseProvider(it->GetBase());
+
+            while (it != plugins_.begin()) {
+                --it;
+                (*it)->HookOnRequestNotSent(req);
+            }
+            return future;
+        }
+    }
+    return std::nullopt;
+}
+
+void PluginPipeline::HookOnResponse(RequestState& request_state, Response& response) {
+    PluginRequest req(request_state);
+    const auto* provider = request_state.GetResponseProvider();
+
+    // NOLINTNEXTLINE(modernize-loop-convert)
+    for (auto it = plugins_.rbegin(); it != plugins_.rend(); ++it) {
+        const auto& plugin = *it;
+        if (plugin.GetBase() == provider) continue;
+        plugin->HookOnResponse(req, response);
+    }
+}
+
 }  // namespace impl
 
 }  // namespace clients::http
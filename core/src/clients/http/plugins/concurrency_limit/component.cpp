@@ -0,0 +1,73 @@
+#include <userver/clients/http/plugins/concurrency_limit/component.hpp>
+
+#include <clients/http/plugins/concurrency_limit/plugin.hpp>
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/components/statistics_storage.hpp>
+#include <userver/dynamic_config/storage/component.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http::plugins::concurrency_limit {
+
+namespace {
+
+Settings ParseSettings(const components::ComponentConfig& config) {
+    Settings settings;
+    settings.congestion_control =
+        config["congestion-control"].As<congestion_control::v2::LinearController::StaticConfig>();
+    settings.max_destinations = config["max-destinations"].As<std::size_t>(settings.max_destinations);
+    return settings;
+}
+
+}  // namespace
+
+Component::Component(const components::ComponentConfig& config, const components::ComponentContext& context)
+    : ComponentBase(config, context),
+      plugin_(std::make_unique<concurrency_limit::Plugin>(
+          ParseSettings(config),
+          context.FindComponent<components::DynamicConfig>().GetSource()
+      )) {
+    auto& storage = context.FindComponent<components::StatisticsStorage>().GetStorage();
+    statistics_holder_ = storage.RegisterWriter(
+        "httpclient.concurrency-limit",
+        [this](utils::statistics::Writer& writer) { plugin_->WriteStatistics(writer); }
+    );
+}
+
+Component::~Component() = default;
+
+http::Plugin& Component::GetPlugin() { return *plugin_; }
+
+yaml_config::Schema Component::GetStaticConfigSchema() {
+    return yaml_config::MergeSchemas<plugin::ComponentBase>(R"(
+type: object
+description: HTTP client plugin that adaptively limits the concurrency of requests to each destination
+additionalProperties: false
+properties:
+    congestion-control:
+        type: object
+        description: congestion control options
+        additionalProperties: false
+        properties:
+            enabled:
+                type: boolean
+                description: set to false to never limit the requests
+                defaultDescription: true
+            fake-mode:
+                type: boolean
+                description: compute the limits, but do not apply them
+                defaultDescription: false
+    max-destinations:
+        type: integer
+        description: max number of destinations with own limits
+        defaultDescription: 100
+        minimum: 0
+)");
+}
+
+}  // namespace clients::http::plugins::concurrency_limit
+
+USERVER_NAMESPACE_END
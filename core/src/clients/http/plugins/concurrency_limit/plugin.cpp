@@ -0,0 +1,229 @@
+#include <clients/http/plugins/concurrency_limit/plugin.hpp>
+
+#include <algorithm>  // for std::max
+#include <limits>
+
+#include <curl-ev/error_code.hpp>
+#include <userver/clients/http/error.hpp>
+#include <userver/clients/http/response.hpp>
+#include <userver/dynamic_config/value.hpp>
+#include <userver/logging/log.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http::plugins::concurrency_limit {
+
+namespace {
+
+const std::string kName = "concurrency-limit";
+
+constexpr std::size_t kNoLimit = std::numeric_limits<std::size_t>::max();
+constexpr std::chrono::seconds kStepPeriod{1};
+
+const dynamic_config::Key<congestion_control::v2::Config> kCcConfig{
+    "HTTP_CLIENT_CONGESTION_CONTROL_SETTINGS",
+    dynamic_config::DefaultAsJsonString{"{}"}};
+
+bool IsUpstreamError(Status status) {
+    // 429 is the explicit request of the destination to lower the load
+    return status == Status::kTooManyRequests || static_cast<int>(status) >= 500;
+}
+
+bool IsUpstreamError(const std::exception_ptr& error) {
+    try {
+        std::rethrow_exception(error);
+    } catch (const BaseException& ex) {
+        // Cancellations and our own deadlines say nothing about the destination
+        const auto kind = ex.GetErrorKind();
+        return kind == ErrorKind::kNetwork || kind == ErrorKind::kTimeout;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+std::chrono::milliseconds GetTiming(const std::exception_ptr& error) {
+    try {
+        std::rethrow_exception(error);
+    } catch (const BaseException& ex) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(ex.GetStats().time_to_process);
+    } catch (const std::exception&) {
+        return {};
+    }
+}
+
+}  // namespace
+
+Destination::Destination(
+    const std::string& name,
+    const congestion_control::v2::LinearController::StaticConfig& config,
+    dynamic_config::Source config_source
+)
+    : limit_(kNoLimit),
+      sensor_(*this),
+      controller_(
+          "httpclient-" + name,
+          sensor_,
+          *this,
+          stats_,
+          config,
+          config_source,
+          [](const dynamic_config::Snapshot& config) { return config[kCcConfig]; }
+      ) {}
+
+bool Destination::TryAcquire() noexcept {
+    // atomic [current++ iff current < limit]
+    auto in_flight = in_flight_.load();
+    do {
+        if (in_flight >= limit_.load()) {
+            ++rejected_;
+            return false;
+        }
+    } while (!in_flight_.compare_exchange_weak(in_flight, in_flight + 1));
+
+    return true;
+}
+
+void Destination::Release(bool is_upstream_error, std::chrono::milliseconds timing) noexcept {
+    UASSERT(in_flight_.load() > 0);
+    --in_flight_;
+
+    ++total_;
+    if (is_upstream_error) ++errors_;
+    timings_sum_ms_ += timing.count();
+}
+
+void Destination::Cancel() noexcept {
+    UASSERT(in_flight_.load() > 0);
+    --in_flight_;
+}
+
+void Destination::Step() { controller_.Step(); }
+
+void Destination::SetLimit(const congestion_control::Limit& new_limit) {
+    limit_ = new_limit.load_limit.value_or(kNoLimit);
+}
+
+void DumpMetric(utils::statistics::Writer& writer, const Destination& destination) {
+    writer["in-flight"] = destination.in_flight_.load();
+    writer["rejected"] = destination.rejected_;
+    writer["congestion-control"] = destination.stats_;
+}
+
+Destination::AccumulatedData Destination::GetAccumulatedData() const noexcept {
+    return {total_.load(), errors_.load(), timings_sum_ms_.load()};
+}
+
+Destination::Sensor::Sensor(const Destination& destination) : destination_(destination) {}
+
+congestion_control::v2::Sensor::Data Destination::Sensor::GetCurrent() {
+    const auto new_data = destination_.GetAccumulatedData();
+    const auto last_data = std::exchange(last_data_, new_data);
+
+    const auto total = new_data.total - last_data.total;
+    const auto errors = new_data.errors - last_data.errors;
+    const auto timings_sum_ms = new_data.timings_sum_ms - last_data.timings_sum_ms;
+
+    const auto timings_avg_ms = timings_sum_ms / std::max(total, std::uint64_t{1});
+    const auto current_load = destination_.in_flight_.load();
+    return {total, errors, timings_avg_ms, current_load};
+}
+
+Plugin::Plugin(Settings settings, dynamic_config::Source config_source)
+    : http::Plugin(kName), settings_(std::move(settings)), config_source_(config_source) {
+    if (settings_.congestion_control.enabled) {
+        controllers_task_.Start("httpclient-concurrency-limit", {kStepPeriod}, [this] {
+            for (const auto& [name, destination] : destinations_) {
+                destination->Step();
+            }
+        });
+    }
+}
+
+Plugin::~Plugin() { controllers_task_.Stop(); }
+
+void Plugin::HookPerformRequest(PluginRequest&) {}
+
+void Plugin::HookCreateSpan(PluginRequest&) {}
+
+void Plugin::HookOnCompleted(PluginRequest& request, Response& response) {
+    if (request.IsStreamed()) return;
+
+    auto* destination = FindDestination(request);
+    if (!destination) return;
+
+    const auto timing = std::chrono::duration_cast<std::chrono::milliseconds>(response.GetStats().time_to_process);
+    destination->Release(IsUpstreamError(response.status_code()), timing);
+}
+
+void Plugin::HookOnError(PluginRequest& request, std::exception_ptr error) {
+    auto* destination = FindDestination(request);
+    if (destination) destination->Release(IsUpstreamError(error), GetTiming(error));
+}
+
+std::optional<engine::Future<std::shared_ptr<Response>>> Plugin::HookLookupResponse(PluginRequest& request) {
+    const auto& url = request.GetOriginalUrl();
+    auto* destination = FindOrCreateDestination(ExtractDestination(url));
+    if (!destination || destination->TryAcquire()) return std::nullopt;
+
+    LOG_LIMITED_WARNING() << "Request to " << url << " is rejected by the adaptive concurrency limit";
+    engine::Promise<std::shared_ptr<Response>> promise;
+    promise.set_exception(
+        PrepareException(curl::errc::RateLimitErrorCode::kDestinationConcurrencyLimit, url, LocalStats{})
+    );
+    return promise.get_future();
+}
+
+void Plugin::HookOnRequestNotSent(PluginRequest& request) {
+    auto* destination = FindDestination(request);
+    if (destination) destination->Cancel();
+}
+
+void Plugin::WriteStatistics(utils::statistics::Writer& writer) const {
+    for (const auto& [name, destination] : destinations_) {
+        writer.ValueWithLabels(*destination, {"http_destination", name});
+    }
+}
+
+Destination* Plugin::FindOrCreateDestination(const std::string& name) {
+    auto destination = destinations_.Get(name);
+    if (destination) return destination.get();
+
+    // atomic [current++ iff current < max]
+    auto current_destinations = destinations_count_.load();
+    do {
+        if (current_destinations >= settings_.max_destinations) {
+            LOG_LIMITED_WARNING() << "Too many destinations for the adaptive concurrency limit ("
+                                  << settings_.max_destinations
+                                  << "), increase the max-destinations option of the "
+                                     "http-client-plugin-concurrency-limit component";
+            return nullptr;
+        }
+    } while (!destinations_count_.compare_exchange_strong(current_destinations, current_destinations + 1));
+
+    auto [value, inserted] = destinations_.Emplace(name, name, settings_.congestion_control, config_source_);
+    if (!inserted) --destinations_count_;
+    return value.get();
+}
+
+Destination* Plugin::FindDestination(const PluginRequest& request) {
+    // Destinations are never removed, so every admitted request finds its own
+    return destinations_.Get(ExtractDestination(request.GetOriginalUrl())).get();
+}
+
+std::string ExtractDestination(std::string_view url) {
+    // Drop "schema://"
+    const auto schema_pos = url.find("://");
+    if (schema_pos != std::string_view::npos) url.remove_prefix(schema_pos + 3);
+
+    // Drop /.* and ?.*
+    url = url.substr(0, url.find_first_of("/?#"));
+
+    const auto userinfo_pos = url.rfind('@');
+    if (userinfo_pos != std::string_view::npos) url.remove_prefix(userinfo_pos + 1);
+
+    return std::string{url};
+}
+
+}  // namespace clients::http::plugins::concurrency_limit
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include <userver/clients/http/plugin.hpp>
+#include <userver/congestion_control/controllers/linear.hpp>
+#include <userver/congestion_control/limiter.hpp>
+#include <userver/congestion_control/sensor.hpp>
+#include <userver/dynamic_config/source.hpp>
+#include <userver/rcu/rcu_map.hpp>
+#include <userver/utils/periodic_task.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http::plugins::concurrency_limit {
+
+struct Settings {
+    congestion_control::v2::LinearController::StaticConfig congestion_control;
+    std::size_t max_destinations{100};
+};
+
+/// Adaptive limit of concurrent requests to a single destination
+class Destination final : public congestion_control::Limiter {
+public:
+    Destination(
+        const std::string& name,
+        const congestion_control::v2::LinearController::StaticConfig& config,
+        dynamic_config::Source config_source
+    );
+
+    /// Returns false if the request should not be sent because of the limit
+    bool TryAcquire() noexcept;
+
+    /// Accounts the end of a request that was admitted by TryAcquire()
+    void Release(bool is_upstream_error, std::chrono::milliseconds timing) noexcept;
+
+    /// Returns the slot of a request that was admitted by TryAcquire() but
+    /// was not sent, the controller does not account such requests
+    void Cancel() noexcept;
+
+    /// Recalculates the limit, should be called once per second
+    void Step();
+
+    void SetLimit(const congestion_control::Limit& new_limit) override;
+
+    friend void DumpMetric(utils::statistics::Writer& writer, const Destination& destination);
+
+private:
+    struct AccumulatedData {
+        std::uint64_t total{0};
+        std::uint64_t errors{0};
+        std::uint64_t timings_sum_ms{0};
+    };
+
+    class Sensor final : public congestion_control::v2::Sensor {
+    public:
+        explicit Sensor(const Destination& destination);
+
+        Data GetCurrent() override;
+
+    private:
+        const Destination& destination_;
+        AccumulatedData last_data_;
+    };
+
+    AccumulatedData GetAccumulatedData() const noexcept;
+
+    std::atomic<std::size_t> limit_;
+    std::atomic<std::size_t> in_flight_{0};
+    std::atomic<std::uint64_t> total_{0};
+    std::atomic<std::uint64_t> errors_{0};
+    std::atomic<std::uint64_t> timings_sum_ms_{0};
+    utils::statistics::RateCounter rejected_;
+
+    congestion_control::v2::Stats stats_;
+    Sensor sensor_;
+    congestion_control::v2::LinearController controller_;
+};
+
+/// Limits the concurrency of requests to each destination with the
+/// congestion control heuristics and rejects the requests over the limit
+class Plugin final : public http::Plugin {
+public:
+    Plugin(Settings settings, dynamic_config::Source config_source);
+
+    ~Plugin() override;
+
+    void HookPerformRequest(PluginRequest& request) override;
+
+    void HookCreateSpan(PluginRequest& request) override;
+
+    void HookOnCompleted(PluginRequest& request, Response& response) override;
+
+    void HookOnError(PluginRequest& request, std::exception_ptr error) override;
+
+    std::optional<engine::Future<std::shared_ptr<Response>>> HookLookupResponse(PluginRequest& request) override;
+
+    void HookOnRequestNotSent(PluginRequest& request) override;
+
+    void WriteStatistics(utils::statistics::Writer& writer) const;
+
+private:
+    Destination* FindOrCreateDestination(const std::string& name);
+
+    Destination* FindDestination(const PluginRequest& request);
+
+    const Settings settings_;
+    dynamic_config::Source config_source_;
+    rcu::RcuMap<std::string, Destination> destinations_;
+    std::atomic<std::size_t> destinations_count_{0};
+    utils::PeriodicTask controllers_task_;
+};
+
+/// Returns the "host:port" part of the URL
+std::string ExtractDestination(std::string_view url);
+
+}  // namespace clients::http::plugins::concurrency_limit
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,97 @@
+#include <clients/http/plugins/concurrency_limit/plugin.hpp>
+
+#include <clients/http/plugins/response_cache/plugin.hpp>
+#include <userver/clients/http/client.hpp>
+#include <userver/dynamic_config/test_helpers.hpp>
+#include <userver/utest/http_client.hpp>
+#include <userver/utest/simple_server.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/testing.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace concurrency_limit = clients::http::plugins::concurrency_limit;
+
+using HttpResponse = utest::SimpleServer::Response;
+using HttpRequest = utest::SimpleServer::Request;
+
+HttpResponse OkCallback(const HttpRequest&) {
+    return {
+        "HTTP/1.1 200 OK\r\nConnection: close\r\nContent-Length: 2\r\n\r\nok",
+        HttpResponse::kWriteAndClose,
+    };
+}
+
+HttpResponse CacheableCallback(const HttpRequest&) {
+    return {
+        "HTTP/1.1 200 OK\r\nConnection: close\r\nCache-Control: max-age=600\r\nContent-Length: 2\r\n\r\nok",
+        HttpResponse::kWriteAndClose,
+    };
+}
+
+}  // namespace
+
+TEST(HttpClientConcurrencyLimit, ExtractDestination) {
+    EXPECT_EQ(concurrency_limit::ExtractDestination("http://example.com/path?a=b"), "example.com");
+    EXPECT_EQ(concurrency_limit::ExtractDestination("https://example.com:8080"), "example.com:8080");
+    EXPECT_EQ(concurrency_limit::ExtractDestination("http://user:pass@[::1]:80/"), "[::1]:80");
+    EXPECT_EQ(concurrency_limit::ExtractDestination("example.com?a=b"), "example.com");
+}
+
+UTEST(HttpClientConcurrencyLimit, Limit) {
+    concurrency_limit::Destination destination{"test", {}, dynamic_config::GetDefaultSource()};
+    EXPECT_TRUE(destination.TryAcquire());
+    EXPECT_TRUE(destination.TryAcquire());
+    EXPECT_TRUE(destination.TryAcquire());
+
+    destination.SetLimit({3, 3});
+    EXPECT_FALSE(destination.TryAcquire());
+
+    destination.Release(false, std::chrono::milliseconds{10});
+    EXPECT_TRUE(destination.TryAcquire());
+    EXPECT_FALSE(destination.TryAcquire());
+
+    destination.SetLimit({std::nullopt, 3});
+    EXPECT_TRUE(destination.TryAcquire());
+
+    for (int i = 0; i < 4; ++i) destination.Release(true, std::chrono::milliseconds{10});
+}
+
+UTEST(HttpClientConcurrencyLimit, RequestsAreSent) {
+    const utest::SimpleServer http_server{&OkCallback};
+    concurrency_limit::Plugin plugin{{}, dynamic_config::GetDefaultSource()};
+    auto http_client = utest::CreateHttpClient({plugin});
+
+    for (int i = 0; i < 3; ++i) {
+        const auto response =
+            http_client->CreateRequest().get(http_server.GetBaseUrl()).timeout(utest::kMaxTestWaitTime).perform();
+        EXPECT_EQ(response->status_code(), clients::http::Status::OK);
+        EXPECT_EQ(response->body_view(), "ok");
+    }
+}
+
+UTEST(HttpClientConcurrencyLimit, SlotIsReturnedIfRequestIsNotSent) {
+    const utest::SimpleServer http_server{&CacheableCallback};
+    concurrency_limit::Plugin plugin{{}, dynamic_config::GetDefaultSource()};
+    clients::http::plugins::response_cache::Plugin cache_plugin{{}};
+    auto http_client = utest::CreateHttpClient({plugin, cache_plugin});
+
+    utils::statistics::Storage storage;
+    const auto holder = storage.RegisterWriter("concurrency-limit", [&plugin](utils::statistics::Writer& writer) {
+        plugin.WriteStatistics(writer);
+    });
+
+    for (int i = 0; i < 3; ++i) {
+        const auto response =
+            http_client->CreateRequest().get(http_server.GetBaseUrl()).timeout(utest::kMaxTestWaitTime).perform();
+        EXPECT_EQ(response->body_view(), "ok");
+    }
+
+    const utils::statistics::Snapshot snapshot{storage, "concurrency-limit"};
+    EXPECT_EQ(snapshot.SingleMetric("in-flight").AsInt(), 0);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,77 @@
+#include <userver/clients/http/plugins/response_cache/component.hpp>
+
+#include <clients/http/plugins/response_cache/plugin.hpp>
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/components/statistics_storage.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http::plugins::response_cache {
+
+namespace {
+
+Settings ParseSettings(const components::ComponentConfig& config) {
+    Settings settings;
+    settings.ways = config["ways"].As<std::size_t>(settings.ways);
+    settings.max_memory_bytes = config["max-memory-bytes"].As<std::size_t>(settings.max_memory_bytes);
+    settings.max_entry_bytes = config["max-entry-bytes"].As<std::size_t>(settings.max_entry_bytes);
+    settings.max_lifetime = config["max-lifetime"].As<std::chrono::milliseconds>(settings.max_lifetime);
+    settings.key_headers = config["headers"].As<std::vector<std::string>>({});
+    return settings;
+}
+
+}  // namespace
+
+Component::Component(const components::ComponentConfig& config, const components::ComponentContext& context)
+    : ComponentBase(config, context), plugin_(std::make_unique<response_cache::Plugin>(ParseSettings(config))) {
+    auto& storage = context.FindComponent<components::StatisticsStorage>().GetStorage();
+    statistics_holder_ = storage.RegisterWriter(
+        "httpclient.response-cache",
+        [this](utils::statistics::Writer& writer) { plugin_->WriteStatistics(writer); }
+    );
+}
+
+Component::~Component() = default;
+
+http::Plugin& Component::GetPlugin() { return *plugin_; }
+
+yaml_config::Schema Component::GetStaticConfigSchema() {
+    return yaml_config::MergeSchemas<plugin::ComponentBase>(R"(
+type: object
+description: HTTP client plugin that caches responses honouring Cache-Control and ETag
+additionalProperties: false
+properties:
+    ways:
+        type: integer
+        description: number of cache shards
+        defaultDescription: 16
+        minimum: 1
+    max-memory-bytes:
+        type: integer
+        description: upper bound for memory used by cached responses
+        defaultDescription: 64Mb
+        minimum: 1
+    max-entry-bytes:
+        type: integer
+        description: responses larger than that are not cached
+        defaultDescription: 1Mb
+        minimum: 1
+    max-lifetime:
+        type: string
+        description: stale responses older than that are evicted instead of being revalidated
+        defaultDescription: 10m
+    headers:
+        type: array
+        description: request headers that are a part of the cache key
+        items:
+            type: string
+            description: header name
+)");
+}
+
+}  // namespace clients::http::plugins::response_cache
+
+USERVER_NAMESPACE_END
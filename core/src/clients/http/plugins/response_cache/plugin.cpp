@@ -0,0 +1,297 @@
+#include <clients/http/plugins/response_cache/plugin.hpp>
+
+#include <algorithm>
+
+#include <userver/http/common_headers.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/datetime.hpp>
+#include <userver/utils/from_string.hpp>
+#include <userver/utils/str_icase.hpp>
+#include <userver/utils/text_light.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http::plugins::response_cache {
+
+namespace {
+
+const std::string kName = "response-cache";
+
+std::string_view TrimView(std::string_view value) {
+    while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) value.remove_prefix(1);
+    while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) value.remove_suffix(1);
+    return value;
+}
+
+// The entry that the plugin revalidates with its own If-None-Match
+const utils::AnyStorageDataTag<PluginStorageContext, std::shared_ptr<const CachedResponse>> kRevalidatedEntry;
+
+std::size_t GetWayMaxBytes(const Settings& settings) {
+    return std::max<std::size_t>(settings.max_memory_bytes / std::max<std::size_t>(settings.ways, 1), 1);
+}
+
+// The ways are bounded by bytes, the entries count only limits the number of
+// tiny entries
+std::size_t GetWaySize(const Settings& settings) {
+    return std::max<std::size_t>(GetWayMaxBytes(settings) / sizeof(CachedResponse), 1);
+}
+
+std::chrono::seconds GetFreshnessLifetime(const CacheControl& cache_control, const Headers& headers) {
+    if (cache_control.no_cache || !cache_control.max_age) return std::chrono::seconds{0};
+
+    std::chrono::seconds age{0};
+    const auto age_it = headers.find(USERVER_NAMESPACE::http::headers::kAge);
+    if (age_it != headers.end()) {
+        try {
+            age = std::chrono::seconds{utils::FromString<std::int64_t>(TrimView(age_it->second))};
+        } catch (const std::exception& e) {
+            LOG_LIMITED_WARNING() << "Failed to parse Age header '" << age_it->second << "': " << e.what();
+        }
+    }
+    return std::max(*cache_control.max_age - age, std::chrono::seconds{0});
+}
+
+CacheControl GetCacheControl(const Headers& headers) {
+    const auto it = headers.find(USERVER_NAMESPACE::http::headers::kCacheControl);
+    if (it == headers.end()) return {};
+    return ParseCacheControl(it->second);
+}
+
+std::string GetETag(const Headers& headers) {
+    const auto it = headers.find(USERVER_NAMESPACE::http::headers::kETag);
+    if (it == headers.end()) return {};
+    return it->second;
+}
+
+bool IsKeyHeader(const Settings& settings, std::string_view name) {
+    const utils::StrIcaseEqual equal;
+    return std::any_of(settings.key_headers.begin(), settings.key_headers.end(), [&](const std::string& header) {
+        return equal(header, name);
+    });
+}
+
+bool HasValidators(const PluginRequest& request) {
+    return request.FindHeaderByName(USERVER_NAMESPACE::http::headers::kIfNoneMatch) ||
+           request.FindHeaderByName(USERVER_NAMESPACE::http::headers::kIfModifiedSince);
+}
+
+// Returns std::nullopt for `Vary: *`
+std::optional<std::vector<std::pair<std::string, std::optional<std::string>>>> GetVary(
+    const PluginRequest& request,
+    const Headers& headers
+) {
+    std::vector<std::pair<std::string, std::optional<std::string>>> result;
+    const auto it = headers.find(USERVER_NAMESPACE::http::headers::kVary);
+    if (it == headers.end()) return result;
+
+    for (const auto name_raw : utils::text::SplitIntoStringViewVector(it->second, ",")) {
+        const auto name = TrimView(name_raw);
+        if (name.empty()) continue;
+        if (name == "*") return std::nullopt;
+
+        auto value = request.FindHeaderByName(name);
+        result.emplace_back(std::string{name}, value ? std::optional<std::string>{*value} : std::nullopt);
+    }
+    return result;
+}
+
+bool MatchesVary(const CachedResponse& cached, const PluginRequest& request) {
+    return std::all_of(cached.vary.begin(), cached.vary.end(), [&request](const auto& header) {
+        const auto value = request.FindHeaderByName(header.first);
+        return value.has_value() == header.second.has_value() && (!value || *value == *header.second);
+    });
+}
+
+void FillResponse(const CachedResponse& cached, Response& response) {
+    response.SetStatusCode(cached.status_code);
+    response.headers() = cached.headers;
+    response.sink_string() = cached.body;
+}
+
+}  // namespace
+
+CacheControl ParseCacheControl(std::string_view header_value) {
+    CacheControl result;
+    for (const auto directive_raw : utils::text::SplitIntoStringViewVector(header_value, ",")) {
+        const auto directive = TrimView(directive_raw);
+        const utils::StrIcaseEqual equal;
+        if (equal(directive, "no-store")) {
+            result.no_store = true;
+        } else if (equal(directive, "no-cache")) {
+            result.no_cache = true;
+        } else if (equal(directive, "private")) {
+            result.is_private = true;
+        } else if (utils::text::ICaseStartsWith(directive, "max-age=")) {
+            auto value = directive.substr(std::string_view{"max-age="}.size());
+            if (!value.empty() && value.front() == '"' && value.back() == '"' && value.size() >= 2) {
+                value = value.substr(1, value.size() - 2);
+            }
+            try {
+                result.max_age = std::chrono::seconds{utils::FromString<std::int64_t>(value)};
+            } catch (const std::exception&) {
+                // RFC 9111: an invalid max-age makes the response stale
+                result.max_age = std::chrono::seconds{0};
+            }
+        }
+    }
+    return result;
+}
+
+std::size_t CachedResponse::GetSizeApproximate() const {
+    std::size_t size = sizeof(CachedResponse) + body.size() + etag.size();
+    for (const auto& [name, value] : headers) {
+        size += name.size() + value.size();
+    }
+    for (const auto& [name, value] : vary) {
+        size += name.size() + (value ? value->size() : 0);
+    }
+    return size;
+}
+
+std::size_t EstimateSize(const std::shared_ptr<const CachedResponse>& response) {
+    return sizeof(response) + (response ? response->GetSizeApproximate() : 0);
+}
+
+Plugin::Plugin(Settings settings)
+    : http::Plugin(kName), settings_(std::move(settings)), cache_(settings_.ways, GetWaySize(settings_)) {
+    cache_.SetMaxLifetime(settings_.max_lifetime);
+    cache_.SetWayMaxBytes(GetWayMaxBytes(settings_));
+}
+
+void Plugin::HookPerformRequest(PluginRequest&) {}
+
+void Plugin::HookCreateSpan(PluginRequest&) {}
+
+void Plugin::HookOnCompleted(PluginRequest&, Response&) {}
+
+std::optional<engine::Future<std::shared_ptr<Response>>> Plugin::HookLookupResponse(PluginRequest& request) {
+    auto& storage = request.GetStorageContext();
+    // Conditional requests of the caller expect 304 and are passed as is. The
+    // validator may also be left by the previous lookup of the same request.
+    if (!storage.GetOptional(kRevalidatedEntry) && HasValidators(request)) return std::nullopt;
+
+    const auto key = MakeKey(request);
+    if (!key) return std::nullopt;
+
+    const auto entry = cache_.GetOptionalNoUpdate(*key);
+    if (!entry || !MatchesVary(**entry, request)) {
+        ++misses_;
+        return std::nullopt;
+    }
+
+    const auto& cached = **entry;
+    if (utils::datetime::SteadyNow() < cached.fresh_until) {
+        ++hits_;
+        auto response = std::make_shared<Response>();
+        FillResponse(cached, *response);
+
+        engine::Promise<std::shared_ptr<Response>> promise;
+        auto future = promise.get_future();
+        promise.set_value(std::move(response));
+        return future;
+    }
+
+    if (cached.etag.empty()) {
+        ++misses_;
+        return std::nullopt;
+    }
+
+    ++revalidations_;
+    request.SetHeader(USERVER_NAMESPACE::http::headers::kIfNoneMatch, cached.etag);
+    storage.Set(kRevalidatedEntry, *entry);
+    return std::nullopt;
+}
+
+void Plugin::HookOnResponse(PluginRequest& request, Response& response) {
+    const auto key = MakeKey(request);
+    if (!key) return;
+
+    if (response.status_code() == Status::kNotModified) {
+        // 304 to the validator of the caller is returned as is
+        const auto* revalidated = request.GetStorageContext().GetOptional(kRevalidatedEntry);
+        if (revalidated) Revalidated(*key, **revalidated, response);
+    } else if (response.status_code() == Status::kOk) {
+        Store(*key, request, response);
+    }
+}
+
+void Plugin::WriteStatistics(utils::statistics::Writer& writer) const {
+    writer["hits"] = hits_;
+    writer["misses"] = misses_;
+    writer["revalidations"] = revalidations_;
+    writer["not-modified"] = not_modified_;
+    writer["stored"] = stored_;
+    writer["too-large"] = too_large_;
+    writer["not-storable"] = not_storable_;
+    writer["lru"] = cache_;
+}
+
+std::optional<std::string> Plugin::MakeKey(const PluginRequest& request) const {
+    if (request.GetHttpMethod() != "GET") return std::nullopt;
+    // Responses to authorized requests are private unless the credentials are
+    // a part of the key
+    if (request.FindHeaderByName(USERVER_NAMESPACE::http::headers::kAuthorization) &&
+        !IsKeyHeader(settings_, USERVER_NAMESPACE::http::headers::kAuthorization)) {
+        return std::nullopt;
+    }
+
+    std::string key = request.GetOriginalUrl();
+    for (const auto& header : settings_.key_headers) {
+        key += '\n';
+        key += request.FindHeaderByName(header).value_or(std::string_view{});
+    }
+    return key;
+}
+
+void Plugin::Revalidated(const std::string& key, const CachedResponse& cached, Response& response) {
+    ++not_modified_;
+
+    // The entry may have been evicted while the request was in flight, the
+    // caller still gets the response it has not asked to revalidate
+    auto refreshed = std::make_shared<CachedResponse>(cached);
+    const auto cache_control = GetCacheControl(response.headers());
+    refreshed->fresh_until = utils::datetime::SteadyNow() + GetFreshnessLifetime(cache_control, response.headers());
+    auto etag = GetETag(response.headers());
+    if (!etag.empty()) refreshed->etag = std::move(etag);
+
+    FillResponse(*refreshed, response);
+    if (cache_control.no_store || cache_control.is_private) {
+        ++not_storable_;
+        cache_.InvalidateByKey(key);
+        return;
+    }
+    cache_.Put(key, std::move(refreshed));
+}
+
+void Plugin::Store(const std::string& key, const PluginRequest& request, const Response& response) {
+    const auto cache_control = GetCacheControl(response.headers());
+    auto vary = GetVary(request, response.headers());
+    // The plugin is a shared cache, so private responses are not stored
+    if (cache_control.no_store || cache_control.is_private || !vary) {
+        ++not_storable_;
+        return;
+    }
+
+    auto cached = std::make_shared<CachedResponse>();
+    cached->vary = std::move(*vary);
+    cached->etag = GetETag(response.headers());
+    const auto freshness = GetFreshnessLifetime(cache_control, response.headers());
+    if (freshness == std::chrono::seconds{0} && cached->etag.empty()) return;
+
+    cached->status_code = response.status_code();
+    cached->headers = response.headers();
+    cached->body = response.body_view();
+    cached->fresh_until = utils::datetime::SteadyNow() + freshness;
+
+    if (cached->GetSizeApproximate() > settings_.max_entry_bytes) {
+        ++too_large_;
+        return;
+    }
+
+    ++stored_;
+    cache_.Put(key, std::move(cached));
+}
+
+}  // namespace clients::http::plugins::response_cache
+
+USERVER_NAMESPACE_END
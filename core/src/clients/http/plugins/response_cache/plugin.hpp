@@ -0,0 +1,93 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <userver/cache/expirable_lru_cache.hpp>
+#include <userver/clients/http/plugin.hpp>
+#include <userver/clients/http/response.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http::plugins::response_cache {
+
+struct Settings final {
+    std::size_t ways{16};
+    std::size_t max_memory_bytes{64 * 1024 * 1024};
+    std::size_t max_entry_bytes{1024 * 1024};
+    std::chrono::milliseconds max_lifetime{std::chrono::minutes{10}};
+    std::vector<std::string> key_headers;
+};
+
+/// Parsed `Cache-Control` response header
+struct CacheControl final {
+    bool no_store{false};
+    bool no_cache{false};
+    bool is_private{false};
+    std::optional<std::chrono::seconds> max_age;
+};
+
+CacheControl ParseCacheControl(std::string_view header_value);
+
+struct CachedResponse final {
+    Status status_code{Status::Invalid};
+    Headers headers;
+    std::string body;
+    std::string etag;
+    std::chrono::steady_clock::time_point fresh_until;
+    // Request headers listed in the `Vary` response header and their values
+    std::vector<std::pair<std::string, std::optional<std::string>>> vary;
+
+    std::size_t GetSizeApproximate() const;
+};
+
+/// Used by cache::DefaultWeigher
+std::size_t EstimateSize(const std::shared_ptr<const CachedResponse>& response);
+
+/// Caches responses to GET requests honouring Cache-Control, Vary and ETag
+class Plugin final : public http::Plugin {
+public:
+    explicit Plugin(Settings settings);
+
+    void HookPerformRequest(PluginRequest& request) override;
+
+    void HookCreateSpan(PluginRequest& request) override;
+
+    void HookOnCompleted(PluginRequest& request, Response& response) override;
+
+    std::optional<engine::Future<std::shared_ptr<Response>>> HookLookupResponse(PluginRequest& request) override;
+
+    void HookOnResponse(PluginRequest& request, Response& response) override;
+
+    void WriteStatistics(utils::statistics::Writer& writer) const;
+
+private:
+    using Cache = cache::ExpirableLruCache<std::string, std::shared_ptr<const CachedResponse>>;
+
+    std::optional<std::string> MakeKey(const PluginRequest& request) const;
+
+    void Revalidated(const std::string& key, const CachedResponse& cached, Response& response);
+
+    void Store(const std::string& key, const PluginRequest& request, const Response& response);
+
+    const Settings settings_;
+    Cache cache_;
+
+    utils::statistics::RateCounter hits_;
+    utils::statistics::RateCounter misses_;
+    utils::statistics::RateCounter revalidations_;
+    utils::statistics::RateCounter not_modified_;
+    utils::statistics::RateCounter stored_;
+    utils::statistics::RateCounter too_large_;
+    utils::statistics::RateCounter not_storable_;
+};
+
+}  // namespace clients::http::plugins::response_cache
+
+USERVER_NAMESPACE_END
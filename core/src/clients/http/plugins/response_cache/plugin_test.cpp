@@ -0,0 +1,208 @@
+#include <clients/http/plugins/response_cache/plugin.hpp>
+
+#include <atomic>
+
+#include <userver/clients/http/client.hpp>
+#include <userver/utest/http_client.hpp>
+#include <userver/utest/simple_server.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using HttpResponse = utest::SimpleServer::Response;
+using HttpRequest = utest::SimpleServer::Request;
+
+constexpr char kETag[] = "\"v1\"";
+
+struct ServerCounters {
+    std::atomic<std::size_t> requests{0};
+    std::atomic<std::size_t> not_modified{0};
+};
+
+class CachingCallback final {
+public:
+    CachingCallback(ServerCounters& counters, std::string cache_control, std::string extra_headers = {})
+        : counters_(counters), cache_control_(std::move(cache_control)), extra_headers_(std::move(extra_headers)) {}
+
+    HttpResponse operator()(const HttpRequest& request) const {
+        ++counters_.requests;
+        if (request.find(std::string{"If-None-Match: "} + kETag) != std::string::npos) {
+            ++counters_.not_modified;
+            return {
+                "HTTP/1.1 304 Not Modified\r\nConnection: close\r\nCache-Control: " + cache_control_ + "\r\n\r\n",
+                HttpResponse::kWriteAndClose,
+            };
+        }
+
+        return {
+            "HTTP/1.1 200 OK\r\nConnection: close\r\nCache-Control: " + cache_control_ + "\r\nETag: " + kETag +
+                "\r\n" + extra_headers_ + "Content-Length: 4\r\n\r\nbody",
+            HttpResponse::kWriteAndClose,
+        };
+    }
+
+private:
+    ServerCounters& counters_;
+    const std::string cache_control_;
+    const std::string extra_headers_;
+};
+
+}  // namespace
+
+TEST(HttpClientResponseCache, ParseCacheControl) {
+    using clients::http::plugins::response_cache::ParseCacheControl;
+
+    const auto parsed = ParseCacheControl("public, Max-Age=60");
+    EXPECT_FALSE(parsed.no_store);
+    EXPECT_FALSE(parsed.no_cache);
+    EXPECT_EQ(parsed.max_age, std::chrono::seconds{60});
+
+    EXPECT_TRUE(ParseCacheControl("no-store").no_store);
+    EXPECT_TRUE(ParseCacheControl("private,no-cache").no_cache);
+    EXPECT_TRUE(ParseCacheControl("private,no-cache").is_private);
+    EXPECT_EQ(ParseCacheControl("max-age=\"5\"").max_age, std::chrono::seconds{5});
+    EXPECT_EQ(ParseCacheControl("max-age=junk").max_age, std::chrono::seconds{0});
+    EXPECT_FALSE(ParseCacheControl("").max_age);
+}
+
+UTEST(HttpClientResponseCache, FreshResponseIsServedFromCache) {
+    ServerCounters counters;
+    const utest::SimpleServer http_server{CachingCallback{counters, "max-age=600"}};
+    clients::http::plugins::response_cache::Plugin plugin{{}};
+    auto http_client = utest::CreateHttpClient({plugin});
+
+    for (int i = 0; i < 3; ++i) {
+        const auto response =
+            http_client->CreateRequest().get(http_server.GetBaseUrl()).timeout(utest::kMaxTestWaitTime).perform();
+        EXPECT_EQ(response->status_code(), clients::http::Status::kOk);
+        EXPECT_EQ(response->body_view(), "body");
+    }
+    EXPECT_EQ(counters.requests.load(), 1);
+
+    const auto post_response =
+        http_client->CreateRequest().post(http_server.GetBaseUrl(), "x").timeout(utest::kMaxTestWaitTime).perform();
+    EXPECT_EQ(post_response->status_code(), clients::http::Status::kOk);
+    EXPECT_EQ(counters.requests.load(), 2);
+}
+
+UTEST(HttpClientResponseCache, StaleResponseIsRevalidated) {
+    ServerCounters counters;
+    const utest::SimpleServer http_server{CachingCallback{counters, "no-cache"}};
+    clients::http::plugins::response_cache::Plugin plugin{{}};
+    auto http_client = utest::CreateHttpClient({plugin});
+
+    for (int i = 0; i < 3; ++i) {
+        const auto response =
+            http_client->CreateRequest().get(http_server.GetBaseUrl()).timeout(utest::kMaxTestWaitTime).perform();
+        EXPECT_EQ(response->status_code(), clients::http::Status::kOk);
+        EXPECT_EQ(response->body_view(), "body");
+    }
+    EXPECT_EQ(counters.requests.load(), 3);
+    EXPECT_EQ(counters.not_modified.load(), 2);
+}
+
+UTEST(HttpClientResponseCache, NoStore) {
+    ServerCounters counters;
+    const utest::SimpleServer http_server{CachingCallback{counters, "no-store, max-age=600"}};
+    clients::http::plugins::response_cache::Plugin plugin{{}};
+    auto http_client = utest::CreateHttpClient({plugin});
+
+    for (int i = 0; i < 2; ++i) {
+        const auto response =
+            http_client->CreateRequest().get(http_server.GetBaseUrl()).timeout(utest::kMaxTestWaitTime).perform();
+        EXPECT_EQ(response->body_view(), "body");
+    }
+    EXPECT_EQ(counters.requests.load(), 2);
+    EXPECT_EQ(counters.not_modified.load(), 0);
+}
+
+UTEST(HttpClientResponseCache, PrivateIsNotStored) {
+    ServerCounters counters;
+    const utest::SimpleServer http_server{CachingCallback{counters, "private, max-age=600"}};
+    clients::http::plugins::response_cache::Plugin plugin{{}};
+    auto http_client = utest::CreateHttpClient({plugin});
+
+    for (int i = 0; i < 2; ++i) {
+        const auto response =
+            http_client->CreateRequest().get(http_server.GetBaseUrl()).timeout(utest::kMaxTestWaitTime).perform();
+        EXPECT_EQ(response->body_view(), "body");
+    }
+    EXPECT_EQ(counters.requests.load(), 2);
+}
+
+UTEST(HttpClientResponseCache, AuthorizedRequestsBypassCache) {
+    ServerCounters counters;
+    const utest::SimpleServer http_server{CachingCallback{counters, "max-age=600"}};
+    clients::http::plugins::response_cache::Plugin plugin{{}};
+    auto http_client = utest::CreateHttpClient({plugin});
+
+    for (const auto* user : {"Basic dXNlcjE6cGFzcw==", "Basic dXNlcjI6cGFzcw=="}) {
+        const auto response = http_client->CreateRequest()
+                                  .get(http_server.GetBaseUrl())
+                                  .headers({{"Authorization", user}})
+                                  .timeout(utest::kMaxTestWaitTime)
+                                  .perform();
+        EXPECT_EQ(response->body_view(), "body");
+    }
+    EXPECT_EQ(counters.requests.load(), 2);
+}
+
+UTEST(HttpClientResponseCache, Vary) {
+    ServerCounters counters;
+    const utest::SimpleServer http_server{CachingCallback{counters, "max-age=600", "Vary: X-Lang\r\n"}};
+    clients::http::plugins::response_cache::Plugin plugin{{}};
+    auto http_client = utest::CreateHttpClient({plugin});
+
+    for (const auto* lang : {"en", "en", "ru"}) {
+        const auto response = http_client->CreateRequest()
+                                  .get(http_server.GetBaseUrl())
+                                  .headers({{"X-Lang", lang}})
+                                  .timeout(utest::kMaxTestWaitTime)
+                                  .perform();
+        EXPECT_EQ(response->body_view(), "body");
+    }
+    EXPECT_EQ(counters.requests.load(), 2);
+}
+
+UTEST(HttpClientResponseCache, ConditionalRequestOfCaller) {
+    ServerCounters counters;
+    const utest::SimpleServer http_server{CachingCallback{counters, "no-cache"}};
+    clients::http::plugins::response_cache::Plugin plugin{{}};
+    auto http_client = utest::CreateHttpClient({plugin});
+
+    const auto url = http_server.GetBaseUrl();
+    EXPECT_EQ(
+        http_client->CreateRequest().get(url).timeout(utest::kMaxTestWaitTime).perform()->status_code(),
+        clients::http::Status::kOk
+    );
+
+    const auto response = http_client->CreateRequest()
+                              .get(url)
+                              .headers({{"If-None-Match", kETag}})
+                              .timeout(utest::kMaxTestWaitTime)
+                              .perform();
+    EXPECT_EQ(response->status_code(), clients::http::Status::kNotModified);
+    EXPECT_EQ(counters.not_modified.load(), 1);
+}
+
+UTEST(HttpClientResponseCache, MemoryLimitIsInBytes) {
+    ServerCounters counters;
+    const utest::SimpleServer http_server{CachingCallback{counters, "max-age=600"}};
+    clients::http::plugins::response_cache::Settings settings;
+    settings.ways = 1;
+    // smaller than any response, yet enough for many entries if it was a count
+    settings.max_memory_bytes = 64;
+    clients::http::plugins::response_cache::Plugin plugin{settings};
+    auto http_client = utest::CreateHttpClient({plugin});
+
+    for (int i = 0; i < 2; ++i) {
+        const auto response =
+            http_client->CreateRequest().get(http_server.GetBaseUrl()).timeout(utest::kMaxTestWaitTime).perform();
+        EXPECT_EQ(response->body_view(), "body");
+    }
+    EXPECT_EQ(counters.requests.load(), 2);
+}
+
+USERVER_NAMESPACE_END
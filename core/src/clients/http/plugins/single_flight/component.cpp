@@ -0,0 +1,44 @@
+#include <userver/clients/http/plugins/single_flight/component.hpp>
+
+#include <clients/http/plugins/single_flight/plugin.hpp>
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/components/statistics_storage.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http::plugins::single_flight {
+
+Component::Component(const components::ComponentConfig& config, const components::ComponentContext& context)
+    : ComponentBase(config, context),
+      plugin_(std::make_unique<single_flight::Plugin>(config["headers"].As<std::vector<std::string>>({}))) {
+    auto& storage = context.FindComponent<components::StatisticsStorage>().GetStorage();
+    statistics_holder_ = storage.RegisterWriter("httpclient.single-flight", [this](utils::statistics::Writer& writer) {
+        plugin_->WriteStatistics(writer);
+    });
+}
+
+Component::~Component() = default;
+
+http::Plugin& Component::GetPlugin() { return *plugin_; }
+
+yaml_config::Schema Component::GetStaticConfigSchema() {
+    return yaml_config::MergeSchemas<plugin::ComponentBase>(R"(
+type: object
+description: HTTP client plugin that merges identical in-flight GET requests
+additionalProperties: false
+properties:
+    headers:
+        type: array
+        description: request headers that are a part of the request identity
+        items:
+            type: string
+            description: header name
+)");
+}
+
+}  // namespace clients::http::plugins::single_flight
+
+USERVER_NAMESPACE_END
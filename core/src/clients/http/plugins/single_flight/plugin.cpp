@@ -0,0 +1,157 @@
+#include <clients/http/plugins/single_flight/plugin.hpp>
+
+#include <utility>
+
+#include <userver/clients/http/error.hpp>
+#include <userver/clients/http/response.hpp>
+#include <userver/logging/log.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http::plugins::single_flight {
+
+namespace {
+
+const std::string kName = "single-flight";
+
+// Retries and backoffs may make the leader request last longer than a single
+// attempt. If it lasts even longer, the completion hooks were most probably
+// lost and a new leader is elected.
+constexpr int kLeaderExpirationTimeoutsCount = 4;
+
+// The cancellation and the timeouts of the leader are its own, the waiters
+// with other deadlines should not fail because of them
+bool IsSharedError(const std::exception_ptr& error) {
+    try {
+        std::rethrow_exception(error);
+    } catch (const BaseException& ex) {
+        const auto kind = ex.GetErrorKind();
+        return kind == ErrorKind::kNetwork || kind == ErrorKind::kServer;
+    } catch (const std::exception&) {
+        // e.g. DNS resolution errors
+        return true;
+    } catch (...) {
+        return true;
+    }
+}
+
+void RetryLookup(std::vector<engine::Promise<std::shared_ptr<Response>>>& waiters) {
+    for (auto& waiter : waiters) {
+        waiter.set_exception(std::make_exception_ptr(LookupRetryException{}));
+    }
+}
+
+}  // namespace
+
+Plugin::Plugin(std::vector<std::string> key_headers) : http::Plugin(kName), key_headers_(std::move(key_headers)) {}
+
+void Plugin::HookPerformRequest(PluginRequest&) {}
+
+void Plugin::HookCreateSpan(PluginRequest&) {}
+
+void Plugin::HookOnCompleted(PluginRequest& request, Response& response) {
+    auto waiters = ExtractWaiters(request);
+    for (auto& waiter : waiters) {
+        // Each waiter gets its own copy, because Response is not thread safe
+        waiter.set_value(std::make_shared<Response>(response));
+    }
+}
+
+void Plugin::HookOnError(PluginRequest& request, std::exception_ptr error) {
+    auto waiters = ExtractWaiters(request);
+    if (!IsSharedError(error)) {
+        // One of the waiters becomes the new leader
+        retried_.Add(utils::statistics::Rate{waiters.size()});
+        RetryLookup(waiters);
+        return;
+    }
+
+    for (auto& waiter : waiters) {
+        waiter.set_exception(error);
+    }
+}
+
+std::optional<engine::Future<std::shared_ptr<Response>>> Plugin::HookLookupResponse(PluginRequest& request) {
+    auto key = MakeKey(request);
+    if (!key) return std::nullopt;
+
+    Waiters expired_waiters;
+    auto in_flight = in_flight_.UniqueLock();
+    auto [it, inserted] = in_flight->try_emplace(std::move(*key));
+    auto& entry = it->second;
+    // A request is never in flight twice, so if it is the leader then the
+    // completion hooks of its previous flight were lost
+    if (!inserted && (entry.expiration.IsReached() || entry.leader == request.GetRequestId())) {
+        LOG_WARNING() << "In-flight request for " << request.GetOriginalUrl()
+                      << " has not completed in time, sending a new one";
+        ++expired_leaders_;
+        // The waiters of the expired leader retry and join the new one
+        expired_waiters = std::exchange(entry.waiters, {});
+        inserted = true;
+    }
+
+    if (inserted) {
+        entry.leader = request.GetRequestId();
+        entry.expiration = engine::Deadline::FromDuration(request.GetTimeout() * kLeaderExpirationTimeoutsCount);
+        ++sent_;
+        in_flight.GetLock().unlock();
+
+        retried_.Add(utils::statistics::Rate{expired_waiters.size()});
+        RetryLookup(expired_waiters);
+        return std::nullopt;
+    }
+
+    ++coalesced_;
+    engine::Promise<std::shared_ptr<Response>> promise;
+    auto future = promise.get_future();
+    entry.waiters.push_back(std::move(promise));
+    return future;
+}
+
+void Plugin::HookOnRequestNotSent(PluginRequest& request) {
+    // One of the next plugins has provided the response of the leader, e.g.
+    // from a cache, but the waiters may not be allowed to use it
+    auto waiters = ExtractWaiters(request);
+    retried_.Add(utils::statistics::Rate{waiters.size()});
+    RetryLookup(waiters);
+}
+
+void Plugin::WriteStatistics(utils::statistics::Writer& writer) const {
+    writer["sent"] = sent_;
+    writer["coalesced"] = coalesced_;
+    writer["expired-leaders"] = expired_leaders_;
+    writer["retried"] = retried_;
+
+    const auto in_flight = in_flight_.UniqueLock();
+    writer["in-flight"] = in_flight->size();
+}
+
+std::optional<std::string> Plugin::MakeKey(const PluginRequest& request) const {
+    // Only idempotent requests without a body may be merged
+    if (request.GetHttpMethod() != "GET" || request.IsStreamed()) return std::nullopt;
+
+    std::string key = request.GetOriginalUrl();
+    for (const auto& header : key_headers_) {
+        key += '\n';
+        key += request.FindHeaderByName(header).value_or(std::string_view{});
+    }
+    return key;
+}
+
+Plugin::Waiters Plugin::ExtractWaiters(const PluginRequest& request) {
+    const auto key = MakeKey(request);
+    if (!key) return {};
+
+    auto in_flight = in_flight_.UniqueLock();
+    const auto it = in_flight->find(*key);
+    // The waiters of an expired leader were passed to the new one
+    if (it == in_flight->end() || it->second.leader != request.GetRequestId()) return {};
+
+    auto waiters = std::move(it->second.waiters);
+    in_flight->erase(it);
+    return waiters;
+}
+
+}  // namespace clients::http::plugins::single_flight
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/clients/http/plugin.hpp>
+#include <userver/concurrent/variable.hpp>
+#include <userver/engine/deadline.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http::plugins::single_flight {
+
+/// Merges identical in-flight GET requests into a single network request
+class Plugin final : public http::Plugin {
+public:
+    explicit Plugin(std::vector<std::string> key_headers);
+
+    void HookPerformRequest(PluginRequest& request) override;
+
+    void HookCreateSpan(PluginRequest& request) override;
+
+    void HookOnCompleted(PluginRequest& request, Response& response) override;
+
+    void HookOnError(PluginRequest& request, std::exception_ptr error) override;
+
+    std::optional<engine::Future<std::shared_ptr<Response>>> HookLookupResponse(PluginRequest& request) override;
+
+    void HookOnRequestNotSent(PluginRequest& request) override;
+
+    void WriteStatistics(utils::statistics::Writer& writer) const;
+
+private:
+    using Waiters = std::vector<engine::Promise<std::shared_ptr<Response>>>;
+
+    struct InFlightRequest {
+        // PluginRequest::GetRequestId() of the request that is actually sent
+        const void* leader{nullptr};
+        Waiters waiters;
+        engine::Deadline expiration;
+    };
+
+    using InFlightMap = std::unordered_map<std::string, InFlightRequest>;
+
+    std::optional<std::string> MakeKey(const PluginRequest& request) const;
+
+    Waiters ExtractWaiters(const PluginRequest& request);
+
+    const std::vector<std::string> key_headers_;
+    concurrent::Variable<InFlightMap, std::mutex> in_flight_;
+
+    utils::statistics::RateCounter sent_;
+    utils::statistics::RateCounter coalesced_;
+    utils::statistics::RateCounter expired_leaders_;
+    utils::statistics::RateCounter retried_;
+};
+
+}  // namespace clients::http::plugins::single_flight
+
+USERVER_NAMESPACE_END
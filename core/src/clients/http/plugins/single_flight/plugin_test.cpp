@@ -0,0 +1,170 @@
+#include <clients/http/plugins/single_flight/plugin.hpp>
+
+#include <atomic>
+
+#include <clients/http/plugins/response_cache/plugin.hpp>
+
+#include <userver/clients/http/client.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/http_client.hpp>
+#include <userver/utest/simple_server.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using HttpResponse = utest::SimpleServer::Response;
+using HttpRequest = utest::SimpleServer::Request;
+
+constexpr std::size_t kRequestsCount = 5;
+constexpr std::chrono::milliseconds kServerDelay{100};
+
+class CountingCallback final {
+public:
+    explicit CountingCallback(std::atomic<std::size_t>& counter) : counter_(counter) {}
+
+    HttpResponse operator()(const HttpRequest&) const {
+        ++counter_;
+        engine::InterruptibleSleepFor(kServerDelay);
+        return {
+            "HTTP/1.1 200 OK\r\nConnection: close\r\nContent-Length: 2\r\n\r\nok",
+            HttpResponse::kWriteAndClose,
+        };
+    }
+
+private:
+    std::atomic<std::size_t>& counter_;
+};
+
+class CacheableCallback final {
+public:
+    explicit CacheableCallback(std::atomic<std::size_t>& counter) : counter_(counter) {}
+
+    HttpResponse operator()(const HttpRequest&) const {
+        ++counter_;
+        return {
+            "HTTP/1.1 200 OK\r\nConnection: close\r\nCache-Control: max-age=60\r\nContent-Length: 2\r\n\r\nok",
+            HttpResponse::kWriteAndClose,
+        };
+    }
+
+private:
+    std::atomic<std::size_t>& counter_;
+};
+
+}  // namespace
+
+UTEST(HttpClientSingleFlight, MergesIdenticalRequests) {
+    std::atomic<std::size_t> server_requests{0};
+    const utest::SimpleServer http_server{CountingCallback{server_requests}};
+    clients::http::plugins::single_flight::Plugin plugin{std::vector<std::string>{}};
+    auto http_client = utest::CreateHttpClient({plugin});
+
+    std::vector<clients::http::ResponseFuture> futures;
+    for (std::size_t i = 0; i < kRequestsCount; ++i) {
+        futures.push_back(
+            http_client->CreateRequest().get(http_server.GetBaseUrl()).timeout(utest::kMaxTestWaitTime).async_perform()
+        );
+    }
+
+    for (auto& future : futures) {
+        const auto response = future.Get();
+        EXPECT_EQ(response->status_code(), clients::http::Status::OK);
+        EXPECT_EQ(response->body_view(), "ok");
+    }
+    EXPECT_EQ(server_requests.load(), 1);
+}
+
+UTEST(HttpClientSingleFlight, DifferentRequestsAreNotMerged) {
+    std::atomic<std::size_t> server_requests{0};
+    const utest::SimpleServer http_server{CountingCallback{server_requests}};
+    clients::http::plugins::single_flight::Plugin plugin{std::vector<std::string>{"X-Key"}};
+    auto http_client = utest::CreateHttpClient({plugin});
+
+    const auto url = http_server.GetBaseUrl();
+    std::vector<clients::http::ResponseFuture> futures;
+    futures.push_back(
+        http_client->CreateRequest().get(url).headers({{"X-Key", "1"}}).timeout(utest::kMaxTestWaitTime).async_perform()
+    );
+    futures.push_back(
+        http_client->CreateRequest().get(url).headers({{"X-Key", "2"}}).timeout(utest::kMaxTestWaitTime).async_perform()
+    );
+    futures.push_back(http_client->CreateRequest().post(url, "data").timeout(utest::kMaxTestWaitTime).async_perform());
+    futures.push_back(http_client->CreateRequest().post(url, "data").timeout(utest::kMaxTestWaitTime).async_perform());
+
+    for (auto& future : futures) {
+        EXPECT_EQ(future.Get()->status_code(), clients::http::Status::OK);
+    }
+    EXPECT_EQ(server_requests.load(), futures.size());
+}
+
+UTEST(HttpClientSingleFlight, WaiterDeadline) {
+    std::atomic<std::size_t> server_requests{0};
+    const utest::SimpleServer http_server{CountingCallback{server_requests}};
+    clients::http::plugins::single_flight::Plugin plugin{std::vector<std::string>{}};
+    auto http_client = utest::CreateHttpClient({plugin});
+
+    const auto url = http_server.GetBaseUrl();
+    auto leader = http_client->CreateRequest().get(url).timeout(utest::kMaxTestWaitTime).async_perform();
+    auto waiter = http_client->CreateRequest().get(url).timeout(kServerDelay / 10).async_perform();
+
+    UEXPECT_THROW(waiter.Get(), clients::http::TimeoutException);
+    EXPECT_EQ(leader.Get()->status_code(), clients::http::Status::OK);
+    EXPECT_EQ(server_requests.load(), 1);
+}
+
+UTEST(HttpClientSingleFlight, LeaderTimeoutIsNotShared) {
+    std::atomic<std::size_t> server_requests{0};
+    const utest::SimpleServer http_server{CountingCallback{server_requests}};
+    clients::http::plugins::single_flight::Plugin plugin{std::vector<std::string>{}};
+    auto http_client = utest::CreateHttpClient({plugin});
+
+    const auto url = http_server.GetBaseUrl();
+    auto leader = http_client->CreateRequest().get(url).retry(1).timeout(kServerDelay / 2).async_perform();
+    auto waiter = http_client->CreateRequest().get(url).timeout(utest::kMaxTestWaitTime).async_perform();
+
+    UEXPECT_THROW(leader.Get(), clients::http::TimeoutException);
+    EXPECT_EQ(waiter.Get()->status_code(), clients::http::Status::OK);
+    EXPECT_EQ(server_requests.load(), 2);
+}
+
+UTEST(HttpClientSingleFlight, LeaderCancellationIsNotShared) {
+    std::atomic<std::size_t> server_requests{0};
+    const utest::SimpleServer http_server{CountingCallback{server_requests}};
+    clients::http::plugins::single_flight::Plugin plugin{std::vector<std::string>{}};
+    auto http_client = utest::CreateHttpClient({plugin});
+
+    const auto url = http_server.GetBaseUrl();
+    auto leader = http_client->CreateRequest().get(url).timeout(utest::kMaxTestWaitTime).async_perform();
+    std::vector<clients::http::ResponseFuture> waiters;
+    for (std::size_t i = 0; i < kRequestsCount; ++i) {
+        waiters.push_back(http_client->CreateRequest().get(url).timeout(utest::kMaxTestWaitTime).async_perform());
+    }
+
+    leader.Cancel();
+    for (auto& waiter : waiters) {
+        EXPECT_EQ(waiter.Get()->status_code(), clients::http::Status::OK);
+    }
+    EXPECT_LE(server_requests.load(), 2);
+}
+
+UTEST(HttpClientSingleFlight, ResponseOfNextPlugin) {
+    std::atomic<std::size_t> server_requests{0};
+    const utest::SimpleServer http_server{CacheableCallback{server_requests}};
+    clients::http::plugins::single_flight::Plugin single_flight{std::vector<std::string>{}};
+    clients::http::plugins::response_cache::Plugin response_cache{{}};
+    auto http_client = utest::CreateHttpClient({single_flight, response_cache});
+
+    const auto url = http_server.GetBaseUrl();
+    for (std::size_t i = 0; i < kRequestsCount; ++i) {
+        // The cached response is returned instead of sending the leader, which
+        // must not leave the followers waiting for it
+        const auto response = http_client->CreateRequest().get(url).timeout(utest::kMaxTestWaitTime / 10).perform();
+        EXPECT_EQ(response->status_code(), clients::http::Status::OK);
+        EXPECT_EQ(response->body_view(), "ok");
+    }
+    EXPECT_EQ(server_requests.load(), 1);
+}
+
+USERVER_NAMESPACE_END
@@ -421,6 +421,7 @@ Request Request::cookies(const std::unordered_map<std::string, std::string>& coo
 }
 
 Request& Request::method(HttpMethod method) & {
+    pimpl_->SetHttpMethod(ToString(method));
     switch (method) {
         case HttpMethod::kDelete:
         case HttpMethod::kOptions:
@@ -471,6 +472,7 @@ Request& Request::set_custom_http_request_method(std::string method) & {
                              "changing of request type. Use it only if you need to make "
                              "GET-request with body.";
     pimpl_->easy().set_custom_request(method);
+    pimpl_->SetHttpMethod(std::move(method));
     return *this;
 }
 Request Request::set_custom_http_request_method(std::string method) && {
@@ -484,8 +484,10 @@ void RequestState::on_completed(std::shared_ptr<RequestState> holder, std::error
             [&holder, &err](FullBufferedData& buffered_data) {
                 { [[maybe_unused]] const auto cleanup = holder->response_move(); }
                 auto promise = std::move(buffered_data.promise_);
+                auto exception = holder->PrepareException(err);
+                holder->plugin_pipeline_.HookOnError(*holder, exception);
                 // The task will wake up and may reuse RequestState.
-                promise.set_exception(holder->PrepareException(err));
+                promise.set_exception(std::move(exception));
             },
             [](StreamData& stream_data) {
                 auto producer = std::move(stream_data.queue_producer);
@@ -628,6 +630,14 @@ void RequestState::parse_header(char* ptr, size_t size) try {
     LOG_ERROR() << "Failed to parse header: " << e.what();
 }
 
+void RequestState::SetHttpMethod(std::string method) { http_method_ = std::move(method); }
+
+std::string_view RequestState::GetHttpMethod() const {
+    if (!http_method_.empty()) return http_method_;
+    // cURL sends POST if the body is set and no method was set explicitly
+    return easy().has_post_data() ? "POST" : "GET";
+}
+
 void RequestState::SetLoggedUrl(std::string url) { log_url_ = std::move(url); }
 
 const std::string& RequestState::GetLoggedOriginalUrl() const noexcept {
@@ -642,6 +652,7 @@ std::string_view RequestState::GetLoggedEffectiveUrl() noexcept {
 }
 
 engine::Future<std::shared_ptr<Response>> RequestState::async_perform(utils::impl::SourceLocation location) {
+    perform_location_ = location;
     data_.emplace<FullBufferedData>();
 
     StartNewSpan(location);
@@ -656,6 +667,14 @@ engine::Future<std::shared_ptr<Response>> RequestState::async_perform(utils::imp
     auto future = std::get_if<FullBufferedData>(&data_)->promise_.get_future();
 
     if (UpdateTimeoutFromDeadlineAndCheck()) {
+        response_lookup_performed_ = true;
+        auto plugin_future = plugin_pipeline_.HookLookupResponse(*this);
+        if (plugin_future) {
+            span.AddTag("plugin_response", 1);
+            span_storage_.reset();
+            return std::move(*plugin_future);
+        }
+
         perform_request([holder = shared_from_this()](std::error_code err) mutable {
             RequestState::on_retry(std::move(holder), err);
         });
@@ -664,6 +683,11 @@ engine::Future<std::shared_ptr<Response>> RequestState::async_perform(utils::imp
     return future;
 }
 
+engine::Future<std::shared_ptr<Response>> RequestState::RetryLookupResponse() {
+    UASSERT(perform_location_);
+    return async_perform(*perform_location_);
+}
+
 engine::Future<void>
 RequestState::async_perform_stream(const std::shared_ptr<Queue>& queue, utils::impl::SourceLocation location) {
     data_.emplace<StreamData>(queue->GetProducer());
@@ -710,11 +734,13 @@ void RequestState::perform_request(curl::easy::handler_type handler) {
                 // TODO: should retry - TAXICOMMON-4932
                 auto* buffered_data = std::get_if<FullBufferedData>(&data_);
                 if (buffered_data) {
+                    plugin_pipeline_.HookOnError(*this, std::current_exception());
                     buffered_data->promise_.set_exception(std::current_exception());
                 }
             } catch (const BaseException& ex) {
                 auto* buffered_data = std::get_if<FullBufferedData>(&data_);
                 if (buffered_data) {
+                    plugin_pipeline_.HookOnError(*this, std::current_exception());
                     buffered_data->promise_.set_exception(std::current_exception());
                 }
             }
@@ -785,7 +811,10 @@ void RequestState::HandleDeadlineAlreadyPassed() {
     auto exc = PrepareDeadlinePassedException(GetLoggedOriginalUrl(), easy().get_local_stats());
 
     const utils::Overloaded visitor{
-        [&exc](FullBufferedData& buffered_data) {
+        [this, &exc](FullBufferedData& buffered_data) {
+            // Plugins have not seen the request if the deadline has passed
+            // before the first attempt
+            if (response_lookup_performed_) plugin_pipeline_.HookOnError(*this, exc);
             auto promise = std::move(buffered_data.promise_);
             // The task will wake up and may reuse RequestState.
             promise.set_exception(std::move(exc));
@@ -882,6 +911,8 @@ void RequestState::ResetDataForNewRequest() {
 
     response_ = std::make_shared<Response>();
     response_->SetStatusCode(Status::InternalServerError);
+    response_provider_ = nullptr;
+    response_lookup_performed_ = false;
 
     is_cancelled_ = false;
     retry_.current = 1;
@@ -1017,6 +1048,8 @@ void RequestState::SetTracingManager(const tracing::TracingManagerBase& m) { tra
 
 PluginRequest RequestState::GetEditableRequestInstance() { return PluginRequest(*this); }
 
+void RequestState::HookOnResponse(Response& response) { plugin_pipeline_.HookOnResponse(*this, response); }
+
 }  // namespace clients::http
 
 USERVER_NAMESPACE_END
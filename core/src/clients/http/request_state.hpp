@@ -6,6 +6,7 @@
 #include <optional>
 #include <string>
 #include <system_error>
+#include <variant>
 
 #include <userver/clients/dns/resolver_fwd.hpp>
 #include <userver/clients/http/config.hpp>
@@ -58,6 +59,10 @@ public:
         utils::impl::SourceLocation location = utils::impl::SourceLocation::Current()
     );
 
+    /// Perform async http request again after a plugin asked for it with
+    /// LookupRetryException
+    engine::Future<std::shared_ptr<Response>> RetryLookupResponse();
+
     /// Perform streaming http request, returns headers future
     engine::Future<void> async_perform_stream(
         const std::shared_ptr<Queue>& queue,
@@ -128,6 +133,11 @@ public:
     std::shared_ptr<Response> response() const { return response_; }
     std::shared_ptr<Response> response_move() { return std::move(response_); }
 
+    /// set HTTP method name for plugins
+    void SetHttpMethod(std::string method);
+    /// get HTTP method name
+    std::string_view GetHttpMethod() const;
+
     void SetLoggedUrl(std::string url);
     void SetEasyTimeout(std::chrono::milliseconds timeout);
 
@@ -135,6 +145,16 @@ public:
 
     PluginRequest GetEditableRequestInstance();
 
+    /// run HookOnResponse of plugins in coroutine context
+    void HookOnResponse(Response& response);
+    /// remember the plugin that provided the response without a request
+    void SetResponseProvider(const Plugin* plugin) { response_provider_ = plugin; }
+    const Plugin* GetResponseProvider() const { return response_provider_; }
+
+    bool IsStreamed() const { return std::holds_alternative<StreamData>(data_); }
+
+    utils::AnyStorage<PluginStorageContext>& GetPluginStorageContext() { return plugin_storage_context_; }
+
 private:
     /// final callback that calls user callback and set value in promise
     static void on_completed(std::shared_ptr<RequestState>, std::error_code err);
@@ -231,7 +251,12 @@ private:
 
     clients::dns::Resolver* resolver_{nullptr};
     std::string proxy_url_;
+    std::string http_method_;
     impl::PluginPipeline& plugin_pipeline_;
+    const Plugin* response_provider_{nullptr};
+    bool response_lookup_performed_{false};
+    std::optional<utils::impl::SourceLocation> perform_location_;
+    utils::AnyStorage<PluginStorageContext> plugin_storage_context_;
 
     struct StreamData {
         StreamData(Queue::Producer&& queue_producer) : queue_producer(std::move(queue_producer)) {}
@@ -3,6 +3,7 @@
 #include <algorithm>
 
 #include <clients/http/request_state.hpp>
+#include <userver/clients/http/plugin.hpp>
 #include <userver/server/request/task_inherited_data.hpp>
 #include <userver/utils/fast_scope_guard.hpp>
 
@@ -123,12 +124,21 @@ std::future_status ResponseFuture::Wait() {
 }
 
 std::shared_ptr<Response> ResponseFuture::Get() {
-    const auto future_status = Wait();
-    if (future_status == std::future_status::ready) {
+    while (Wait() == std::future_status::ready) {
         if (request_state_->IsDeadlineExpired()) {
             server::request::MarkTaskInheritedDeadlineExpired();
         }
-        auto response = future_.get();
+
+        std::shared_ptr<Response> response;
+        try {
+            response = future_.get();
+        } catch (const LookupRetryException&) {
+            // The request waits until deadline_ as before
+            future_ = request_state_->RetryLookupResponse();
+            continue;
+        }
+
+        request_state_->HookOnResponse(*response);
         Detach();
         return response;
     }
@@ -3,6 +3,7 @@
 #include <logging/dynamic_debug.hpp>
 #include <logging/dynamic_debug_config.hpp>
 #include <tracing/no_log_spans.hpp>
+#include <tracing/sampling.hpp>
 #include <userver/components/component.hpp>
 #include <userver/dynamic_config/storage/component.hpp>
 #include <userver/dynamic_config/value.hpp>
@@ -29,6 +30,17 @@ const dynamic_config::Key<tracing::NoLogSpans> kNoLogSpans{
 )"}};
 /// [key]
 
+const dynamic_config::Key<tracing::TraceSampling> kTraceSampling{
+    "USERVER_TRACE_SAMPLING",
+    dynamic_config::DefaultAsJsonString{R"(
+  {
+    "default-rate": 1.0,
+    "root-span-rates": {},
+    "keep-errors": true,
+    "keep-slower-than-ms": 0
+  }
+)"}};
+
 const dynamic_config::Key<logging::DynamicDebugConfig> kDynamicDebugConfig{
     "USERVER_LOG_DYNAMIC_DEBUG",
     dynamic_config::DefaultAsJsonString{R"(
@@ -41,19 +53,34 @@ const dynamic_config::Key<logging::DynamicDebugConfig> kDynamicDebugConfig{
 }  // namespace
 
 LoggingConfigurator::LoggingConfigurator(const ComponentConfig& config, const ComponentContext& context) {
-    logging::impl::SetLogLimitedEnable(config["limited-logging-enable"].As<bool>());
-    logging::impl::SetLogLimitedInterval(config["limited-logging-interval"].As<std::chrono::milliseconds>());
+    const auto limited_logging_enable = config["limited-logging-enable"].As<bool>();
+    const auto limited_logging_interval = config["limited-logging-interval"].As<std::chrono::milliseconds>();
+    logging::impl::SetLogLimitedEnable(limited_logging_enable);
+    logging::impl::SetLogLimitedInterval(limited_logging_interval);
 
     config_subscription_ = context.FindComponent<components::DynamicConfig>().GetSource().UpdateAndListen(
         this, kName, &LoggingConfigurator::OnConfigUpdate
     );
+
+    if (limited_logging_enable) {
+        // Reports the records dropped by the LOG_LIMITED call sites that went quiet
+        log_limited_summaries_task_.Start(
+            "log_limited_summaries",
+            utils::PeriodicTask::Settings(limited_logging_interval, {}, logging::Level::kTrace),
+            [] { logging::impl::LogLimitedSummaries(); }
+        );
+    }
 }
 
-LoggingConfigurator::~LoggingConfigurator() { config_subscription_.Unsubscribe(); }
+LoggingConfigurator::~LoggingConfigurator() {
+    log_limited_summaries_task_.Stop();
+    config_subscription_.Unsubscribe();
+}
 
 void LoggingConfigurator::OnConfigUpdate(const dynamic_config::Snapshot& config) {
     (void)this;  // silence clang-tidy
     tracing::Tracer::SetNoLogSpans(tracing::NoLogSpans{config[kNoLogSpans]});
+    tracing::Tracer::SetTraceSampling(tracing::TraceSampling{config[kTraceSampling]});
 
     try {
         const auto& dd = config[kDynamicDebugConfig];
@@ -101,7 +128,7 @@ properties:
         description: set to true to make LOG_LIMITED drop repeated logs
     limited-logging-interval:
         type: string
-        description: utils::StringToDuration suitable duration string to group repeated logs into one message
+        description: utils::StringToDuration suitable duration string to group repeated logs into one message, the count of the dropped logs is reported at the end of each interval
 )");
 }
 
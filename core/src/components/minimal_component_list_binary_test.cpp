@@ -0,0 +1,68 @@
+#include <userver/components/minimal_component_list.hpp>
+
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gmock/gmock.h>
+
+#include <userver/components/run.hpp>
+#include <userver/fs/blocking/read.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/fs/blocking/write.hpp>
+#include <userver/logging/impl/binary_format.hpp>
+#include <userver/logging/impl/mem_logger.hpp>
+
+#include <components/component_list_test.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::string_view kConfigVarsTemplate = R"(
+  logger_file_path: {0}
+)";
+
+std::string MakeBinaryLogsStaticConfig() {
+    std::string static_config{tests::kMinimalStaticConfig};
+    const std::string_view ltsv_format = "format: ltsv";
+    static_config.replace(static_config.find(ltsv_format), ltsv_format.size(), "format: binary");
+    return static_config;
+}
+
+}  // namespace
+
+TEST_F(ComponentList, MinimalBinaryLogs) {
+    const auto temp_root = fs::blocking::TempDirectory::Create();
+    const std::string config_vars_path = temp_root.GetPath() + "/config_vars.json";
+    const std::string logs_path = temp_root.GetPath() + "/log.bin";
+    const std::string static_config = MakeBinaryLogsStaticConfig() + config_vars_path + '\n';
+
+    fs::blocking::RewriteFileContents(config_vars_path, fmt::format(kConfigVarsTemplate, logs_path));
+
+    // The records that are logged before the logging is set up are kept by
+    // MemLogger as TSKV and are forwarded to the default logger on startup
+    logging::impl::SetDefaultLoggerRef(logging::impl::MemLogger::GetMemLogger());
+    LOG_INFO() << "Logged before the logging setup";
+
+    components::RunOnce(components::InMemoryConfig{static_config}, components::MinimalComponentList());
+
+    logging::LogFlush();
+
+    const auto logs = fs::blocking::ReadFileContents(logs_path);
+    EXPECT_THAT(logs, testing::Not(testing::HasSubstr("tskv\t")));
+
+    logging::impl::binary::RecordReader reader{logs};
+    std::vector<std::string> texts;
+    while (const auto record = reader.Next()) {
+        for (const auto& tag : record->tags) {
+            if (tag.key == "text") texts.emplace_back(tag.value);
+        }
+    }
+    EXPECT_EQ(reader.GetConsumedSize(), logs.size());
+    EXPECT_THAT(texts, testing::Contains("Logged before the logging setup"));
+    EXPECT_THAT(texts, testing::Contains(testing::HasSubstr("Parsed configs from")));
+}
+
+USERVER_NAMESPACE_END
@@ -56,6 +56,9 @@ public:
         return *new_node;
     }
 
+    /// Takes a free node, if any, or returns `nullptr`. Never allocates.
+    T* TryAcquire() noexcept { return free_list_.TryPop(); }
+
     /// Makes the node available for reuse by `Acquire`. Does not touch the node
     /// data.
     void Release(T& node) noexcept { free_list_.Push(node); }
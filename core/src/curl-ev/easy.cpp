@@ -230,7 +230,7 @@ void easy::reset() {
     if (proxy_headers_) proxy_headers_->clear();
     if (http200_aliases_) http200_aliases_->clear();
     if (resolved_hosts_) resolved_hosts_->clear();
-    share_.reset();
+    // curl_easy_reset() keeps the share, so should we
     retries_count_ = 0;
     sockets_opened_ = 0;
     rate_limit_error_.clear();
@@ -590,7 +590,7 @@ void easy::set_share(std::shared_ptr<share> share) {
 void easy::set_share(std::shared_ptr<share> share, std::error_code& ec) {
     share_ = std::move(share);
 
-    if (share) {
+    if (share_) {
         ec = std::error_code{static_cast<errc::EasyErrorCode>(
             native::curl_easy_setopt(handle_, native::CURLOPT_SHARE, share_->native_handle())
         )};
@@ -409,11 +409,13 @@ void Dumper::Impl::DoWriteDump(TimePoint update_time, tracing::ScopeTime& scope,
     auto writer = dump_data.rw_factory->CreateWriter(dump_path, scope);
     dump_data.dumpable.GetAndWrite(*writer);
     writer->Finish();
+    const auto uncompressed_size = writer->GetWrittenSize();
     const auto dump_size = boost::filesystem::file_size(dump_path);
 
     LOG_INFO() << Name() << ": a new dump has been written at \"" << dump_path << '"';
 
     statistics_.last_written_size = dump_size;
+    statistics_.last_uncompressed_size = uncompressed_size;
     statistics_.last_nontrivial_write_duration =
         std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - dump_start);
     statistics_.last_nontrivial_write_start_time = dump_start;
@@ -429,6 +431,7 @@ std::optional<TimePoint> Dumper::Impl::LoadFromDump(DumpData& dump_data, const D
     }
 
     const auto load_start = std::chrono::steady_clock::now();
+    std::size_t loaded_size = 0;
 
     const std::optional<TimePoint> update_time =
         utils::CriticalAsync(fs_task_processor_, read_span_name_, [&] {
@@ -441,6 +444,7 @@ std::optional<TimePoint> Dumper::Impl::LoadFromDump(DumpData& dump_data, const D
                 auto reader = dump_data.rw_factory->CreateReader(dump_stats->full_path);
                 dump_data.dumpable.ReadAndSet(*reader);
                 reader->Finish();
+                loaded_size = reader->GetReadSize();
 
                 LOG_INFO() << Name() << ": a dump has been loaded successfully";
                 return std::optional{dump_stats->update_time};
@@ -462,6 +466,7 @@ std::optional<TimePoint> Dumper::Impl::LoadFromDump(DumpData& dump_data, const D
     dump_data.dumped_update_time = update_times;
 
     statistics_.is_loaded = true;
+    statistics_.loaded_size = loaded_size;
     statistics_.load_duration =
         std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - load_start);
     return update_time;
@@ -564,6 +569,14 @@ properties:
                 type: boolean
                 description: Whether to encrypt the dump
                 defaultDescription: false
+            mmap:
+                type: boolean
+                description: Whether to map the dump into memory on read, allows dump::MappedArray to be used in place; incompatible with `encrypted`
+                defaultDescription: false
+            compressed:
+                type: boolean
+                description: Whether to compress the dump with zstd in chunks, that are compressed and decompressed in parallel on `fs-task-processor`; incompatible with `encrypted` and `mmap`
+                defaultDescription: false
 )");
 }
 
@@ -1,8 +1,10 @@
 #include <userver/dump/factory.hpp>
 
 #include <dump/secdist.hpp>
+#include <userver/dump/operations_compressed.hpp>
 #include <userver/dump/operations_encrypted.hpp>
 #include <userver/dump/operations_file.hpp>
+#include <userver/dump/operations_mmap.hpp>
 #include <userver/storages/secdist/component.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -29,6 +31,10 @@ CreateOperationsFactory(const Config& config, const components::ComponentContext
         const auto& secdist = context.FindComponent<components::Secdist>().Get();
         auto secret_key = secdist.Get<dump::Secdist>().GetSecretKey(config.name);
         return std::make_unique<dump::EncryptedOperationsFactory>(std::move(secret_key), dump_perms);
+    } else if (config.dump_is_compressed) {
+        return std::make_unique<dump::CompressedOperationsFactory>(dump_perms);
+    } else if (config.dump_is_mmapped) {
+        return std::make_unique<dump::MmapOperationsFactory>(dump_perms);
     } else {
         return std::make_unique<dump::FileOperationsFactory>(dump_perms);
     }
@@ -0,0 +1,215 @@
+#include <userver/dump/operations_compressed.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include <userver/dump/unsafe.hpp>
+#include <userver/engine/task/task_base.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+namespace {
+
+// File layout: kMagic, then chunks of
+// [compressed size: 4 bytes little-endian][zstd frame with a checksum]
+constexpr std::string_view kMagic{"udmpzst1"};
+constexpr std::size_t kChunkHeaderSize = 4;
+constexpr std::size_t kMaxChunkSize = 256 * 1024 * 1024;
+// Incompressible data grows a bit, the limit guards against corrupted headers
+constexpr std::size_t kMaxCompressedChunkSize = 2 * kMaxChunkSize;
+
+std::array<char, kChunkHeaderSize> EncodeChunkHeader(std::size_t compressed_size) {
+    std::array<char, kChunkHeaderSize> result{};
+    for (std::size_t i = 0; i < kChunkHeaderSize; ++i) {
+        result[i] = static_cast<char>((compressed_size >> (8 * i)) & 0xFF);
+    }
+    return result;
+}
+
+std::size_t DecodeChunkHeader(std::string_view header) {
+    UASSERT(header.size() == kChunkHeaderSize);
+    std::size_t result = 0;
+    for (std::size_t i = 0; i < kChunkHeaderSize; ++i) {
+        result |= std::size_t{static_cast<unsigned char>(header[i])} << (8 * i);
+    }
+    return result;
+}
+
+}  // namespace
+
+CompressedWriter::CompressedWriter(
+    std::string path,
+    boost::filesystem::perms perms,
+    tracing::ScopeTime& scope,
+    const CompressedWriterSettings& settings
+)
+    : file_(std::move(path), perms, scope), settings_(settings) {
+    UINVARIANT(
+        settings_.chunk_size != 0 && settings_.chunk_size <= kMaxChunkSize,
+        "Chunk size of a compressed dump must be positive and not greater than 256MiB"
+    );
+    UINVARIANT(settings_.max_parallel_chunks != 0, "At least one chunk must be compressed at a time");
+
+    WriteStringViewUnsafe(file_, kMagic);
+    chunk_.reserve(settings_.chunk_size);
+}
+
+CompressedWriter::~CompressedWriter() = default;
+
+void CompressedWriter::WriteRaw(std::string_view data) {
+    while (!data.empty()) {
+        const auto size = std::min(data.size(), settings_.chunk_size - chunk_.size());
+        chunk_.append(data.substr(0, size));
+        data.remove_prefix(size);
+
+        if (chunk_.size() == settings_.chunk_size) FlushChunk();
+    }
+}
+
+void CompressedWriter::FlushChunk() {
+    if (compressed_chunks_.size() >= settings_.max_parallel_chunks) WriteOldestChunk();
+
+    compressed_chunks_.push_back(utils::CriticalAsync(
+        engine::current_task::GetTaskProcessor(),
+        "dump_compress_chunk",
+        [chunk = std::move(chunk_), level = settings_.compression_level] {
+            try {
+                return compression::zstd::Compress(chunk, level);
+            } catch (const std::exception& ex) {
+                throw Error(fmt::format("Failed to compress a chunk of the dump: {}", ex.what()));
+            }
+        }
+    ));
+
+    chunk_ = std::string{};
+    chunk_.reserve(settings_.chunk_size);
+}
+
+void CompressedWriter::WriteOldestChunk() {
+    UASSERT(!compressed_chunks_.empty());
+
+    const auto compressed = compressed_chunks_.front().Get();
+    compressed_chunks_.pop_front();
+
+    const auto header = EncodeChunkHeader(compressed.size());
+    WriteStringViewUnsafe(file_, std::string_view{header.data(), header.size()});
+    WriteStringViewUnsafe(file_, compressed);
+}
+
+void CompressedWriter::Finish() {
+    if (!chunk_.empty()) FlushChunk();
+    while (!compressed_chunks_.empty()) WriteOldestChunk();
+    file_.Finish();
+}
+
+CompressedReader::CompressedReader(std::string path, std::size_t max_parallel_chunks)
+    : file_(path), path_(std::move(path)), max_parallel_chunks_(max_parallel_chunks) {
+    UINVARIANT(max_parallel_chunks_ != 0, "At least one chunk must be decompressed at a time");
+
+    if (ReadUnsafeAtMost(file_, kMagic.size()) != kMagic) {
+        throw Error(fmt::format("The dump file \"{}\" is not a compressed dump", path_));
+    }
+}
+
+CompressedReader::~CompressedReader() = default;
+
+std::string_view CompressedReader::ReadRaw(std::size_t max_size) {
+    if (chunk_.size() - chunk_position_ >= max_size) return TakeFromChunk(max_size);
+
+    // The data spans several chunks
+    buffer_.clear();
+    while (buffer_.size() < max_size) {
+        if (chunk_position_ == chunk_.size() && !NextChunk()) break;
+        buffer_.append(TakeFromChunk(max_size - buffer_.size()));
+    }
+    return buffer_;
+}
+
+std::string_view CompressedReader::TakeFromChunk(std::size_t max_size) {
+    const auto result = std::string_view{chunk_}.substr(chunk_position_, max_size);
+    chunk_position_ += result.size();
+    return result;
+}
+
+bool CompressedReader::NextChunk() {
+    ScheduleChunks();
+    if (decompressed_chunks_.empty()) return false;
+
+    chunk_ = decompressed_chunks_.front().Get();
+    decompressed_chunks_.pop_front();
+    chunk_position_ = 0;
+
+    ScheduleChunks();
+    return true;
+}
+
+void CompressedReader::ScheduleChunks() {
+    while (!file_finished_ && decompressed_chunks_.size() < max_parallel_chunks_) {
+        const auto header = ReadUnsafeAtMost(file_, kChunkHeaderSize);
+        if (header.empty()) {
+            file_finished_ = true;
+            break;
+        }
+        if (header.size() != kChunkHeaderSize) {
+            throw Error(fmt::format("Unexpected end-of-file in a chunk header of the dump file \"{}\"", path_));
+        }
+
+        const auto compressed_size = DecodeChunkHeader(header);
+        if (compressed_size > kMaxCompressedChunkSize) {
+            throw Error(
+                fmt::format("Invalid chunk size in the dump file \"{}\": compressed-size={}", path_, compressed_size)
+            );
+        }
+
+        std::string compressed{ReadStringViewUnsafe(file_, compressed_size)};
+        decompressed_chunks_.push_back(utils::CriticalAsync(
+            engine::current_task::GetTaskProcessor(),
+            "dump_decompress_chunk",
+            [&path = path_, compressed = std::move(compressed)] {
+                try {
+                    return compression::zstd::Decompress(compressed, kMaxChunkSize);
+                } catch (const std::exception& ex) {
+                    throw Error(
+                        fmt::format("Failed to decompress a chunk of the dump file \"{}\": {}", path, ex.what())
+                    );
+                }
+            }
+        ));
+    }
+}
+
+void CompressedReader::Finish() {
+    while (chunk_position_ == chunk_.size() && NextChunk()) {
+    }
+
+    if (chunk_position_ != chunk_.size()) {
+        throw Error(fmt::format(
+            "Unexpected extra data at the end of the dump file \"{}\": unread-size-in-chunk={}",
+            path_,
+            chunk_.size() - chunk_position_
+        ));
+    }
+    file_.Finish();
+}
+
+CompressedOperationsFactory::CompressedOperationsFactory(boost::filesystem::perms perms) : perms_(perms) {}
+
+std::unique_ptr<Reader> CompressedOperationsFactory::CreateReader(std::string full_path) {
+    return std::make_unique<CompressedReader>(std::move(full_path));
+}
+
+std::unique_ptr<Writer> CompressedOperationsFactory::CreateWriter(std::string full_path, tracing::ScopeTime& scope) {
+    return std::make_unique<CompressedWriter>(std::move(full_path), perms_, scope);
+}
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,141 @@
+#include <userver/dump/operations_compressed.hpp>
+
+#include <string>
+#include <vector>
+
+#include <userver/dump/common_containers.hpp>
+#include <userver/dump/unsafe.hpp>
+#include <userver/fs/blocking/read.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/fs/blocking/write.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::string DumpFilePath(const fs::blocking::TempDirectory& dir) { return dir.GetPath() + "/dump"; }
+
+constexpr dump::CompressedWriterSettings kSmallChunks{/*chunk_size=*/100, /*max_parallel_chunks=*/3};
+
+void WriteSample(const std::string& path, const dump::CompressedWriterSettings& settings) {
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    dump::CompressedWriter writer(path, boost::filesystem::perms::owner_read, scope_time, settings);
+    for (std::size_t i = 0; i < 1000; ++i) {
+        writer.Write(std::string(i % 300, static_cast<char>('a' + i % 26)));
+    }
+    writer.Write(std::vector<int>(10'000, 42));
+    writer.Finish();
+}
+
+void ReadSample(const std::string& path) {
+    dump::CompressedReader reader(path, /*max_parallel_chunks=*/2);
+    for (std::size_t i = 0; i < 1000; ++i) {
+        ASSERT_EQ(reader.Read<std::string>(), std::string(i % 300, static_cast<char>('a' + i % 26)));
+    }
+    EXPECT_EQ(reader.Read<std::vector<int>>(), std::vector<int>(10'000, 42));
+    reader.Finish();
+}
+
+}  // namespace
+
+UTEST_MT(DumpOperationsCompressed, WriteRead, 4) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = DumpFilePath(dir);
+
+    WriteSample(path, kSmallChunks);
+    ReadSample(path);
+}
+
+UTEST(DumpOperationsCompressed, DefaultSettings) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = DumpFilePath(dir);
+
+    WriteSample(path, {});
+    ReadSample(path);
+}
+
+UTEST(DumpOperationsCompressed, Compresses) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = DumpFilePath(dir);
+
+    const std::string data(1'000'000, 'a');
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    dump::CompressedWriter writer(path, boost::filesystem::perms::owner_read, scope_time);
+    WriteStringViewUnsafe(writer, data);
+    writer.Finish();
+
+    EXPECT_EQ(writer.GetWrittenSize(), data.size());
+    EXPECT_LT(fs::blocking::ReadFileContents(path).size(), data.size() / 100);
+
+    dump::CompressedReader reader(path);
+    EXPECT_EQ(ReadStringViewUnsafe(reader, data.size()), data);
+    reader.Finish();
+    EXPECT_EQ(reader.GetReadSize(), data.size());
+}
+
+UTEST(DumpOperationsCompressed, EmptyDump) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = DumpFilePath(dir);
+
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    dump::CompressedWriter writer(path, boost::filesystem::perms::owner_read, scope_time);
+    writer.Finish();
+
+    dump::CompressedReader reader(path);
+    EXPECT_EQ(ReadStringViewUnsafe(reader, 0), "");
+    reader.Finish();
+}
+
+UTEST(DumpOperationsCompressed, Overread) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = DumpFilePath(dir);
+
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    dump::CompressedWriter writer(path, boost::filesystem::perms::owner_read, scope_time, kSmallChunks);
+    WriteStringViewUnsafe(writer, std::string(250, 'a'));
+    writer.Finish();
+
+    dump::CompressedReader reader(path);
+    EXPECT_EQ(ReadUnsafeAtMost(reader, 1000), std::string(250, 'a'));
+    UEXPECT_THROW(ReadStringViewUnsafe(reader, 1), dump::Error);
+}
+
+UTEST(DumpOperationsCompressed, Underread) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = DumpFilePath(dir);
+
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    dump::CompressedWriter writer(path, boost::filesystem::perms::owner_read, scope_time, kSmallChunks);
+    WriteStringViewUnsafe(writer, std::string(250, 'a'));
+    writer.Finish();
+
+    dump::CompressedReader reader(path);
+    EXPECT_EQ(ReadStringViewUnsafe(reader, 150), std::string(150, 'a'));
+    UEXPECT_THROW(reader.Finish(), dump::Error);
+}
+
+UTEST(DumpOperationsCompressed, Corrupted) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = DumpFilePath(dir);
+
+    WriteSample(path, kSmallChunks);
+
+    auto contents = fs::blocking::ReadFileContents(path);
+    contents[contents.size() / 2] ^= 1;
+    const auto corrupted_path = path + "-corrupted";
+    fs::blocking::RewriteFileContents(corrupted_path, contents);
+
+    UEXPECT_THROW(ReadSample(corrupted_path), dump::Error);
+}
+
+UTEST(DumpOperationsCompressed, NotCompressed) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = DumpFilePath(dir);
+    fs::blocking::RewriteFileContents(path, "plain dump contents");
+
+    UEXPECT_THROW(dump::CompressedReader{path}, dump::Error);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,115 @@
+#include <userver/dump/operations_mmap.hpp>
+
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include <userver/dump/operations_file.hpp>
+#include <userver/fs/blocking/file_descriptor.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <utils/check_syscall.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+class MmapFileReader::Mapping final {
+public:
+    explicit Mapping(const std::string& path) {
+        auto fd = fs::blocking::FileDescriptor::Open(path, fs::blocking::OpenFlag::kRead);
+        size_ = fd.GetSize();
+        // mmap does not support empty mappings
+        if (size_ == 0) return;
+
+        // The mapping stays valid after the file is closed or removed.
+        // Dump files are never modified after they are written.
+        data_ = utils::CheckSyscallNotEquals(
+            ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd.GetNative(), 0), MAP_FAILED, "mmap('{}')", path
+        );
+    }
+
+    Mapping(Mapping&&) = delete;
+    Mapping& operator=(Mapping&&) = delete;
+
+    ~Mapping() {
+        if (data_) {
+            [[maybe_unused]] const auto result = ::munmap(data_, size_);
+            UASSERT(result == 0);
+        }
+    }
+
+    std::string_view GetData() const noexcept { return {static_cast<const char*>(data_), size_}; }
+
+private:
+    void* data_{nullptr};
+    std::size_t size_{0};
+};
+
+MmapFileReader::MmapFileReader(std::string path) : path_(std::move(path)) {
+    try {
+        mapping_ = std::make_shared<const Mapping>(path_);
+    } catch (const std::exception& ex) {
+        throw Error(fmt::format("Failed to map the dump file for reading \"{}\". Reason: {}", path_, ex.what()));
+    }
+}
+
+MmapFileReader::~MmapFileReader() = default;
+
+std::string_view MmapFileReader::ReadRaw(std::size_t max_size) {
+    const auto data = mapping_->GetData();
+    const auto result = data.substr(position_, std::min(max_size, data.size() - position_));
+    position_ += result.size();
+    return result;
+}
+
+std::optional<MappedData> MmapFileReader::ReadMapped(std::size_t size) {
+    const auto data = mapping_->GetData();
+    if (data.size() - position_ < size) {
+        throw Error(fmt::format(
+            "Unexpected end-of-file while trying to read from the dump file \"{}\": "
+            "requested-size={}, unread-size={}",
+            path_,
+            size,
+            data.size() - position_
+        ));
+    }
+
+    MappedData result{data.substr(position_, size), mapping_};
+    position_ += size;
+    return result;
+}
+
+void MmapFileReader::Finish() {
+    const auto file_size = mapping_->GetData().size();
+    if (position_ != file_size) {
+        throw Error(fmt::format(
+            "Unexpected extra data at the end of the dump file \"{}\": "
+            "file-size={}, position={}, unread-size={}",
+            path_,
+            file_size,
+            position_,
+            file_size - position_
+        ));
+    }
+
+    // The mapping is kept alive by the data returned from ReadMapped, if any
+    mapping_.reset();
+}
+
+MmapOperationsFactory::MmapOperationsFactory(boost::filesystem::perms perms) : perms_(perms) {}
+
+std::unique_ptr<Reader> MmapOperationsFactory::CreateReader(std::string full_path) {
+    return std::make_unique<MmapFileReader>(std::move(full_path));
+}
+
+std::unique_ptr<Writer> MmapOperationsFactory::CreateWriter(std::string full_path, tracing::ScopeTime& scope) {
+    return std::make_unique<FileWriter>(std::move(full_path), perms_, scope);
+}
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
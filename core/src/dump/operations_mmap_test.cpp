@@ -0,0 +1,165 @@
+#include <userver/dump/operations_mmap.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include <boost/regex.hpp>
+
+#include <userver/dump/common_containers.hpp>
+#include <userver/dump/mapped_array.hpp>
+#include <userver/dump/operations_file.hpp>
+#include <userver/dump/test_helpers.hpp>
+#include <userver/dump/unsafe.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/fs/blocking/temp_file.hpp>
+#include <userver/fs/blocking/write.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::string DumpFilePath(const fs::blocking::TempDirectory& dir) { return dir.GetPath() + "/dump"; }
+
+struct Point final {
+    std::int32_t x;
+    std::int64_t y;
+};
+
+std::vector<Point> MakePoints(std::size_t count) {
+    std::vector<Point> result;
+    for (std::size_t i = 0; i < count; ++i) {
+        result.push_back({static_cast<std::int32_t>(i), static_cast<std::int64_t>(i * i)});
+    }
+    return result;
+}
+
+void ExpectPoints(const dump::MappedArray<Point>& points, std::size_t count) {
+    ASSERT_EQ(points.size(), count);
+    for (std::size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(points[i].x, static_cast<std::int32_t>(i));
+        EXPECT_EQ(points[i].y, static_cast<std::int64_t>(i * i));
+    }
+}
+
+}  // namespace
+
+UTEST(DumpOperationsMmap, WriteReadRaw) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = DumpFilePath(dir);
+
+    constexpr std::size_t kMaxLength = 10;
+
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    dump::FileWriter writer(path, boost::filesystem::perms::owner_read, scope_time);
+    for (std::size_t i = 0; i <= kMaxLength; ++i) {
+        WriteStringViewUnsafe(writer, std::string(i, 'a'));
+    }
+    writer.Finish();
+
+    dump::MmapFileReader reader(path);
+    for (std::size_t i = 0; i <= kMaxLength; ++i) {
+        EXPECT_EQ(ReadStringViewUnsafe(reader, i), std::string(i, 'a'));
+    }
+    reader.Finish();
+}
+
+UTEST(DumpOperationsMmap, EmptyDump) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = DumpFilePath(dir);
+
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    dump::FileWriter writer(path, boost::filesystem::perms::owner_read, scope_time);
+    writer.Finish();
+
+    dump::MmapFileReader reader(path);
+    EXPECT_EQ(ReadStringViewUnsafe(reader, 0), "");
+    reader.Finish();
+}
+
+UTEST(DumpOperationsMmap, MappedArrayInPlace) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = DumpFilePath(dir);
+
+    constexpr std::size_t kCount = 1000;
+
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    dump::FileWriter writer(path, boost::filesystem::perms::owner_read, scope_time);
+    // Misaligns the array that follows
+    writer.Write(std::string{"abc"});
+    writer.Write(dump::MappedArray<Point>{MakePoints(kCount)});
+    writer.Write(std::vector<int>{1, 2, 3});
+    writer.Finish();
+
+    dump::MappedArray<Point> points;
+    {
+        dump::MmapFileReader reader(path);
+        EXPECT_EQ(reader.Read<std::string>(), "abc");
+        points = reader.Read<dump::MappedArray<Point>>();
+        EXPECT_EQ(reader.Read<std::vector<int>>(), (std::vector<int>{1, 2, 3}));
+        reader.Finish();
+    }
+
+    // The array is used in place and outlives the reader
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(points.data()) % alignof(Point), 0);
+    ExpectPoints(points, kCount);
+
+    // The same dump can be read by the regular reader
+    dump::FileReader reader(path);
+    EXPECT_EQ(reader.Read<std::string>(), "abc");
+    ExpectPoints(reader.Read<dump::MappedArray<Point>>(), kCount);
+    EXPECT_EQ(reader.Read<std::vector<int>>(), (std::vector<int>{1, 2, 3}));
+    reader.Finish();
+}
+
+TEST(DumpOperationsMmap, MappedArrayWriteRead) {
+    ExpectPoints(dump::FromBinary<dump::MappedArray<Point>>(dump::ToBinary(dump::MappedArray<Point>{})), 0);
+    ExpectPoints(dump::FromBinary<dump::MappedArray<Point>>(dump::ToBinary(dump::MappedArray{MakePoints(10)})), 10);
+}
+
+TEST(DumpOperationsMmap, MappedArrayLayoutMismatch) {
+    const auto data = dump::ToBinary(dump::MappedArray<std::int32_t>{std::vector<std::int32_t>{1, 2, 3}});
+    EXPECT_THROW(dump::FromBinary<dump::MappedArray<std::int64_t>>(data), dump::Error);
+    // Same layout
+    EXPECT_EQ(dump::FromBinary<dump::MappedArray<std::uint32_t>>(data).size(), 3);
+}
+
+TEST(DumpOperationsMmap, Overread) {
+    const auto file = fs::blocking::TempFile::Create();
+    fs::blocking::RewriteFileContents(file.GetPath(), std::string(10, 'a'));
+
+    dump::MmapFileReader reader(file.GetPath());
+    try {
+        ReadStringViewUnsafe(reader, 11);
+    } catch (const dump::Error& ex) {
+        EXPECT_EQ(
+            std::string{ex.what()},
+            "Unexpected end-of-file while trying to read from the dump file: "
+            "requested-size=11"
+        );
+        return;
+    }
+    FAIL();
+}
+
+TEST(DumpOperationsMmap, Underread) {
+    const auto file = fs::blocking::TempFile::Create();
+    fs::blocking::RewriteFileContents(file.GetPath(), std::string(10, 'a'));
+
+    dump::MmapFileReader reader(file.GetPath());
+    EXPECT_EQ(ReadStringViewUnsafe(reader, 9), std::string(9, 'a'));
+    try {
+        reader.Finish();
+    } catch (const dump::Error& ex) {
+        EXPECT_TRUE(boost::regex_match(
+            ex.what(),
+            boost::regex{"Unexpected extra data at the end of the dump file "
+                         "\".+\": file-size=10, position=9, unread-size=1"}
+        )) << ex.what();
+        return;
+    }
+    FAIL();
+}
+
+USERVER_NAMESPACE_END
@@ -1,16 +1,30 @@
 #include <dump/statistics.hpp>
 
+#include <algorithm>
+
 #include <userver/formats/json/value_builder.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace dump {
 
+namespace {
+
+std::size_t GetKbPerSecond(std::size_t size, std::chrono::milliseconds duration) {
+    // Sub-millisecond operations are accounted as lasting 1ms
+    const auto ms = std::max(duration.count(), std::chrono::milliseconds::rep{1});
+    return size * 1000 / 1024 / static_cast<std::size_t>(ms);
+}
+
+}  // namespace
+
 void DumpMetric(utils::statistics::Writer& writer, const Statistics& stats) {
     const bool is_loaded = stats.is_loaded;
     writer["is-loaded-from-dump"] = is_loaded ? 1 : 0;
     if (is_loaded) {
-        writer["load-duration-ms"] = stats.load_duration.load().count();
+        const auto load_duration = stats.load_duration.load();
+        writer["load-duration-ms"] = load_duration.count();
+        writer["load-throughput-kb-per-second"] = GetKbPerSecond(stats.loaded_size.load(), load_duration);
     }
     writer["is-current-from-dump"] = stats.is_current_from_dump.load() ? 1 : 0;
 
@@ -22,8 +36,14 @@ void DumpMetric(utils::statistics::Writer& writer, const Statistics& stats) {
                 std::chrono::steady_clock::now() - stats.last_nontrivial_write_start_time.load()
             )
                 .count();
-        write["duration-ms"] = stats.last_nontrivial_write_duration.load().count();
-        write["size-kb"] = stats.last_written_size.load() / 1024;
+        const auto duration = stats.last_nontrivial_write_duration.load();
+        const auto size = stats.last_written_size.load();
+        const auto uncompressed_size = stats.last_uncompressed_size.load();
+        write["duration-ms"] = duration.count();
+        write["size-kb"] = size / 1024;
+        write["uncompressed-size-kb"] = uncompressed_size / 1024;
+        write["compression-ratio"] = size == 0 ? 1.0 : static_cast<double>(uncompressed_size) / size;
+        write["throughput-kb-per-second"] = GetKbPerSecond(uncompressed_size, duration);
     }
 }
 
@@ -1,5 +1,7 @@
 #include <userver/dump/unsafe.hpp>
 
+#include <array>
+
 #include <fmt/format.h>
 
 #include <userver/dump/common.hpp>
@@ -9,7 +11,26 @@ USERVER_NAMESPACE_BEGIN
 
 namespace dump {
 
-void WriteStringViewUnsafe(Writer& writer, std::string_view value) { writer.WriteRaw(value); }
+namespace {
+
+constexpr std::size_t kMaxPaddingAlignment = 256;
+
+std::size_t GetPaddingSize(std::size_t position, std::size_t alignment) {
+    UINVARIANT(
+        alignment != 0 && alignment <= kMaxPaddingAlignment && (alignment & (alignment - 1)) == 0,
+        "Padding alignment must be a power of 2 not greater than 256"
+    );
+    return (alignment - position % alignment) % alignment;
+}
+
+}  // namespace
+
+std::optional<MappedData> Reader::ReadMapped(std::size_t /*size*/) { return std::nullopt; }
+
+void WriteStringViewUnsafe(Writer& writer, std::string_view value) {
+    writer.WriteRaw(value);
+    writer.written_size_ += value.size();
+}
 
 std::string_view ReadStringViewUnsafe(Reader& reader) {
     const auto size = reader.Read<std::size_t>();
@@ -33,6 +54,36 @@ std::string_view ReadStringViewUnsafe(Reader& reader, std::size_t size) {
 std::string_view ReadUnsafeAtMost(Reader& reader, std::size_t max_size) {
     const auto result = reader.ReadRaw(max_size);
     UASSERT(result.size() <= max_size);
+    reader.read_size_ += result.size();
+    return result;
+}
+
+void WritePaddingUnsafe(Writer& writer, std::size_t alignment) {
+    static constexpr std::array<char, kMaxPaddingAlignment> kZeros{};
+    const auto padding_size = GetPaddingSize(writer.written_size_, alignment);
+    WriteStringViewUnsafe(writer, std::string_view{kZeros.data(), padding_size});
+}
+
+void SkipPaddingUnsafe(Reader& reader, std::size_t alignment) {
+    const auto padding_size = GetPaddingSize(reader.read_size_, alignment);
+    const auto padding = ReadStringViewUnsafe(reader, padding_size);
+    if (padding.find_first_not_of('\0') != std::string_view::npos) {
+        throw Error("Unexpected non-zero padding in the dump");
+    }
+}
+
+std::optional<MappedData> ReadMappedUnsafe(Reader& reader, std::size_t size) {
+    auto result = reader.ReadMapped(size);
+    if (!result) return std::nullopt;
+
+    if (result->data.size() != size) {
+        throw Error(fmt::format(
+            "Unexpected end-of-file while trying to read from the dump "
+            "file: requested-size={}",
+            size
+        ));
+    }
+    reader.read_size_ += size;
     return result;
 }
 
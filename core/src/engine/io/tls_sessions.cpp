@@ -0,0 +1,244 @@
+#include <userver/engine/io/tls_sessions.hpp>
+
+#include <cstring>
+
+#include <openssl/rand.h>
+#if OPENSSL_VERSION_NUMBER >= 0x030000000L
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+#endif
+
+#include <userver/crypto/openssl.hpp>
+#include <userver/engine/io/exception.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+#include <crypto/helpers.hpp>
+#include <engine/io/tls_sessions_impl.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::io {
+
+namespace {
+
+// Any constant works, it only has to be set for resumption of the sessions
+// with verified client certificates
+constexpr std::string_view kSessionIdContext = "userver";
+
+template <std::size_t N>
+void FillRandom(std::array<unsigned char, N>& data) {
+    if (1 != RAND_bytes(data.data(), data.size())) {
+        throw TlsException(crypto::FormatSslError("Failed to generate TLS session ticket key: RAND_bytes"));
+    }
+}
+
+}  // namespace
+
+void DumpMetric(utils::statistics::Writer& writer, const TlsHandshakeStats& stats) {
+    writer["full"] = stats.full;
+    writer["resumed"] = stats.resumed;
+}
+
+TlsSessionCache::Impl::Impl(std::size_t max_size) : sessions_(max_size) {}
+
+void TlsSessionCache::Impl::SetUp(SSL_CTX* ctx) {
+    UASSERT(ctx);
+    // Sessions are stored by the callback only, the internal cache of the
+    // context is useless as the context is not shared between connections
+    SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_sess_set_new_cb(ctx, &NewSessionCallback);
+}
+
+void TlsSessionCache::Impl::Attach(SSL* ssl, Binding& binding) {
+    UASSERT(ssl);
+    UASSERT(&binding.cache == this);
+    SSL_set_app_data(ssl, &binding);
+
+    SslSession session;
+    {
+        auto sessions = sessions_.Lock();
+        auto* stored = sessions->Get(binding.destination);
+        if (!stored) return;
+        SSL_SESSION_up_ref(stored->get());
+        session.reset(stored->get());
+    }
+
+    if (1 != SSL_set_session(ssl, session.get())) {
+        throw TlsException(crypto::FormatSslError("Failed to set up client TLS wrapper: SSL_set_session"));
+    }
+}
+
+void TlsSessionCache::Impl::Store(const std::string& destination, SslSession session) {
+    UASSERT(session);
+    auto sessions = sessions_.Lock();
+    sessions->Put(destination, std::move(session));
+}
+
+void TlsSessionCache::Impl::Clear() {
+    auto sessions = sessions_.Lock();
+    sessions->Clear();
+}
+
+std::size_t TlsSessionCache::Impl::GetSize() const {
+    auto sessions = sessions_.Lock();
+    return sessions->GetSize();
+}
+
+int TlsSessionCache::Impl::NewSessionCallback(SSL* ssl, SSL_SESSION* session) noexcept {
+    auto* binding = static_cast<Binding*>(SSL_get_app_data(ssl));
+    if (!binding) return 0;
+
+    try {
+        binding->cache.Store(binding->destination, SslSession{session});
+    } catch (const std::exception&) {
+        // Session was freed by SslSession, the ownership was still taken
+    }
+    return 1;  // we took the ownership of the session
+}
+
+TlsSessionCache::TlsSessionCache(std::size_t max_size) : impl_(std::make_unique<Impl>(max_size)) {}
+
+TlsSessionCache::~TlsSessionCache() = default;
+
+void TlsSessionCache::Clear() { impl_->Clear(); }
+
+std::size_t TlsSessionCache::GetSize() const { return impl_->GetSize(); }
+
+const TlsHandshakeStats& TlsSessionCache::GetStats() const noexcept { return impl_->stats; }
+
+TlsSessionCache::Impl& TlsSessionCache::GetImpl() noexcept { return *impl_; }
+
+TlsTicketKeys::Impl::Impl() : keys_(Keys{MakeKey(), std::nullopt}) {}
+
+void TlsTicketKeys::Impl::Rotate() {
+    auto keys = keys_.StartWrite();
+    keys->previous = keys->current;
+    keys->current = MakeKey();
+    keys.Commit();
+}
+
+void TlsTicketKeys::Impl::SetUp(SSL_CTX* ctx) {
+    UASSERT(ctx);
+    SSL_CTX_set_app_data(ctx, this);
+    SSL_CTX_clear_options(ctx, SSL_OP_NO_TICKET);
+    if (1 != SSL_CTX_set_session_id_context(
+                 ctx, reinterpret_cast<const unsigned char*>(kSessionIdContext.data()), kSessionIdContext.size()
+             )) {
+        throw TlsException(crypto::FormatSslError("Failed to set up server TLS wrapper: SSL_CTX_set_session_id_context"
+        ));
+    }
+
+#if OPENSSL_VERSION_NUMBER >= 0x030000000L
+    const auto ret = SSL_CTX_set_tlsext_ticket_key_evp_cb(ctx, &TicketKeyCallback);
+#else
+    // cast in openssl macro expansion
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+    const auto ret = SSL_CTX_set_tlsext_ticket_key_cb(ctx, &TicketKeyCallback);
+#endif
+    if (1 != ret) {
+        throw TlsException(crypto::FormatSslError("Failed to set up server TLS wrapper: ticket key callback"));
+    }
+}
+
+TlsTicketKeys::Impl::Key TlsTicketKeys::Impl::MakeKey() {
+    crypto::Openssl::Init();
+
+    Key key;
+    FillRandom(key.name);
+    FillRandom(key.hmac_key);
+    FillRandom(key.aes_key);
+    return key;
+}
+
+#if OPENSSL_VERSION_NUMBER >= 0x030000000L
+int TlsTicketKeys::Impl::TicketKeyCallback(
+    SSL* ssl,
+    unsigned char* key_name,
+    unsigned char* iv,
+    EVP_CIPHER_CTX* cipher_ctx,
+    EVP_MAC_CTX* mac_ctx,
+    int enc
+) noexcept {
+    const auto* self = static_cast<const Impl*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
+    UASSERT(self);
+    return self->HandleTicket(key_name, iv, cipher_ctx, enc, [mac_ctx](const Key& key) {
+        // NOLINTBEGIN(cppcoreguidelines-pro-type-const-cast)
+        const OSSL_PARAM params[] = {
+            OSSL_PARAM_construct_octet_string(
+                OSSL_MAC_PARAM_KEY, const_cast<unsigned char*>(key.hmac_key.data()), key.hmac_key.size()
+            ),
+            OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, const_cast<char*>("SHA256"), 0),
+            OSSL_PARAM_construct_end(),
+        };
+        // NOLINTEND(cppcoreguidelines-pro-type-const-cast)
+        return 1 == EVP_MAC_CTX_set_params(mac_ctx, params);
+    });
+}
+#else
+int TlsTicketKeys::Impl::TicketKeyCallback(
+    SSL* ssl,
+    unsigned char* key_name,
+    unsigned char* iv,
+    EVP_CIPHER_CTX* cipher_ctx,
+    HMAC_CTX* hmac_ctx,
+    int enc
+) noexcept {
+    const auto* self = static_cast<const Impl*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
+    UASSERT(self);
+    return self->HandleTicket(key_name, iv, cipher_ctx, enc, [hmac_ctx](const Key& key) {
+        return 1 == HMAC_Init_ex(hmac_ctx, key.hmac_key.data(), key.hmac_key.size(), EVP_sha256(), nullptr);
+    });
+}
+#endif
+
+template <typename MacInit>
+int TlsTicketKeys::Impl::HandleTicket(
+    unsigned char* key_name,
+    unsigned char* iv,
+    EVP_CIPHER_CTX* cipher_ctx,
+    int enc,
+    MacInit mac_init
+) const noexcept {
+    // Return values are documented in SSL_CTX_set_tlsext_ticket_key_cb(3):
+    // -1 is an error, 0 means "no ticket", 1 is success and 2 is success
+    // with a request to renew the ticket
+    const auto keys = keys_.Read();
+
+    if (enc) {
+        const auto& key = keys->current;
+        if (1 != RAND_bytes(iv, EVP_CIPHER_iv_length(EVP_aes_256_cbc()))) return -1;
+        std::memcpy(key_name, key.name.data(), key.name.size());
+        if (1 != EVP_EncryptInit_ex(cipher_ctx, EVP_aes_256_cbc(), nullptr, key.aes_key.data(), iv)) return -1;
+        if (!mac_init(key)) return -1;
+        return 1;
+    }
+
+    const auto matches = [key_name](const Key& key) {
+        return std::memcmp(key_name, key.name.data(), key.name.size()) == 0;
+    };
+    const Key* key = nullptr;
+    if (matches(keys->current)) {
+        key = &keys->current;
+    } else if (keys->previous && matches(*keys->previous)) {
+        key = &*keys->previous;
+    } else {
+        return 0;  // the key was rotated out, fall back to the full handshake
+    }
+
+    if (!mac_init(*key)) return -1;
+    if (1 != EVP_DecryptInit_ex(cipher_ctx, EVP_aes_256_cbc(), nullptr, key->aes_key.data(), iv)) return -1;
+    return key == &keys->current ? 1 : 2;
+}
+
+TlsTicketKeys::TlsTicketKeys() : impl_(std::make_unique<Impl>()) {}
+
+TlsTicketKeys::~TlsTicketKeys() = default;
+
+void TlsTicketKeys::Rotate() { impl_->Rotate(); }
+
+TlsTicketKeys::Impl& TlsTicketKeys::GetImpl() noexcept { return *impl_; }
+
+}  // namespace engine::io
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/ssl.h>
+
+#include <userver/cache/lru_map.hpp>
+#include <userver/concurrent/variable.hpp>
+#include <userver/engine/io/tls_sessions.hpp>
+#include <userver/rcu/rcu.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::io {
+
+struct SslSessionDeleter {
+    void operator()(SSL_SESSION* session) const noexcept { SSL_SESSION_free(session); }
+};
+using SslSession = std::unique_ptr<SSL_SESSION, SslSessionDeleter>;
+
+class TlsSessionCache::Impl final {
+public:
+    /// Data of a single client connection, must outlive its SSL object
+    struct Binding {
+        Impl& cache;
+        std::string destination;
+    };
+
+    explicit Impl(std::size_t max_size);
+
+    /// Makes the clients of the context report new sessions to the cache
+    static void SetUp(SSL_CTX* ctx);
+
+    /// Offers the stored session for the handshake and subscribes to the
+    /// sessions that the server issues
+    void Attach(SSL* ssl, Binding& binding);
+
+    void Store(const std::string& destination, SslSession session);
+
+    void Clear();
+
+    std::size_t GetSize() const;
+
+    TlsHandshakeStats stats;
+
+private:
+    static int NewSessionCallback(SSL* ssl, SSL_SESSION* session) noexcept;
+
+    mutable concurrent::Variable<cache::LruMap<std::string, SslSession>, std::mutex> sessions_;
+};
+
+class TlsTicketKeys::Impl final {
+public:
+    Impl();
+
+    void Rotate();
+
+    /// Makes the servers of the context encrypt session tickets with the keys
+    void SetUp(SSL_CTX* ctx);
+
+private:
+    struct Key {
+        std::array<unsigned char, 16> name{};
+        std::array<unsigned char, 32> hmac_key{};
+        std::array<unsigned char, 32> aes_key{};
+    };
+
+    struct Keys {
+        Key current;
+        std::optional<Key> previous;
+    };
+
+    static Key MakeKey();
+
+#if OPENSSL_VERSION_NUMBER >= 0x030000000L
+    static int TicketKeyCallback(
+        SSL* ssl,
+        unsigned char* key_name,
+        unsigned char* iv,
+        EVP_CIPHER_CTX* cipher_ctx,
+        EVP_MAC_CTX* mac_ctx,
+        int enc
+    ) noexcept;
+#else
+    static int TicketKeyCallback(
+        SSL* ssl,
+        unsigned char* key_name,
+        unsigned char* iv,
+        EVP_CIPHER_CTX* cipher_ctx,
+        HMAC_CTX* hmac_ctx,
+        int enc
+    ) noexcept;
+#endif
+
+    template <typename MacInit>
+    int HandleTicket(unsigned char* key_name, unsigned char* iv, EVP_CIPHER_CTX* cipher_ctx, int enc, MacInit mac_init)
+        const noexcept;
+
+    rcu::Variable<Keys> keys_;
+};
+
+}  // namespace engine::io
+
+USERVER_NAMESPACE_END
@@ -15,6 +15,7 @@
 
 #include <crypto/helpers.hpp>
 #include <engine/io/fd_control.hpp>
+#include <engine/io/tls_sessions_impl.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -276,6 +277,7 @@ public:
 
     Impl(Impl&& other) noexcept
         : bio_data(std::move(other.bio_data)),
+          session_cache_binding(std::move(other.session_cache_binding)),
           ssl(std::move(other.ssl)),
           read_accessor(*this),
           is_in_shutdown(other.is_in_shutdown) {
@@ -329,6 +331,24 @@ public:
         }
     }
 
+    void AttachSessionCache(TlsSessionCache::Impl& cache, const std::string& server_name) {
+        UASSERT(ssl);
+        // Sessions are bound to the peer address too, so that the name of a
+        // balancer does not mix the sessions of the hosts behind it
+        session_cache_binding = std::make_unique<TlsSessionCache::Impl::Binding>(TlsSessionCache::Impl::Binding{
+            cache, fmt::format("{}@{}", server_name, bio_data.socket.Getpeername())});
+        cache.Attach(ssl.get(), *session_cache_binding);
+    }
+
+    void AccountHandshake(TlsHandshakeStats& stats) const {
+        UASSERT(ssl);
+        if (SSL_session_reused(ssl.get())) {
+            ++stats.resumed;
+        } else {
+            ++stats.full;
+        }
+    }
+
     template <typename SslIoFunc>
     size_t PerformSslIo(
         SslIoFunc&& io_func,
@@ -410,6 +430,8 @@ public:
     }
 
     SocketBioData bio_data;
+    // Referenced from the SSL object, so it has to outlive it
+    std::unique_ptr<TlsSessionCache::Impl::Binding> session_cache_binding;
     Ssl ssl;
     ReadContextAccessor read_accessor;
     bool is_in_shutdown{false};
@@ -463,6 +485,25 @@ TlsWrapper TlsWrapper::StartTlsClient(Socket&& socket, const std::string& server
     return wrapper;
 }
 
+TlsWrapper TlsWrapper::StartTlsClient(
+    Socket&& socket,
+    const std::string& server_name,
+    TlsSessionCache& session_cache,
+    Deadline deadline
+) {
+    auto& cache_impl = session_cache.GetImpl();
+    auto ssl_ctx = MakeSslCtx();
+    SetServerName(ssl_ctx, server_name);
+    cache_impl.SetUp(ssl_ctx.get());
+
+    TlsWrapper wrapper{std::move(socket)};
+    wrapper.impl_->SetUp(std::move(ssl_ctx));
+    wrapper.impl_->AttachSessionCache(cache_impl, server_name);
+    wrapper.impl_->ClientConnect(server_name, deadline);
+    wrapper.impl_->AccountHandshake(cache_impl.stats);
+    return wrapper;
+}
+
 TlsWrapper TlsWrapper::StartTlsClient(
     Socket&& socket,
     const std::string& server_name,
@@ -502,8 +543,33 @@ TlsWrapper TlsWrapper::StartTlsServer(
     const crypto::PrivateKey& key,
     Deadline deadline,
     const std::vector<crypto::Certificate>& extra_cert_authorities
+) {
+    return DoStartTlsServer(std::move(socket), cert, key, nullptr, deadline, extra_cert_authorities);
+}
+
+TlsWrapper TlsWrapper::StartTlsServer(
+    Socket&& socket,
+    const crypto::Certificate& cert,
+    const crypto::PrivateKey& key,
+    TlsTicketKeys& ticket_keys,
+    Deadline deadline,
+    const std::vector<crypto::Certificate>& extra_cert_authorities
+) {
+    return DoStartTlsServer(std::move(socket), cert, key, &ticket_keys.GetImpl(), deadline, extra_cert_authorities);
+}
+
+TlsWrapper TlsWrapper::DoStartTlsServer(
+    Socket&& socket,
+    const crypto::Certificate& cert,
+    const crypto::PrivateKey& key,
+    TlsTicketKeys::Impl* ticket_keys,
+    Deadline deadline,
+    const std::vector<crypto::Certificate>& extra_cert_authorities
 ) {
     auto ssl_ctx = MakeSslCtx();
+    if (ticket_keys) {
+        ticket_keys->SetUp(ssl_ctx.get());
+    }
 
     if (!extra_cert_authorities.empty()) {
         AddCertAuthorities(ssl_ctx, extra_cert_authorities);
@@ -561,6 +627,8 @@ void TlsWrapper::SetupContextAccessors() {
 
 bool TlsWrapper::IsValid() const { return impl_->ssl && !impl_->is_in_shutdown; }
 
+bool TlsWrapper::IsSessionReused() const { return impl_->ssl && SSL_session_reused(impl_->ssl.get()); }
+
 bool TlsWrapper::WaitReadable(Deadline deadline) {
     impl_->CheckAlive();
     char buf = 0;
@@ -3,12 +3,14 @@
 #include <openssl/opensslv.h>
 #include <sys/socket.h>
 
+#include <algorithm>
 #include <stdexcept>
 #include <string_view>
 #include <vector>
 
 #include <userver/engine/async.hpp>
 #include <userver/engine/io/socket.hpp>
+#include <userver/engine/io/tls_sessions.hpp>
 #include <userver/engine/io/tls_wrapper.hpp>
 #include <userver/engine/run_standalone.hpp>
 #include <userver/engine/single_consumer_event.hpp>
@@ -175,4 +177,53 @@ BENCHMARK(tls_write_all_buffered)->RangeMultiplier(2)->Range(1 << 6, 1 << 12)->U
 
 BENCHMARK(tls_write_all_default)->RangeMultiplier(2)->Range(1 << 6, 1 << 12)->Unit(benchmark::kNanosecond);
 
+[[maybe_unused]] void tls_handshake(benchmark::State& state) {
+    const bool resume = state.range(0);
+
+    engine::RunStandalone(2, [&]() {
+        const auto deadline = Deadline::FromDuration(kDeadlineMaxTime);
+        const auto server_cert = crypto::Certificate::LoadFromString(cert);
+        const auto server_key = crypto::PrivateKey::LoadFromString(key);
+
+        TcpListener tcp_listener;
+        io::TlsTicketKeys ticket_keys;
+        io::TlsSessionCache session_cache;
+
+        for ([[maybe_unused]] auto _ : state) {
+            if (!resume) {
+                state.PauseTiming();
+                session_cache.Clear();
+                state.ResumeTiming();
+            }
+
+            auto [server, client] = tcp_listener.MakeSocketPair(deadline);
+            auto server_task = engine::AsyncNoSpan(
+                [&](auto&& server) {
+                    auto tls_server = io::TlsWrapper::StartTlsServer(
+                        std::forward<decltype(server)>(server), server_cert, server_key, ticket_keys, deadline
+                    );
+                    const auto sent_bytes = tls_server.SendAll("1", 1, deadline);
+                    benchmark::DoNotOptimize(sent_bytes);
+                },
+                std::move(server)
+            );
+
+            auto tls_client = io::TlsWrapper::StartTlsClient(std::move(client), {}, session_cache, deadline);
+            // receives the session ticket too
+            char c = 0;
+            const auto received_bytes = tls_client.RecvSome(&c, 1, deadline);
+            benchmark::DoNotOptimize(received_bytes);
+            server_task.Get();
+        }
+
+        const auto& stats = session_cache.GetStats();
+        state.counters["resumed_ratio"] = benchmark::Counter(
+            static_cast<double>(stats.resumed.Load().value) /
+            static_cast<double>(std::max<std::uint64_t>(stats.full.Load().value + stats.resumed.Load().value, 1))
+        );
+    });
+}
+
+BENCHMARK(tls_handshake)->Arg(0)->Arg(1)->ArgName("resume")->Unit(benchmark::kMicrosecond);
+
 USERVER_NAMESPACE_END
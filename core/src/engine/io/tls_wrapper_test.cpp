@@ -9,6 +9,7 @@
 
 #include <userver/engine/async.hpp>
 #include <userver/engine/io/socket.hpp>
+#include <userver/engine/io/tls_sessions.hpp>
 #include <userver/engine/io/tls_wrapper.hpp>
 #include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/sleep.hpp>
@@ -714,4 +715,95 @@ UTEST(TlsWrapper, PeerDisconnect) {
     server_task.Get();
 }
 
+namespace {
+
+// Returns whether the client resumed the session
+bool ExchangeWithTickets(
+    TcpListener& tcp_listener,
+    io::TlsTicketKeys& ticket_keys,
+    io::TlsSessionCache& session_cache
+) {
+    const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+    auto [server, client] = tcp_listener.MakeSocketPair(test_deadline);
+
+    auto server_task = engine::AsyncNoSpan(
+        [test_deadline, &ticket_keys](auto&& server) {
+            auto tls_server = io::TlsWrapper::StartTlsServer(
+                std::forward<decltype(server)>(server),
+                crypto::Certificate::LoadFromString(cert),
+                crypto::PrivateKey::LoadFromString(key),
+                ticket_keys,
+                test_deadline
+            );
+            EXPECT_EQ(1, tls_server.SendAll("1", 1, test_deadline));
+            char c = 0;
+            EXPECT_EQ(1, tls_server.RecvSome(&c, 1, test_deadline));
+            return tls_server.IsSessionReused();
+        },
+        std::move(server)
+    );
+
+    auto tls_client = io::TlsWrapper::StartTlsClient(std::move(client), {}, session_cache, test_deadline);
+    char c = 0;
+    // TLS 1.3 tickets arrive after the handshake and are processed on read
+    EXPECT_EQ(1, tls_client.RecvSome(&c, 1, test_deadline));
+    EXPECT_EQ(1, tls_client.SendAll("2", 1, test_deadline));
+
+    const bool server_reused = server_task.Get();
+    EXPECT_EQ(server_reused, tls_client.IsSessionReused());
+    return tls_client.IsSessionReused();
+}
+
+}  // namespace
+
+UTEST_MT(TlsWrapper, SessionResumption, 2) {
+    io::TlsTicketKeys ticket_keys;
+    io::TlsSessionCache session_cache;
+    // sessions are cached per destination
+    TcpListener tcp_listener;
+
+    EXPECT_FALSE(ExchangeWithTickets(tcp_listener, ticket_keys, session_cache));
+    EXPECT_EQ(session_cache.GetSize(), 1);
+    EXPECT_TRUE(ExchangeWithTickets(tcp_listener, ticket_keys, session_cache));
+    EXPECT_TRUE(ExchangeWithTickets(tcp_listener, ticket_keys, session_cache));
+
+    EXPECT_EQ(session_cache.GetStats().full.Load().value, 1);
+    EXPECT_EQ(session_cache.GetStats().resumed.Load().value, 2);
+}
+
+UTEST_MT(TlsWrapper, SessionResumptionKeyRotation, 2) {
+    io::TlsTicketKeys ticket_keys;
+    io::TlsSessionCache session_cache;
+    // sessions are cached per destination
+    TcpListener tcp_listener;
+
+    EXPECT_FALSE(ExchangeWithTickets(tcp_listener, ticket_keys, session_cache));
+
+    // Tickets of the previous key are still accepted and renewed
+    ticket_keys.Rotate();
+    EXPECT_TRUE(ExchangeWithTickets(tcp_listener, ticket_keys, session_cache));
+    ticket_keys.Rotate();
+    EXPECT_TRUE(ExchangeWithTickets(tcp_listener, ticket_keys, session_cache));
+
+    // Tickets of the dropped key are not
+    ticket_keys.Rotate();
+    ticket_keys.Rotate();
+    EXPECT_FALSE(ExchangeWithTickets(tcp_listener, ticket_keys, session_cache));
+}
+
+UTEST_MT(TlsWrapper, SessionResumptionOtherKeys, 2) {
+    io::TlsTicketKeys ticket_keys;
+    io::TlsTicketKeys other_ticket_keys;
+    io::TlsSessionCache session_cache;
+    // sessions are cached per destination
+    TcpListener tcp_listener;
+
+    EXPECT_FALSE(ExchangeWithTickets(tcp_listener, ticket_keys, session_cache));
+    EXPECT_FALSE(ExchangeWithTickets(tcp_listener, other_ticket_keys, session_cache));
+
+    session_cache.Clear();
+    EXPECT_FALSE(ExchangeWithTickets(tcp_listener, other_ticket_keys, session_cache));
+}
+
 USERVER_NAMESPACE_END
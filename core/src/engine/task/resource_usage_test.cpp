@@ -0,0 +1,81 @@
+#include <userver/engine/task/resource_usage.hpp>
+
+#include <chrono>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr auto kBusyTime = 20ms;
+
+void BusyWait(std::chrono::milliseconds duration) {
+    const auto deadline = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < deadline) {
+    }
+}
+
+std::chrono::nanoseconds GetCpuTime() {
+    const auto usage = engine::current_task::GetResourceUsage();
+    EXPECT_TRUE(usage);
+    return usage ? usage->cpu_time : std::chrono::nanoseconds{0};
+}
+
+}  // namespace
+
+UTEST(TaskResourceUsage, DisabledByDefault) {
+    EXPECT_FALSE(engine::current_task::GetResourceUsage());
+    EXPECT_FALSE(engine::AsyncNoSpan([] { return engine::current_task::GetResourceUsage(); }).Get());
+}
+
+UTEST(TaskResourceUsage, CpuTime) {
+    engine::current_task::EnableResourceAccounting();
+    const auto started = GetCpuTime();
+
+    BusyWait(kBusyTime);
+    const auto after_busy = GetCpuTime();
+    // The thread might have been preempted by the OS
+    EXPECT_GT(after_busy - started, kBusyTime / 4);
+
+    engine::SleepFor(kBusyTime * 5);
+    EXPECT_LT(GetCpuTime() - after_busy, kBusyTime * 5);
+}
+
+UTEST(TaskResourceUsage, AccumulatedAcrossContextSwitches) {
+    engine::current_task::EnableResourceAccounting();
+    const auto started = GetCpuTime();
+
+    for (int i = 0; i < 4; ++i) {
+        BusyWait(kBusyTime / 4);
+        engine::Yield();
+    }
+    EXPECT_GT(GetCpuTime() - started, kBusyTime / 4);
+}
+
+UTEST_MT(TaskResourceUsage, SubtasksAreNotAccounted, 2) {
+    engine::current_task::EnableResourceAccounting();
+    const auto started = GetCpuTime();
+
+    engine::AsyncNoSpan([] {
+        EXPECT_FALSE(engine::current_task::GetResourceUsage());
+        BusyWait(kBusyTime * 5);
+    }).Get();
+
+    EXPECT_LT(GetCpuTime() - started, kBusyTime * 5);
+}
+
+UTEST(TaskResourceUsage, EnableTwice) {
+    engine::current_task::EnableResourceAccounting();
+    BusyWait(kBusyTime);
+    const auto before = GetCpuTime();
+
+    engine::current_task::EnableResourceAccounting();
+    EXPECT_GE(GetCpuTime(), before);
+}
+
+USERVER_NAMESPACE_END
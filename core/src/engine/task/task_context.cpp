@@ -1,5 +1,6 @@
 #include "task_context.hpp"
 
+#include <ctime>
 #include <exception>
 #include <utility>
 
@@ -26,6 +27,7 @@
 #include <engine/task/coro_unwinder.hpp>
 #include <engine/task/cxxabi_eh_globals.hpp>
 #include <engine/task/task_processor.hpp>
+#include <utils/jemalloc.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -65,6 +67,10 @@ impl::TaskContext* GetCurrentTaskContextUnchecked() noexcept {
     return *current_task_context;
 }
 
+void EnableResourceAccounting() noexcept { GetCurrentTaskContext().EnableResourceAccounting(); }
+
+std::optional<TaskResourceUsage> GetResourceUsage() noexcept { return GetCurrentTaskContext().GetResourceUsage(); }
+
 }  // namespace current_task
 
 namespace impl {
@@ -75,6 +81,17 @@ namespace {
 
 auto ReadableTaskId(const TaskContext* task) noexcept { return logging::HexShort(task ? task->GetTaskId() : 0); }
 
+TaskResourceUsage GetThreadResourceUsage() noexcept {
+    TaskResourceUsage result;
+
+    struct timespec cpu_time {};
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_time) == 0) {
+        result.cpu_time = std::chrono::seconds{cpu_time.tv_sec} + std::chrono::nanoseconds{cpu_time.tv_nsec};
+    }
+    result.allocated_bytes = utils::jemalloc::GetThreadAllocatedBytes();
+    return result;
+}
+
 class CurrentTaskScope final {
 public:
     explicit CurrentTaskScope(TaskContext& context, EhGlobals& eh_store) : eh_store_(eh_store) {
@@ -202,7 +219,15 @@ void TaskContext::DoStep() {
             SetState(Task::State::kRunning);
             auto& coro_ref = *coro_;
             TsanAcquireBarrier();
+            if (is_resource_accounting_enabled_) step_started_usage_ = GetThreadResourceUsage();
             coro_ref(this);
+            // May be enabled during the step, EnableResourceAccounting() sets step_started_usage_
+            if (is_resource_accounting_enabled_) {
+                const auto step_finished_usage = GetThreadResourceUsage();
+                resource_usage_.cpu_time += step_finished_usage.cpu_time - step_started_usage_.cpu_time;
+                resource_usage_.allocated_bytes +=
+                    step_finished_usage.allocated_bytes - step_started_usage_.allocated_bytes;
+            }
         } catch (...) {
             uncaught = std::current_exception();
         }
@@ -276,6 +301,25 @@ void TaskContext::SetBackground(bool is_background) {
     is_background_ = is_background;
 }
 
+void TaskContext::EnableResourceAccounting() noexcept {
+    UASSERT(IsCurrent());
+    if (is_resource_accounting_enabled_) return;
+    is_resource_accounting_enabled_ = true;
+    step_started_usage_ = GetThreadResourceUsage();
+}
+
+std::optional<TaskResourceUsage> TaskContext::GetResourceUsage() const noexcept {
+    UASSERT(IsCurrent());
+    if (!is_resource_accounting_enabled_) return std::nullopt;
+
+    // The current step is not finished yet, account its progress
+    const auto now_usage = GetThreadResourceUsage();
+    auto result = resource_usage_;
+    result.cpu_time += now_usage.cpu_time - step_started_usage_.cpu_time;
+    result.allocated_bytes += now_usage.allocated_bytes - step_started_usage_.allocated_bytes;
+    return result;
+}
+
 TaskContext::WakeupSource TaskContext::Sleep(WaitStrategy& wait_strategy, Deadline deadline) {
     UASSERT(IsCurrent());
     UASSERT(state_ == Task::State::kRunning);
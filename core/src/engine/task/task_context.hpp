@@ -3,6 +3,7 @@
 #include <atomic>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include <ev.h>
@@ -22,6 +23,7 @@
 #include <userver/engine/impl/task_local_storage.hpp>
 #include <userver/engine/impl/wait_list_fwd.hpp>
 #include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/resource_usage.hpp>
 #include <userver/engine/task/task.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/utils/flags.hpp>
@@ -134,6 +136,10 @@ public:
     void SetBackground(bool);
     bool IsBackground() const noexcept { return is_background_; };
 
+    // must only be called from this context
+    void EnableResourceAccounting() noexcept;
+    std::optional<TaskResourceUsage> GetResourceUsage() const noexcept;
+
     // causes this to yield and wait for wakeup
     // must only be called from this context
     // "spurious wakeups" may be caused by wakeup queueing
@@ -210,6 +216,7 @@ private:
     bool is_cancellable_{true};
     bool is_background_{false};
     bool within_sleep_{false};
+    bool is_resource_accounting_enabled_{false};
     EhGlobals eh_globals_;
 
     utils::impl::WrappedCallBase* payload_;
@@ -229,6 +236,11 @@ private:
 
     std::size_t trace_csw_left_;
 
+    // accumulated over the finished steps, only if resource accounting is enabled
+    TaskResourceUsage resource_usage_{};
+    // thread counters at the start of the current step
+    TaskResourceUsage step_started_usage_{};
+
     AtomicSleepState sleep_state_{SleepState{SleepFlags::kSleeping, SleepState::Epoch{0}}};
     WakeupSource wakeup_source_{WakeupSource::kNone};
 
@@ -5,6 +5,7 @@
 
 #include <logging/config.hpp>
 #include <logging/impl/tcp_socket_sink.hpp>
+#include <logging/request_log_buffer.hpp>
 #include <logging/tp_logger.hpp>
 #include <logging/tp_logger_utils.hpp>
 #include <userver/alerts/component.hpp>
@@ -230,6 +231,7 @@ void Logging::WriteStatistics(utils::statistics::Writer& writer) const {
     for (const auto& [name, logger] : loggers_) {
         writer.ValueWithLabels(logger->GetStatistics(), {"logger", logger->GetLoggerName()});
     }
+    writer["request-log-buffers"] = logging::impl::GetRequestLogBufferStatistics();
 }
 
 void Logging::FlushLogs() {
@@ -272,6 +274,7 @@ properties:
                       - tskv
                       - ltsv
                       - raw
+                      - binary
                 flush_level:
                     type: string
                     description: messages of this and higher levels get flushed to the file immediately
@@ -287,6 +290,22 @@ properties:
                     enum:
                       - discard
                       - block
+                batch_max_bytes:
+                    type: integer
+                    description: the records are written to the sinks in batches of up to this size
+                    defaultDescription: 65536
+                batch_max_delay:
+                    type: string
+                    description: time to wait for a batch of records to accumulate after the queue was empty, e.g. '5ms'
+                    defaultDescription: 0ms
+                rate_limit_bytes_per_second:
+                    type: integer
+                    description: limits the bytes of the records written by the logger, the records over the limit are dropped before formatting; 0 disables the limit
+                    defaultDescription: 0
+                rate_limit_burst_bytes:
+                    type: integer
+                    description: how many bytes the logger may write at once over the rate_limit_bytes_per_second limit
+                    defaultDescription: rate_limit_bytes_per_second
                 fs-task-processor:
                     type: string
                     description: task processor for disk I/O operations for this logger
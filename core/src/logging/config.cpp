@@ -44,6 +44,16 @@ LoggerConfig Parse(const yaml_config::YamlConfig& value, formats::parse::To<Logg
     config.queue_overflow_behavior =
         value["overflow_behavior"].As<QueueOverflowBehavior>(config.queue_overflow_behavior);
 
+    config.batch_max_bytes = value["batch_max_bytes"].As<size_t>(config.batch_max_bytes);
+
+    config.batch_max_delay = value["batch_max_delay"].As<std::chrono::milliseconds>(config.batch_max_delay);
+
+    config.rate_limit_bytes_per_second =
+        value["rate_limit_bytes_per_second"].As<size_t>(config.rate_limit_bytes_per_second);
+
+    config.rate_limit_burst_bytes =
+        value["rate_limit_burst_bytes"].As<size_t>(config.rate_limit_bytes_per_second);
+
     config.fs_task_processor = value["fs-task-processor"].As<std::optional<std::string>>();
 
     config.testsuite_capture = value["testsuite-capture"].As<std::optional<TestsuiteCaptureConfig>>();
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+#include <optional>
 #include <string>
 #include <unordered_map>
 
@@ -24,6 +26,7 @@ QueueOverflowBehavior Parse(const yaml_config::YamlConfig& value, formats::parse
 
 struct LoggerConfig final {
     static constexpr size_t kDefaultMessageQueueSize = 1 << 16;
+    static constexpr size_t kDefaultBatchMaxBytes = 1 << 16;
 
     void SetName(std::string name);
 
@@ -38,6 +41,13 @@ struct LoggerConfig final {
     size_t message_queue_size = kDefaultMessageQueueSize;
     QueueOverflowBehavior queue_overflow_behavior = QueueOverflowBehavior::kDiscard;
 
+    size_t batch_max_bytes = kDefaultBatchMaxBytes;
+    std::chrono::milliseconds batch_max_delay{0};
+
+    // zero disables the limit
+    size_t rate_limit_bytes_per_second{0};
+    size_t rate_limit_burst_bytes{0};
+
     std::optional<std::string> fs_task_processor;
 
     std::optional<TestsuiteCaptureConfig> testsuite_capture;
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <atomic>
+#include <string_view>
+#include <vector>
 
 #include <logging/impl/reopen_mode.hpp>
 #include <userver/logging/level.hpp>
+#include <userver/utils/span.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -22,6 +25,10 @@ public:
 
     void Log(const LogMessage& message);
 
+    /// Writes the messages that pass the level check in order, the sinks may
+    /// write the whole batch at once
+    void LogBatch(utils::span<const LogMessage> messages);
+
     virtual void Flush();
 
     virtual void Reopen(ReopenMode);
@@ -35,8 +42,13 @@ protected:
 
     virtual void Write(std::string_view log) = 0;
 
+    /// Writes the records one by one by default
+    virtual void WriteBatch(utils::span<const std::string_view> logs);
+
 private:
     std::atomic<Level> level_{Level::kTrace};
+    // Reused between the batches, sinks are written from a single thread
+    std::vector<std::string_view> batch_;
 };
 
 }  // namespace logging::impl
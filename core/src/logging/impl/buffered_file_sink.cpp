@@ -1,11 +1,21 @@
 #include "buffered_file_sink.hpp"
 
+#include <cstdio>
+
 #include "open_file_helper.hpp"
+#include "vectored_write.hpp"
 
 USERVER_NAMESPACE_BEGIN
 
 namespace logging::impl {
 
+namespace {
+
+// Smaller batches are cheaper to copy into the stdio buffer
+constexpr std::size_t kMinDirectWriteBytes = BUFSIZ;
+
+}  // namespace
+
 BufferedFileSink::BufferedFileSink(const std::string& filename)
     : filename_{filename}, file_(OpenFile<fs::blocking::CFile>(filename)) {
     if (file_.GetSize() > 0) {
@@ -24,6 +34,24 @@ BufferedFileSink::~BufferedFileSink() = default;
 
 void BufferedFileSink::Write(std::string_view log) { file_.Write(log); }
 
+void BufferedFileSink::WriteBatch(utils::span<const std::string_view> logs) {
+    std::size_t batch_bytes = 0;
+    for (const auto log : logs) {
+        batch_bytes += log.size();
+    }
+
+    if (batch_bytes < kMinDirectWriteBytes) {
+        for (const auto log : logs) {
+            file_.Write(log);
+        }
+        return;
+    }
+
+    // The buffered data goes first to keep the order of the records
+    file_.FlushLight();
+    WriteVectored(::fileno(file_.GetNative()), logs);
+}
+
 void BufferedFileSink::Flush() {
     if (file_.IsOpen()) {
         file_.FlushLight();
@@ -25,6 +25,8 @@ protected:
 
     void Write(std::string_view log) final;
 
+    void WriteBatch(utils::span<const std::string_view> logs) final;
+
     fs::blocking::CFile& GetFile();
 
 private:
@@ -0,0 +1,51 @@
+#include <logging/impl/byte_budget.hpp>
+
+#include <algorithm>
+#include <cstdint>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+namespace {
+
+using Refill = std::atomic<ByteBudget::Clock::duration>;
+static_assert(Refill::is_always_lock_free);
+
+std::size_t ValidateRate(std::size_t bytes_per_second) {
+    UINVARIANT(bytes_per_second != 0, "Log byte budget rate must be positive");
+    return bytes_per_second;
+}
+
+}  // namespace
+
+ByteBudget::ByteBudget(std::size_t bytes_per_second, std::size_t burst_bytes)
+    : bytes_per_second_(ValidateRate(bytes_per_second)), burst_refill_time_(GetRefillTime(burst_bytes)) {}
+
+bool ByteBudget::HasBudget(Clock::time_point now) const noexcept {
+    // The bucket is not empty while it is refilled in less than the time of
+    // a full refill
+    return refilled_at_.load(std::memory_order_relaxed) - now.time_since_epoch() < burst_refill_time_;
+}
+
+void ByteBudget::Spend(std::size_t bytes, Clock::time_point now) noexcept {
+    const auto refill_time = GetRefillTime(bytes);
+    auto refilled_at = refilled_at_.load(std::memory_order_relaxed);
+    while (!refilled_at_.compare_exchange_weak(
+        refilled_at, std::max(refilled_at, now.time_since_epoch()) + refill_time, std::memory_order_relaxed
+    )) {
+    }
+}
+
+ByteBudget::Clock::duration ByteBudget::GetRefillTime(std::size_t bytes) const noexcept {
+    using Nanoseconds = std::chrono::duration<std::int64_t, std::nano>;
+    return std::chrono::duration_cast<Clock::duration>(
+        Nanoseconds{static_cast<std::int64_t>(bytes * std::uint64_t{1'000'000'000} / bytes_per_second_)}
+    );
+}
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
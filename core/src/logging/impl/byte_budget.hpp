@@ -0,0 +1,42 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+/// @brief Lock-free token bucket of the bytes written by a logger.
+///
+/// The size of a record is not known until it is formatted, so the budget is
+/// checked before formatting and spent after it. A large record may put the
+/// budget into debt, which delays the following records.
+class ByteBudget final {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// @param bytes_per_second refill rate, must be positive
+    /// @param burst_bytes the size of the bucket
+    ByteBudget(std::size_t bytes_per_second, std::size_t burst_bytes);
+
+    ByteBudget(const ByteBudget&) = delete;
+    ByteBudget& operator=(const ByteBudget&) = delete;
+
+    bool HasBudget(Clock::time_point now) const noexcept;
+
+    void Spend(std::size_t bytes, Clock::time_point now) noexcept;
+
+private:
+    Clock::duration GetRefillTime(std::size_t bytes) const noexcept;
+
+    const std::size_t bytes_per_second_;
+    const Clock::duration burst_refill_time_;
+    // The time at which the bucket becomes full again, since the clock epoch
+    std::atomic<Clock::duration> refilled_at_{Clock::duration::zero()};
+};
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
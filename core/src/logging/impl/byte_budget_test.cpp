@@ -0,0 +1,47 @@
+#include <logging/impl/byte_budget.hpp>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using logging::impl::ByteBudget;
+using namespace std::chrono_literals;
+
+const ByteBudget::Clock::time_point kStart = ByteBudget::Clock::now();
+
+}  // namespace
+
+TEST(LogByteBudget, Burst) {
+    ByteBudget budget{100, 1000};
+    EXPECT_TRUE(budget.HasBudget(kStart));
+
+    budget.Spend(600, kStart);
+    EXPECT_TRUE(budget.HasBudget(kStart));
+
+    budget.Spend(600, kStart);
+    EXPECT_FALSE(budget.HasBudget(kStart));
+}
+
+TEST(LogByteBudget, Refill) {
+    ByteBudget budget{100, 1000};
+    budget.Spend(1000, kStart);
+    EXPECT_FALSE(budget.HasBudget(kStart));
+    EXPECT_TRUE(budget.HasBudget(kStart + 100ms));
+
+    // The bucket does not grow over the burst size while idle
+    budget.Spend(1500, kStart + 100s);
+    EXPECT_FALSE(budget.HasBudget(kStart + 100s));
+}
+
+TEST(LogByteBudget, Debt) {
+    ByteBudget budget{100, 100};
+    budget.Spend(1100, kStart);
+
+    // 1000 bytes of debt are paid off in 10 seconds
+    EXPECT_FALSE(budget.HasBudget(kStart + 9s));
+    EXPECT_TRUE(budget.HasBudget(kStart + 10s + 1ms));
+}
+
+USERVER_NAMESPACE_END
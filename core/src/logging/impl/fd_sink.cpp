@@ -1,5 +1,7 @@
 #include "fd_sink.hpp"
 
+#include "vectored_write.hpp"
+
 USERVER_NAMESPACE_BEGIN
 
 namespace logging::impl {
@@ -8,6 +10,8 @@ FdSink::FdSink(fs::blocking::FileDescriptor fd) : fd_{std::move(fd)} {}
 
 void FdSink::Write(std::string_view log) { fd_.Write(log); }
 
+void FdSink::WriteBatch(utils::span<const std::string_view> logs) { WriteVectored(fd_.GetNative(), logs); }
+
 void FdSink::Flush() {
     if (fd_.IsOpen()) {
         fd_.FSync();
@@ -1,5 +1,9 @@
 #include "fd_sink.hpp"
 
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
 #include <gmock/gmock.h>
 
 #include <userver/engine/async.hpp>
@@ -72,4 +76,31 @@ UTEST(FdSink, PipeSinkLogMulti) {
     read_task.Get();
 }
 
+UTEST(FdSink, PipeSinkLogBatch) {
+    engine::io::Pipe fd_pipe{};
+
+    // More records than fit into a single ::writev call
+    constexpr std::size_t kRecordsCount = 1000;
+    std::vector<std::string> records;
+    std::vector<std::string> expected;
+    for (std::size_t i = 0; i < kRecordsCount; ++i) {
+        expected.push_back(fmt::format("message {}", i));
+        records.push_back(expected.back() + '\n');
+    }
+    std::vector<logging::impl::LogMessage> batch;
+    for (const auto& record : records) {
+        batch.push_back({record, logging::Level::kInfo});
+    }
+
+    auto read_task = engine::AsyncNoSpan([&fd_pipe, &expected] {
+        const auto result = test::ReadFromFd(fs::blocking::FileDescriptor::AdoptFd(fd_pipe.reader.Release()));
+        EXPECT_EQ(result, expected);
+    });
+    {
+        auto sink = logging::impl::FdSink{fs::blocking::FileDescriptor::AdoptFd(fd_pipe.writer.Release())};
+        EXPECT_NO_THROW(sink.LogBatch(batch));
+    }
+    read_task.Get();
+}
+
 USERVER_NAMESPACE_END
@@ -1,3 +1,6 @@
+#include <string>
+#include <vector>
+
 #include <benchmark/benchmark.h>
 
 #include <userver/fs/blocking/temp_directory.hpp>
@@ -36,4 +39,34 @@ void check_buffered_file_sink(benchmark::State& state) {
 }
 BENCHMARK(check_buffered_file_sink);
 
+template <typename Sink>
+void check_file_sink_batch(benchmark::State& state) {
+    const auto temp_root = fs::blocking::TempDirectory::Create();
+    const std::string filename = temp_root.GetPath() + "/temp_file_" + std::to_string(utils::Rand());
+    auto sink = Sink(filename);
+
+    const auto count_logs = static_cast<std::size_t>(kCountLogs);
+    const auto batch_size = static_cast<std::size_t>(state.range(0));
+    const std::string record(state.range(1) - 1, '*');
+    const auto line = record + '\n';
+    const std::vector<logging::impl::LogMessage> batch(batch_size, {line, logging::Level::kWarning});
+
+    for ([[maybe_unused]] auto _ : state) {
+        for (std::size_t i = 0; i < count_logs; i += batch_size) {
+            sink.LogBatch(batch);
+        }
+    }
+    sink.Flush();
+
+    const auto batches_per_iteration = (count_logs + batch_size - 1) / batch_size;
+    state.SetBytesProcessed(state.iterations() * batches_per_iteration * batch_size * line.size());
+}
+// Batch sizes of 1 to 1024 records, records of 100 bytes and 1 kilobyte
+BENCHMARK_TEMPLATE(check_file_sink_batch, logging::impl::FileSink)
+    ->ArgNames({"batch", "record"})
+    ->ArgsProduct({{1, 8, 64, 256, 1024}, {100, 1024}});
+BENCHMARK_TEMPLATE(check_file_sink_batch, logging::impl::BufferedFileSink)
+    ->ArgNames({"batch", "record"})
+    ->ArgsProduct({{1, 8, 64, 256, 1024}, {100, 1024}});
+
 USERVER_NAMESPACE_END
@@ -1,5 +1,6 @@
 #include "file_sink.hpp"
 
+#include <cstdio>
 #include <functional>
 
 #include <userver/fs/blocking/temp_directory.hpp>
@@ -179,6 +180,28 @@ UTEST_P(FileSinks, TestValidWriteMultiInFile) {
     EXPECT_EQ(test::ReadFromFile(Filename()), test::Messages("message", "message 2", "message 3"));
 }
 
+UTEST_P(FileSinks, TestWriteBatch) {
+    // Large enough to bypass the stdio buffer of BufferedFileSink
+    const std::string long_message(BUFSIZ, 'x');
+    const auto long_record = long_message + '\n';
+    const std::vector<logging::impl::LogMessage> batch{
+        {"message 2\n", logging::Level::kWarning},
+        {"filtered out\n", logging::Level::kDebug},
+        {long_record, logging::Level::kInfo},
+        {"message 3\n", logging::Level::kCritical},
+    };
+
+    Sink().SetLevel(logging::Level::kInfo);
+    EXPECT_NO_THROW(Sink().Log({"message\n", logging::Level::kInfo}));
+    EXPECT_NO_THROW(Sink().LogBatch(batch));
+    EXPECT_NO_THROW(Sink().Log({"message 4\n", logging::Level::kInfo}));
+    EXPECT_NO_THROW(Sink().Flush());
+
+    EXPECT_EQ(
+        test::ReadFromFile(Filename()), test::Messages("message", "message 2", long_message, "message 3", "message 4")
+    );
+}
+
 INSTANTIATE_UTEST_SUITE_P(
     /* no prefix */,
     FileSinks,
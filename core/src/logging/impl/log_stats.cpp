@@ -8,6 +8,8 @@ namespace logging::impl {
 
 void DumpMetric(utils::statistics::Writer& writer, const impl::LogStatistics& stats) {
     writer["dropped"].ValueWithLabels(stats.dropped, {"version", "2"});
+    writer["rate_limited"] = stats.rate_limited;
+    writer["log_limited_dropped"] = stats.log_limited_dropped;
 
     utils::statistics::Rate total;
 
@@ -5,6 +5,7 @@
 #include <unistd.h>
 
 #include <iostream>
+#include <system_error>
 
 #include <fmt/format.h>
 
@@ -12,6 +13,8 @@
 #include <userver/utils/strerror.hpp>
 #include <utils/check_syscall.hpp>
 
+#include "vectored_write.hpp"
+
 USERVER_NAMESPACE_BEGIN
 
 namespace logging::impl {
@@ -40,6 +43,15 @@ void UnixSocketClient::send(std::string_view message) {
     }
 }
 
+void UnixSocketClient::send(utils::span<const std::string_view> messages) {
+    try {
+        WriteVectored(socket_, messages);
+    } catch (const std::system_error&) {
+        close();
+        throw;
+    }
+}
+
 void UnixSocketClient::close() {
     if (socket_ != -1) {
         if (::close(socket_) == -1) {
@@ -55,6 +67,8 @@ UnixSocketClient::~UnixSocketClient() { close(); }
 
 void UnixSocketSink::Write(std::string_view log) { client_.send(log); }
 
+void UnixSocketSink::WriteBatch(utils::span<const std::string_view> logs) { client_.send(logs); }
+
 void UnixSocketSink::Close() { client_.close(); }
 
 }  // namespace logging::impl
@@ -4,6 +4,7 @@
 #include <string>
 
 #include <logging/impl/base_sink.hpp>
+#include <userver/utils/span.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -21,6 +22,7 @@ public:
 
     void connect(std::string_view filename);
     void send(std::string_view message);
+    void send(utils::span<const std::string_view> messages);
     void close();
 
 private:
@@ -36,6 +38,8 @@ public:
 protected:
     void Write(std::string_view log) final;
 
+    void WriteBatch(utils::span<const std::string_view> logs) final;
+
 private:
     const std::string filename_;
     impl::UnixSocketClient client_;
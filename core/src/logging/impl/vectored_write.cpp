@@ -0,0 +1,63 @@
+#include "vectored_write.hpp"
+
+#include <sys/uio.h>
+
+#include <array>
+#include <cerrno>
+#include <system_error>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+namespace {
+
+// Within the IOV_MAX of all the supported platforms
+constexpr std::size_t kMaxIovecs = 256;
+
+void WriteAll(int fd, iovec* iovecs, std::size_t count) {
+    while (count > 0) {
+        const auto written = ::writev(fd, iovecs, static_cast<int>(count));
+        if (written < 0) {
+            if (errno == EAGAIN || errno == EINTR) continue;
+
+            const auto code = std::make_error_code(std::errc{errno});
+            throw std::system_error(code, "calling ::writev");
+        }
+
+        auto left = static_cast<std::size_t>(written);
+        while (count > 0 && left >= iovecs->iov_len) {
+            left -= iovecs->iov_len;
+            ++iovecs;
+            --count;
+        }
+        if (count > 0) {
+            iovecs->iov_base = static_cast<char*>(iovecs->iov_base) + left;
+            iovecs->iov_len -= left;
+        }
+    }
+}
+
+}  // namespace
+
+void WriteVectored(int fd, utils::span<const std::string_view> records) {
+    std::array<iovec, kMaxIovecs> iovecs{};
+    std::size_t count = 0;
+
+    for (const auto record : records) {
+        if (record.empty()) continue;
+
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        iovecs[count++] = iovec{const_cast<char*>(record.data()), record.size()};
+        if (count == iovecs.size()) {
+            WriteAll(fd, iovecs.data(), count);
+            count = 0;
+        }
+    }
+
+    WriteAll(fd, iovecs.data(), count);
+}
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <string_view>
+
+#include <userver/utils/span.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+/// Writes all the records to `fd` in order, using as few `::writev` calls as
+/// possible. Partial writes are continued.
+/// @throws std::system_error on write errors
+void WriteVectored(int fd, utils::span<const std::string_view> records);
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
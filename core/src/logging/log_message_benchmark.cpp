@@ -2,9 +2,11 @@
 
 #include <ostream>
 
+#include <userver/logging/impl/binary_format.hpp>
 #include <userver/logging/impl/logger_base.hpp>
 #include <userver/logging/impl/tag_writer.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/logging/log_extra.hpp>
 #include <userver/logging/logger.hpp>
 
 #include <utils/gbench_auxilary.hpp>
@@ -15,13 +17,17 @@ namespace {
 
 class NoopLogger : public logging::impl::LoggerBase {
 public:
-    NoopLogger() noexcept : LoggerBase(logging::Format::kRaw) { SetLevel(logging::Level::kInfo); }
+    explicit NoopLogger(logging::Format format = logging::Format::kRaw) noexcept : LoggerBase(format) {
+        SetLevel(logging::Level::kInfo);
+    }
     void Log(logging::Level, std::string_view) override {}
     void Flush() override {}
 };
 
 class PrependedTagLogger final : public NoopLogger {
 public:
+    using NoopLogger::NoopLogger;
+
     void PrependCommonTags(logging::impl::TagWriter writer) const override {
         writer.PutTag("aaaaaaaaaaaaaaaaaa", "value");
         writer.PutTag("bbbbbbbbbb", 42);
@@ -148,6 +154,99 @@ void LogPrependedTags(benchmark::State& state) {
 }
 BENCHMARK(LogPrependedTags);
 
+class CaptureLogger final : public logging::impl::LoggerBase {
+public:
+    explicit CaptureLogger(logging::Format format) noexcept : LoggerBase(format) { SetLevel(logging::Level::kInfo); }
+    void Log(logging::Level, std::string_view msg) override { data_.append(msg); }
+    void Flush() override {}
+
+    const std::string& GetData() const { return data_; }
+
+private:
+    std::string data_;
+};
+
+class RecordSizeLogger final : public NoopLogger {
+public:
+    using NoopLogger::NoopLogger;
+
+    void Log(logging::Level, std::string_view msg) override { last_record_size_ = msg.size(); }
+
+    std::size_t GetLastRecordSize() const { return last_record_size_; }
+
+private:
+    std::size_t last_record_size_{0};
+};
+
+const logging::LogExtra& GetTypicalExtra() {
+    static const logging::LogExtra kExtra{
+        {"trace_id", "b2e5e3b5e4a94b1e8d8f6b5e0c2a9d3f"},
+        {"span_id", "d6e4b3b5e4a94b1e"},
+        {"link", "0f3c2a9d3fb2e5e3b5e4a94b1e8d8f6b"},
+        {"uri", "/v1/some/handler?param=value"},
+        {"meta_type", "/v1/some/handler"},
+        {"custom_key", "value\twith\nescapes"},
+    };
+    return kExtra;
+}
+
+template <logging::Format Format>
+void LogFormatString(benchmark::State& state) {
+    const logging::DefaultLoggerGuard guard{std::make_shared<NoopLogger>(Format)};
+    const auto msg = Launder(std::string(state.range(0), '*'));
+    for ([[maybe_unused]] auto _ : state) {
+        LOG_INFO() << msg;
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK_TEMPLATE(LogFormatString, logging::Format::kTskv)->RangeMultiplier(8)->Range(8, 8 << 10)->Complexity();
+BENCHMARK_TEMPLATE(LogFormatString, logging::Format::kBinary)->RangeMultiplier(8)->Range(8, 8 << 10)->Complexity();
+
+template <logging::Format Format>
+void LogFormatEscapedString(benchmark::State& state) {
+    const logging::DefaultLoggerGuard guard{std::make_shared<NoopLogger>(Format)};
+    const auto msg = Launder(std::string(state.range(0), '\t'));
+    for ([[maybe_unused]] auto _ : state) {
+        LOG_INFO() << msg;
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK_TEMPLATE(LogFormatEscapedString, logging::Format::kTskv)->RangeMultiplier(8)->Range(8, 8 << 10);
+BENCHMARK_TEMPLATE(LogFormatEscapedString, logging::Format::kBinary)->RangeMultiplier(8)->Range(8, 8 << 10);
+
+template <logging::Format Format>
+void LogFormatTypicalRecord(benchmark::State& state) {
+    auto logger = std::make_shared<RecordSizeLogger>(Format);
+    const logging::DefaultLoggerGuard guard{logger};
+    const auto& extra = GetTypicalExtra();
+    for ([[maybe_unused]] auto _ : state) {
+        LOG_INFO() << "Some typical log message of a handler" << extra;
+    }
+    state.counters["record_bytes"] = logger->GetLastRecordSize();
+}
+BENCHMARK_TEMPLATE(LogFormatTypicalRecord, logging::Format::kTskv);
+BENCHMARK_TEMPLATE(LogFormatTypicalRecord, logging::Format::kBinary);
+
+void LogBinaryDecode(benchmark::State& state) {
+    CaptureLogger logger{logging::Format::kBinary};
+    const auto& extra = GetTypicalExtra();
+    for (int i = 0; i < state.range(0); ++i) {
+        LOG_INFO_TO(logger) << "Some typical log message of a handler" << extra;
+    }
+
+    std::string output;
+    for ([[maybe_unused]] auto _ : state) {
+        logging::impl::binary::RecordReader reader{logger.GetData()};
+        while (auto record = reader.Next()) {
+            logging::impl::binary::AppendTskv(*record, output);
+        }
+        benchmark::DoNotOptimize(output);
+        output.clear();
+    }
+    state.SetBytesProcessed(state.iterations() * logger.GetData().size());
+}
+BENCHMARK(LogBinaryDecode)->Arg(1)->Arg(1000);
+
 }  // namespace
 
 USERVER_NAMESPACE_END
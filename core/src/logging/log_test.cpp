@@ -1,7 +1,10 @@
-#include <gtest/gtest.h>
+#include <gmock/gmock.h>
 
 #include <optional>
+#include <thread>
+#include <vector>
 
+#include <logging/rate_limit.hpp>
 #include <logging/socket_logging_test.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/logging/log_helper_extras.hpp>
@@ -9,6 +12,7 @@
 #include <userver/utest/utest.hpp>
 #include <userver/utils/async.hpp>
 #include <userver/utils/datetime/date.hpp>
+#include <userver/utils/fast_scope_guard.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -126,6 +130,101 @@ UTEST_F(SocketLoggingTest, Test) {
     EXPECT_EQ("test", NextLoggedText());
 }
 
+TEST_F(LoggingTest, LimitedPerCallSite) {
+    constexpr std::size_t kThreads = 4;
+    constexpr std::size_t kRecordsPerThread = 100;
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < kThreads; ++i) {
+        threads.emplace_back([] {
+            for (std::size_t j = 0; j < kRecordsPerThread; ++j) {
+                LOG_LIMITED_ERROR() << "limited record";
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    logging::LogFlush();
+    const auto logs = GetStreamString();
+    std::size_t entries = 0;
+    for (auto pos = logs.find("limited record"); pos != std::string::npos; pos = logs.find("limited record", pos + 1)) {
+        ++entries;
+    }
+    // The counter of the call site is shared by the threads, so at most
+    // log2(kThreads * kRecordsPerThread) + 1 records are written per interval.
+    // Separate per-thread counters would let through up to 4 times more.
+    EXPECT_GE(entries, 2);
+    EXPECT_LE(entries, 20);
+    EXPECT_THAT(logs, testing::HasSubstr("logs dropped]"));
+}
+
+TEST_F(LoggingTest, LimitedSummary) {
+    const auto interval = logging::impl::GetLogLimitedInterval();
+    const utils::FastScopeGuard restore_interval{[interval]() noexcept {
+        logging::impl::SetLogLimitedInterval(interval);
+    }};
+
+    // Report the records dropped by the other tests
+    logging::impl::SetLogLimitedInterval(std::chrono::milliseconds{0});
+    logging::impl::LogLimitedSummaries();
+    logging::LogFlush();
+    ClearLog();
+    const auto dropped_before = GetStreamLogger()->GetStatistics().log_limited_dropped.Load().value;
+
+    logging::impl::SetLogLimitedInterval(std::chrono::milliseconds{200});
+
+    for (int i = 0; i < 3; ++i) {
+        LOG_LIMITED_ERROR() << "quiet record";
+    }
+
+    // The dropped record is reported once the interval is over
+    logging::impl::LogLimitedSummaries();
+    logging::LogFlush();
+    EXPECT_THAT(GetStreamString(), testing::Not(testing::HasSubstr("messages suppressed")));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{250});
+    logging::impl::LogLimitedSummaries();
+    logging::LogFlush();
+    EXPECT_THAT(GetStreamString(), testing::HasSubstr("text=1 messages suppressed by LOG_LIMITED"));
+    EXPECT_EQ(GetStreamLogger()->GetStatistics().log_limited_dropped.Load().value, dropped_before + 1);
+}
+
+TEST_F(LoggingTest, LimitedSummaryOfCustomLogger) {
+    const auto interval = logging::impl::GetLogLimitedInterval();
+    const utils::FastScopeGuard restore_interval{[interval]() noexcept {
+        logging::impl::SetLogLimitedInterval(interval);
+    }};
+
+    // Report the records dropped by the other tests
+    logging::impl::SetLogLimitedInterval(std::chrono::milliseconds{0});
+    logging::impl::LogLimitedSummaries();
+    logging::LogFlush();
+    ClearLog();
+
+    logging::impl::SetLogLimitedInterval(std::chrono::milliseconds{200});
+
+    const auto logger_data = MakeNamedStreamLogger("other-logger", logging::Format::kTskv);
+    auto& logger = *logger_data.logger;
+    const auto log_quiet_record = [&logger] { LOG_LIMITED_ERROR_TO(logger) << "quiet record"; };
+    for (int i = 0; i < 3; ++i) {
+        log_quiet_record();
+    }
+
+    // The summaries are written only for the default logger, the records
+    // dropped by the other loggers are reported by the next record
+    std::this_thread::sleep_for(std::chrono::milliseconds{250});
+    logging::impl::LogLimitedSummaries();
+    logging::LogFlush();
+    EXPECT_THAT(GetStreamString(), testing::Not(testing::HasSubstr("messages suppressed")));
+
+    log_quiet_record();
+    logging::LogFlush(logger);
+    EXPECT_THAT(logger_data.stream.str(), testing::HasSubstr("[1 logs dropped] quiet record"));
+    EXPECT_THAT(logger_data.stream.str(), testing::Not(testing::HasSubstr("messages suppressed")));
+}
+
 TEST_F(LoggingTest, LogRaw) {
     logging::impl::LogRaw(logging::GetDefaultLogger(), logging::Level::kInfo, "foo");
     EXPECT_EQ(GetStreamString(), "foo\n");
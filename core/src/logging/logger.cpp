@@ -6,6 +6,7 @@
 #include <logging/impl/buffered_file_sink.hpp>
 #include <logging/impl/fd_sink.hpp>
 #include <logging/impl/unix_socket_sink.hpp>
+#include <logging/request_log_buffer.hpp>
 #include <logging/tp_logger.hpp>
 
 #include <userver/logging/impl/tag_writer.hpp>
@@ -75,6 +76,21 @@ bool DoShouldLog(Level level) noexcept {
     return true;
 }
 
+bool DoShouldBuffer(Level level) noexcept {
+    const auto* const span = tracing::Span::CurrentSpanUnchecked();
+    if (!span) return false;
+
+    const auto* const buffer = span->GetRequestLogBuffer(utils::impl::InternalTag{});
+    return buffer && level >= buffer->GetLevel() && DoShouldLog(level);
+}
+
+void Buffer(LoggerBase& logger, Level level, std::string_view msg) noexcept {
+    const auto* const span = tracing::Span::CurrentSpanUnchecked();
+    auto* const buffer = span ? span->GetRequestLogBuffer(utils::impl::InternalTag{}) : nullptr;
+    // The current span may have changed since the ShouldBuffer() check
+    if (buffer) buffer->Append(logger, level, msg);
+}
+
 void PrependCommonTags(TagWriter writer) {
     auto* const span = tracing::Span::CurrentSpanUnchecked();
     if (span) span->LogTo(writer);
@@ -0,0 +1,119 @@
+#include <logging/request_log_buffer.hpp>
+
+#include <utility>
+
+#include <userver/formats/json/value.hpp>
+#include <userver/logging/level_serialization.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+namespace {
+
+std::size_t GetRecordBytes(std::string_view message) noexcept {
+    return message.size() + sizeof(LoggerBase*) + sizeof(Level) + sizeof(std::size_t);
+}
+
+}  // namespace
+
+RequestLogBufferConfig Parse(const formats::json::Value& value, formats::parse::To<RequestLogBufferConfig>) {
+    RequestLogBufferConfig config;
+    config.enabled = value["enabled"].As<bool>(config.enabled);
+    config.level = value["level"].As<Level>(config.level);
+    config.max_request_bytes = value["max-request-bytes"].As<std::size_t>(config.max_request_bytes);
+    config.max_total_bytes = value["max-total-bytes"].As<std::size_t>(config.max_total_bytes);
+    config.emit_slower_than = std::chrono::milliseconds{
+        value["emit-slower-than-ms"].As<std::chrono::milliseconds::rep>(config.emit_slower_than.count())};
+    return config;
+}
+
+void DumpMetric(utils::statistics::Writer& writer, const RequestLogBufferStatistics& stats) {
+    writer["bytes"] = stats.bytes.load(std::memory_order_relaxed);
+    writer["emitted"] = stats.emitted;
+    writer["discarded"] = stats.discarded;
+    writer["dropped"] = stats.dropped;
+}
+
+RequestLogBufferStatistics& GetRequestLogBufferStatistics() noexcept {
+    static RequestLogBufferStatistics stats;
+    return stats;
+}
+
+RequestLogBuffer::RequestLogBuffer(const RequestLogBufferConfig& config)
+    : level_(config.level), max_request_bytes_(config.max_request_bytes), max_total_bytes_(config.max_total_bytes) {
+    alive_request_log_buffers.fetch_add(1, std::memory_order_relaxed);
+}
+
+RequestLogBuffer::~RequestLogBuffer() {
+    Discard();
+    alive_request_log_buffers.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void RequestLogBuffer::Append(LoggerBase& logger, Level level, std::string_view message) noexcept {
+    auto& stats = GetRequestLogBufferStatistics();
+    const auto record_bytes = GetRecordBytes(message);
+
+    const std::lock_guard lock{mutex_};
+    if (is_closed_) {
+        ++stats.discarded;
+        return;
+    }
+
+    if (bytes_ + record_bytes > max_request_bytes_) {
+        ++stats.dropped;
+        return;
+    }
+
+    const auto total_bytes = stats.bytes.fetch_add(record_bytes, std::memory_order_relaxed);
+    if (static_cast<std::size_t>(total_bytes) + record_bytes > max_total_bytes_) {
+        stats.bytes.fetch_sub(record_bytes, std::memory_order_relaxed);
+        ++stats.dropped;
+        return;
+    }
+
+    const auto old_size = data_.size();
+    try {
+        data_.append(message);
+        records_.push_back(Record{&logger, level, message.size()});
+        bytes_ += record_bytes;
+    } catch (const std::exception&) {
+        data_.resize(old_size);
+        stats.bytes.fetch_sub(record_bytes, std::memory_order_relaxed);
+        ++stats.dropped;
+    }
+}
+
+void RequestLogBuffer::Emit() {
+    std::string data;
+    std::vector<Record> records;
+    Close(data, records);
+
+    std::string_view remaining = data;
+    for (const auto& record : records) {
+        record.logger->Log(record.level, remaining.substr(0, record.size));
+        remaining.remove_prefix(record.size);
+    }
+    UASSERT(remaining.empty());
+    GetRequestLogBufferStatistics().emitted.Add(utils::statistics::Rate{records.size()});
+}
+
+void RequestLogBuffer::Discard() noexcept {
+    std::string data;
+    std::vector<Record> records;
+    Close(data, records);
+    GetRequestLogBufferStatistics().discarded.Add(utils::statistics::Rate{records.size()});
+}
+
+void RequestLogBuffer::Close(std::string& data, std::vector<Record>& records) noexcept {
+    const std::lock_guard lock{mutex_};
+    is_closed_ = true;
+    data.swap(data_);
+    records.swap(records_);
+    GetRequestLogBufferStatistics().bytes.fetch_sub(std::exchange(bytes_, 0), std::memory_order_relaxed);
+}
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
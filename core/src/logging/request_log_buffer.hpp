@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <userver/formats/parse/to.hpp>
+#include <userver/logging/impl/logger_base.hpp>
+#include <userver/logging/level.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json {
+class Value;
+}
+
+namespace logging::impl {
+
+/// Request log buffering settings, see USERVER_LOG_REQUEST_BUFFERING
+struct RequestLogBufferConfig final {
+    bool enabled{false};
+    // Records of this level and above that are below the logger level are buffered
+    Level level{Level::kDebug};
+    std::size_t max_request_bytes{256 * 1024};
+    std::size_t max_total_bytes{64 * 1024 * 1024};
+    // Zero disables the rule
+    std::chrono::milliseconds emit_slower_than{0};
+};
+
+RequestLogBufferConfig Parse(const formats::json::Value& value, formats::parse::To<RequestLogBufferConfig>);
+
+struct RequestLogBufferStatistics final {
+    std::atomic<std::int64_t> bytes{0};
+    utils::statistics::RateCounter emitted{};
+    utils::statistics::RateCounter discarded{};
+    utils::statistics::RateCounter dropped{};
+};
+
+void DumpMetric(utils::statistics::Writer& writer, const RequestLogBufferStatistics& stats);
+
+// Statistics of all the request log buffers of the process
+RequestLogBufferStatistics& GetRequestLogBufferStatistics() noexcept;
+
+/// @brief Keeps the formatted log records of a request, that are below the
+/// logger level, until the request outcome is known.
+///
+/// The buffer is shared by the spans of the request task and its subtasks.
+/// The records are either written to their loggers by Emit() or dropped by
+/// Discard(), the records that arrive after that are dropped.
+///
+/// Thread-safe.
+class RequestLogBuffer final {
+public:
+    explicit RequestLogBuffer(const RequestLogBufferConfig& config);
+
+    RequestLogBuffer(const RequestLogBuffer&) = delete;
+    RequestLogBuffer& operator=(const RequestLogBuffer&) = delete;
+    ~RequestLogBuffer();
+
+    Level GetLevel() const noexcept { return level_; }
+
+    // Drops the record if the per-request or the total limit is reached
+    void Append(LoggerBase& logger, Level level, std::string_view message) noexcept;
+
+    // Writes the buffered records to their loggers in the original order
+    void Emit();
+
+    void Discard() noexcept;
+
+private:
+    struct Record final {
+        LoggerBase* logger;
+        Level level;
+        std::size_t size;
+    };
+
+    void Close(std::string& data, std::vector<Record>& records) noexcept;
+
+    const Level level_;
+    const std::size_t max_request_bytes_;
+    const std::size_t max_total_bytes_;
+
+    std::mutex mutex_;
+    bool is_closed_{false};
+    std::size_t bytes_{0};
+    std::string data_;
+    std::vector<Record> records_;
+};
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,151 @@
+#include <logging/request_log_buffer.hpp>
+
+#include <gmock/gmock.h>
+
+#include <logging/log_extra_stacktrace.hpp>
+#include <logging/logging_test.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/async.hpp>
+
+using testing::HasSubstr;
+using testing::Not;
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+class RequestLogBuffer : public LoggingTest {
+protected:
+    RequestLogBuffer() { SetDefaultLoggerLevel(logging::Level::kWarning); }
+
+    static std::shared_ptr<logging::impl::RequestLogBuffer> StartBuffering(
+        tracing::Span& span,
+        logging::impl::RequestLogBufferConfig config = MakeConfig()
+    ) {
+        auto buffer = std::make_shared<logging::impl::RequestLogBuffer>(config);
+        span.SetRequestLogBuffer(buffer, utils::impl::InternalTag{});
+        return buffer;
+    }
+
+    static bool ShouldBuffer(logging::Level level) { return logging::GetDefaultLogger().ShouldBuffer(level); }
+
+    static logging::impl::RequestLogBufferConfig MakeConfig() {
+        logging::impl::RequestLogBufferConfig config;
+        config.enabled = true;
+        return config;
+    }
+};
+
+}  // namespace
+
+UTEST_F(RequestLogBuffer, Emit) {
+    {
+        tracing::Span span{"request"};
+        auto buffer = StartBuffering(span);
+
+        EXPECT_TRUE(ShouldBuffer(logging::Level::kDebug));
+        EXPECT_FALSE(ShouldBuffer(logging::Level::kTrace));
+        // The explicit checks are not affected by the buffering
+        EXPECT_FALSE(logging::ShouldLog(logging::Level::kDebug));
+        EXPECT_FALSE(logging::impl::ShouldLogStacktrace());
+
+        LOG_DEBUG() << "debug context";
+        LOG_WARNING() << "warning";
+        logging::LogFlush();
+        EXPECT_THAT(GetStreamString(), Not(HasSubstr("debug context")));
+        EXPECT_THAT(GetStreamString(), HasSubstr("warning"));
+
+        buffer->Emit();
+        LOG_DEBUG() << "after emit";
+    }
+
+    logging::LogFlush();
+    const auto logs = GetStreamString();
+    EXPECT_THAT(logs, HasSubstr("level=DEBUG"));
+    EXPECT_THAT(logs, HasSubstr("debug context"));
+    EXPECT_THAT(logs, Not(HasSubstr("after emit")));
+}
+
+UTEST_F(RequestLogBuffer, Discard) {
+    {
+        tracing::Span span{"request"};
+        auto buffer = StartBuffering(span);
+
+        LOG_INFO() << "info context";
+        buffer->Discard();
+    }
+
+    logging::LogFlush();
+    EXPECT_THAT(GetStreamString(), Not(HasSubstr("info context")));
+    EXPECT_EQ(logging::impl::GetRequestLogBufferStatistics().bytes.load(), 0);
+}
+
+UTEST_F(RequestLogBuffer, Subtasks) {
+    tracing::Span span{"request"};
+    auto buffer = StartBuffering(span);
+
+    utils::Async("subtask", [] { LOG_DEBUG() << "subtask context"; }).Get();
+    engine::AsyncNoSpan([] { LOG_DEBUG() << "detached from span"; }).Get();
+
+    buffer->Emit();
+    logging::LogFlush();
+    EXPECT_THAT(GetStreamString(), HasSubstr("subtask context"));
+    EXPECT_THAT(GetStreamString(), Not(HasSubstr("detached from span")));
+}
+
+UTEST_F(RequestLogBuffer, Limits) {
+    auto config = MakeConfig();
+    config.level = logging::Level::kInfo;
+    config.max_request_bytes = 4096;
+
+    tracing::Span span{"request"};
+    auto buffer = StartBuffering(span, config);
+    EXPECT_FALSE(ShouldBuffer(logging::Level::kDebug));
+
+    const auto dropped_before = logging::impl::GetRequestLogBufferStatistics().dropped.Load();
+    LOG_INFO() << "first";
+    for (int i = 0; i < 100; ++i) {
+        LOG_INFO() << "flood " << i;
+    }
+    EXPECT_GT(logging::impl::GetRequestLogBufferStatistics().dropped.Load().value, dropped_before.value);
+    EXPECT_GT(logging::impl::GetRequestLogBufferStatistics().bytes.load(), 0);
+    EXPECT_LE(logging::impl::GetRequestLogBufferStatistics().bytes.load(), 4096);
+
+    buffer->Emit();
+    logging::LogFlush();
+    EXPECT_THAT(GetStreamString(), HasSubstr("first"));
+    EXPECT_THAT(GetStreamString(), Not(HasSubstr("flood 99")));
+    EXPECT_EQ(logging::impl::GetRequestLogBufferStatistics().bytes.load(), 0);
+}
+
+UTEST_F(RequestLogBuffer, NoBuffer) {
+    tracing::Span span{"request"};
+    EXPECT_FALSE(ShouldBuffer(logging::Level::kInfo));
+
+    {
+        tracing::Span other{"other-request"};
+        auto buffer = StartBuffering(other);
+        EXPECT_TRUE(ShouldBuffer(logging::Level::kInfo));
+    }
+    EXPECT_FALSE(ShouldBuffer(logging::Level::kInfo));
+}
+
+TEST(RequestLogBufferConfig, Parse) {
+    const auto config = formats::json::FromString(R"({
+        "enabled": true,
+        "level": "info",
+        "max-request-bytes": 1024,
+        "emit-slower-than-ms": 500
+    })")
+                            .As<logging::impl::RequestLogBufferConfig>();
+    EXPECT_TRUE(config.enabled);
+    EXPECT_EQ(config.level, logging::Level::kInfo);
+    EXPECT_EQ(config.max_request_bytes, 1024);
+    EXPECT_EQ(config.max_total_bytes, logging::impl::RequestLogBufferConfig{}.max_total_bytes);
+    EXPECT_EQ(config.emit_slower_than, std::chrono::milliseconds{500});
+}
+
+USERVER_NAMESPACE_END
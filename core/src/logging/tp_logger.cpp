@@ -1,9 +1,12 @@
 #include "tp_logger.hpp"
 
+#include <algorithm>
+
 #include <fmt/format.h>
 
 #include <engine/task/task_context.hpp>
 #include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/logging/impl/tag_writer.hpp>
 #include <userver/logging/logger.hpp>
@@ -15,12 +18,21 @@ USERVER_NAMESPACE_BEGIN
 
 namespace logging::impl {
 
+namespace {
+
+// Limits the memory held by the pool of the queue nodes after bursts
+constexpr std::size_t kMaxPooledNodes = 1024;
+
+// The batch storage is preallocated, so that consuming does not allocate
+constexpr std::size_t kMaxBatchRecords = 1024;
+
+}  // namespace
+
 struct TpLogger::ActionVisitor final {
     TpLogger& logger;
 
-    void operator()(impl::async::Log&& log) const {
-        logger.AccountLogConsumed();
-        logger.BackendLog(std::move(log));
+    void operator()(impl::async::Log&&) const noexcept {
+        UASSERT_MSG(false, "Log records must be written in batches");
     }
 
     void operator()(impl::async::Stop&&) const noexcept {
@@ -47,6 +59,19 @@ struct TpLogger::ActionVisitor final {
 
 TpLogger::TpLogger(Format format, std::string logger_name) : LoggerBase(format), logger_name_(std::move(logger_name)) {
     SetLevel(logging::Level::kInfo);
+    batch_.reserve(kMaxBatchRecords);
+    batch_nodes_.reserve(kMaxBatchRecords);
+}
+
+void TpLogger::SetBatchLimits(std::size_t max_bytes, std::chrono::milliseconds max_delay) {
+    UINVARIANT(state_ == State::kSync, "Batch limits must be set before starting the consumer task");
+    batch_max_bytes_ = max_bytes;
+    batch_max_delay_ = max_delay;
+}
+
+void TpLogger::SetRateLimit(std::size_t bytes_per_second, std::size_t burst_bytes) {
+    UINVARIANT(state_ == State::kSync, "Rate limit must be set before starting the consumer task");
+    budget_.emplace(bytes_per_second, burst_bytes);
 }
 
 void TpLogger::StartConsumerTask(
@@ -128,6 +153,12 @@ impl::LogStatistics& TpLogger::GetStatistics() noexcept { return stats_; }
 void TpLogger::Log(Level level, std::string_view msg) {
     ++stats_.by_level[static_cast<std::size_t>(level)];
 
+    if (budget_) {
+        // Also spent by the emitted request log buffer records, that were not
+        // checked against the budget
+        budget_->Spend(msg.size(), ByteBudget::Clock::now());
+    }
+
     if (GetSinks().empty()) {
         return;
     }
@@ -139,7 +170,7 @@ void TpLogger::Log(Level level, std::string_view msg) {
         produced_->fetch_add(1);
 
         try {
-            Push(impl::async::Log{level, std::string{msg}});
+            PushLog(level, msg);
         } catch (const std::exception&) {
             // failed to construct a Log action or a node in Push
             produced_->fetch_sub(1);
@@ -152,7 +183,30 @@ void TpLogger::Log(Level level, std::string_view msg) {
 
 void TpLogger::PrependCommonTags(TagWriter writer) const { impl::default_::PrependCommonTags(writer); }
 
-bool TpLogger::DoShouldLog(Level level) const noexcept { return impl::default_::DoShouldLog(level); }
+bool TpLogger::DoShouldLog(Level level) const noexcept {
+    // Checked before formatting, so that a surge of records does not waste
+    // CPU on the records that would be dropped on the queue overflow anyway
+    return impl::default_::DoShouldLog(level) && (!budget_ || budget_->HasBudget(ByteBudget::Clock::now()));
+}
+
+bool TpLogger::DoShouldLogRecord(Level level) const noexcept {
+    if (!impl::default_::DoShouldLog(level)) {
+        return false;
+    }
+
+    // Unlike the explicit logging::ShouldLog() checks, the rejected records are accounted
+    if (budget_ && !budget_->HasBudget(ByteBudget::Clock::now())) {
+        ++stats_.rate_limited;
+        return false;
+    }
+    return true;
+}
+
+bool TpLogger::DoShouldBuffer(Level level) const noexcept { return impl::default_::DoShouldBuffer(level); }
+
+void TpLogger::Buffer(Level level, std::string_view msg) { impl::default_::Buffer(*this, level, msg); }
+
+void TpLogger::AccountLogLimitedDrop() noexcept { ++stats_.log_limited_dropped; }
 
 void TpLogger::AddSink(impl::SinkPtr&& sink) {
     UASSERT(sink);
@@ -188,6 +242,11 @@ void TpLogger::ProcessingLoop() {
             break;
         }
         queue_.WaitWhileEmpty(queue_consumer_);
+
+        if (batch_max_delay_.count() > 0) {
+            // Lets the records accumulate in the queue to be written at once
+            engine::SleepFor(batch_max_delay_);
+        }
     }
 
     CleanUpQueue(std::move(queue_consumer_));
@@ -223,9 +282,47 @@ bool TpLogger::TryWaitFreeQueueCapacity() {
 }
 
 void TpLogger::Push(impl::async::Action&& action) {
-    auto node = std::make_unique<impl::async::ActionNode>();
-    node->action = std::move(action);
-    DoPush(*node.release());
+    auto& node = AcquireNode();
+    node.action = std::move(action);
+    DoPush(node);
+}
+
+void TpLogger::PushLog(Level level, std::string_view msg) {
+    auto& node = AcquireNode();
+    try {
+        auto& log = node.action.emplace<impl::async::Log>(level);
+        log.payload.append(msg);
+    } catch (const std::exception&) {
+        ReleaseNode(node);
+        throw;
+    }
+    DoPush(node);
+}
+
+impl::async::ActionNode& TpLogger::AcquireNode() {
+    if (auto* const node = node_pool_.TryAcquire()) {
+        return *node;
+    }
+
+    if (pooled_nodes_count_.fetch_add(1, std::memory_order_relaxed) < kMaxPooledNodes) {
+        auto& node = node_pool_.Acquire();
+        node.is_pooled = true;
+        return node;
+    }
+
+    pooled_nodes_count_.fetch_sub(1, std::memory_order_relaxed);
+    return *new impl::async::ActionNode{};
+}
+
+void TpLogger::ReleaseNode(impl::async::ActionNode& node) noexcept {
+    if (!node.is_pooled) {
+        delete &node;
+        return;
+    }
+
+    // Frees the payload if it did not fit into the inline buffer
+    node.action.emplace<impl::async::Stop>();
+    node_pool_.Release(node);
 }
 
 void TpLogger::DoPush(concurrent::impl::SinglyLinkedBaseHook& node) noexcept {
@@ -235,8 +332,8 @@ void TpLogger::DoPush(concurrent::impl::SinglyLinkedBaseHook& node) noexcept {
     }
 }
 
-void TpLogger::AccountLogConsumed() noexcept {
-    consumed_->store(consumed_->load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+void TpLogger::AccountLogsConsumed(QueueSize count) noexcept {
+    consumed_->store(consumed_->load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
     if (overflow_policy_.load() == QueueOverflowBehavior::kBlock) {
         {
             // Atomic consumed_ mutation doesn't need to be protected by lock.
@@ -255,36 +352,73 @@ void TpLogger::ConsumeNode(concurrent::impl::SinglyLinkedBaseHook& node) noexcep
     auto& action_node = static_cast<impl::async::ActionNode&>(node);
     if (&action_node == &stop_node_) return;
 
+    if (std::holds_alternative<impl::async::Log>(action_node.action)) {
+        AddToBatch(action_node);
+        return;
+    }
+
+    // Other actions must observe all the preceding records written
+    BackendLogBatch();
     BackendPerform(std::move(action_node.action));
-    delete &action_node;
+    ReleaseNode(action_node);
 }
 
 void TpLogger::ConsumeQueueOnce(Queue::Consumer& consumer) noexcept {
     while (auto* const node_base = consumer.TryPop()) {
         ConsumeNode(*node_base);
     }
+    BackendLogBatch();
 }
 
 void TpLogger::CleanUpQueue(Queue::Consumer&& consumer) noexcept {
-    std::move(consumer).ConsumeAndStop([this](auto& node) noexcept { ConsumeNode(node); });
+    // The batch must be written before stopping, the next consumer may be
+    // another thread
+    do {
+        ConsumeQueueOnce(consumer);
+    } while (!consumer.TryStopConsuming());
 }
 
-void TpLogger::BackendLog(impl::async::Log&& action) const {
+void TpLogger::AddToBatch(impl::async::ActionNode& node) noexcept {
+    const auto& log = std::get<impl::async::Log>(node.action);
+
     LogMessage message;
-    message.payload = action.payload;
-    message.level = action.level;
+    message.payload = std::string_view{log.payload.data(), log.payload.size()};
+    message.level = log.level;
+
+    batch_.push_back(message);
+    batch_nodes_.push_back(&node);
+    batch_bytes_ += message.payload.size();
+
+    if (batch_bytes_ >= batch_max_bytes_ || batch_nodes_.size() == kMaxBatchRecords) {
+        BackendLogBatch();
+    }
+}
+
+void TpLogger::BackendLogBatch() noexcept {
+    if (batch_nodes_.empty()) return;
 
     for (const auto& sink : GetSinks()) {
         try {
-            sink->Log(message);
+            sink->LogBatch(batch_);
         } catch (const std::exception& e) {
             UASSERT_MSG(false, "While writing a log message caught an exception: " + std::string(e.what()));
         }
     }
 
-    if (ShouldFlush(message.level)) {
+    const bool should_flush = std::any_of(batch_.begin(), batch_.end(), [this](const LogMessage& message) {
+        return ShouldFlush(message.level);
+    });
+    if (should_flush) {
         BackendFlush();
     }
+
+    AccountLogsConsumed(static_cast<QueueSize>(batch_nodes_.size()));
+    for (auto* const node : batch_nodes_) {
+        ReleaseNode(*node);
+    }
+    batch_.clear();
+    batch_nodes_.clear();
+    batch_bytes_ = 0;
 }
 
 void TpLogger::BackendFlush() const {
@@ -1,14 +1,18 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <future>
 #include <limits>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <variant>
 #include <vector>
 
+#include <fmt/format.h>
+
 #include <userver/engine/condition_variable.hpp>
 #include <userver/engine/future.hpp>
 #include <userver/engine/mutex.hpp>
@@ -17,9 +21,11 @@
 #include <userver/logging/impl/logger_base.hpp>
 
 #include <concurrent/impl/interference_shield.hpp>
+#include <concurrent/intrusive_walkable_pool.hpp>
 #include <engine/impl/async_flat_combining_queue.hpp>
 #include <logging/config.hpp>
 #include <logging/impl/base_sink.hpp>
+#include <logging/impl/byte_budget.hpp>
 #include <logging/impl/reopen_mode.hpp>
 #include <userver/concurrent/impl/intrusive_hooks.hpp>
 #include <userver/logging/impl/log_stats.hpp>
@@ -32,10 +38,16 @@ using SinkPtr = std::unique_ptr<BaseSink>;
 
 namespace async {
 
+/// Records of up to this size are stored inline in the queue nodes, which are
+/// reused, so logging them does not allocate
+inline constexpr std::size_t kInlineLogPayloadSize = 1500;
+
 struct Log {
-    Level level{};
-    std::string payload{};
-    std::chrono::system_clock::time_point time{std::chrono::system_clock::now()};
+    // User-provided, so that the inline buffer is not zeroed on construction
+    explicit Log(Level level) : level(level) {}
+
+    Level level;
+    fmt::basic_memory_buffer<char, kInlineLogPayloadSize> payload;
 };
 
 struct FlushCoro {
@@ -57,6 +69,9 @@ using Action = std::variant<Stop, Log, FlushCoro, FlushThreaded, ReopenCoro>;
 
 struct ActionNode final : public concurrent::impl::SinglyLinkedBaseHook {
     Action action{Stop{}};
+    concurrent::impl::IntrusiveWalkablePoolHook<ActionNode> pool_hook;
+    // Nodes are deleted after consumption if the pool is full
+    bool is_pooled{false};
 };
 
 }  // namespace async
@@ -75,7 +90,19 @@ public:
 
     void StopConsumerTask();
 
+    /// Sets the limit of the records size written to the sinks at once and
+    /// the time to wait for a batch to accumulate after the queue was empty.
+    /// Must be called before StartConsumerTask.
+    void SetBatchLimits(std::size_t max_bytes, std::chrono::milliseconds max_delay);
+
+    /// Limits the bytes of the records written by the logger, the records are
+    /// rejected before formatting while the budget is exhausted.
+    /// Must be called before StartConsumerTask.
+    void SetRateLimit(std::size_t bytes_per_second, std::size_t burst_bytes);
+
     void Log(Level level, std::string_view msg) override;
+    void Buffer(Level level, std::string_view msg) override;
+    void AccountLogLimitedDrop() noexcept override;
     void Flush() override;
     void PrependCommonTags(TagWriter writer) const override;
 
@@ -89,6 +116,8 @@ public:
 
 protected:
     bool DoShouldLog(Level level) const noexcept override;
+    bool DoShouldLogRecord(Level level) const noexcept override;
+    bool DoShouldBuffer(Level level) const noexcept override;
 
 private:
     struct ActionVisitor;
@@ -101,18 +130,24 @@ private:
 
     using Queue = engine::impl::AsyncFlatCombiningQueue;
     using QueueSize = std::int64_t;
+    using NodePoolHook = concurrent::impl::MemberHook<&impl::async::ActionNode::pool_hook>;
+    using NodePool = concurrent::impl::IntrusiveWalkablePool<impl::async::ActionNode, NodePoolHook>;
 
     void ProcessingLoop();
     bool HasFreeQueueCapacity() noexcept;
     bool TryWaitFreeQueueCapacity();
     void Push(impl::async::Action&& action);
+    void PushLog(Level level, std::string_view msg);
+    impl::async::ActionNode& AcquireNode();
+    void ReleaseNode(impl::async::ActionNode& node) noexcept;
     void DoPush(concurrent::impl::SinglyLinkedBaseHook& node) noexcept;
     void ConsumeNode(concurrent::impl::SinglyLinkedBaseHook& node) noexcept;
     void ConsumeQueueOnce(Queue::Consumer& consumer) noexcept;
     void CleanUpQueue(Queue::Consumer&& consumer) noexcept;
-    void AccountLogConsumed() noexcept;
+    void AccountLogsConsumed(QueueSize count) noexcept;
     void BackendPerform(impl::async::Action&& action) noexcept;
-    void BackendLog(impl::async::Log&& action) const;
+    void AddToBatch(impl::async::ActionNode& node) noexcept;
+    void BackendLogBatch() noexcept;
     void BackendFlush() const;
     void BackendReopen(ReopenMode reopen_mode) const;
 
@@ -128,9 +163,22 @@ private:
     // State changes rarely, no need for an InterferenceShield.
     std::atomic<State> state_{State::kSync};
     Queue::Consumer queue_consumer_;
+
+    // Only accessed by the current consumer of queue_.
+    std::vector<LogMessage> batch_;
+    std::vector<impl::async::ActionNode*> batch_nodes_;
+    std::size_t batch_bytes_{0};
+    std::size_t batch_max_bytes_{LoggerConfig::kDefaultBatchMaxBytes};
+    std::chrono::milliseconds batch_max_delay_{0};
+
+    std::optional<ByteBudget> budget_;
+
     // A dummy action used for notifying the async task during stopping.
     impl::async::ActionNode stop_node_;
 
+    // Must outlive queue_, the nodes are returned to the pool on consumption.
+    NodePool node_pool_;
+    std::atomic<std::size_t> pooled_nodes_count_{0};
     Queue queue_;
     concurrent::impl::InterferenceShield<std::atomic<QueueSize>> produced_{0};
     concurrent::impl::InterferenceShield<std::atomic<QueueSize>> consumed_{0};
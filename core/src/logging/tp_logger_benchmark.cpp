@@ -1,5 +1,10 @@
 #include <logging/tp_logger.hpp>
 
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
 #include <benchmark/benchmark.h>
 
 #include <logging/impl/null_sink.hpp>
@@ -14,6 +19,22 @@ USERVER_NAMESPACE_BEGIN
 
 namespace {
 
+// Counted by the replaced global operator new below
+std::atomic<bool> count_allocations{false};
+std::atomic<std::uint64_t> allocations{0};
+
+class AllocationsCounter final {
+public:
+    AllocationsCounter() noexcept {
+        allocations = 0;
+        count_allocations = true;
+    }
+
+    ~AllocationsCounter() { count_allocations = false; }
+
+    std::uint64_t Get() const noexcept { return allocations.load(); }
+};
+
 std::shared_ptr<logging::impl::TpLogger>
 MakeLoggerFromSink(const std::string& logger_name, logging::impl::SinkPtr sink_ptr, logging::Format format) {
     auto logger = std::make_unique<logging::impl::TpLogger>(format, logger_name);
@@ -38,6 +59,14 @@ protected:
         return utils::FastScopeGuard([this]() noexcept { tp_logger_->StopConsumerTask(); });
     }
 
+    // Fills the pool of the queue nodes
+    void WarmUp(const std::string& msg) {
+        for (int i = 0; i < 1000; ++i) {
+            LOG_INFO() << msg;
+        }
+        tp_logger_->Flush();
+    }
+
 private:
     std::shared_ptr<logging::impl::TpLogger> tp_logger_;
     std::optional<logging::DefaultLoggerGuard> guard_;
@@ -49,9 +78,13 @@ BENCHMARK_DEFINE_F(TpLoggerBenchmark, LogString)(benchmark::State& state) {
     engine::RunStandalone(2, [&] {
         auto scope = StartAsyncLoggerScope();
         const auto msg = Launder(std::string(state.range(0), '*'));
+        WarmUp(msg);
+
+        const AllocationsCounter counter;
         for ([[maybe_unused]] auto _ : state) {
             LOG_INFO() << msg;
         }
+        state.counters["allocations"] = benchmark::Counter(counter.Get(), benchmark::Counter::kAvgIterations);
         state.SetComplexityN(state.range(0));
     });
 }
@@ -90,3 +123,15 @@ BENCHMARK_DEFINE_F(TpLoggerBenchmark, LogCheckSpan)
 BENCHMARK_REGISTER_F(TpLoggerBenchmark, LogCheckSpan);
 
 USERVER_NAMESPACE_END
+
+// The allocations of the whole benchmark binary are counted, but only while
+// an AllocationsCounter exists
+void* operator new(std::size_t size) {
+    if (USERVER_NAMESPACE::count_allocations.load(std::memory_order_relaxed)) {
+        USERVER_NAMESPACE::allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) return ptr;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
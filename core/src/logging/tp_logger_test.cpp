@@ -587,6 +587,93 @@ UTEST_F(LoggingTestCoro, TpLoggerFlushMultiple) {
     EXPECT_EQ(GetRecordsCount(), kLoggingTestIterations);
 }
 
+UTEST_F(LoggingTestCoro, TpLoggerRecordSizes) {
+    auto logger = StartAsyncLogger(kLoggingTestIterations);
+
+    // The records are stored in the reused queue nodes, with the long ones
+    // spilling out of the inline buffer
+    const std::string short_text(10, 's');
+    const std::string long_text(logging::impl::async::kInlineLogPayloadSize * 3, 'l');
+    for (std::size_t i = 0; i < kLoggingTestIterations; ++i) {
+        LOG_INFO_TO(logger) << (i % 2 == 0 ? short_text : long_text) << i;
+        if (i % 16 == 0) {
+            logger->Flush();
+        }
+    }
+    logger->StopConsumerTask();
+
+    const auto logs = GetStreamString();
+    for (std::size_t i = 0; i < kLoggingTestIterations; ++i) {
+        EXPECT_THAT(logs, testing::HasSubstr(fmt::format("text={}{}", i % 2 == 0 ? short_text : long_text, i)));
+    }
+    EXPECT_EQ(GetRecordsCount(), kLoggingTestIterations);
+}
+
+UTEST_F(LoggingTestCoro, TpLoggerBatchLimits) {
+    auto logger = GetStreamLogger();
+    // Batches of a few records each, with the records accumulating in the queue
+    logger->SetBatchLimits(100, std::chrono::milliseconds{5});
+    logger->StartConsumerTask(
+        engine::current_task::GetTaskProcessor(), kLoggingTestIterations, QueueOverflowBehavior::kDiscard
+    );
+
+    for (std::size_t i = 0; i < kLoggingTestIterations; ++i) {
+        LOG_INFO_TO(logger) << "record " << i << " end";
+    }
+    logger->Flush();
+    EXPECT_EQ(GetRecordsCount(), kLoggingTestIterations);
+    logger->StopConsumerTask();
+
+    const auto logs = GetStreamString();
+    std::size_t previous_position = 0;
+    for (std::size_t i = 0; i < kLoggingTestIterations; ++i) {
+        const auto position = logs.find(fmt::format("record {} end", i));
+        ASSERT_NE(position, std::string::npos) << i;
+        EXPECT_GE(position, previous_position) << "Records must be written in order";
+        previous_position = position;
+    }
+}
+
+UTEST_F(LoggingTestCoro, TpLoggerRateLimit) {
+    // Room for a few records, with almost no refill during the test
+    GetStreamLogger()->SetRateLimit(1, 1000);
+    auto logger = StartAsyncLogger(kLoggingTestIterations);
+
+    std::size_t formatted = 0;
+    const auto format = [&formatted] {
+        ++formatted;
+        return "record";
+    };
+    for (std::size_t i = 0; i < kLoggingTestIterations; ++i) {
+        LOG_ERROR_TO(logger) << format();
+    }
+    // The explicit checks are not accounted
+    EXPECT_FALSE(logging::LoggerShouldLog(logger, logging::Level::kError));
+    logger->Flush();
+    logger->StopConsumerTask();
+
+    // The records over the budget are rejected before formatting
+    EXPECT_GT(formatted, 0);
+    EXPECT_LT(formatted, kLoggingTestIterations / 4);
+    EXPECT_EQ(GetRecordsCount(), formatted);
+    EXPECT_EQ(GetMetric("rate_limited"), kLoggingTestIterations - formatted);
+    EXPECT_EQ(GetMetric("dropped"), 0);
+}
+
+UTEST_F(LoggingTestCoro, TpLoggerLogLimited) {
+    auto logger = StartAsyncLogger(kLoggingTestIterations);
+    for (std::size_t i = 0; i < kLoggingTestIterations; ++i) {
+        LOG_LIMITED_ERROR_TO(logger) << "limited record";
+    }
+    logger->Flush();
+    logger->StopConsumerTask();
+
+    EXPECT_GT(GetRecordsCount(), 0);
+    EXPECT_LT(GetRecordsCount(), kLoggingTestIterations / 4);
+    EXPECT_EQ(GetMetric("log_limited_dropped"), kLoggingTestIterations - GetRecordsCount());
+    EXPECT_EQ(GetMetric("dropped"), 0);
+}
+
 UTEST_F_MT(LoggingTestCoro, TpLoggerLogMultipleMT, 4) {
     const std::size_t message_count = kLoggingTestIterations * (GetThreadCount() - 1);
     auto logger = StartAsyncLogger(message_count * 10, QueueOverflowBehavior::kDiscard);
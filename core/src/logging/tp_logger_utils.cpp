@@ -69,6 +69,10 @@ std::shared_ptr<TpLogger> MakeTpLogger(const LoggerConfig& config) {
     auto logger = std::make_shared<TpLogger>(config.format, config.logger_name);
     logger->SetLevel(config.level);
     logger->SetFlushOn(config.flush_level);
+    logger->SetBatchLimits(config.batch_max_bytes, config.batch_max_delay);
+    if (config.rate_limit_bytes_per_second != 0) {
+        logger->SetRateLimit(config.rate_limit_bytes_per_second, config.rate_limit_burst_bytes);
+    }
 
     if (auto basic_sink = MakeOptionalSink(config)) {
         logger->AddSink(std::move(basic_sink));
@@ -9,6 +9,8 @@
 #include <userver/engine/sleep.hpp>
 #include <userver/engine/task/task_with_result.hpp>
 #include <userver/rcu/rcu.hpp>
+#include <userver/rcu/rcu_map.hpp>
+#include <userver/rcu/sharded_rcu_map.hpp>
 #include <userver/utils/async.hpp>
 #include <utils/impl/parallelize_benchmark.hpp>
 
@@ -38,10 +40,17 @@ BENCHMARK_TEMPLATE(rcu_read, 1);
 BENCHMARK_TEMPLATE(rcu_read, 2);
 BENCHMARK_TEMPLATE(rcu_read, 4);
 
-template <int VariableCount>
+namespace {
+
+using DefaultTraits = rcu::DefaultRcuTraits<std::uint64_t>;
+using EpochTraits = rcu::EpochRcuTraits<std::uint64_t>;
+
+}  // namespace
+
+template <int VariableCount, typename RcuTraits = DefaultTraits>
 void rcu_write(benchmark::State& state) {
     engine::RunStandalone([&] {
-        rcu::Variable<std::uint64_t> vars[VariableCount];
+        rcu::Variable<std::uint64_t, RcuTraits> vars[VariableCount];
 
         std::uint64_t i = 0;
         for ([[maybe_unused]] auto _ : state) {
@@ -53,7 +62,10 @@ void rcu_write(benchmark::State& state) {
 BENCHMARK_TEMPLATE(rcu_write, 1);
 BENCHMARK_TEMPLATE(rcu_write, 2);
 BENCHMARK_TEMPLATE(rcu_write, 4);
+BENCHMARK_TEMPLATE(rcu_write, 1, EpochTraits);
+BENCHMARK_TEMPLATE(rcu_write, 4, EpochTraits);
 
+template <typename RcuTraits>
 void rcu_contention(benchmark::State& state) {
     const std::size_t readers_count = state.range(0);
     const std::size_t writers_count = state.range(1);
@@ -63,14 +75,14 @@ void rcu_contention(benchmark::State& state) {
 
     engine::RunStandalone(thread_count, [&] {
         std::atomic<bool> run{true};
-        rcu::Variable<std::uint64_t> var{0};
+        rcu::Variable<std::uint64_t, RcuTraits> var{0};
 
         std::vector<engine::TaskWithResult<void>> tasks;
         tasks.reserve(readers_count - 1 + writers_count);
 
         for (std::size_t j = 0; j < readers_count - 1; j++) {
             tasks.push_back(utils::Async("reader", [&] {
-                std::vector<rcu::ReadablePtr<std::uint64_t>> pointers;
+                std::vector<rcu::ReadablePtr<std::uint64_t, RcuTraits>> pointers;
                 pointers.reserve(kept_readable_pointers_count);
 
                 while (run) {
@@ -94,7 +106,7 @@ void rcu_contention(benchmark::State& state) {
         }
 
         {
-            std::queue<rcu::ReadablePtr<std::uint64_t>> pointers;
+            std::queue<rcu::ReadablePtr<std::uint64_t, RcuTraits>> pointers;
             for (std::size_t i = 0; i < kept_readable_pointers_count; i++) {
                 pointers.push(var.Read());
             }
@@ -112,7 +124,11 @@ void rcu_contention(benchmark::State& state) {
         }
     });
 }
-BENCHMARK(rcu_contention)
+BENCHMARK_TEMPLATE(rcu_contention, DefaultTraits)
+    ->RangeMultiplier(2)
+    ->Ranges({{1, 16}, {0, 1}, {1, 4}})
+    ->Ranges({{2048, 2048}, {0, 1}, {1, 4}});
+BENCHMARK_TEMPLATE(rcu_contention, EpochTraits)
     ->RangeMultiplier(2)
     ->Ranges({{1, 16}, {0, 1}, {1, 4}})
     ->Ranges({{2048, 2048}, {0, 1}, {1, 4}});
@@ -133,4 +149,64 @@ void rcu_of_shared_ptr(benchmark::State& state) {
 }
 BENCHMARK(rcu_of_shared_ptr)->RangeMultiplier(2)->Range(1, 32);
 
+namespace {
+
+constexpr int kMapKeyCount = 100'000;
+
+template <typename Map>
+void FillMap(Map& map) {
+    for (int i = 0; i < kMapKeyCount; ++i) {
+        map.Emplace(i, i);
+    }
+}
+
+}  // namespace
+
+// Inserts new keys into a large map, each insertion copies the keyset
+// (or the keyset of a shard for ShardedRcuMap)
+template <typename Map>
+void rcu_map_insert_heavy(benchmark::State& state) {
+    engine::RunStandalone([&] {
+        Map map;
+        FillMap(map);
+
+        int key = kMapKeyCount;
+        for ([[maybe_unused]] auto _ : state) {
+            map.Emplace(key, key);
+            map.Erase(key - kMapKeyCount);
+            ++key;
+        }
+    });
+}
+BENCHMARK_TEMPLATE(rcu_map_insert_heavy, rcu::RcuMap<int, int>);
+BENCHMARK_TEMPLATE(rcu_map_insert_heavy, rcu::ShardedRcuMap<int, int>);
+
+// One insertion per `state.range(1)` lookups from `state.range(0)` threads
+template <typename Map>
+void rcu_map_read_heavy(benchmark::State& state) {
+    const std::size_t threads_count = state.range(0);
+    const std::size_t reads_per_write = state.range(1);
+
+    engine::RunStandalone(threads_count, [&] {
+        Map map;
+        FillMap(map);
+        std::atomic<int> next_key{kMapKeyCount};
+
+        RunParallelBenchmark(state, [&](auto& range) {
+            std::size_t i = 0;
+            for ([[maybe_unused]] auto _ : range) {
+                if (++i % reads_per_write == 0) {
+                    const int key = next_key++;
+                    map.Emplace(key, key);
+                } else {
+                    auto value = map.Get(static_cast<int>(i % kMapKeyCount));
+                    benchmark::DoNotOptimize(value);
+                }
+            }
+        });
+    });
+}
+BENCHMARK_TEMPLATE(rcu_map_read_heavy, rcu::RcuMap<int, int>)->Ranges({{1, 4}, {100, 10'000}});
+BENCHMARK_TEMPLATE(rcu_map_read_heavy, rcu::ShardedRcuMap<int, int>)->Ranges({{1, 4}, {100, 10'000}});
+
 USERVER_NAMESPACE_END
@@ -24,6 +24,11 @@ struct RcuTraitsStdMutex : rcu::DefaultRcuMapTraits<Key, Value> {
 
 using StdMutexRcuMap = rcu::RcuMap<std::string, int, RcuTraitsStdMutex<std::string, int>>;
 
+template <typename Key, typename Value>
+struct RcuTraitsEpochs : rcu::DefaultRcuMapTraits<Key, Value> {
+    static constexpr rcu::Reclamation kReclamation = rcu::Reclamation::kEpochs;
+};
+
 }  // namespace
 
 TEST(RcuMap, StdMutexBase) {
@@ -321,4 +326,26 @@ UTEST(RcuMap, StartWriteNoTearing) {
     UEXPECT_NO_THROW(checker.Get());
 }
 
+UTEST_MT(RcuMap, EpochsConcurrentUpdates, 4) {
+    rcu::RcuMap<int, int, RcuTraitsEpochs<int, int>> map;
+    std::atomic<bool> stop_flag{false};
+
+    auto reader = utils::Async("reader", [&map, &stop_flag] {
+        while (!stop_flag) {
+            for (const auto& [key, value] : map) {
+                ASSERT_EQ(key, *value);
+            }
+        }
+    });
+
+    for (int i = 0; i < 10'000; ++i) {
+        map.Emplace(i, i);
+        if (i % 2) EXPECT_TRUE(map.Erase(i - 1));
+    }
+    stop_flag = true;
+    reader.Get();
+
+    EXPECT_EQ(map.SizeApprox(), 5'000);
+}
+
 USERVER_NAMESPACE_END
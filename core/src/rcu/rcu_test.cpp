@@ -410,14 +410,13 @@ constexpr std::size_t kWritingTasks = 2;
 constexpr std::size_t kSleeperTask = 1;
 constexpr std::size_t kTotalTasks = kReadablePtrPingPongTasks + kReadingTasks + kWritingTasks + kSleeperTask;
 
-}  // namespace
-
-UTEST_MT(Rcu, TortureTest, kTotalTasks) {
-    rcu::Variable<CleaningUpInt> data{1};
+template <typename RcuTraits>
+void RunTortureTest() {
+    rcu::Variable<CleaningUpInt, RcuTraits> data{1};
     std::atomic<bool> keep_running{true};
 
     engine::Mutex ping_pong_mutex;
-    rcu::ReadablePtr<CleaningUpInt> ptr = data.Read();
+    rcu::ReadablePtr<CleaningUpInt, RcuTraits> ptr = data.Read();
 
     std::vector<engine::TaskWithResult<void>> tasks;
 
@@ -457,6 +456,38 @@ UTEST_MT(Rcu, TortureTest, kTotalTasks) {
     keep_running = false;
 }
 
+}  // namespace
+
+UTEST_MT(Rcu, TortureTest, kTotalTasks) { RunTortureTest<rcu::DefaultRcuTraits<CleaningUpInt>>(); }
+
+UTEST_MT(Rcu, EpochsTortureTest, kTotalTasks) { RunTortureTest<rcu::EpochRcuTraits<CleaningUpInt>>(); }
+
+UTEST(Rcu, EpochsLifetime) {
+    using Counted = Counted<struct EpochsLifetimeTag>;
+    using Traits = rcu::EpochRcuTraits<Counted>;
+
+    {
+        rcu::Variable<Counted, Traits> ptr{rcu::DestructionType::kSync};
+        EXPECT_EQ(1, Counted::counter);
+
+        {
+            auto reader = ptr.Read();
+            for (int i = 0; i < 5; ++i) ptr.Emplace();
+            // The epoch of the reader can not end, so nothing is freed
+            EXPECT_EQ(6, Counted::counter);
+            EXPECT_EQ(1, reader->value);
+        }
+
+        // The snapshots are freed once two epochs pass without the readers
+        ptr.Emplace();
+        ptr.Emplace();
+        EXPECT_EQ(2, Counted::counter);
+        ptr.Cleanup();
+        EXPECT_EQ(1, Counted::counter);
+    }
+    EXPECT_EQ(0, Counted::counter);
+}
+
 UTEST(Rcu, WritablePtrUnlocksInCommit) {
     rcu::Variable<int> var{1};
 
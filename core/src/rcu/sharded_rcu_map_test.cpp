@@ -0,0 +1,128 @@
+#include <userver/rcu/sharded_rcu_map.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+UTEST(ShardedRcuMap, Modify) {
+    rcu::ShardedRcuMap<int, int, rcu::DefaultRcuMapTraits<int, int>, 4> map;
+    const auto& cmap = map;
+
+    UEXPECT_THROW(cmap[1], rcu::MissingKeyException);
+    EXPECT_EQ(map.begin(), map.end());
+    EXPECT_EQ(cmap.begin(), cmap.end());
+
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(map.Emplace(i, i).inserted);
+    }
+    EXPECT_FALSE(map.Emplace(1, 42).inserted);
+    EXPECT_FALSE(map.TryEmplace(1, 42).inserted);
+    EXPECT_EQ(map.SizeApprox(), 100);
+    EXPECT_EQ(*cmap[1], 1);
+
+    map.InsertOrAssign(1, std::make_shared<int>(42));
+    EXPECT_EQ(*map.Get(1), 42);
+
+    EXPECT_TRUE(map.Erase(1));
+    EXPECT_FALSE(map.Erase(1));
+    EXPECT_FALSE(map.Get(1));
+    EXPECT_EQ(*map.Pop(2), 2);
+    EXPECT_FALSE(map.Pop(2));
+    EXPECT_EQ(map.SizeApprox(), 98);
+
+    std::vector<bool> seen(100);
+    for (const auto& [key, value] : cmap) {
+        ASSERT_TRUE(key >= 0 && key < 100);
+        EXPECT_FALSE(seen[key]);
+        seen[key] = true;
+        EXPECT_EQ(key, *value);
+    }
+    EXPECT_EQ(std::count(seen.begin(), seen.end(), true), 98);
+
+    const auto snapshot = map.GetSnapshot();
+    EXPECT_EQ(snapshot.size(), 98);
+    EXPECT_EQ(snapshot.count(1), 0);
+
+    map.Clear();
+    EXPECT_EQ(map.begin(), map.end());
+    EXPECT_EQ(map.SizeApprox(), 0);
+    EXPECT_EQ(snapshot.size(), 98);
+}
+
+UTEST(ShardedRcuMap, Assign) {
+    rcu::ShardedRcuMap<std::string, int> map;
+    *map["stale"] = 1;
+
+    decltype(map)::RawMap new_map;
+    for (int i = 0; i < 1000; ++i) {
+        new_map.emplace(std::to_string(i), std::make_shared<int>(i));
+    }
+    map.Assign(std::move(new_map));
+
+    EXPECT_FALSE(map.Get("stale"));
+    EXPECT_EQ(map.SizeApprox(), 1000);
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(map.Get(std::to_string(i)));
+        EXPECT_EQ(*map.Get(std::to_string(i)), i);
+    }
+}
+
+UTEST(ShardedRcuMap, StartWrite) {
+    rcu::ShardedRcuMap<int, int> map;
+
+    int other = 1;
+    while (!map.IsSameShard(0, other)) ++other;
+
+    auto txn = map.StartWrite(0);
+    txn->emplace(0, std::make_shared<int>(10));
+    txn->emplace(other, std::make_shared<int>(20));
+    EXPECT_FALSE(map.Get(0));
+    txn.Commit();
+
+    EXPECT_EQ(*map.Get(0), 10);
+    EXPECT_EQ(*map.Get(other), 20);
+}
+
+UTEST_MT(ShardedRcuMap, ConcurrentInserts, 4) {
+    constexpr int kTasks = 4;
+    constexpr int kKeysPerTask = 1000;
+    rcu::ShardedRcuMap<int, int> map;
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    for (int i = 0; i < kTasks; ++i) {
+        tasks.push_back(utils::Async("writer", [&map, i] {
+            for (int key = i * kKeysPerTask; key < (i + 1) * kKeysPerTask; ++key) {
+                ASSERT_TRUE(map.Emplace(key, key).inserted);
+                ASSERT_TRUE(map.Get(key));
+            }
+        }));
+    }
+    for (auto& task : tasks) task.Get();
+
+    EXPECT_EQ(map.SizeApprox(), kTasks * kKeysPerTask);
+    EXPECT_EQ(map.GetSnapshot().size(), kTasks * kKeysPerTask);
+}
+
+UTEST(ShardedRcuMap, SampleShardedRcuMap) {
+    /// [Sample rcu::ShardedRcuMap usage]
+    // Only the shard of the key is copied on insertion,
+    // which makes the map suitable for a large frequently updated keyset
+    rcu::ShardedRcuMap<std::string, std::atomic<int>> map;
+
+    for (int i = 0; i < 100'000; ++i) {
+        map.Emplace(std::to_string(i), i);
+    }
+    ++*map["42"];
+    ASSERT_EQ(map["42"]->load(), 43);
+    ASSERT_EQ(map.SizeApprox(), 100'000);
+    /// [Sample rcu::ShardedRcuMap usage]
+}
+
+USERVER_NAMESPACE_END
@@ -132,6 +132,14 @@ properties:
                     private-key-passphrase-name:
                         type: string
                         description: passphrase name located in secdist
+                    session-tickets:
+                        type: boolean
+                        description: whether to issue and accept TLS session tickets for session resumption
+                        defaultDescription: false
+                    session-ticket-key-rotation-period:
+                        type: string
+                        description: period of the TLS session ticket key rotation, 0 to never rotate
+                        defaultDescription: 1h
             handler-defaults:
                 type: object
                 description: handler defaults options
@@ -141,6 +141,13 @@ properties:
         defaultDescription: taken from server.listener.handler-defaults.deadline_expired_status_code
         minimum: 400
         maximum: 599
+    resource_accounting_enabled:
+        type: boolean
+        description: |
+            account CPU time and allocated bytes (with jemalloc) of the request
+            processing task, the values are reported in handler statistics and
+            in the tags of the request span
+        defaultDescription: false
 )");
 }
 
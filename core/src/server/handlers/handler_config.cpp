@@ -81,6 +81,7 @@ HandlerConfig ParseHandlerConfigsWithDefaults(
     config.set_response_server_hostname = value["set-response-server-hostname"].As<std::optional<bool>>();
 
     config.response_body_stream = value["response-body-stream"].As<bool>(false);
+    config.resource_accounting_enabled = value["resource_accounting_enabled"].As<bool>(false);
 
     if (config.max_requests_per_second && config.max_requests_per_second.value() <= 0) {
         throw std::runtime_error(
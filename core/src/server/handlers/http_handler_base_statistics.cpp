@@ -24,6 +24,11 @@ void DumpMetric(utils::statistics::Writer& writer, HttpHandlerStatisticsHelper h
     writer["deadline-received"] = stats.deadline_received;
     writer["cancelled-by-deadline"] = stats.cancelled_by_deadline;
     writer["timings"] = stats.timings;
+    if (stats.resource_accounted) {
+        writer["resource-accounted"] = stats.resource_accounted;
+        writer["cpu-time-us"] = stats.cpu_time_us;
+        writer["allocated-bytes"] = stats.allocated_bytes;
+    }
 }
 
 }  // namespace
@@ -33,6 +38,15 @@ void HttpHandlerMethodStatistics::Account(const HttpHandlerStatisticsEntry& stat
     timings_.GetCurrentCounter().Account(stats.timing.count());
     if (stats.deadline.IsReachable()) ++deadline_received_;
     if (stats.cancelled_by_deadline) ++cancelled_by_deadline_;
+    if (stats.resource_usage) {
+        ++resource_accounted_;
+        cpu_time_us_.Add(
+            utils::statistics::Rate{static_cast<utils::statistics::Rate::ValueType>(
+                std::chrono::duration_cast<std::chrono::microseconds>(stats.resource_usage->cpu_time).count()
+            )}
+        );
+        allocated_bytes_.Add(utils::statistics::Rate{stats.resource_usage->allocated_bytes});
+    }
 }
 
 std::size_t HttpHandlerMethodStatistics::GetInFlight() const noexcept {
@@ -53,7 +67,10 @@ HttpHandlerStatisticsSnapshot::HttpHandlerStatisticsSnapshot(const HttpHandlerMe
       too_many_requests_in_flight(stats.too_many_requests_in_flight_.Load()),
       rate_limit_reached(stats.rate_limit_reached_.Load()),
       deadline_received(stats.deadline_received_.Load()),
-      cancelled_by_deadline(stats.cancelled_by_deadline_.Load()) {}
+      cancelled_by_deadline(stats.cancelled_by_deadline_.Load()),
+      resource_accounted(stats.resource_accounted_.Load()),
+      cpu_time_us(stats.cpu_time_us_.Load()),
+      allocated_bytes(stats.allocated_bytes_.Load()) {}
 
 void HttpHandlerStatisticsSnapshot::Add(const HttpHandlerStatisticsSnapshot& other) {
     timings.Add(other.timings);
@@ -64,6 +81,9 @@ void HttpHandlerStatisticsSnapshot::Add(const HttpHandlerStatisticsSnapshot& oth
     rate_limit_reached += other.rate_limit_reached;
     deadline_received += other.deadline_received;
     cancelled_by_deadline += other.cancelled_by_deadline;
+    resource_accounted += other.resource_accounted;
+    cpu_time_us += other.cpu_time_us;
+    allocated_bytes += other.allocated_bytes;
 }
 
 void DumpMetric(utils::statistics::Writer& writer, const HttpHandlerStatisticsSnapshot& stats) {
@@ -101,6 +121,7 @@ HttpHandlerStatisticsScope::~HttpHandlerStatisticsScope() {
     stats.timing = std::chrono::duration_cast<std::chrono::milliseconds>(finish_time - start_time_);
     stats.deadline = data ? data->deadline : engine::Deadline{};
     stats.cancelled_by_deadline = cancelled_by_deadline_;
+    stats.resource_usage = engine::current_task::GetResourceUsage();
     stats_.ForMethod(method_).Account(stats);
     stats_.ForMethod(method_).DecrementInFlight();
 }
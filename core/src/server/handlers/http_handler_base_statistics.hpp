@@ -3,10 +3,12 @@
 #include <array>
 #include <chrono>
 #include <cstddef>
+#include <optional>
 #include <type_traits>
 
 #include <server/http/handler_methods.hpp>
 #include <userver/engine/deadline.hpp>
+#include <userver/engine/task/resource_usage.hpp>
 #include <userver/server/handlers/http_handler_base.hpp>
 #include <userver/server/http/http_status.hpp>
 #include <userver/utils/statistics/percentile.hpp>
@@ -25,6 +27,8 @@ struct HttpHandlerStatisticsEntry final {
     std::chrono::milliseconds timing{};
     engine::Deadline deadline{};
     bool cancelled_by_deadline{false};
+    // std::nullopt if resource accounting is disabled for the handler
+    std::optional<engine::TaskResourceUsage> resource_usage{};
 };
 
 struct HttpHandlerStatisticsSnapshot;
@@ -59,6 +63,9 @@ private:
     utils::statistics::RateCounter rate_limit_reached_;
     utils::statistics::RateCounter deadline_received_;
     utils::statistics::RateCounter cancelled_by_deadline_;
+    utils::statistics::RateCounter resource_accounted_;
+    utils::statistics::RateCounter cpu_time_us_;
+    utils::statistics::RateCounter allocated_bytes_;
 };
 
 void DumpMetric(utils::statistics::Writer& writer, const HttpHandlerMethodStatistics& stats);
@@ -78,6 +85,9 @@ struct HttpHandlerStatisticsSnapshot final {
     utils::statistics::Rate rate_limit_reached;
     utils::statistics::Rate deadline_received;
     utils::statistics::Rate cancelled_by_deadline;
+    utils::statistics::Rate resource_accounted;
+    utils::statistics::Rate cpu_time_us;
+    utils::statistics::Rate allocated_bytes;
 };
 
 void DumpMetric(utils::statistics::Writer& writer, const HttpHandlerStatisticsSnapshot& stats);
@@ -17,6 +17,18 @@ const dynamic_config::Key<HeadersWhitelist> kLogRequestHeaderWhitelist{
     "USERVER_LOG_REQUEST_HEADERS_WHITELIST",
     dynamic_config::DefaultAsJsonString{"[]"}};
 
+const dynamic_config::Key<logging::impl::RequestLogBufferConfig> kLogRequestBuffering{
+    "USERVER_LOG_REQUEST_BUFFERING",
+    dynamic_config::DefaultAsJsonString{R"(
+  {
+    "enabled": false,
+    "level": "debug",
+    "max-request-bytes": 262144,
+    "max-total-bytes": 67108864,
+    "emit-slower-than-ms": 0
+  }
+)"}};
+
 const dynamic_config::Key<bool> kCancelHandleRequestByDeadline{"USERVER_CANCEL_HANDLE_REQUEST_BY_DEADLINE", false};
 
 CcCustomStatus Parse(const formats::json::Value& value, formats::parse::To<CcCustomStatus>) {
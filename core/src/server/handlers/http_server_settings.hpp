@@ -3,6 +3,7 @@
 #include <chrono>
 #include <unordered_set>
 
+#include <logging/request_log_buffer.hpp>
 #include <userver/dynamic_config/snapshot.hpp>
 #include <userver/server/http/http_status.hpp>
 
@@ -18,6 +19,8 @@ extern const dynamic_config::Key<bool> kLogRequestHeaders;
 
 extern const dynamic_config::Key<HeadersWhitelist> kLogRequestHeaderWhitelist;
 
+extern const dynamic_config::Key<logging::impl::RequestLogBufferConfig> kLogRequestBuffering;
+
 extern const dynamic_config::Key<bool> kCancelHandleRequestByDeadline;
 
 struct CcCustomStatus final {
@@ -2,8 +2,10 @@
 
 #include <userver/components/component.hpp>
 #include <userver/components/statistics_storage.hpp>
+#include <userver/engine/mutex.hpp>
 #include <userver/formats/json/serialize.hpp>
 #include <userver/server/handlers/exceptions.hpp>
+#include <userver/server/http/http_response_body_stream.hpp>
 #include <userver/utils/statistics/graphite.hpp>
 #include <userver/utils/statistics/json.hpp>
 #include <userver/utils/statistics/pretty_format.hpp>
@@ -34,6 +36,9 @@ namespace {
 
 using impl::StatsFormat;
 
+// Chunks of the streamed response
+constexpr std::size_t kStreamChunkSize = 64 * 1024;
+
 std::optional<StatsFormat> ParseFormat(std::string_view format) {
     if (format.empty()) return {};
 
@@ -69,48 +74,65 @@ ServerMonitor::ServerMonitor(
     : HttpHandlerBase(config, component_context, /*is_monitor = */ true),
       statistics_storage_(component_context.FindComponent<components::StatisticsStorage>().GetStorage()),
       common_labels_{config["common-labels"].As<CommonLabels>({})},
-      default_format_{ParseFormat(config["format"].As<std::string>({}))} {}
+      default_format_{ParseFormat(config["format"].As<std::string>({}))},
+      prometheus_formatters_{std::make_unique<PrometheusFormatters>()} {}
 
-std::string ServerMonitor::HandleRequestThrow(const http::HttpRequest& request, request::RequestContext&) const {
-    const auto& prefix = request.GetArg("prefix");
-    const auto& path = request.GetArg("path");
-    if (!path.empty() && !prefix.empty() && path != prefix) {
-        throw handlers::ClientError(handlers::ExternalBody{"Use either 'path' or 'prefix' URL parameter, not both"});
-    }
+struct ServerMonitor::PrometheusFormatters final {
+    engine::Mutex mutex;
+    utils::statistics::PrometheusFormatter typed{utils::statistics::PrometheusFormatter::Types::kTyped};
+    utils::statistics::PrometheusFormatter untyped{utils::statistics::PrometheusFormatter::Types::kUntyped};
+};
 
-    std::vector<utils::statistics::Label> labels;
-    const auto& labels_json = request.GetArg("labels");
-    if (!labels_json.empty()) {
-        auto json = formats::json::FromString(labels_json);
-        for (auto [key, value] : Items(json)) {
-            labels.emplace_back(std::move(key), value.As<std::string>());
-        }
-    }
+ServerMonitor::~ServerMonitor() = default;
 
-    const auto arg_format = ParseFormat(request.GetArg("format"));
+std::string ServerMonitor::HandleRequestThrow(const http::HttpRequest& request, request::RequestContext&) const {
+    const auto [format, statistics_request] = ParseRequest(request);
+    return FormatResponse(request, format, statistics_request);
+}
 
-    if (!default_format_.has_value() && !arg_format.has_value()) {
-        throw handlers::ClientError(handlers::ExternalBody{"No format was provided"});
+void ServerMonitor::HandleStreamRequest(
+    const http::HttpRequest& request,
+    request::RequestContext&,
+    http::ResponseBodyStream& response_body_stream
+) const {
+    const auto [format, statistics_request] = ParseRequest(request);
+    if (format != StatsFormat::kPrometheus && format != StatsFormat::kPrometheusUntyped) {
+        auto body = FormatResponse(request, format, statistics_request);
+        response_body_stream.SetStatusCode(http::HttpStatus::kOk);
+        response_body_stream.SetEndOfHeaders();
+        response_body_stream.PushBodyChunk(std::move(body), engine::Deadline{});
+        return;
     }
 
-    const auto format = arg_format.has_value() ? arg_format.value() : default_format_.value();
-
-    using utils::statistics::Request;
-    auto common_labels = format == StatsFormat::kSolomon ? Request::AddLabels{} : common_labels_;
-    const auto statistics_request =
-        (path.empty() ? Request::MakeWithPrefix(prefix, std::move(common_labels), std::move(labels))
-                      : Request::MakeWithPath(path, std::move(common_labels), std::move(labels)));
+    // The headers are sent with the first chunk, so that a failure to format
+    // it is still reported with an error status code
+    bool headers_sent = false;
+    const auto send_headers = [&] {
+        if (std::exchange(headers_sent, true)) return;
+        request.GetHttpResponse().SetContentType("text/plain; charset=utf-8");
+        response_body_stream.SetStatusCode(http::HttpStatus::kOk);
+        response_body_stream.SetEndOfHeaders();
+    };
+    FormatPrometheus(format, statistics_request, [&](std::string&& chunk) {
+        send_headers();
+        response_body_stream.PushBodyChunk(std::move(chunk), engine::Deadline{});
+    });
+    send_headers();
+}
 
+std::string ServerMonitor::FormatResponse(
+    const http::HttpRequest& request,
+    StatsFormat format,
+    const utils::statistics::Request& statistics_request
+) const {
     request.GetHttpResponse().SetContentType("text/plain; charset=utf-8");
     switch (format) {
         case StatsFormat::kGraphite:
             return utils::statistics::ToGraphiteFormat(statistics_storage_, statistics_request);
 
         case StatsFormat::kPrometheus:
-            return utils::statistics::ToPrometheusFormat(statistics_storage_, statistics_request);
-
         case StatsFormat::kPrometheusUntyped:
-            return utils::statistics::ToPrometheusFormatUntyped(statistics_storage_, statistics_request);
+            return FormatPrometheus(format, statistics_request, {});
 
         case StatsFormat::kJson:
             request.GetHttpResponse().SetContentType("application/json");
@@ -133,6 +155,64 @@ std::string ServerMonitor::HandleRequestThrow(const http::HttpRequest& request,
     UINVARIANT(false, "Unexpected 'format' value");
 }
 
+std::pair<StatsFormat, utils::statistics::Request> ServerMonitor::ParseRequest(const http::HttpRequest& request) const {
+    const auto& prefix = request.GetArg("prefix");
+    const auto& path = request.GetArg("path");
+    if (!path.empty() && !prefix.empty() && path != prefix) {
+        throw handlers::ClientError(handlers::ExternalBody{"Use either 'path' or 'prefix' URL parameter, not both"});
+    }
+
+    std::vector<utils::statistics::Label> labels;
+    const auto& labels_json = request.GetArg("labels");
+    if (!labels_json.empty()) {
+        auto json = formats::json::FromString(labels_json);
+        for (auto [key, value] : Items(json)) {
+            labels.emplace_back(std::move(key), value.As<std::string>());
+        }
+    }
+
+    const auto arg_format = ParseFormat(request.GetArg("format"));
+
+    if (!default_format_.has_value() && !arg_format.has_value()) {
+        throw handlers::ClientError(handlers::ExternalBody{"No format was provided"});
+    }
+
+    const auto format = arg_format.has_value() ? arg_format.value() : default_format_.value();
+
+    using utils::statistics::Request;
+    auto common_labels = format == StatsFormat::kSolomon ? Request::AddLabels{} : common_labels_;
+    return {
+        format,
+        path.empty() ? Request::MakeWithPrefix(prefix, std::move(common_labels), std::move(labels))
+                     : Request::MakeWithPath(path, std::move(common_labels), std::move(labels)),
+    };
+}
+
+std::string ServerMonitor::FormatPrometheus(
+    StatsFormat format,
+    const utils::statistics::Request& statistics_request,
+    std::optional<utils::statistics::PrometheusFormatter::ChunkConsumer> consumer
+) const {
+    using utils::statistics::PrometheusFormatter;
+    const auto format_with = [&](PrometheusFormatter& formatter) {
+        if (!consumer) return formatter.Format(statistics_storage_, statistics_request);
+        formatter.Format(statistics_storage_, statistics_request, kStreamChunkSize, *consumer);
+        return std::string{};
+    };
+
+    // Concurrent scrapes are rare, they do not wait for the cached names
+    std::unique_lock lock{prometheus_formatters_->mutex, std::try_to_lock};
+    if (!lock.owns_lock()) {
+        PrometheusFormatter formatter{
+            format == StatsFormat::kPrometheus ? PrometheusFormatter::Types::kTyped
+                                               : PrometheusFormatter::Types::kUntyped};
+        return format_with(formatter);
+    }
+    return format_with(
+        format == StatsFormat::kPrometheus ? prometheus_formatters_->typed : prometheus_formatters_->untyped
+    );
+}
+
 std::string
 ServerMonitor::GetResponseDataForLogging(const http::HttpRequest&, request::RequestContext&, const std::string&) const {
     // Useless data for logs, no need to duplicate metrics in logs
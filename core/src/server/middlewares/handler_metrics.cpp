@@ -3,6 +3,7 @@
 #include <server/handlers/http_handler_base_statistics.hpp>
 #include <server/request/internal_request_context.hpp>
 
+#include <userver/engine/task/resource_usage.hpp>
 #include <userver/server/request/request_context.hpp>
 #include <userver/utils/fast_scope_guard.hpp>
 
@@ -13,6 +14,10 @@ namespace server::middlewares {
 HandlerMetrics::HandlerMetrics(const handlers::HttpHandlerBase& handler) : handler_{handler} {}
 
 void HandlerMetrics::HandleRequest(http::HttpRequest& request, request::RequestContext& context) const {
+    if (handler_.GetConfig().resource_accounting_enabled) {
+        engine::current_task::EnableResourceAccounting();
+    }
+
     handlers::HttpHandlerStatisticsScope stats_scope(
         handler_.GetHandlerStatistics(), request.GetMethod(), request.GetHttpResponse()
     );
@@ -1,11 +1,15 @@
 #include <server/middlewares/tracing.hpp>
 
+#include <exception>
+#include <memory>
+
 #include <server/handlers/http_server_settings.hpp>
 #include <server/middlewares/misc.hpp>
 #include <server/request/internal_request_context.hpp>
 
 #include <userver/components/component_config.hpp>
 #include <userver/components/component_context.hpp>
+#include <userver/engine/task/resource_usage.hpp>
 #include <userver/http/common_headers.hpp>
 #include <userver/logging/level_serialization.hpp>
 #include <userver/server/handlers/handler_config.hpp>
@@ -26,6 +30,8 @@ namespace {
 const std::string kTracingTypeResponse = "response";
 const std::string kTracingBody = "body";
 const std::string kTracingUri = "uri";
+const std::string kTracingCpuTimeUs = "cpu_time_us";
+const std::string kTracingAllocatedBytes = "allocated_bytes";
 
 std::string GetHeadersLogString(const http::HttpResponse& response) {
     formats::json::ValueBuilder json_headers(formats::json::Type::kObject);
@@ -63,25 +69,43 @@ Tracing::Tracing(const tracing::TracingManagerBase& tracing_manager, const handl
 void Tracing::HandleRequest(http::HttpRequest& request, request::RequestContext& context) const {
     const auto meta_type = misc::CutTrailingSlash(request.GetRequestPath(), handler_.GetConfig().url_trailing_slash);
     auto span = MakeSpan(request, meta_type);
-    LogYandexHeaders(request);
 
     // This needs ConfigSnapshot, which is reset down the call chain in Next(),
     // so we prepare settings here
     const auto logging_settings = ParseLoggingSettings(context);
-    const utils::FastScopeGuard guard{[this, &span, &logging_settings, &request, &context]() noexcept {
-        try {
-            FillResponseWithTracingContext(span, request.GetHttpResponse());
-            EnrichLogs(span, logging_settings, request, context);
-        } catch (const std::exception& ex) {
-            // Something went really wrong if our tracing threw itself.
-            LOG_ERROR() << "Failed to set tracing context for response: " << ex;
-        } catch (...) {
-            // Something went terribly wrong if our tracing threw non-std
-            // exception itself.
-            LOG_ERROR() << "Failed to set tracing context for response due to an "
-                           "unknown exception (task cancellation?)";
+    if (logging_settings.request_log_buffer.enabled) {
+        span.SetRequestLogBuffer(
+            std::make_shared<logging::impl::RequestLogBuffer>(logging_settings.request_log_buffer),
+            utils::impl::InternalTag{}
+        );
+    }
+    LogYandexHeaders(request);
+
+    const auto start_time = std::chrono::steady_clock::now();
+    const auto uncaught_exceptions = std::uncaught_exceptions();
+    const utils::FastScopeGuard guard{
+        [this, &span, &logging_settings, &request, &context, start_time, uncaught_exceptions]() noexcept {
+            try {
+                FinishRequestLogBuffer(
+                    span,
+                    logging_settings,
+                    request,
+                    std::chrono::steady_clock::now() - start_time,
+                    std::uncaught_exceptions() > uncaught_exceptions
+                );
+                FillResponseWithTracingContext(span, request.GetHttpResponse());
+                EnrichLogs(span, logging_settings, request, context);
+            } catch (const std::exception& ex) {
+                // Something went really wrong if our tracing threw itself.
+                LOG_ERROR() << "Failed to set tracing context for response: " << ex;
+            } catch (...) {
+                // Something went terribly wrong if our tracing threw non-std
+                // exception itself.
+                LOG_ERROR() << "Failed to set tracing context for response due to an "
+                               "unknown exception (task cancellation?)";
+            }
         }
-    }};
+    };
 
     Next(request, context);
 }
@@ -109,7 +133,31 @@ void Tracing::FillResponseWithTracingContext(const tracing::Span& span, http::Ht
 Tracing::LoggingSettings Tracing::ParseLoggingSettings(request::RequestContext& context) const {
     const auto& config_snapshot = context.GetInternalContext().GetConfigSnapshot();
 
-    return {config_snapshot[handlers::kLogRequest], config_snapshot[handlers::kLogRequestHeaders]};
+    return {
+        config_snapshot[handlers::kLogRequest],
+        config_snapshot[handlers::kLogRequestHeaders],
+        config_snapshot[handlers::kLogRequestBuffering],
+    };
+}
+
+void Tracing::FinishRequestLogBuffer(
+    tracing::Span& span,
+    const LoggingSettings& logging_settings,
+    const http::HttpRequest& request,
+    std::chrono::steady_clock::duration duration,
+    bool has_exception
+) const {
+    auto* const buffer = span.GetRequestLogBuffer(utils::impl::InternalTag{});
+    if (!buffer) return;
+
+    const auto emit_slower_than = logging_settings.request_log_buffer.emit_slower_than;
+    const bool is_failed = has_exception || static_cast<int>(request.GetHttpResponse().GetStatus()) >= 500 ||
+                           (emit_slower_than.count() > 0 && duration >= emit_slower_than);
+    if (is_failed) {
+        buffer->Emit();
+    } else {
+        buffer->Discard();
+    }
 }
 
 void Tracing::EnrichLogs(
@@ -135,7 +183,9 @@ void Tracing::EnrichLogs(
         span.AddTag(tracing::kHttpStatusCode, response_code);
         if (response_code >= 500) span.AddTag(tracing::kErrorFlag, true);
 
-        if (logging_settings.need_log_response) {
+        // Spans of the unsampled traces are rarely logged, do not format their bodies
+        const bool is_likely_logged = span.IsSampled() || response_code >= 500;
+        if (logging_settings.need_log_response && is_likely_logged) {
             if (logging_settings.need_log_response_headers) {
                 span.AddNonInheritableTag("response_headers", GetHeadersLogString(response));
             }
@@ -144,6 +194,15 @@ void Tracing::EnrichLogs(
             );
         }
         span.AddNonInheritableTag(kTracingUri, request.GetUrl());
+
+        // Only set if `resource_accounting_enabled` is set in the handler config
+        if (const auto resource_usage = engine::current_task::GetResourceUsage()) {
+            span.AddNonInheritableTag(
+                kTracingCpuTimeUs,
+                std::chrono::duration_cast<std::chrono::microseconds>(resource_usage->cpu_time).count()
+            );
+            span.AddNonInheritableTag(kTracingAllocatedBytes, resource_usage->allocated_bytes);
+        }
     } catch (const std::exception& ex) {
         LOG_ERROR() << "can't finalize request processing: " << ex;
     }
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <chrono>
+
+#include <logging/request_log_buffer.hpp>
 #include <userver/dynamic_config/source.hpp>
 #include <userver/logging/level.hpp>
 #include <userver/server/middlewares/builtin.hpp>
@@ -28,6 +31,7 @@ private:
     struct LoggingSettings final {
         bool need_log_response{false};
         bool need_log_response_headers{false};
+        logging::impl::RequestLogBufferConfig request_log_buffer{};
     };
 
     void HandleRequest(http::HttpRequest& request, request::RequestContext& context) const override;
@@ -38,6 +42,14 @@ private:
 
     LoggingSettings ParseLoggingSettings(request::RequestContext& context) const;
 
+    void FinishRequestLogBuffer(
+        tracing::Span& span,
+        const LoggingSettings& logging_settings,
+        const http::HttpRequest& request,
+        std::chrono::steady_clock::duration duration,
+        bool has_exception
+    ) const;
+
     void EnrichLogs(
         tracing::Span& span,
         const LoggingSettings& logging_settings,
@@ -57,6 +57,11 @@ ListenerConfig Parse(const yaml_config::YamlConfig& value, formats::parse::To<Li
         auto contents = fs::blocking::ReadFileContents(ca_path);
         config.tls_certificate_authorities.push_back(crypto::Certificate::LoadFromString(contents));
     }
+    config.tls_session_tickets = value["tls"]["session-tickets"].As<bool>(config.tls_session_tickets);
+    config.tls_session_ticket_key_rotation_period =
+        value["tls"]["session-ticket-key-rotation-period"].As<std::chrono::seconds>(
+            config.tls_session_ticket_key_rotation_period
+        );
 
     return config;
 }
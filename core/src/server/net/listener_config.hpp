@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <optional>
 
@@ -31,6 +32,8 @@ struct ListenerConfig {
     std::string tls_private_key_passphrase_name;
     crypto::PrivateKey tls_private_key;
     std::vector<crypto::Certificate> tls_certificate_authorities;
+    bool tls_session_tickets{false};
+    std::chrono::seconds tls_session_ticket_key_rotation_period{std::chrono::hours{1}};
 };
 
 ListenerConfig Parse(const yaml_config::YamlConfig& value, formats::parse::To<ListenerConfig>);
@@ -33,6 +33,11 @@ ListenerImpl::ListenerImpl(
       endpoint_info_(std::move(endpoint_info)),
       stats_(std::make_shared<Stats>()),
       data_accounter_(data_accounter),
+      tls_ticket_keys_(
+          endpoint_info_->listener_config.tls && endpoint_info_->listener_config.tls_session_tickets
+              ? std::make_unique<engine::io::TlsTicketKeys>()
+              : nullptr
+      ),
       socket_listener_task_(engine::CriticalAsyncNoSpan(
           task_processor_,
           [this](engine::io::Socket&& request_socket) {
@@ -51,13 +56,22 @@ ListenerImpl::ListenerImpl(
               }
           },
           CreateSocket(endpoint_info_->listener_config)
-      )) {}
+      )) {
+    const auto rotation_period = endpoint_info_->listener_config.tls_session_ticket_key_rotation_period;
+    if (tls_ticket_keys_ && rotation_period.count() > 0) {
+        tls_ticket_keys_rotation_task_.Start(
+            "tls-ticket-keys-rotation", {rotation_period}, [this] { tls_ticket_keys_->Rotate(); }
+        );
+    }
+}
 
 ListenerImpl::~ListenerImpl() {
     LOG_TRACE() << "Stopping socket listener task";
     socket_listener_task_.SyncCancel();
     LOG_TRACE() << "Stopped socket listener task";
 
+    tls_ticket_keys_rotation_task_.Stop();
+
     connections_.CancelAndWait();
 }
 
@@ -101,9 +115,27 @@ void ListenerImpl::ProcessConnection(engine::io::Socket peer_socket) {
     auto remote_address = peer_socket.Getpeername();
     if (endpoint_info_->listener_config.tls) {
         const auto& config = endpoint_info_->listener_config;
-        socket = std::make_unique<engine::io::TlsWrapper>(engine::io::TlsWrapper::StartTlsServer(
-            std::move(peer_socket), config.tls_cert, config.tls_private_key, {}, config.tls_certificate_authorities
-        ));
+        auto tls_socket = tls_ticket_keys_ ? engine::io::TlsWrapper::StartTlsServer(
+                                                 std::move(peer_socket),
+                                                 config.tls_cert,
+                                                 config.tls_private_key,
+                                                 *tls_ticket_keys_,
+                                                 {},
+                                                 config.tls_certificate_authorities
+                                             )
+                                           : engine::io::TlsWrapper::StartTlsServer(
+                                                 std::move(peer_socket),
+                                                 config.tls_cert,
+                                                 config.tls_private_key,
+                                                 {},
+                                                 config.tls_certificate_authorities
+                                             );
+        if (tls_socket.IsSessionReused()) {
+            ++stats_->tls_handshakes_resumed;
+        } else {
+            ++stats_->tls_handshakes_full;
+        }
+        socket = std::make_unique<engine::io::TlsWrapper>(std::move(tls_socket));
     } else {
         socket = std::make_unique<engine::io::Socket>(std::move(peer_socket));
     }
@@ -4,8 +4,10 @@
 
 #include <userver/concurrent/background_task_storage.hpp>
 #include <userver/engine/io/socket.hpp>
+#include <userver/engine/io/tls_sessions.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/periodic_task.hpp>
 
 #include "connection.hpp"
 #include "endpoint_info.hpp"
@@ -36,6 +38,9 @@ private:
     std::shared_ptr<Stats> stats_;
     request::ResponseDataAccounter& data_accounter_;
 
+    std::unique_ptr<engine::io::TlsTicketKeys> tls_ticket_keys_;
+    utils::PeriodicTask tls_ticket_keys_rotation_task_;
+
     concurrent::BackgroundTaskStorageCore connections_;
 
     engine::TaskWithResult<void> socket_listener_task_;
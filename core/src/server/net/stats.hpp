@@ -61,6 +61,8 @@ struct Stats {
     std::atomic<size_t> active_connections{0};
     std::atomic<size_t> connections_created{0};
     std::atomic<size_t> connections_closed{0};
+    utils::statistics::RateCounter tls_handshakes_full{0};
+    utils::statistics::RateCounter tls_handshakes_resumed{0};
 
     // per connection
     ParserStats parser_stats;
@@ -75,6 +77,8 @@ struct StatsAggregation final {
         : active_connections{stats.active_connections.load()},
           connections_created{stats.connections_created.load()},
           connections_closed{stats.connections_closed.load()},
+          tls_handshakes_full{stats.tls_handshakes_full.Load()},
+          tls_handshakes_resumed{stats.tls_handshakes_resumed.Load()},
           parser_stats{stats.parser_stats},
           active_request_count{stats.active_request_count.NonNegativeRead()},
           requests_processed_count{stats.requests_processed_count.Read()} {}
@@ -83,6 +87,8 @@ struct StatsAggregation final {
         active_connections += other.active_connections;
         connections_created += other.connections_created;
         connections_closed += other.connections_closed;
+        tls_handshakes_full += other.tls_handshakes_full;
+        tls_handshakes_resumed += other.tls_handshakes_resumed;
 
         parser_stats += other.parser_stats;
         active_request_count += other.active_request_count;
@@ -94,6 +100,8 @@ struct StatsAggregation final {
     std::size_t active_connections{0};
     std::size_t connections_created{0};
     std::size_t connections_closed{0};
+    utils::statistics::Rate tls_handshakes_full{0};
+    utils::statistics::Rate tls_handshakes_resumed{0};
 
     // per connection
     ParserStatsAggregation parser_stats;
@@ -339,6 +339,9 @@ void Server::WriteMonitorData(utils::statistics::Writer& writer) const {
         conn_stats["active"] = server_stats.active_connections;
         conn_stats["opened"] = server_stats.connections_created;
         conn_stats["closed"] = server_stats.connections_closed;
+        auto tls_handshakes_stats = conn_stats["tls-handshakes"];
+        tls_handshakes_stats["full"] = server_stats.tls_handshakes_full;
+        tls_handshakes_stats["resumed"] = server_stats.tls_handshakes_resumed;
     }
 
     if (auto request_stats = writer["requests"]) {
@@ -16,6 +16,7 @@ constexpr std::string_view kSampledTag = "sampled";
 // default value for Sampled flag is '01' as we always write spans by
 // default
 constexpr std::string_view kDefaultOtelTraceFlags = "01";
+constexpr std::string_view kUnsampledOtelTraceFlags = "00";
 
 // The order matter for TryFillSpanBuilderFromRequest as it returns on first
 // success
@@ -40,6 +41,11 @@ engine::TaskInheritedVariable<OTelTracingHeadersInheritedData> kOTelTracingHeade
 /// @see TracingHeadersInheritedData for details on the contents.
 engine::TaskInheritedVariable<std::string> kB3TracingSampledInheritedData;
 
+// The sampled flag is the lowest bit of the hex encoded traceflags
+bool IsOtelSampled(std::string_view traceflags) {
+    return traceflags.empty() || std::string_view{"13579bdfBDF"}.find(traceflags.back()) != std::string_view::npos;
+}
+
 bool B3TryFillSpanBuilderFromRequest(const server::http::HttpRequest& request, tracing::SpanBuilder& span_builder) {
     namespace b3 = http::headers::b3;
     const auto& trace_id = request.GetHeader(b3::kTraceId);
@@ -56,6 +62,8 @@ bool B3TryFillSpanBuilderFromRequest(const server::http::HttpRequest& request, t
     span_builder.SetTraceId(trace_id);
     span_builder.SetParentSpanId(request.GetHeader(b3::kSpanId));
     span_builder.AddTagFrozen(std::string{kSampledTag}, sampled);
+    // "1" means accept, "d" means debug, that implies accept
+    span_builder.SetSampled(sampled != "0" && sampled != "false");
     return true;
 }
 
@@ -70,7 +78,7 @@ void B3FillWithTracingContext(const tracing::Span& span, T& target) {
     if (sampled && !sampled->empty()) {
         target.SetHeader(b3::kSampled, *sampled);
     } else {
-        target.SetHeader(b3::kSampled, "1");
+        target.SetHeader(b3::kSampled, span.IsSampled() ? "1" : "0");
     }
 }
 
@@ -101,6 +109,7 @@ bool OpenTelemetryTryFillSpanBuilderFromRequest(
     if (data.trace_flags.empty()) {
         data.trace_flags = std::string{kDefaultOtelTraceFlags};
     }
+    span_builder.SetSampled(IsOtelSampled(data.trace_flags));
 
     const auto& tracestate = request.GetHeader(opentelemetry::kTraceState);
     kOTelTracingHeadersInheritedData.Set({
@@ -114,7 +123,7 @@ template <class T>
 void OpenTelemetryFillWithTracingContext(const tracing::Span& span, T& target, const logging::Level log_level) {
     const auto* data = kOTelTracingHeadersInheritedData.GetOptional();
 
-    std::string_view traceflags = kDefaultOtelTraceFlags;
+    std::string_view traceflags = span.IsSampled() ? kDefaultOtelTraceFlags : kUnsampledOtelTraceFlags;
     if (data) {
         traceflags = data->traceflags;
     }
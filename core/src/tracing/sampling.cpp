@@ -0,0 +1,51 @@
+#include <tracing/sampling.hpp>
+
+#include <cstdint>
+
+#include <fmt/format.h>
+
+#include <userver/formats/json/exception.hpp>
+#include <userver/formats/json/value.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing {
+
+namespace {
+
+double ParseRate(const formats::json::Value& value) {
+    const auto rate = value.As<double>();
+    if (!(rate >= 0.0 && rate <= 1.0)) {
+        throw formats::json::ParseException(
+            fmt::format("Sampling rate at '{}' must be in [0, 1], got {}", value.GetPath(), rate)
+        );
+    }
+    return rate;
+}
+
+}  // namespace
+
+TraceSampling Parse(const formats::json::Value& value, formats::parse::To<TraceSampling>) {
+    TraceSampling result;
+    if (value.HasMember("default-rate")) result.default_rate = ParseRate(value["default-rate"]);
+
+    const auto& rates = value["root-span-rates"];
+    if (!rates.IsMissing()) {
+        for (auto it = rates.begin(); it != rates.end(); ++it) {
+            result.root_span_rates.emplace(it.GetName(), ParseRate(*it));
+        }
+    }
+
+    result.keep_errors = value["keep-errors"].As<bool>(result.keep_errors);
+    const auto keep_slower_than_ms = value["keep-slower-than-ms"].As<std::int64_t>(0);
+    if (keep_slower_than_ms < 0) {
+        throw formats::json::ParseException("Negative 'keep-slower-than-ms' in trace sampling config");
+    }
+    result.keep_slower_than = std::chrono::milliseconds{keep_slower_than_ms};
+
+    return result;
+}
+
+}  // namespace tracing
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <unordered_map>
+
+#include <userver/formats/parse/to.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json {
+class Value;
+}
+
+namespace tracing {
+
+/// Sampling of the traces.
+///
+/// The head decision is made once for a trace by its root span using
+/// `root_span_rates` or `default_rate`, or is taken from the upstream service
+/// tracing headers. The spans of the sampled traces are logged as usual. The
+/// spans of the unsampled traces are logged only if the tail rules keep them.
+struct TraceSampling {
+    double default_rate{1.0};
+    std::unordered_map<std::string, double> root_span_rates;
+
+    bool keep_errors{true};
+    // Zero disables the rule
+    std::chrono::milliseconds keep_slower_than{0};
+};
+
+TraceSampling Parse(const formats::json::Value&, formats::parse::To<TraceSampling>);
+
+}  // namespace tracing
+
+USERVER_NAMESPACE_END
@@ -1,16 +1,19 @@
 #include <tracing/span_impl.hpp>
 
 #include <type_traits>
+#include <variant>
 
 #include <fmt/compile.h>
 #include <fmt/format.h>
 
 #include <engine/task/task_context.hpp>
 #include <logging/log_helper_impl.hpp>
+#include <logging/request_log_buffer.hpp>
 #include <userver/engine/task/local_variable.hpp>
 #include <userver/logging/impl/logger_base.hpp>
 #include <userver/logging/impl/tag_writer.hpp>
 #include <userver/tracing/span.hpp>
+#include <userver/tracing/tags.hpp>
 #include <userver/tracing/tracer.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/encoding/hex.hpp>
@@ -95,6 +98,7 @@ Span::Impl::Impl(
     : name_(std::move(name)),
       is_no_log_span_(tracing::Tracer::IsNoLogSpan(name_)),
       log_level_(is_no_log_span_ ? logging::Level::kNone : log_level),
+      is_sampled_(parent ? parent->is_sampled_ : tracing::Tracer::ShouldSampleTrace(name_)),
       tracer_(std::move(tracer)),
       start_system_time_(std::chrono::system_clock::now()),
       start_steady_time_(std::chrono::steady_clock::now()),
@@ -106,6 +110,7 @@ Span::Impl::Impl(
     if (parent) {
         log_extra_inheritable_ = parent->log_extra_inheritable_;
         local_log_level_ = parent->local_log_level_;
+        request_log_buffer_ = parent->request_log_buffer_;
     }
 }
 
@@ -114,6 +119,11 @@ Span::Impl::~Impl() {
         return;
     }
 
+    // Spans of the unsampled traces are dropped before formatting any tags
+    if (!is_sampled_ && !ShouldKeepUnsampled()) {
+        return;
+    }
+
     {
         const impl::DetachLocalSpansScope ignore_local_span;
         logging::LogHelper lh{logging::GetDefaultLogger(), log_level_, source_location_};
@@ -194,6 +204,25 @@ bool Span::Impl::ShouldLog() const {
            local_log_level_.value_or(logging::Level::kTrace) <= log_level_;
 }
 
+bool Span::Impl::ShouldKeepUnsampled() const {
+    const auto is_error_flag = [](const logging::LogExtra::Value& value) {
+        return std::visit(
+            [](const auto& flag) {
+                if constexpr (std::is_same_v<std::decay_t<decltype(flag)>, std::string>) {
+                    return flag == "true" || flag == "1";
+                } else {
+                    return flag != 0;
+                }
+            },
+            value
+        );
+    };
+
+    const bool is_error = is_error_flag(log_extra_inheritable_.GetValue(kErrorFlag)) ||
+                          (log_extra_local_ && is_error_flag(log_extra_local_->GetValue(kErrorFlag)));
+    return tracing::Tracer::ShouldKeepUnsampledSpan(std::chrono::steady_clock::now() - start_steady_time_, is_error);
+}
+
 void Span::OptionalDeleter::operator()(Span::Impl* impl) const noexcept {
     if (do_delete) {
         std::default_delete<Impl>{}(impl);
@@ -351,6 +380,14 @@ void Span::AddTags(const logging::LogExtra& log_extra, utils::impl::InternalTag)
 
 impl::TimeStorage& Span::GetTimeStorage(utils::impl::InternalTag) { return pimpl_->GetTimeStorage(); }
 
+void Span::SetRequestLogBuffer(std::shared_ptr<logging::impl::RequestLogBuffer> buffer, utils::impl::InternalTag) {
+    pimpl_->request_log_buffer_ = std::move(buffer);
+}
+
+logging::impl::RequestLogBuffer* Span::GetRequestLogBuffer(utils::impl::InternalTag) const noexcept {
+    return pimpl_->request_log_buffer_.get();
+}
+
 std::string Span::GetTag(std::string_view tag) const {
     const auto& value = pimpl_->log_extra_inheritable_.GetValue(tag);
     const auto* s = std::get_if<std::string>(&value);
@@ -376,6 +413,8 @@ void Span::LogTo(logging::impl::TagWriter writer) const& { pimpl_->LogTo(writer)
 
 bool Span::ShouldLogDefault() const noexcept { return pimpl_->ShouldLog(); }
 
+bool Span::IsSampled() const noexcept { return pimpl_->is_sampled_; }
+
 void Span::DetachFromCoroStack() {
     if (pimpl_) pimpl_->DetachFromCoroStack();
 }
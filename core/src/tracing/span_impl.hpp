@@ -2,6 +2,7 @@
 
 #include <chrono>
 #include <list>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -82,11 +83,14 @@ private:
 
     static std::string GetParentIdForLogging(const Span::Impl* parent);
     bool ShouldLog() const;
+    bool ShouldKeepUnsampled() const;
 
     const std::string name_;
     const bool is_no_log_span_;
     logging::Level log_level_;
     std::optional<logging::Level> local_log_level_;
+    bool is_sampled_;
+    std::shared_ptr<logging::impl::RequestLogBuffer> request_log_buffer_;
 
     std::shared_ptr<Tracer> tracer_;
     logging::LogExtra log_extra_inheritable_;
@@ -4,9 +4,12 @@
 #include <logging/log_helper_impl.hpp>
 #include <logging/logging_test.hpp>
 #include <tracing/no_log_spans.hpp>
+#include <tracing/sampling.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/formats/json/serialize.hpp>
 #include <userver/tracing/span.hpp>
+#include <userver/tracing/span_builder.hpp>
+#include <userver/tracing/tags.hpp>
 #include <userver/tracing/tracer.hpp>
 #include <userver/utest/utest.hpp>
 #include <userver/utils/regex.hpp>
@@ -688,4 +691,102 @@ UTEST_F(Span, MakeSpanWithParentIdTraceIdLinkWithExisting) {
     }
 }
 
+UTEST_F(Span, HeadSampling) {
+    tracing::TraceSampling sampling;
+    sampling.default_rate = 0.0;
+    sampling.root_span_rates = {{"sampled_root", 1.0}};
+    tracing::Tracer::SetTraceSampling(std::move(sampling));
+
+    {
+        auto root_span = tracing::Span::MakeRootSpan("unsampled_root");
+        EXPECT_FALSE(root_span.IsSampled());
+        tracing::Span child_span{"unsampled_child"};
+        EXPECT_FALSE(child_span.IsSampled());
+        LOG_INFO() << "regular record";
+    }
+    {
+        auto root_span = tracing::Span::MakeRootSpan("sampled_root");
+        EXPECT_TRUE(root_span.IsSampled());
+        tracing::Span child_span{"sampled_child"};
+        EXPECT_TRUE(child_span.IsSampled());
+    }
+
+    logging::LogFlush();
+    EXPECT_THAT(GetStreamString(), Not(HasSubstr("stopwatch_name=unsampled_")));
+    EXPECT_THAT(GetStreamString(), HasSubstr("regular record"))
+        << "Sampling must not affect the non-span records";
+    EXPECT_THAT(GetStreamString(), HasSubstr("stopwatch_name=sampled_root"));
+    EXPECT_THAT(GetStreamString(), HasSubstr("stopwatch_name=sampled_child"));
+
+    tracing::Tracer::SetTraceSampling(tracing::TraceSampling{});
+}
+
+UTEST_F(Span, HeadSamplingUpstreamDecision) {
+    tracing::TraceSampling sampling;
+    sampling.default_rate = 0.0;
+    tracing::Tracer::SetTraceSampling(std::move(sampling));
+
+    {
+        auto root_span = tracing::Span::MakeRootSpan("root");
+        tracing::SpanBuilder builder{"upstream_sampled"};
+        EXPECT_FALSE(builder.GetTraceId().empty());
+        builder.SetSampled(true);
+        auto span = std::move(builder).Build();
+        EXPECT_TRUE(span.IsSampled());
+    }
+
+    logging::LogFlush();
+    EXPECT_THAT(GetStreamString(), HasSubstr("stopwatch_name=upstream_sampled"));
+    EXPECT_THAT(GetStreamString(), Not(HasSubstr("stopwatch_name=root")));
+
+    tracing::Tracer::SetTraceSampling(tracing::TraceSampling{});
+}
+
+UTEST_F(Span, TailSampling) {
+    tracing::TraceSampling sampling;
+    sampling.default_rate = 0.0;
+    sampling.keep_errors = true;
+    sampling.keep_slower_than = std::chrono::milliseconds{20};
+    tracing::Tracer::SetTraceSampling(std::move(sampling));
+
+    {
+        auto root_span = tracing::Span::MakeRootSpan("root");
+        {
+            tracing::Span span{"fast_span"};
+        }
+        {
+            tracing::Span span{"error_span"};
+            span.AddNonInheritableTag(tracing::kErrorFlag, true);
+        }
+        {
+            tracing::Span span{"slow_span"};
+            engine::SleepFor(std::chrono::milliseconds{30});
+        }
+    }
+
+    logging::LogFlush();
+    EXPECT_THAT(GetStreamString(), Not(HasSubstr("stopwatch_name=fast_span")));
+    EXPECT_THAT(GetStreamString(), HasSubstr("stopwatch_name=error_span"));
+    EXPECT_THAT(GetStreamString(), HasSubstr("stopwatch_name=slow_span"));
+    // The root span took longer than the slow span
+    EXPECT_THAT(GetStreamString(), HasSubstr("stopwatch_name=root"));
+
+    tracing::Tracer::SetTraceSampling(tracing::TraceSampling{});
+}
+
+UTEST_F(Span, TraceSamplingConfig) {
+    const auto sampling = formats::json::FromString(R"({
+        "default-rate": 0.5,
+        "root-span-rates": {"http/handler-ping": 0.01},
+        "keep-slower-than-ms": 100
+    })")
+                              .As<tracing::TraceSampling>();
+    EXPECT_EQ(sampling.default_rate, 0.5);
+    EXPECT_EQ(sampling.root_span_rates.at("http/handler-ping"), 0.01);
+    EXPECT_TRUE(sampling.keep_errors);
+    EXPECT_EQ(sampling.keep_slower_than, std::chrono::milliseconds{100});
+
+    UEXPECT_THROW(formats::json::FromString(R"({"default-rate": 2})").As<tracing::TraceSampling>(), std::exception);
+}
+
 USERVER_NAMESPACE_END
@@ -4,9 +4,11 @@
 
 #include <userver/logging/impl/tag_writer.hpp>
 #include <userver/rcu/rcu.hpp>
+#include <userver/utils/rand.hpp>
 #include <userver/utils/uuid4.hpp>
 
 #include <tracing/no_log_spans.hpp>
+#include <tracing/sampling.hpp>
 #include <tracing/span_impl.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -37,6 +39,11 @@ auto& GlobalNoLogSpans() {
     return spans;
 }
 
+auto& GlobalTraceSampling() {
+    static rcu::Variable<TraceSampling> sampling{};
+    return sampling;
+}
+
 auto& GlobalTracer() {
     static rcu::Variable<TracerPtr> tracer(tracing::MakeTracer({}, {}));
     return tracer;
@@ -77,6 +84,25 @@ bool Tracer::IsNoLogSpan(const std::string& name) {
     return ValueMatchesOneOfPrefixes(name, spans->prefixes) || spans->names.find(name) != spans->names.end();
 }
 
+void Tracer::SetTraceSampling(TraceSampling&& sampling) { GlobalTraceSampling().Assign(std::move(sampling)); }
+
+bool Tracer::ShouldSampleTrace(const std::string& root_span_name) {
+    const auto sampling = GlobalTraceSampling().Read();
+
+    const auto it = sampling->root_span_rates.find(root_span_name);
+    const auto rate = (it == sampling->root_span_rates.end() ? sampling->default_rate : it->second);
+    if (rate >= 1.0) return true;
+    if (rate <= 0.0) return false;
+    return utils::RandRange(1.0) < rate;
+}
+
+bool Tracer::ShouldKeepUnsampledSpan(std::chrono::steady_clock::duration duration, bool is_error) {
+    const auto sampling = GlobalTraceSampling().Read();
+
+    if (is_error && sampling->keep_errors) return true;
+    return sampling->keep_slower_than.count() > 0 && duration >= sampling->keep_slower_than;
+}
+
 void Tracer::SetTracer(std::shared_ptr<Tracer> tracer) { GlobalTracer().Assign(std::move(tracer)); }
 
 std::shared_ptr<Tracer> Tracer::GetTracer() { return GlobalTracer().ReadCopy(); }
@@ -6,6 +6,7 @@
 #include <cerrno>
 #endif
 
+#include <userver/compiler/thread_local.hpp>
 #include <userver/utils/thread_name.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -35,6 +36,15 @@ std::error_code MallCtl(const char* name) {
     return MakeErrorCode(rc);
 }
 
+// jemalloc keeps a per-thread counter of the allocated bytes, its address is
+// stable for the lifetime of the thread.
+compiler::ThreadLocal local_thread_allocated_ptr = []() -> std::uint64_t* {
+    std::uint64_t* ptr = nullptr;
+    size_t size = sizeof(ptr);
+    if (mallctl("thread.allocatedp", &ptr, &size, nullptr, 0) != 0) return nullptr;
+    return ptr;
+};
+
 void MallocStatPrintCb(void* data, const char* msg) {
     auto* s = static_cast<std::string*>(data);
     *s += msg;
@@ -65,6 +75,11 @@ std::error_code EnableBgThreads() {
 
 std::error_code StopBgThreads() { return MallCtl<bool>("background_thread", false); }
 
+std::uint64_t GetThreadAllocatedBytes() noexcept {
+    auto allocated_ptr = local_thread_allocated_ptr.Use();
+    return *allocated_ptr ? **allocated_ptr : 0;
+}
+
 }  // namespace utils::jemalloc
 
 USERVER_NAMESPACE_END
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <system_error>
 
@@ -22,6 +23,9 @@ std::error_code EnableBgThreads();
 // blocking
 std::error_code StopBgThreads();
 
+// Total bytes allocated by the calling thread, 0 if jemalloc is disabled
+std::uint64_t GetThreadAllocatedBytes() noexcept;
+
 }  // namespace utils::jemalloc
 
 USERVER_NAMESPACE_END
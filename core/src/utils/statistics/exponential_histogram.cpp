@@ -0,0 +1,356 @@
+#include <userver/utils/statistics/exponential_histogram.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <utility>
+
+#include <concurrent/impl/interference_shield.hpp>
+#include <userver/compiler/thread_local.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/histogram.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+namespace impl::exponential_histogram {
+
+inline constexpr std::size_t kCountersPerLine =
+    concurrent::impl::kDestructiveInterferenceSize / sizeof(std::atomic<std::uint64_t>);
+
+struct alignas(concurrent::impl::kDestructiveInterferenceSize) CounterLine final {
+    std::atomic<std::uint64_t> values[kCountersPerLine]{};
+};
+
+}  // namespace impl::exponential_histogram
+
+using impl::exponential_histogram::CounterLine;
+using impl::exponential_histogram::kCountersPerLine;
+
+namespace {
+
+// The more stripes, the less contention, but the more memory and the slower
+// reads. 16 stripes are enough to make the contention negligible in practice.
+constexpr std::size_t kMaxStripeCount = 16;
+
+// Bounds used for serialization, see utils::statistics::Histogram
+constexpr std::size_t kMaxDumpBucketCount = 50;
+
+std::atomic<std::size_t> next_stripe{0};
+
+compiler::ThreadLocal local_stripe = [] { return next_stripe.fetch_add(1, std::memory_order_relaxed); };
+
+// Multiplies by 2^by, unlike the shift is defined for negative indices.
+std::int64_t Upscale(std::int64_t index, int by) noexcept { return index * (std::int64_t{1} << by); }
+
+// Rounds towards negative infinity, unlike the division.
+std::int64_t FloorShift(std::int64_t index, int by) noexcept {
+    return index >= 0 ? index >> by : -((-index - 1) >> by) - 1;
+}
+
+// 2^(k / 2^scale) for k in [0, 2^scale]
+double SubBucketBound(int scale, std::int64_t k) noexcept {
+    return std::exp2(static_cast<double>(k) / static_cast<double>(std::int64_t{1} << scale));
+}
+
+// The lower bound of the bucket `index` at `scale`
+double BoundAt(int scale, std::int64_t index) noexcept {
+    if (scale <= 0) {
+        return std::ldexp(1.0, static_cast<int>(std::clamp<std::int64_t>(Upscale(index, -scale), -2000, 2000)));
+    }
+    const auto whole = FloorShift(index, scale);
+    const auto fraction = index - Upscale(whole, scale);
+    return std::ldexp(SubBucketBound(scale, fraction), static_cast<int>(std::clamp<std::int64_t>(whole, -2000, 2000)));
+}
+
+// Index of the bucket `(BoundAt(index), BoundAt(index + 1)]` that contains a
+// positive finite `value`.
+std::int64_t ComputeIndex(double value, int scale) noexcept {
+    int exponent = 0;
+    // value == mantissa * 2^exponent, mantissa is in [1, 2)
+    const auto mantissa = std::frexp(value, &exponent) * 2;
+    --exponent;
+
+    if (mantissa == 1.0) {
+        // Powers of 2 belong to the lower bucket
+        return scale <= 0 ? FloorShift(exponent - 1, -scale) : Upscale(exponent, scale) - 1;
+    }
+    if (scale <= 0) return FloorShift(exponent, -scale);
+
+    // Count of the sub-bucket bounds less than mantissa, std::log2 gives an
+    // estimation that is corrected to match SubBucketBound exactly.
+    const std::int64_t sub_bucket_count = std::int64_t{1} << scale;
+    auto sub = std::clamp<std::int64_t>(
+        static_cast<std::int64_t>(std::log2(mantissa) * sub_bucket_count), 0, sub_bucket_count - 1
+    );
+    while (sub > 0 && SubBucketBound(scale, sub) >= mantissa) --sub;
+    while (sub + 1 < sub_bucket_count && SubBucketBound(scale, sub + 1) < mantissa) ++sub;
+    return Upscale(exponent, scale) + sub;
+}
+
+}  // namespace
+
+ExponentialHistogramSnapshot::ExponentialHistogramSnapshot(
+    int scale,
+    double zero_threshold,
+    std::size_t max_bucket_count
+)
+    : scale_(scale), zero_threshold_(zero_threshold), max_bucket_count_(max_bucket_count) {
+    UINVARIANT(scale >= kMinScale && scale <= kMaxScale, "Exponential histogram scale is out of range");
+    UINVARIANT(zero_threshold >= 0 && std::isfinite(zero_threshold), "Zero threshold must be non-negative");
+    UINVARIANT(max_bucket_count >= 2, "Exponential histogram must have at least 2 buckets");
+}
+
+void ExponentialHistogramSnapshot::Account(double value, std::uint64_t count) {
+    if (std::isnan(value)) return;
+    if (value <= zero_threshold_) {
+        zero_count_ += count;
+        return;
+    }
+    value = std::min(value, std::numeric_limits<double>::max());
+    AccountBucket(scale_, ComputeIndex(value, scale_), count);
+}
+
+void ExponentialHistogramSnapshot::AccountBucket(int scale, std::int32_t index, std::uint64_t count) {
+    if (count == 0) return;
+    if (BoundAt(scale, std::int64_t{index} + 1) <= zero_threshold_) {
+        zero_count_ += count;
+        return;
+    }
+
+    if (scale < scale_) Downscale(scale_ - scale);
+    std::int64_t current_index = FloorShift(index, scale - scale_);
+
+    std::int64_t min_index = buckets_.empty() ? current_index : std::min<std::int64_t>(current_index, offset_);
+    std::int64_t max_index =
+        buckets_.empty() ? current_index
+                         : std::max<std::int64_t>(current_index, offset_ + static_cast<std::int64_t>(buckets_.size()) - 1);
+    while (max_index - min_index + 1 > static_cast<std::int64_t>(max_bucket_count_)) {
+        Downscale(1);
+        current_index = FloorShift(current_index, 1);
+        min_index = FloorShift(min_index, 1);
+        max_index = FloorShift(max_index, 1);
+    }
+
+    Extend(static_cast<std::int32_t>(min_index), static_cast<std::int32_t>(max_index));
+    buckets_[current_index - offset_] += count;
+}
+
+void ExponentialHistogramSnapshot::AccountOverflow(std::uint64_t count) { overflow_count_ += count; }
+
+void ExponentialHistogramSnapshot::Add(const ExponentialHistogramSnapshot& other) {
+    if (&other == this) {
+        const auto copy = other;
+        Add(copy);
+        return;
+    }
+
+    if (other.zero_threshold_ > zero_threshold_) {
+        zero_threshold_ = other.zero_threshold_;
+        for (std::size_t i = 0; i < buckets_.size(); ++i) {
+            if (GetUpperBound(offset_ + static_cast<std::int32_t>(i)) > zero_threshold_) break;
+            zero_count_ += std::exchange(buckets_[i], 0);
+        }
+    }
+
+    zero_count_ += other.zero_count_;
+    overflow_count_ += other.overflow_count_;
+    for (std::size_t i = 0; i < other.buckets_.size(); ++i) {
+        AccountBucket(other.scale_, other.offset_ + static_cast<std::int32_t>(i), other.buckets_[i]);
+    }
+}
+
+void ExponentialHistogramSnapshot::Downscale(int by) {
+    if (by <= 0) return;
+    UINVARIANT(scale_ - by >= kMinScale, "Exponential histogram scale is out of range");
+    scale_ -= by;
+    if (buckets_.empty()) return;
+
+    const auto new_offset = FloorShift(offset_, by);
+    const auto new_max_index = FloorShift(offset_ + static_cast<std::int64_t>(buckets_.size()) - 1, by);
+    std::vector<std::uint64_t> new_buckets(new_max_index - new_offset + 1, 0);
+    for (std::size_t i = 0; i < buckets_.size(); ++i) {
+        new_buckets[FloorShift(offset_ + static_cast<std::int64_t>(i), by) - new_offset] += buckets_[i];
+    }
+
+    offset_ = static_cast<std::int32_t>(new_offset);
+    buckets_ = std::move(new_buckets);
+}
+
+void ExponentialHistogramSnapshot::Extend(std::int32_t min_index, std::int32_t max_index) {
+    if (buckets_.empty()) {
+        offset_ = min_index;
+        buckets_.assign(max_index - min_index + 1, 0);
+        return;
+    }
+    if (min_index < offset_) {
+        buckets_.insert(buckets_.begin(), offset_ - min_index, 0);
+        offset_ = min_index;
+    }
+    const auto size = static_cast<std::size_t>(max_index - offset_ + 1);
+    if (size > buckets_.size()) buckets_.resize(size, 0);
+}
+
+std::uint64_t ExponentialHistogramSnapshot::GetTotalCount() const noexcept {
+    std::uint64_t result = zero_count_ + overflow_count_;
+    for (const auto count : buckets_) result += count;
+    return result;
+}
+
+double ExponentialHistogramSnapshot::GetLowerBound(std::int32_t index) const noexcept {
+    return BoundAt(scale_, index);
+}
+
+double ExponentialHistogramSnapshot::GetUpperBound(std::int32_t index) const noexcept {
+    return BoundAt(scale_, std::int64_t{index} + 1);
+}
+
+double ExponentialHistogramSnapshot::GetPercentile(double percent) const noexcept {
+    const auto total = GetTotalCount();
+    if (total == 0) return 0;
+
+    const auto want = std::clamp<std::uint64_t>(
+        static_cast<std::uint64_t>(std::ceil(static_cast<double>(total) * percent / 100)), 1, total
+    );
+    std::uint64_t sum = zero_count_;
+    if (sum >= want) return zero_threshold_;
+
+    for (std::size_t i = 0; i < buckets_.size(); ++i) {
+        sum += buckets_[i];
+        if (sum >= want) return GetUpperBound(offset_ + static_cast<std::int32_t>(i));
+    }
+    if (overflow_count_ != 0) return std::numeric_limits<double>::infinity();
+    UASSERT_MSG(false, "Percentile is out of the buckets");
+    return GetUpperBound(offset_ + static_cast<std::int32_t>(buckets_.size()) - 1);
+}
+
+ExponentialHistogram::ExponentialHistogram(double min_value, double max_value, int scale) : scale_(scale) {
+    UINVARIANT(
+        scale >= 0 && scale <= ExponentialHistogramSnapshot::kMaxScale, "Exponential histogram scale is out of range"
+    );
+    UINVARIANT(
+        min_value >= std::numeric_limits<float>::min() && max_value <= std::numeric_limits<float>::max(),
+        "Exponential histogram bounds must fit in 'float'"
+    );
+    UINVARIANT(min_value < max_value, "Exponential histogram bounds must be sorted");
+
+    int min_exponent = 0;
+    std::frexp(min_value, &min_exponent);
+    zero_threshold_ = std::ldexp(1.0, min_exponent - 1);
+    min_index_ = static_cast<std::int32_t>(Upscale(min_exponent - 1, scale_));
+    // Round up to the last bucket of the octave
+    max_index_ = static_cast<std::int32_t>(Upscale(FloorShift(ComputeIndex(max_value, scale_), scale_) + 1, scale_) - 1);
+    max_threshold_ = BoundAt(scale_, std::int64_t{max_index_} + 1);
+
+    for (std::int64_t k = 1; k < (std::int64_t{1} << scale_); ++k) {
+        sub_bucket_bounds_.push_back(SubBucketBound(scale_, k));
+    }
+
+    // The zero bucket is the slot 0, the overflow bucket is the last slot
+    slot_count_ = max_index_ - min_index_ + 3;
+    lines_per_stripe_ = (slot_count_ + kCountersPerLine - 1) / kCountersPerLine;
+    stripe_count_ = std::clamp<std::size_t>(std::thread::hardware_concurrency(), 1, kMaxStripeCount);
+    counters_ = std::make_unique<CounterLine[]>(lines_per_stripe_ * stripe_count_);
+}
+
+ExponentialHistogram::~ExponentialHistogram() = default;
+
+std::size_t ExponentialHistogram::GetSlot(double value) const noexcept {
+    if (!(value > zero_threshold_)) return 0;
+    if (!(value <= max_threshold_)) return slot_count_ - 1;
+
+    int exponent = 0;
+    const auto mantissa = std::frexp(value, &exponent) * 2;
+    --exponent;
+
+    // Same as ComputeIndex, but with the precomputed sub-bucket bounds
+    auto index = Upscale(exponent, scale_);
+    if (mantissa == 1.0) {
+        --index;
+    } else {
+        index += std::lower_bound(sub_bucket_bounds_.begin(), sub_bucket_bounds_.end(), mantissa) -
+                 sub_bucket_bounds_.begin();
+    }
+    return static_cast<std::size_t>(index - min_index_) + 1;
+}
+
+void ExponentialHistogram::Account(double value, std::uint64_t count) noexcept {
+    if (std::isnan(value)) return;
+
+    const auto slot = GetSlot(value);
+    std::size_t stripe = 0;
+    {
+        auto local_stripe_scope = local_stripe.Use();
+        stripe = *local_stripe_scope % stripe_count_;
+    }
+    auto& counter = counters_[stripe * lines_per_stripe_ + slot / kCountersPerLine].values[slot % kCountersPerLine];
+    counter.fetch_add(count, std::memory_order_relaxed);
+}
+
+template <typename Func>
+void ExponentialHistogram::ForEachSlotTotal(Func func) const {
+    for (std::size_t slot = 0; slot < slot_count_; ++slot) {
+        std::uint64_t total = 0;
+        for (std::size_t stripe = 0; stripe < stripe_count_; ++stripe) {
+            const auto& line = counters_[stripe * lines_per_stripe_ + slot / kCountersPerLine];
+            total += line.values[slot % kCountersPerLine].load(std::memory_order_relaxed);
+        }
+        if (total != 0) func(slot, total);
+    }
+}
+
+ExponentialHistogramSnapshot ExponentialHistogram::GetSnapshot(std::size_t max_bucket_count) const {
+    ExponentialHistogramSnapshot snapshot{scale_, zero_threshold_, max_bucket_count};
+    ForEachSlotTotal([&](std::size_t slot, std::uint64_t total) {
+        if (slot == 0) {
+            snapshot.Account(0, total);
+        } else if (slot == slot_count_ - 1) {
+            snapshot.AccountOverflow(total);
+        } else {
+            snapshot.AccountBucket(scale_, min_index_ + static_cast<std::int32_t>(slot) - 1, total);
+        }
+    });
+    return snapshot;
+}
+
+void ResetMetric(ExponentialHistogram& histogram) noexcept {
+    for (std::size_t i = 0; i < histogram.lines_per_stripe_ * histogram.stripe_count_; ++i) {
+        for (auto& value : histogram.counters_[i].values) value.store(0, std::memory_order_relaxed);
+    }
+}
+
+void DumpMetric(Writer& writer, const ExponentialHistogram& histogram) {
+    // The bounds depend only on the configured range, so that the metric
+    // is summable across hosts and its bounds do not change over time.
+    int scale = histogram.scale_;
+    const auto get_bucket_count = [&histogram](int by) {
+        return FloorShift(histogram.max_index_, by) - FloorShift(histogram.min_index_, by) + 1;
+    };
+    while (1 + get_bucket_count(histogram.scale_ - scale) > static_cast<std::int64_t>(kMaxDumpBucketCount)) --scale;
+
+    auto snapshot = histogram.GetSnapshot(histogram.slot_count_);
+    snapshot.Downscale(snapshot.GetScale() - scale);
+
+    const auto by = histogram.scale_ - scale;
+    std::vector<double> bounds{histogram.zero_threshold_};
+    for (auto index = FloorShift(histogram.min_index_, by); index <= FloorShift(histogram.max_index_, by); ++index) {
+        bounds.push_back(BoundAt(scale, index + 1));
+    }
+
+    Histogram result{bounds};
+    result.Account(0, snapshot.GetZeroCount());
+    const auto buckets = snapshot.GetBuckets();
+    for (std::size_t i = 0; i < buckets.size(); ++i) {
+        result.Account(snapshot.GetUpperBound(snapshot.GetOffset() + static_cast<std::int32_t>(i)), buckets[i]);
+    }
+    result.Account(std::numeric_limits<double>::infinity(), snapshot.GetOverflowCount());
+    writer = result.GetView();
+}
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,248 @@
+#include <userver/utils/statistics/exponential_histogram.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/fixed_array.hpp>
+#include <userver/utils/rand.hpp>
+#include <userver/utils/statistics/fmt.hpp>
+#include <userver/utils/statistics/prometheus.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/testing.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using utils::statistics::ExponentialHistogram;
+using utils::statistics::ExponentialHistogramSnapshot;
+
+std::vector<double> RandomValues(std::size_t count) {
+    std::vector<double> values(count);
+    for (auto& value : values) {
+        value = std::exp(utils::RandRange(0.0, 10.0));
+    }
+    return values;
+}
+
+double ExactPercentile(std::vector<double> values, double percent) {
+    std::sort(values.begin(), values.end());
+    const auto rank = static_cast<std::size_t>(std::ceil(values.size() * percent / 100));
+    return values[std::max<std::size_t>(rank, 1) - 1];
+}
+
+}  // namespace
+
+TEST(StatisticsExponentialHistogram, Sample) {
+    /// [sample]
+    utils::statistics::Storage storage;
+
+    // Latencies in milliseconds
+    utils::statistics::ExponentialHistogram histogram{0.01, 100'000};
+
+    auto statistics_holder =
+        storage.RegisterWriter("test", [&](utils::statistics::Writer& writer) { writer = histogram; });
+
+    histogram.Account(3.5);
+    histogram.Account(42, 10);  // Account 10 times
+    histogram.Account(0.001);   // Too small, goes to the zero bucket
+
+    const auto snapshot = histogram.GetSnapshot();
+    EXPECT_EQ(snapshot.GetTotalCount(), 12);
+    EXPECT_NEAR(snapshot.GetPercentile(95), 42, 42 * 0.1);
+
+    const utils::statistics::Snapshot metrics{storage};
+    EXPECT_EQ(metrics.SingleMetric("test").AsHistogram().GetTotalCount(), 12);
+    /// [sample]
+}
+
+TEST(StatisticsExponentialHistogram, BucketBounds) {
+    ExponentialHistogramSnapshot snapshot{2};
+    snapshot.Account(1);
+    snapshot.Account(4);
+    snapshot.Account(4.1);
+
+    EXPECT_EQ(snapshot.GetScale(), 2);
+    const auto buckets = snapshot.GetBuckets();
+    ASSERT_EQ(buckets.size(), 10);
+
+    // Powers of 2 belong to the lower bucket
+    EXPECT_EQ(snapshot.GetOffset(), -1);
+    EXPECT_EQ(snapshot.GetUpperBound(-1), 1);
+    EXPECT_EQ(buckets[0], 1);
+    EXPECT_EQ(snapshot.GetUpperBound(7), 4);
+    EXPECT_EQ(buckets[8], 1);
+    EXPECT_EQ(snapshot.GetLowerBound(8), 4);
+    EXPECT_EQ(buckets[9], 1);
+}
+
+TEST(StatisticsExponentialHistogram, Downscale) {
+    ExponentialHistogramSnapshot snapshot{ExponentialHistogramSnapshot::kMaxScale, 0, 20};
+    snapshot.Account(1.5);
+    EXPECT_EQ(snapshot.GetScale(), ExponentialHistogramSnapshot::kMaxScale);
+
+    snapshot.Account(1000, 2);
+    EXPECT_LE(snapshot.GetBuckets().size(), 20);
+    EXPECT_LT(snapshot.GetScale(), ExponentialHistogramSnapshot::kMaxScale);
+    EXPECT_EQ(snapshot.GetTotalCount(), 3);
+    EXPECT_LT(snapshot.GetPercentile(30), 2 * 1.5);
+    EXPECT_GE(snapshot.GetPercentile(100), 1000);
+    EXPECT_LT(snapshot.GetPercentile(100), 2 * 1000);
+}
+
+TEST(StatisticsExponentialHistogram, Percentiles) {
+    const auto values = RandomValues(10'000);
+    ExponentialHistogram histogram{1, 100'000};
+    for (const auto value : values) histogram.Account(value);
+
+    const auto snapshot = histogram.GetSnapshot();
+    EXPECT_EQ(snapshot.GetTotalCount(), values.size());
+
+    const auto max_error = std::exp2(std::exp2(-snapshot.GetScale())) - 1;
+    for (const double percent : {1.0, 50.0, 90.0, 99.0, 99.9, 100.0}) {
+        const auto exact = ExactPercentile(values, percent);
+        const auto estimate = snapshot.GetPercentile(percent);
+        EXPECT_GE(estimate, exact) << percent;
+        EXPECT_LE(estimate, exact * (1 + max_error)) << percent;
+    }
+}
+
+TEST(StatisticsExponentialHistogram, MergeIsExact) {
+    const auto values1 = RandomValues(1'000);
+    const auto values2 = RandomValues(1'000);
+
+    ExponentialHistogramSnapshot fine{5};
+    ExponentialHistogramSnapshot coarse{2};
+    ExponentialHistogramSnapshot expected{2};
+    for (const auto value : values1) {
+        fine.Account(value);
+        expected.Account(value);
+    }
+    for (const auto value : values2) {
+        coarse.Account(value);
+        expected.Account(value);
+    }
+
+    fine.Add(coarse);
+    EXPECT_EQ(fine.GetScale(), 2);
+    EXPECT_EQ(fine.GetOffset(), expected.GetOffset());
+    EXPECT_EQ(
+        std::vector<std::uint64_t>(fine.GetBuckets().begin(), fine.GetBuckets().end()),
+        std::vector<std::uint64_t>(expected.GetBuckets().begin(), expected.GetBuckets().end())
+    );
+
+    // Merging is commutative
+    coarse.Add(fine);
+    fine.Add(fine);
+    EXPECT_EQ(coarse.GetTotalCount(), 3'000);
+    EXPECT_EQ(fine.GetTotalCount(), 4'000);
+}
+
+TEST(StatisticsExponentialHistogram, ZeroThreshold) {
+    ExponentialHistogramSnapshot snapshot{3, 0.5};
+    snapshot.Account(0.1);
+    snapshot.Account(0.5);
+    snapshot.Account(0.6);
+    EXPECT_EQ(snapshot.GetZeroCount(), 2);
+    EXPECT_EQ(snapshot.GetPercentile(50), 0.5);
+
+    ExponentialHistogramSnapshot other{3, 1};
+    other.Add(snapshot);
+    EXPECT_EQ(other.GetZeroCount(), 3);
+    EXPECT_EQ(other.GetZeroThreshold(), 1);
+}
+
+TEST(StatisticsExponentialHistogram, OutOfRange) {
+    ExponentialHistogram histogram{1, 1000};
+    histogram.Account(0.5);
+    histogram.Account(1e9);
+    histogram.Account(std::nan(""));
+
+    const auto snapshot = histogram.GetSnapshot();
+    EXPECT_EQ(snapshot.GetTotalCount(), 2);
+    EXPECT_EQ(snapshot.GetZeroCount(), 1);
+    EXPECT_EQ(snapshot.GetOverflowCount(), 1);
+    EXPECT_EQ(snapshot.GetPercentile(50), snapshot.GetZeroThreshold());
+    EXPECT_EQ(snapshot.GetPercentile(100), std::numeric_limits<double>::infinity());
+
+    // The values up to the rounded up max value are in range
+    ExponentialHistogram rounded{1, 1000};
+    rounded.Account(1024);
+    EXPECT_EQ(rounded.GetSnapshot().GetOverflowCount(), 0);
+    EXPECT_EQ(rounded.GetSnapshot().GetPercentile(100), 1024);
+
+    ExponentialHistogramSnapshot merged;
+    merged.Add(snapshot);
+    merged.Add(snapshot);
+    EXPECT_EQ(merged.GetOverflowCount(), 2);
+    EXPECT_EQ(merged.GetTotalCount(), 4);
+}
+
+TEST(StatisticsExponentialHistogram, Reset) {
+    ExponentialHistogram histogram{1, 1000};
+    histogram.Account(10, 5);
+    ResetMetric(histogram);
+    EXPECT_EQ(histogram.GetSnapshot().GetTotalCount(), 0);
+}
+
+TEST(StatisticsExponentialHistogram, Prometheus) {
+    utils::statistics::Storage storage;
+    ExponentialHistogram histogram{1, 8, 0};
+    histogram.Account(0.5);
+    histogram.Account(3, 2);
+    histogram.Account(8);
+    histogram.Account(9);
+    auto statistics_holder =
+        storage.RegisterWriter("test", [&](utils::statistics::Writer& writer) { writer = histogram; });
+
+    constexpr std::string_view expected = R"(# TYPE test histogram
+test_bucket{le="1"} 1
+test_bucket{le="2"} 1
+test_bucket{le="4"} 3
+test_bucket{le="8"} 4
+test_bucket{le="+Inf"} 5
+test_count{} 5
+)";
+    EXPECT_EQ(utils::statistics::ToPrometheusFormat(storage), expected);
+}
+
+TEST(StatisticsExponentialHistogram, DumpBucketLimit) {
+    utils::statistics::Storage storage;
+    ExponentialHistogram histogram{1e-6, 1e6, ExponentialHistogramSnapshot::kMaxScale};
+    histogram.Account(1e-3);
+    histogram.Account(1e3);
+    histogram.Account(1e7, 2);
+    auto statistics_holder =
+        storage.RegisterWriter("test", [&](utils::statistics::Writer& writer) { writer = histogram; });
+
+    const utils::statistics::Snapshot snapshot{storage};
+    const auto view = snapshot.SingleMetric("test").AsHistogram();
+    EXPECT_LE(view.GetBucketCount(), 50);
+    EXPECT_EQ(view.GetTotalCount(), 4);
+    // The values above the max value are not mixed into the last bucket
+    EXPECT_EQ(view.GetValueAtInf(), 2);
+    EXPECT_EQ(view.GetValueAt(view.GetBucketCount() - 1), 0);
+}
+
+UTEST_MT(StatisticsExponentialHistogram, Concurrent, 4) {
+    constexpr std::size_t kTasks = 8;
+    constexpr std::size_t kIterations = 10'000;
+    ExponentialHistogram histogram{1, 1000};
+
+    auto tasks = utils::GenerateFixedArray(kTasks, [&](std::size_t i) {
+        return engine::AsyncNoSpan([&histogram, i] {
+            for (std::size_t j = 0; j < kIterations; ++j) histogram.Account(i + 1);
+        });
+    });
+    for (auto& task : tasks) task.Get();
+
+    const auto snapshot = histogram.GetSnapshot();
+    EXPECT_EQ(snapshot.GetTotalCount(), kTasks * kIterations);
+    EXPECT_EQ(snapshot.GetPercentile(100), kTasks);
+}
+
+USERVER_NAMESPACE_END
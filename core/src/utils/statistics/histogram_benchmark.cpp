@@ -5,7 +5,9 @@
 
 #include <userver/utils/algo.hpp>
 #include <userver/utils/rand.hpp>
+#include <userver/utils/statistics/exponential_histogram.hpp>
 #include <utils/gbench_auxilary.hpp>
+#include <utils/impl/parallelize_benchmark.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -34,4 +36,66 @@ void HistogramAccount(benchmark::State& state) {
 // poorly (fixed).
 BENCHMARK(HistogramAccount)->DenseRange(10, 50, 10);
 
+namespace {
+
+std::vector<double> MakeLatencies() {
+    auto values = std::vector<double>(1024);
+    for (auto& value : values) {
+        value = utils::RandRange(0.1, 10'000.0);
+    }
+    return Launder(std::move(values));
+}
+
+class HistogramFactory final {
+public:
+    static auto Create() {
+        std::vector<double> bounds;
+        for (double bound = 0.1; bound < 10'000; bound *= 1.5) bounds.push_back(bound);
+        return utils::statistics::Histogram{bounds};
+    }
+};
+
+class ExponentialHistogramFactory final {
+public:
+    static auto Create() { return std::make_unique<utils::statistics::ExponentialHistogram>(0.1, 10'000); }
+};
+
+void AccountTo(utils::statistics::Histogram& histogram, double value) { histogram.Account(value); }
+
+void AccountTo(std::unique_ptr<utils::statistics::ExponentialHistogram>& histogram, double value) {
+    histogram->Account(value);
+}
+
+}  // namespace
+
+void ExponentialHistogramAccount(benchmark::State& state) {
+    const auto values = MakeLatencies();
+    utils::statistics::ExponentialHistogram histogram{0.1, 10'000, static_cast<int>(state.range(0))};
+
+    while (state.KeepRunningBatch(values.size())) {
+        for (const auto value : values) {
+            histogram.Account(value);
+        }
+    }
+}
+
+BENCHMARK(ExponentialHistogramAccount)->DenseRange(0, 6, 3);
+
+// Compares the cost of recording into a single histogram from several threads
+template <typename Factory>
+void HistogramAccountParallel(benchmark::State& state) {
+    const auto values = MakeLatencies();
+    auto histogram = Factory::Create();
+
+    RunParallelBenchmark(state, [&](auto& range) {
+        std::size_t i = 0;
+        for ([[maybe_unused]] auto _ : range) {
+            AccountTo(histogram, values[i++ % values.size()]);
+        }
+    });
+}
+
+BENCHMARK_TEMPLATE(HistogramAccountParallel, HistogramFactory)->RangeMultiplier(2)->Range(1, 16);
+BENCHMARK_TEMPLATE(HistogramAccountParallel, ExponentialHistogramFactory)->RangeMultiplier(2)->Range(1, 16);
+
 USERVER_NAMESPACE_END
@@ -2,11 +2,12 @@
 
 #include <algorithm>
 #include <iterator>
-#include <unordered_map>
+#include <optional>
 
 #include <fmt/compile.h>
 #include <fmt/format.h>
 
+#include <userver/utils/assert.hpp>
 #include <userver/utils/impl/transparent_hash.hpp>
 #include <userver/utils/overloaded.hpp>
 #include <userver/utils/statistics/fmt.hpp>
@@ -18,28 +19,80 @@ namespace utils::statistics {
 
 namespace impl {
 
-namespace {
+// Names that were not used for this number of scrapes are dropped from
+// the cache
+inline constexpr std::uint64_t kMaxUnusedScrapes = 16;
+
+struct CachedName final {
+    std::string name;
+    std::uint64_t last_scrape{0};
+};
+
+using CachedNames = utils::impl::TransparentMap<std::string, CachedName>;
 
-enum class Typed { kYes, kNo };
+struct PrometheusNamesCache final {
+    template <typename Convert>
+    static CachedName& Get(CachedNames& names, std::string_view raw, Convert convert) {
+        if (auto* const cached = utils::impl::FindTransparentOrNullptr(names, raw)) {
+            return *cached;
+        }
+        return names.emplace(std::string{raw}, CachedName{convert(raw), 0}).first->second;
+    }
+
+    void StartScrape() {
+        ++scrape;
+        if (scrape % kMaxUnusedScrapes != 0) return;
 
-template <Typed IsTyped>
+        const auto is_stale = [this](const auto& item) { return item.second.last_scrape + kMaxUnusedScrapes < scrape; };
+        for (auto* names : {&metrics, &labels}) {
+            for (auto it = names->begin(); it != names->end();) {
+                it = is_stale(*it) ? names->erase(it) : std::next(it);
+            }
+        }
+    }
+
+    // metric path -> Prometheus metric name
+    CachedNames metrics;
+    // label name -> Prometheus label name
+    CachedNames labels;
+    std::uint64_t scrape{0};
+};
+
+namespace {
+
+template <PrometheusFormatter::Types Types>
 class FormatBuilder final : public utils::statistics::BaseFormatBuilder {
 public:
-    explicit FormatBuilder() = default;
+    FormatBuilder(
+        PrometheusNamesCache& cache,
+        std::size_t chunk_size = 0,
+        std::optional<PrometheusFormatter::ChunkConsumer> consumer = std::nullopt
+    )
+        : cache_(cache), chunk_size_(chunk_size), consumer_(consumer) {
+        cache_.StartScrape();
+    }
 
     void HandleMetric(std::string_view path, utils::statistics::LabelsSpan labels, const MetricValue& value) override {
         if (value.IsHistogram()) {
             HandleHistogram(path, labels, value);
-            return;
+        } else {
+            DumpMetricNameAndType(path, value);
+            DumpLabels(labels);
+            fmt::format_to(std::back_inserter(buf_), FMT_COMPILE(" {}\n"), value);
         }
 
-        DumpMetricNameAndType(path, value);
-        DumpLabels(labels);
-        fmt::format_to(std::back_inserter(buf_), FMT_COMPILE(" {}\n"), value);
+        if (consumer_ && buf_.size() >= chunk_size_) Flush();
     }
 
     std::string Release() { return fmt::to_string(buf_); }
 
+    void Flush() {
+        UASSERT(consumer_);
+        if (buf_.size() == 0) return;
+        (*consumer_)(fmt::to_string(buf_));
+        buf_.clear();
+    }
+
 private:
     void AppendHistogramMetric(
         std::string_view metric_suffix,
@@ -64,8 +117,7 @@ private:
     void HandleHistogram(std::string_view path, utils::statistics::LabelsSpan labels, const MetricValue& value) {
         static constexpr std::string_view kBucket = "bucket";
 
-        const auto prometheus_name = impl::ToPrometheusName(path);
-        DumpMetricType(prometheus_name, value);
+        const auto& prometheus_name = GetMetricName(path, value);
 
         auto histogram = value.AsHistogram();
         const auto bucket_count = histogram.GetBucketCount();
@@ -91,20 +143,22 @@ private:
         );
     }
 
-    void DumpMetricNameAndType(std::string_view name, const MetricValue& value) {
-        if (const auto* const converted = utils::impl::FindTransparentOrNullptr(metrics_, name)) {
-            buf_.append(*converted);
-            return;
+    // Writes the type before the first metric with the name in this scrape
+    const std::string& GetMetricName(std::string_view path, const MetricValue& value) {
+        auto& cached = PrometheusNamesCache::Get(cache_.metrics, path, &impl::ToPrometheusName);
+        if (cached.last_scrape != cache_.scrape) {
+            cached.last_scrape = cache_.scrape;
+            DumpMetricType(cached.name, value);
         }
+        return cached.name;
+    }
 
-        auto prometheus_name = impl::ToPrometheusName(name);
-        DumpMetricType(prometheus_name, value);
-        buf_.append(prometheus_name);
-        metrics_.emplace(name, std::move(prometheus_name));
+    void DumpMetricNameAndType(std::string_view name, const MetricValue& value) {
+        buf_.append(GetMetricName(name, value));
     }
 
     void DumpMetricType([[maybe_unused]] std::string_view prometheus_name, [[maybe_unused]] const MetricValue& value) {
-        if constexpr (IsTyped == Typed::kNo) {
+        if constexpr (Types == PrometheusFormatter::Types::kUntyped) {
             const bool should_skip = value.Visit(utils::Overloaded{
                 [](std::int64_t) { return true; },
                 [](double) { return true; },
@@ -129,7 +183,10 @@ private:
             if (sep) {
                 buf_.push_back(',');
             }
-            fmt::format_to(std::back_inserter(buf_), FMT_COMPILE("{}=\""), impl::ToPrometheusLabel(label.Name()));
+            auto& cached = PrometheusNamesCache::Get(cache_.labels, label.Name(), &impl::ToPrometheusLabel);
+            cached.last_scrape = cache_.scrape;
+            buf_.append(cached.name);
+            buf_.append(std::string_view{"=\""});
             const auto& value = label.Value();
             std::replace_copy(value.cbegin(), value.cend(), std::back_inserter(buf_), '"', '\'');
             buf_.push_back('"');
@@ -143,8 +200,10 @@ private:
         buf_.push_back('}');
     }
 
+    PrometheusNamesCache& cache_;
+    const std::size_t chunk_size_;
+    const std::optional<PrometheusFormatter::ChunkConsumer> consumer_;
     fmt::memory_buffer buf_;
-    utils::impl::TransparentMap<std::string, std::string> metrics_;
 };
 
 }  // namespace
@@ -181,18 +240,67 @@ std::string ToPrometheusLabel(std::string_view name) {
 
 }  // namespace impl
 
+struct PrometheusFormatter::Impl final {
+    template <Types TypesValue>
+    void Format(
+        const utils::statistics::Storage& statistics,
+        const utils::statistics::Request& request,
+        std::size_t chunk_size,
+        ChunkConsumer consumer
+    ) {
+        impl::FormatBuilder<TypesValue> builder{cache, chunk_size, consumer};
+        statistics.VisitMetrics(builder, request);
+        builder.Flush();
+    }
+
+    template <Types TypesValue>
+    std::string Format(const utils::statistics::Storage& statistics, const utils::statistics::Request& request) {
+        impl::FormatBuilder<TypesValue> builder{cache};
+        statistics.VisitMetrics(builder, request);
+        return builder.Release();
+    }
+
+    Types types;
+    impl::PrometheusNamesCache cache;
+};
+
+PrometheusFormatter::PrometheusFormatter(Types types) : impl_(std::make_unique<Impl>(Impl{types, {}})) {}
+
+PrometheusFormatter::PrometheusFormatter(PrometheusFormatter&&) noexcept = default;
+
+PrometheusFormatter& PrometheusFormatter::operator=(PrometheusFormatter&&) noexcept = default;
+
+PrometheusFormatter::~PrometheusFormatter() = default;
+
+std::string PrometheusFormatter::Format(
+    const utils::statistics::Storage& statistics,
+    const utils::statistics::Request& request
+) {
+    if (impl_->types == Types::kTyped) return impl_->Format<Types::kTyped>(statistics, request);
+    return impl_->Format<Types::kUntyped>(statistics, request);
+}
+
+void PrometheusFormatter::Format(
+    const utils::statistics::Storage& statistics,
+    const utils::statistics::Request& request,
+    std::size_t chunk_size,
+    ChunkConsumer consumer
+) {
+    if (impl_->types == Types::kTyped) {
+        impl_->Format<Types::kTyped>(statistics, request, chunk_size, consumer);
+    } else {
+        impl_->Format<Types::kUntyped>(statistics, request, chunk_size, consumer);
+    }
+}
+
 std::string
 ToPrometheusFormat(const utils::statistics::Storage& statistics, const utils::statistics::Request& request) {
-    impl::FormatBuilder<impl::Typed::kYes> builder{};
-    statistics.VisitMetrics(builder, request);
-    return builder.Release();
+    return PrometheusFormatter{PrometheusFormatter::Types::kTyped}.Format(statistics, request);
 }
 
 std::string
 ToPrometheusFormatUntyped(const utils::statistics::Storage& statistics, const utils::statistics::Request& request) {
-    impl::FormatBuilder<impl::Typed::kNo> builder{};
-    statistics.VisitMetrics(builder, request);
-    return builder.Release();
+    return PrometheusFormatter{PrometheusFormatter::Types::kUntyped}.Format(statistics, request);
 }
 
 }  // namespace utils::statistics
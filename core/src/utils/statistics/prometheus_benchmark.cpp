@@ -0,0 +1,88 @@
+#include <userver/utils/statistics/prometheus.hpp>
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+
+#include <userver/engine/run_standalone.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kSeriesPerWriter = 100;
+
+// A registry of `series_count` time series, similar to the ones of a large
+// service: a lot of writers with labelled metrics
+class SyntheticRegistry final {
+public:
+    explicit SyntheticRegistry(std::size_t series_count) {
+        for (std::size_t i = 0; i < series_count / kSeriesPerWriter; ++i) {
+            entries_.push_back(
+                storage_.RegisterWriter(fmt::format("component-{}.requests", i), [](utils::statistics::Writer& writer) {
+                    for (std::size_t j = 0; j < kSeriesPerWriter; ++j) {
+                        const auto handler = fmt::format("/v1/handler-{}", j % 10);
+                        writer["timings.ms"].ValueWithLabels(
+                            static_cast<std::int64_t>(j),
+                            {{"http.handler", handler}, {"http.status", std::to_string(200 + j / 10)}}
+                        );
+                    }
+                })
+            );
+        }
+    }
+
+    const utils::statistics::Storage& GetStorage() const { return storage_; }
+
+private:
+    utils::statistics::Storage storage_;
+    std::vector<utils::statistics::Entry> entries_;
+};
+
+}  // namespace
+
+void PrometheusScrape(benchmark::State& state) {
+    engine::RunStandalone([&] {
+        const SyntheticRegistry registry{static_cast<std::size_t>(state.range(0))};
+
+        for ([[maybe_unused]] auto _ : state) {
+            benchmark::DoNotOptimize(utils::statistics::ToPrometheusFormat(registry.GetStorage()));
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    });
+}
+BENCHMARK(PrometheusScrape)->RangeMultiplier(10)->Range(1'000, 100'000)->Unit(benchmark::kMillisecond);
+
+void PrometheusScrapeCachedNames(benchmark::State& state) {
+    engine::RunStandalone([&] {
+        const SyntheticRegistry registry{static_cast<std::size_t>(state.range(0))};
+        utils::statistics::PrometheusFormatter formatter;
+
+        for ([[maybe_unused]] auto _ : state) {
+            benchmark::DoNotOptimize(formatter.Format(registry.GetStorage()));
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    });
+}
+BENCHMARK(PrometheusScrapeCachedNames)->RangeMultiplier(10)->Range(1'000, 100'000)->Unit(benchmark::kMillisecond);
+
+void PrometheusScrapeStreamed(benchmark::State& state) {
+    engine::RunStandalone([&] {
+        const SyntheticRegistry registry{static_cast<std::size_t>(state.range(0))};
+        utils::statistics::PrometheusFormatter formatter;
+
+        for ([[maybe_unused]] auto _ : state) {
+            formatter.Format(registry.GetStorage(), {}, 64 * 1024, [](std::string&& chunk) {
+                benchmark::DoNotOptimize(chunk);
+            });
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    });
+}
+BENCHMARK(PrometheusScrapeStreamed)->RangeMultiplier(10)->Range(1'000, 100'000)->Unit(benchmark::kMillisecond);
+
+USERVER_NAMESPACE_END
@@ -392,6 +392,58 @@ child{application="processing"} 8
     }
 }
 
+UTEST(MetricsPrometheus, FormatterReuse) {
+    utils::statistics::Storage statistics_storage;
+    auto statistics_holder = statistics_storage.RegisterWriter("parent", [](utils::statistics::Writer& writer) {
+        writer["child.value"].ValueWithLabels(1, {"some.label", "a"});
+        writer["child.value"].ValueWithLabels(2, {"some.label", "b\"c"});
+        writer["rate"] = utils::statistics::Rate{3};
+    });
+
+    constexpr std::string_view expected = R"(
+# TYPE parent_child_value gauge
+parent_child_value{some_label="a"} 1
+parent_child_value{some_label="b'c"} 2
+# TYPE parent_rate counter
+parent_rate{} 3
+)";
+    utils::statistics::PrometheusFormatter formatter;
+    EXPECT_EQ(formatter.Format(statistics_storage), expected.substr(1));
+    // Cached names are reused, types are written on each scrape
+    EXPECT_EQ(formatter.Format(statistics_storage), expected.substr(1));
+    EXPECT_EQ(ToPrometheusFormat(statistics_storage), expected.substr(1));
+
+    utils::statistics::PrometheusFormatter untyped{utils::statistics::PrometheusFormatter::Types::kUntyped};
+    EXPECT_EQ(untyped.Format(statistics_storage), ToPrometheusFormatUntyped(statistics_storage));
+}
+
+UTEST(MetricsPrometheus, FormatterChunks) {
+    utils::statistics::Storage statistics_storage;
+    auto statistics_holder = statistics_storage.RegisterWriter("metric", [](utils::statistics::Writer& writer) {
+        for (int i = 0; i < 100; ++i) {
+            writer.ValueWithLabels(i, {"index", std::to_string(i)});
+        }
+    });
+
+    utils::statistics::PrometheusFormatter formatter;
+    const auto expected = formatter.Format(statistics_storage);
+
+    constexpr std::size_t kChunkSize = 100;
+    std::vector<std::string> chunks;
+    formatter.Format(statistics_storage, {}, kChunkSize, [&chunks](std::string&& chunk) {
+        chunks.push_back(std::move(chunk));
+    });
+
+    ASSERT_GT(chunks.size(), 1);
+    for (const auto& chunk : chunks) {
+        EXPECT_EQ(chunk.back(), '\n');
+    }
+    for (std::size_t i = 0; i + 1 < chunks.size(); ++i) {
+        EXPECT_GE(chunks[i].size(), kChunkSize);
+    }
+    EXPECT_EQ(utils::text::Join(chunks, ""), expected);
+}
+
 }  // namespace utils::statistics::impl
 
 USERVER_NAMESPACE_END
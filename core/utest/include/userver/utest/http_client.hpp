@@ -1,11 +1,15 @@
 #pragma once
 
 #include <memory>
+#include <vector>
+
+#include <userver/utils/not_null.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace clients::http {
 class Client;
+class Plugin;
 }  // namespace clients::http
 
 namespace engine {
@@ -24,6 +28,11 @@ std::shared_ptr<clients::http::Client> CreateHttpClient(engine::TaskProcessor& f
 
 std::shared_ptr<clients::http::Client> CreateHttpClient(const tracing::TracingManagerBase& tracing_manager);
 
+// The plugins must outlive the client
+std::shared_ptr<clients::http::Client> CreateHttpClient(
+    const std::vector<utils::NotNull<clients::http::Plugin*>>& plugins
+);
+
 }  // namespace utest
 
 USERVER_NAMESPACE_END
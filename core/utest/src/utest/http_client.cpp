@@ -13,13 +13,20 @@ std::shared_ptr<clients::http::Client> CreateHttpClient() {
     return utest::CreateHttpClient(engine::current_task::GetTaskProcessor());
 }
 
-std::shared_ptr<clients::http::Client> CreateHttpClient(engine::TaskProcessor& fs_task_processor) {
+namespace {
+
+const tracing::TracingManagerBase& GetDefaultTracingManager() {
     static const tracing::GenericTracingManager kDefaultTracingManager{
         tracing::Format::kYandexTaxi, tracing::Format::kYandexTaxi};
+    return kDefaultTracingManager;
+}
 
+}  // namespace
+
+std::shared_ptr<clients::http::Client> CreateHttpClient(engine::TaskProcessor& fs_task_processor) {
     clients::http::ClientSettings static_config;
     static_config.io_threads = 1;
-    static_config.tracing_manager = &kDefaultTracingManager;
+    static_config.tracing_manager = &GetDefaultTracingManager();
 
     return std::make_shared<clients::http::Client>(
         std::move(static_config), fs_task_processor, std::vector<utils::NotNull<clients::http::Plugin*>>{}
@@ -38,6 +45,18 @@ std::shared_ptr<clients::http::Client> CreateHttpClient(const tracing::TracingMa
     );
 }
 
+std::shared_ptr<clients::http::Client> CreateHttpClient(
+    const std::vector<utils::NotNull<clients::http::Plugin*>>& plugins
+) {
+    clients::http::ClientSettings static_config;
+    static_config.io_threads = 1;
+    static_config.tracing_manager = &GetDefaultTracingManager();
+
+    return std::make_shared<clients::http::Client>(
+        std::move(static_config), engine::current_task::GetTaskProcessor(), plugins
+    );
+}
+
 }  // namespace utest
 
 USERVER_NAMESPACE_END
@@ -4,11 +4,14 @@
 /// @brief @copybrief components::MongoCache
 
 #include <chrono>
+#include <cstdint>
+#include <vector>
 
 #include <fmt/format.h>
 
 #include <userver/cache/cache_statistics.hpp>
 #include <userver/cache/caching_component_base.hpp>
+#include <userver/cache/impl/fetch_shards.hpp>
 #include <userver/cache/mongo_cache_type_traits.hpp>
 #include <userver/components/component_context.hpp>
 #include <userver/formats/bson/document.hpp>
@@ -34,6 +37,8 @@ namespace impl {
 
 std::chrono::milliseconds GetMongoCacheUpdateCorrection(const ComponentConfig&);
 
+std::size_t GetMongoCacheFullUpdateShards(const ComponentConfig&, bool has_shard_field);
+
 }
 
 // clang-format off
@@ -52,6 +57,7 @@ std::chrono::milliseconds GetMongoCacheUpdateCorrection(const ComponentConfig&);
 /// Name | Description | Default value
 /// ---- | ----------- | -------------
 /// update-correction | adjusts incremental updates window to overlap with previous update | 0
+/// full-update-shards | number of concurrent queries of a full update, requires kMongoShardFieldName in the cache traits | 4 for traits with kMongoShardFieldName, 1 otherwise
 ///
 /// ## Traits example:
 /// All fields below (except for function overrides) are mandatory.
@@ -71,6 +77,13 @@ std::chrono::milliseconds GetMongoCacheUpdateCorrection(const ComponentConfig&);
 ///   static constexpr const std::string& kMongoUpdateFieldName =
 ///       mongo::db::taxi::config::kUpdated;
 ///
+///   // Integral field to split the full update into `full-update-shards`
+///   // concurrent queries by the remainder of the division (optional).
+///   // Every document must have an integral value of the field. Works only
+///   // with the default find operation.
+///   static constexpr const std::string& kMongoShardFieldName =
+///       mongo::db::taxi::config::kId;
+///
 ///   // Cache element type
 ///   using ObjectType = CachedObject;
 ///   // Cache element field name that is used as an index in the cache map
@@ -150,9 +163,14 @@ private:
 
     std::unique_ptr<typename MongoCacheTraits::DataType> GetData(cache::UpdateType type);
 
+    void FullUpdateSharded(typename MongoCacheTraits::DataType& new_cache, cache::UpdateStatisticsScope& stats_scope);
+    std::vector<typename MongoCacheTraits::ObjectType>
+    FetchShard(std::size_t shard, cache::UpdateStatisticsScope& stats_scope) const;
+
     const std::shared_ptr<CollectionsType> mongo_collections_;
     const storages::mongo::Collection* const mongo_collection_;
     const std::chrono::system_clock::duration correction_;
+    const std::size_t full_update_shards_;
     std::size_t cpu_relax_iterations_{0};
 };
 
@@ -165,7 +183,10 @@ MongoCache<MongoCacheTraits>::MongoCache(const ComponentConfig& config, const Co
       mongo_collections_(context.FindComponent<typename MongoCacheTraits::MongoCollectionsComponent>()
                              .template GetCollectionForLibrary<CollectionsType>()),
       mongo_collection_(std::addressof(mongo_collections_.get()->*MongoCacheTraits::kMongoCollectionsField)),
-      correction_(impl::GetMongoCacheUpdateCorrection(config)) {
+      correction_(impl::GetMongoCacheUpdateCorrection(config)),
+      full_update_shards_(
+          impl::GetMongoCacheFullUpdateShards(config, mongo_cache::impl::kHasShardFieldName<MongoCacheTraits>)
+      ) {
     [[maybe_unused]] mongo_cache::impl::CheckTraits<MongoCacheTraits> check_traits;
 
     if (CachingComponentBase<typename MongoCacheTraits::DataType>::GetAllowedUpdateTypes() ==
@@ -203,6 +224,16 @@ void MongoCache<MongoCacheTraits>::Update(
 ) {
     namespace sm = storages::mongo;
 
+    if (type == cache::UpdateType::kFull && full_update_shards_ > 1) {
+        auto new_cache = std::make_unique<typename MongoCacheTraits::DataType>();
+        FullUpdateSharded(*new_cache, stats_scope);
+
+        const auto size = new_cache->size();
+        this->Set(std::move(new_cache));
+        stats_scope.Finish(size);
+        return;
+    }
+
     const auto* collection = mongo_collection_;
     auto find_op = GetFindOperation(type, last_update, now, correction_);
     auto cursor = collection->Execute(find_op);
@@ -263,6 +294,11 @@ void MongoCache<MongoCacheTraits>::Update(
     }
 
     scope.Reset();
+    // Fetch and parse are not separated in the sequential mode
+    stats_scope.AddStageDuration(
+        cache::UpdateStage::kCopy,
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(scope.ElapsedTotal("copy_data"))
+    );
 
     const auto size = new_cache->size();
     this->Set(std::move(new_cache));
@@ -324,6 +360,80 @@ std::unique_ptr<typename MongoCacheTraits::DataType> MongoCache<MongoCacheTraits
     }
 }
 
+template <class MongoCacheTraits>
+void MongoCache<MongoCacheTraits>::FullUpdateSharded(
+    typename MongoCacheTraits::DataType& new_cache,
+    cache::UpdateStatisticsScope& stats_scope
+) {
+    cache::impl::FetchShardsAndMerge(
+        full_update_shards_,
+        cache::impl::kMaxShardsInFlight,
+        [this, &stats_scope](std::size_t shard) { return FetchShard(shard, stats_scope); },
+        [&new_cache](typename MongoCacheTraits::ObjectType&& object) {
+            auto key = (object.*MongoCacheTraits::kKeyField);
+            if (new_cache.count(key) == 0) {
+                new_cache[key] = std::move(object);
+            } else {
+                LOG_LIMITED_ERROR() << "Found duplicate key for 2 items in cache " << MongoCacheTraits::kName
+                                    << ", key=" << key;
+            }
+        },
+        stats_scope
+    );
+}
+
+template <class MongoCacheTraits>
+std::vector<typename MongoCacheTraits::ObjectType>
+MongoCache<MongoCacheTraits>::FetchShard(std::size_t shard, cache::UpdateStatisticsScope& stats_scope) const {
+    namespace bson = formats::bson;
+    namespace sm = storages::mongo;
+
+    std::vector<typename MongoCacheTraits::ObjectType> objects;
+    if constexpr (mongo_cache::impl::kHasShardFieldName<MongoCacheTraits>) {
+        const auto shards = static_cast<std::int64_t>(full_update_shards_);
+        const auto remainder = static_cast<std::int64_t>(shard);
+        const auto& field = MongoCacheTraits::kMongoShardFieldName;
+
+        // $mod keeps the sign of the dividend, negative values have negative remainders
+        const auto mod = [&field, shards](std::int64_t value) {
+            return bson::MakeDoc(field, bson::MakeDoc("$mod", bson::MakeArray(shards, value)));
+        };
+        auto filter = remainder == 0 ? mod(0) : bson::MakeDoc("$or", bson::MakeArray(mod(remainder), mod(-remainder)));
+        sm::operations::Find find_op(std::move(filter));
+        if (MongoCacheTraits::kIsSecondaryPreferred) {
+            find_op.SetOption(sm::options::ReadPreference::kSecondaryPreferred);
+        }
+
+        std::chrono::steady_clock::duration parse_duration{};
+        utils::StreamingCpuRelax relax{1, nullptr};
+        const auto fetch_start = std::chrono::steady_clock::now();
+        for (const auto& doc : mongo_collection_->Execute(find_op)) {
+            relax.Relax(1);
+            stats_scope.IncreaseDocumentsReadCount(1);
+
+            const auto parse_start = std::chrono::steady_clock::now();
+            try {
+                objects.push_back(DeserializeObject(doc));
+            } catch (const std::exception& e) {
+                LOG_LIMITED_ERROR() << "Failed to deserialize cache item of cache " << MongoCacheTraits::kName
+                                    << ", _id=" << doc["_id"].template ConvertTo<std::string>() << ", what(): " << e;
+                stats_scope.IncreaseDocumentsParseFailures(1);
+
+                if (!MongoCacheTraits::kAreInvalidDocumentsSkipped) throw;
+            }
+            parse_duration += std::chrono::steady_clock::now() - parse_start;
+        }
+
+        stats_scope.AddStageDuration(cache::UpdateStage::kParse, parse_duration);
+        stats_scope.AddStageDuration(
+            cache::UpdateStage::kFetch, std::chrono::steady_clock::now() - fetch_start - parse_duration
+        );
+    } else {
+        UASSERT_MSG(false, "No shard field defined but FetchShard invoked");
+    }
+    return objects;
+}
+
 namespace impl {
 
 std::string GetMongoCacheSchema();
@@ -29,6 +29,11 @@ using UpdateFieldName = decltype(T::kMongoUpdateFieldName);
 template <typename T>
 inline constexpr bool kHasUpdateFieldName = meta::kIsDetected<UpdateFieldName, T>;
 
+template <typename T>
+using ShardFieldName = decltype(T::kMongoShardFieldName);
+template <typename T>
+inline constexpr bool kHasShardFieldName = meta::kIsDetected<ShardFieldName, T>;
+
 template <typename T>
 using KeyField = decltype(T::kKeyField);
 template <typename T>
@@ -147,6 +152,12 @@ struct CheckTraits {
         "const std::chrono::system_clock::duration& correction)"
     );
 
+    static_assert(
+        !kHasShardFieldName<MongoCacheTraits> || !kHasFindOperation<MongoCacheTraits>,
+        "Mongo cache traits may specify kMongoShardFieldName only with the "
+        "default find operation"
+    );
+
     static_assert(
         kHasDeserializeObject<MongoCacheTraits> || kHasDefaultDeserializeObject<MongoCacheTraits>,
         "Mongo cache traits must specify deserialize object"
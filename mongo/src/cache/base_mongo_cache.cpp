@@ -1,5 +1,9 @@
 #include <userver/cache/base_mongo_cache.hpp>
 
+#include <stdexcept>
+
+#include <fmt/format.h>
+
 #include <userver/components/component_config.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
@@ -11,6 +15,24 @@ std::chrono::milliseconds GetMongoCacheUpdateCorrection(const ComponentConfig& c
     return config["update-correction"].As<std::chrono::milliseconds>(0);
 }
 
+std::size_t GetMongoCacheFullUpdateShards(const ComponentConfig& config, bool has_shard_field) {
+    static constexpr std::size_t kDefaultFullUpdateShards = 4;
+    const auto shards = config["full-update-shards"].As<std::size_t>(has_shard_field ? kDefaultFullUpdateShards : 1);
+    if (shards == 0) {
+        throw std::logic_error(fmt::format(
+            "'full-update-shards' must be positive in config for '{}' cache", GetCurrentComponentName(config)
+        ));
+    }
+    if (shards > 1 && !has_shard_field) {
+        throw std::logic_error(fmt::format(
+            "Sharded full updates are requested in config but no kMongoShardFieldName is specified in traits of '{}' "
+            "cache",
+            GetCurrentComponentName(config)
+        ));
+    }
+    return shards;
+}
+
 std::string GetMongoCacheSchema() {
     return R"(
 type: object
@@ -21,6 +43,11 @@ properties:
         type: string
         description: adjusts incremental updates window to overlap with previous update
         defaultDescription: 0
+    full-update-shards:
+        type: integer
+        description: number of concurrent queries of a full update, requires kMongoShardFieldName in the cache traits
+        defaultDescription: 4 for traits with kMongoShardFieldName, 1 otherwise
+        minimum: 1
 )";
 }
 
@@ -67,6 +67,15 @@ TEST(CheckTraits, FindOperation) {
     EXPECT_FALSE(mongo_cache::impl::kHasCorrectFindOperation<IncorrectSignatureOfFindOperation>);
 }
 
+struct ShardedMongoCacheTraits {
+    static constexpr int kMongoShardFieldName = 0;
+};
+
+TEST(CheckTraits, ShardFieldName) {
+    EXPECT_TRUE(mongo_cache::impl::kHasShardFieldName<ShardedMongoCacheTraits>);
+    EXPECT_FALSE(mongo_cache::impl::kHasShardFieldName<CorrectMongoCacheTraits>);
+}
+
 TEST(CheckTraits, CorrectTraits) { mongo_cache::impl::CheckTraits<CorrectMongoCacheTraits>{}; }
 
 USERVER_NAMESPACE_END
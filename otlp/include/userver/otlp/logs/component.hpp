@@ -29,6 +29,7 @@ class Logger;
 /// endpoint | URI of otel collector (e.g. 127.0.0.1:4317) | -
 /// max-queue-size | Maximum async queue size | 65535
 /// max-batch-delay | Maximum batch delay | 100ms
+/// max-batch-size | Maximum count of logs and spans in a single export request | 512
 /// service-name | Service name | unknown_service
 /// attributes | Extra attributes for OTLP, object of key/value strings | -
 /// sinks | List of sinks | -
@@ -39,6 +40,10 @@ class Logger;
 /// * `otlp`: OTLP exporter
 /// * `default`: _default_ logger from the `logging` component
 /// * `both`: _default_ logger and OTLP exporter
+///
+/// The export statistics are reported as `otlp.export` metrics with the
+/// `signal` label. Records are dropped with `reason=overflow` if the queue is
+/// full and with `reason=error` if the collector has not accepted them.
 
 // clang-format on
 class LoggerComponent final : public components::RawComponentBase {
@@ -55,6 +60,7 @@ private:
     std::shared_ptr<Logger> logger_;
     logging::LoggerRef old_logger_;
     utils::statistics::Entry statistics_holder_;
+    utils::statistics::Entry export_statistics_holder_;
 };
 
 }  // namespace otlp
@@ -0,0 +1,64 @@
+#pragma once
+
+/// @file userver/otlp/metrics/component.hpp
+/// @brief @copybrief otlp::MetricsExporterComponent
+
+#include <memory>
+#include <string>
+
+#include <userver/components/component_base.hpp>
+#include <userver/components/component_fwd.hpp>
+#include <userver/utils/periodic_task.hpp>
+#include <userver/utils/statistics/entry.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace otlp {
+
+class MetricsExporter;
+
+// clang-format off
+
+/// @ingroup userver_components
+///
+/// @brief Component to periodically export the metrics of
+/// components::StatisticsStorage to an OTLP collector.
+///
+/// The metrics are written directly from the utils::statistics::Storage into
+/// the protobuf messages allocated on a reused arena, without an intermediate
+/// text format. Integer and floating point metrics are exported as gauges,
+/// utils::statistics::Rate metrics as monotonic cumulative sums and
+/// utils::statistics::HistogramView metrics as cumulative histograms.
+///
+/// The export statistics are reported as `otlp.export` metrics with the
+/// `signal=metrics` label.
+///
+/// ## Static options:
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
+/// endpoint | URI of otel collector (e.g. 127.0.0.1:4317) | -
+/// period | Export period | 10s
+/// max-batch-size | Maximum count of data points in a single export request | 5000
+/// service-name | Service name | unknown_service
+/// extra-attributes | Extra attributes for OTLP, object of key/value strings | -
+
+// clang-format on
+class MetricsExporterComponent final : public components::ComponentBase {
+public:
+    static constexpr std::string_view kName = "otlp-metrics-exporter";
+
+    MetricsExporterComponent(const components::ComponentConfig&, const components::ComponentContext&);
+
+    ~MetricsExporterComponent() override;
+
+    static yaml_config::Schema GetStaticConfigSchema();
+
+private:
+    std::unique_ptr<MetricsExporter> exporter_;
+    utils::statistics::Entry statistics_holder_;
+    utils::PeriodicTask export_task_;
+};
+
+}  // namespace otlp
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,17 @@
+#include <otlp/export_statistics.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace otlp {
+
+void DumpMetric(utils::statistics::Writer& writer, const ExportStatistics& stats) {
+    writer["exported"] = stats.exported;
+    writer["dropped"].ValueWithLabels(stats.dropped_on_overflow, {"reason", "overflow"});
+    writer["dropped"].ValueWithLabels(stats.dropped_on_error, {"reason", "error"});
+    writer["requests"] = stats.requests;
+    writer["errors"] = stats.errors;
+}
+
+}  // namespace otlp
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <userver/utils/statistics/rate_counter.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace otlp {
+
+/// Statistics of the export of a single kind of the OTLP data
+struct ExportStatistics final {
+    /// Records (logs, spans or metric data points) sent to the collector
+    utils::statistics::RateCounter exported;
+    /// Records dropped because the queue was full
+    utils::statistics::RateCounter dropped_on_overflow;
+    /// Records dropped because the export request failed
+    utils::statistics::RateCounter dropped_on_error;
+    /// Export requests sent to the collector
+    utils::statistics::RateCounter requests;
+    /// Export requests that failed
+    utils::statistics::RateCounter errors;
+};
+
+void DumpMetric(utils::statistics::Writer& writer, const ExportStatistics& stats);
+
+}  // namespace otlp
+
+USERVER_NAMESPACE_END
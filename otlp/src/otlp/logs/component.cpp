@@ -39,6 +39,7 @@ LoggerComponent::LoggerComponent(const components::ComponentConfig& config, cons
     LoggerConfig logger_config;
     logger_config.max_queue_size = config["max-queue-size"].As<size_t>(65535);
     logger_config.max_batch_delay = config["max-batch-delay"].As<std::chrono::milliseconds>(100);
+    logger_config.max_batch_size = config["max-batch-size"].As<size_t>(logger_config.max_batch_size);
     logger_config.service_name = config["service-name"].As<std::string>("unknown_service");
     logger_config.log_level = config["log-level"].As<USERVER_NAMESPACE::logging::Level>();
     logger_config.extra_attributes = config["extra-attributes"].As<std::unordered_map<std::string, std::string>>({});
@@ -86,6 +87,11 @@ LoggerComponent::LoggerComponent(const components::ComponentConfig& config, cons
             statistics_storage->GetStorage().RegisterWriter("logger", [this](utils::statistics::Writer& writer) {
                 writer.ValueWithLabels(logger_->GetStatistics(), {"logger", "default"});
             });
+        export_statistics_holder_ =
+            statistics_storage->GetStorage().RegisterWriter("otlp.export", [this](utils::statistics::Writer& writer) {
+                writer.ValueWithLabels(logger_->GetLogsExportStatistics(), {"signal", "logs"});
+                writer.ValueWithLabels(logger_->GetTracesExportStatistics(), {"signal", "traces"});
+            });
     }
 }
 
@@ -119,6 +125,10 @@ properties:
     max-batch-delay:
         type: string
         description: max delay between send batches (e.g. 100ms or 1s)
+    max-batch-size:
+        type: integer
+        description: max count of logs and spans in a single export request
+        minimum: 1
     service-name:
         type: string
         description: service name
@@ -15,6 +15,8 @@
 #include <userver/utils/overloaded.hpp>
 #include <userver/utils/text_light.hpp>
 
+#include <otlp/reusable_arena.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace otlp {
@@ -25,6 +27,9 @@ constexpr std::string_view kTelemetrySdkName = "telemetry.sdk.name";
 constexpr std::string_view kServiceName = "service.name";
 
 const std::string kTimestampFormat = "%Y-%m-%dT%H:%M:%E*S";
+
+constexpr std::size_t kInitialArenaBlockSize = 64 * 1024;
+constexpr std::size_t kMaxArenaBlockSize = 16 * 1024 * 1024;
 }  // namespace
 
 SinkType Parse(const yaml_config::YamlConfig& value, formats::parse::To<SinkType>) {
@@ -128,6 +133,7 @@ void Logger::Log(logging::Level level, std::string_view msg) {
     auto ok = queue_producer_.PushNoblock(std::move(log_record));
     if (!ok) {
         ++stats_.dropped;
+        ++logs_export_stats_.dropped_on_overflow;
     }
 }
 
@@ -190,6 +196,7 @@ void Logger::Trace(logging::Level level, std::string_view msg) {
     auto ok = queue_producer_.PushNoblock(std::move(span));
     if (!ok) {
         ++stats_.dropped;
+        ++traces_export_stats_.dropped_on_overflow;
     }
 }
 
@@ -198,44 +205,63 @@ void Logger::SendingLoop(Queue::Consumer& consumer, LogClient& log_client, Trace
     tracing::Span span("");
     span.SetLocalLogLevel(logging::Level::kNone);
 
-    ::opentelemetry::proto::collector::logs::v1::ExportLogsServiceRequest log_request;
-    auto resource_logs = log_request.add_resource_logs();
-    auto scope_logs = resource_logs->add_scope_logs();
-    FillAttributes(*resource_logs->mutable_resource());
+    // The batches are built on the arena, that keeps its memory between the
+    // batches, so the steady state export does not allocate per record
+    ReusableArena arena{kInitialArenaBlockSize, kMaxArenaBlockSize};
+
+    ::opentelemetry::proto::collector::logs::v1::ExportLogsServiceRequest* log_request = nullptr;
+    ::opentelemetry::proto::logs::v1::ScopeLogs* scope_logs = nullptr;
+    ::opentelemetry::proto::collector::trace::v1::ExportTraceServiceRequest* trace_request = nullptr;
+    ::opentelemetry::proto::trace::v1::ScopeSpans* scope_spans = nullptr;
+
+    const auto start_batch = [&] {
+        log_request = arena.Create<::opentelemetry::proto::collector::logs::v1::ExportLogsServiceRequest>();
+        auto* resource_logs = log_request->add_resource_logs();
+        scope_logs = resource_logs->add_scope_logs();
+        FillAttributes(*resource_logs->mutable_resource());
+
+        trace_request = arena.Create<::opentelemetry::proto::collector::trace::v1::ExportTraceServiceRequest>();
+        auto* resource_spans = trace_request->add_resource_spans();
+        scope_spans = resource_spans->add_scope_spans();
+        FillAttributes(*resource_spans->mutable_resource());
+    };
+
+    const auto send_batch = [&] {
+        if (scope_logs->log_records_size() != 0) {
+            DoLog(*log_request, log_client);
+        }
+        if (scope_spans->spans_size() != 0) {
+            DoTrace(*trace_request, trace_client);
+        }
+        arena.Reset();
+        start_batch();
+    };
 
-    ::opentelemetry::proto::collector::trace::v1::ExportTraceServiceRequest trace_request;
-    auto resource_spans = trace_request.add_resource_spans();
-    auto scope_spans = resource_spans->add_scope_spans();
-    FillAttributes(*resource_spans->mutable_resource());
+    start_batch();
 
     Action action{};
     while (consumer.Pop(action)) {
-        scope_logs->clear_log_records();
-        scope_spans->clear_spans();
-
         auto deadline = engine::Deadline::FromDuration(config_.max_batch_delay);
 
         do {
             std::visit(
                 utils::Overloaded{
-                    [&scope_spans](const opentelemetry::proto::trace::v1::Span& action) {
-                        auto span = scope_spans->add_spans();
-                        *span = action;
+                    [&scope_spans](opentelemetry::proto::trace::v1::Span& action) {
+                        *scope_spans->add_spans() = std::move(action);
                     },
-                    [&scope_logs](const opentelemetry::proto::logs::v1::LogRecord& action) {
-                        auto log_records = scope_logs->add_log_records();
-                        *log_records = action;
+                    [&scope_logs](opentelemetry::proto::logs::v1::LogRecord& action) {
+                        *scope_logs->add_log_records() = std::move(action);
                     }},
                 action
             );
+
+            const auto batch_size = scope_logs->log_records_size() + scope_spans->spans_size();
+            if (static_cast<std::size_t>(batch_size) >= config_.max_batch_size) {
+                send_batch();
+            }
         } while (consumer.Pop(action, deadline));
 
-        if (config_.logs_sink == SinkType::kBoth || config_.logs_sink == SinkType::kOtlp) {
-            DoLog(log_request, log_client);
-        }
-        if (config_.tracing_sink == SinkType::kBoth || config_.tracing_sink == SinkType::kOtlp) {
-            DoTrace(trace_request, trace_client);
-        }
+        send_batch();
     }
 }
 
@@ -269,32 +295,40 @@ void Logger::DoLog(
     const opentelemetry::proto::collector::logs::v1::ExportLogsServiceRequest& request,
     LogClient& client
 ) {
+    const auto records = static_cast<std::uint64_t>(request.resource_logs(0).scope_logs(0).log_records_size());
+    ++logs_export_stats_.requests;
     try {
         auto call = client.Export(request);
         auto response = call.Finish();
+        logs_export_stats_.exported += utils::statistics::Rate{records};
     } catch (const ugrpc::client::RpcCancelledError&) {
         std::cerr << "Stopping OTLP sender task\n";
         throw;
     } catch (const std::exception& e) {
+        ++logs_export_stats_.errors;
+        logs_export_stats_.dropped_on_error += utils::statistics::Rate{records};
         std::cerr << "Failed to write down OTLP log(s): " << e.what() << typeid(e).name() << "\n";
     }
-    // TODO: count exceptions
 }
 
 void Logger::DoTrace(
     const opentelemetry::proto::collector::trace::v1::ExportTraceServiceRequest& request,
     TraceClient& trace_client
 ) {
+    const auto records = static_cast<std::uint64_t>(request.resource_spans(0).scope_spans(0).spans_size());
+    ++traces_export_stats_.requests;
     try {
         auto call = trace_client.Export(request);
         auto response = call.Finish();
+        traces_export_stats_.exported += utils::statistics::Rate{records};
     } catch (const ugrpc::client::RpcCancelledError&) {
         std::cerr << "Stopping OTLP sender task\n";
         throw;
     } catch (const std::exception& e) {
+        ++traces_export_stats_.errors;
+        traces_export_stats_.dropped_on_error += utils::statistics::Rate{records};
         std::cerr << "Failed to write down OTLP trace(s): " << e.what() << typeid(e).name() << "\n";
     }
-    // TODO: count exceptions
 }
 
 std::string_view Logger::MapAttribute(std::string_view attr) const {
@@ -13,6 +13,8 @@
 #include <userver/logging/impl/logger_base.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
 
+#include <otlp/export_statistics.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace otlp {
@@ -24,6 +26,7 @@ SinkType Parse(const yaml_config::YamlConfig& value, formats::parse::To<SinkType
 struct LoggerConfig {
     size_t max_queue_size{10000};
     std::chrono::milliseconds max_batch_delay{};
+    size_t max_batch_size{512};
     SinkType logs_sink{SinkType::kOtlp};
     SinkType tracing_sink{SinkType::kOtlp};
     std::string service_name;
@@ -51,6 +54,10 @@ public:
 
     const logging::impl::LogStatistics& GetStatistics() const;
 
+    const ExportStatistics& GetLogsExportStatistics() const { return logs_export_stats_; }
+
+    const ExportStatistics& GetTracesExportStatistics() const { return traces_export_stats_; }
+
     void SetDefaultLogger(logging::LoggerPtr default_logger) { default_logger_ = default_logger; }
 
 protected:
@@ -74,6 +81,8 @@ private:
     std::string_view MapAttribute(std::string_view attr) const;
 
     logging::impl::LogStatistics stats_;
+    ExportStatistics logs_export_stats_;
+    ExportStatistics traces_export_stats_;
     const LoggerConfig config_;
     std::shared_ptr<Queue> queue_;
     Queue::MultiProducer queue_producer_;
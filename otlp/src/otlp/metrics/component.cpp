@@ -0,0 +1,87 @@
+#include <userver/otlp/metrics/component.hpp>
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/components/statistics_storage.hpp>
+#include <userver/formats/parse/common_containers.hpp>
+#include <userver/ugrpc/client/client_factory_component.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include <otlp/metrics/exporter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace otlp {
+
+MetricsExporterComponent::MetricsExporterComponent(
+    const components::ComponentConfig& config,
+    const components::ComponentContext& context
+)
+    : components::ComponentBase(config, context) {
+    auto& client_factory = context.FindComponent<ugrpc::client::ClientFactoryComponent>().GetFactory();
+    auto client = client_factory.MakeClient<MetricsExporter::Client>(
+        "otlp-metrics-exporter", config["endpoint"].As<std::string>()
+    );
+
+    MetricsExporterConfig exporter_config;
+    exporter_config.max_batch_size = config["max-batch-size"].As<std::size_t>(exporter_config.max_batch_size);
+    exporter_config.service_name = config["service-name"].As<std::string>("unknown_service");
+    exporter_config.extra_attributes = config["extra-attributes"].As<std::unordered_map<std::string, std::string>>({});
+
+    auto& storage = context.FindComponent<components::StatisticsStorage>().GetStorage();
+    exporter_ = std::make_unique<MetricsExporter>(std::move(client), storage, std::move(exporter_config));
+
+    statistics_holder_ = storage.RegisterWriter("otlp.export", [this](utils::statistics::Writer& writer) {
+        writer.ValueWithLabels(exporter_->GetStatistics(), {"signal", "metrics"});
+    });
+
+    const auto period = config["period"].As<std::chrono::milliseconds>(std::chrono::seconds{10});
+    export_task_.Start(
+        std::string{kName},
+        utils::PeriodicTask::Settings{period, {}, logging::Level::kDebug},
+        [this] { exporter_->Export(); }
+    );
+}
+
+MetricsExporterComponent::~MetricsExporterComponent() {
+    export_task_.Stop();
+    statistics_holder_.Unregister();
+}
+
+yaml_config::Schema MetricsExporterComponent::GetStaticConfigSchema() {
+    return yaml_config::MergeSchemas<components::ComponentBase>(R"(
+type: object
+description: >
+    OpenTelemetry metrics exporter component
+additionalProperties: false
+properties:
+    endpoint:
+        type: string
+        description: >
+            Hostname:port of otel collector (gRPC).
+    period:
+        type: string
+        description: export period (e.g. 10s)
+        defaultDescription: 10s
+    max-batch-size:
+        type: integer
+        description: max count of data points in a single export request
+        defaultDescription: 5000
+        minimum: 1
+    service-name:
+        type: string
+        description: service name
+        defaultDescription: unknown_service
+    extra-attributes:
+        type: object
+        description: extra OTLP attributes
+        properties: {}
+        additionalProperties:
+            type: string
+            description: attribute value
+)");
+}
+
+}  // namespace otlp
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,184 @@
+#include <otlp/metrics/exporter.hpp>
+
+#include <userver/logging/log.hpp>
+#include <userver/utils/overloaded.hpp>
+#include <userver/utils/statistics/metric_value.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace otlp {
+
+namespace {
+
+namespace metrics = ::opentelemetry::proto::metrics::v1;
+
+constexpr std::string_view kTelemetrySdkLanguage = "telemetry.sdk.language";
+constexpr std::string_view kTelemetrySdkName = "telemetry.sdk.name";
+constexpr std::string_view kServiceName = "service.name";
+
+constexpr std::size_t kInitialArenaBlockSize = 256 * 1024;
+constexpr std::size_t kMaxArenaBlockSize = 64 * 1024 * 1024;
+
+std::uint64_t ToUnixNano(std::chrono::system_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+void AddAttribute(
+    google::protobuf::RepeatedPtrField<::opentelemetry::proto::common::v1::KeyValue>& attributes,
+    std::string_view key,
+    std::string_view value
+) {
+    auto* attribute = attributes.Add();
+    attribute->set_key(key.data(), key.size());
+    attribute->mutable_value()->set_string_value(value.data(), value.size());
+}
+
+}  // namespace
+
+MetricsRequestBuilder::MetricsRequestBuilder(
+    ReusableArena& arena,
+    const MetricsExporterConfig& config,
+    std::chrono::system_clock::time_point start_time,
+    std::chrono::system_clock::time_point time
+)
+    : arena_(arena),
+      config_(config),
+      start_time_unix_nano_(ToUnixNano(start_time)),
+      time_unix_nano_(ToUnixNano(time)) {}
+
+void MetricsRequestBuilder::HandleMetric(
+    std::string_view path,
+    utils::statistics::LabelsSpan labels,
+    const utils::statistics::MetricValue& value
+) {
+    if (batches_.empty() || batches_.back().data_points >= config_.max_batch_size) {
+        StartRequest();
+    }
+    ++batches_.back().data_points;
+
+    value.Visit(utils::Overloaded{
+        [&](std::int64_t gauge) {
+            auto* point = GetMetric(path, metrics::Metric::kGauge).mutable_gauge()->add_data_points();
+            FillDataPoint(*point, labels);
+            point->set_as_int(gauge);
+        },
+        [&](double gauge) {
+            auto* point = GetMetric(path, metrics::Metric::kGauge).mutable_gauge()->add_data_points();
+            FillDataPoint(*point, labels);
+            point->set_as_double(gauge);
+        },
+        [&](utils::statistics::Rate rate) {
+            auto* point = GetMetric(path, metrics::Metric::kSum).mutable_sum()->add_data_points();
+            FillDataPoint(*point, labels);
+            point->set_as_int(static_cast<std::int64_t>(rate.value));
+        },
+        [&](utils::statistics::HistogramView histogram) {
+            auto* point = GetMetric(path, metrics::Metric::kHistogram).mutable_histogram()->add_data_points();
+            FillDataPoint(*point, labels);
+            const auto bucket_count = histogram.GetBucketCount();
+            point->mutable_explicit_bounds()->Reserve(bucket_count);
+            point->mutable_bucket_counts()->Reserve(bucket_count + 1);
+            for (std::size_t i = 0; i < bucket_count; ++i) {
+                point->add_explicit_bounds(histogram.GetUpperBoundAt(i));
+                point->add_bucket_counts(histogram.GetValueAt(i));
+            }
+            point->add_bucket_counts(histogram.GetValueAtInf());
+            point->set_count(histogram.GetTotalCount());
+        },
+    });
+}
+
+void MetricsRequestBuilder::StartRequest() {
+    auto* request = arena_.Create<Request>();
+    auto* resource_metrics = request->add_resource_metrics();
+
+    auto& attributes = *resource_metrics->mutable_resource()->mutable_attributes();
+    AddAttribute(attributes, kTelemetrySdkLanguage, "cpp");
+    AddAttribute(attributes, kTelemetrySdkName, "userver");
+    AddAttribute(attributes, kServiceName, config_.service_name);
+    for (const auto& [key, value] : config_.extra_attributes) {
+        AddAttribute(attributes, key, value);
+    }
+
+    scope_metrics_ = resource_metrics->add_scope_metrics();
+    last_metric_ = nullptr;
+    batches_.push_back({request, 0});
+}
+
+MetricsRequestBuilder::Metric& MetricsRequestBuilder::GetMetric(std::string_view path, Metric::DataCase data_case) {
+    // The data points of a metric are usually visited one after another
+    if (last_metric_ && last_metric_->data_case() == data_case && last_metric_->name() == path) {
+        return *last_metric_;
+    }
+
+    last_metric_ = scope_metrics_->add_metrics();
+    last_metric_->set_name(path.data(), path.size());
+    switch (data_case) {
+        case Metric::kSum: {
+            auto* sum = last_metric_->mutable_sum();
+            sum->set_aggregation_temporality(metrics::AGGREGATION_TEMPORALITY_CUMULATIVE);
+            sum->set_is_monotonic(true);
+            break;
+        }
+        case Metric::kHistogram: {
+            auto* histogram = last_metric_->mutable_histogram();
+            histogram->set_aggregation_temporality(metrics::AGGREGATION_TEMPORALITY_CUMULATIVE);
+            break;
+        }
+        default:
+            break;
+    }
+    return *last_metric_;
+}
+
+template <typename DataPoint>
+void MetricsRequestBuilder::FillDataPoint(DataPoint& point, utils::statistics::LabelsSpan labels) const {
+    point.set_start_time_unix_nano(start_time_unix_nano_);
+    point.set_time_unix_nano(time_unix_nano_);
+    for (const auto& label : labels) {
+        AddAttribute(*point.mutable_attributes(), label.Name(), label.Value());
+    }
+}
+
+MetricsExporter::MetricsExporter(
+    Client client,
+    const utils::statistics::Storage& storage,
+    MetricsExporterConfig&& config
+)
+    : client_(std::move(client)),
+      storage_(storage),
+      config_(std::move(config)),
+      start_time_(std::chrono::system_clock::now()),
+      arena_(kInitialArenaBlockSize, kMaxArenaBlockSize) {}
+
+void MetricsExporter::Export() {
+    // Frees the requests of the previous export, keeping the memory
+    arena_.Reset();
+
+    MetricsRequestBuilder builder{arena_, config_, start_time_, std::chrono::system_clock::now()};
+    storage_.VisitMetrics(builder);
+
+    for (const auto& batch : builder.GetBatches()) {
+        DoExport(*batch.request, batch.data_points);
+    }
+}
+
+void MetricsExporter::DoExport(const MetricsRequestBuilder::Request& request, std::size_t data_points) {
+    const utils::statistics::Rate records{data_points};
+    ++stats_.requests;
+    try {
+        auto call = client_.Export(request);
+        auto response = call.Finish();
+        stats_.exported += records;
+    } catch (const ugrpc::client::RpcCancelledError&) {
+        throw;
+    } catch (const std::exception& e) {
+        ++stats_.errors;
+        stats_.dropped_on_error += records;
+        LOG_LIMITED_WARNING() << "Failed to export OTLP metrics: " << e;
+    }
+}
+
+}  // namespace otlp
+
+USERVER_NAMESPACE_END
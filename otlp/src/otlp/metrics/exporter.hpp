@@ -0,0 +1,105 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <opentelemetry/proto/collector/metrics/v1/metrics_service_client.usrv.pb.hpp>
+
+#include <userver/utils/statistics/storage.hpp>
+
+#include <otlp/export_statistics.hpp>
+#include <otlp/reusable_arena.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace otlp {
+
+struct MetricsExporterConfig {
+    std::size_t max_batch_size{5000};
+    std::string service_name;
+    std::unordered_map<std::string, std::string> extra_attributes;
+};
+
+/// Walks the utils::statistics::Storage directly into the OTLP export requests
+/// allocated on the arena. Each request has at most `max_batch_size` data
+/// points, the consecutive data points of the same metric share the Metric.
+///
+/// Integer and floating point values are exported as gauges, utils::statistics::Rate
+/// as monotonic cumulative sums, utils::statistics::HistogramView as cumulative
+/// histograms.
+class MetricsRequestBuilder final : public utils::statistics::BaseFormatBuilder {
+public:
+    using Request = ::opentelemetry::proto::collector::metrics::v1::ExportMetricsServiceRequest;
+
+    struct Batch {
+        Request* request;
+        std::size_t data_points;
+    };
+
+    MetricsRequestBuilder(
+        ReusableArena& arena,
+        const MetricsExporterConfig& config,
+        std::chrono::system_clock::time_point start_time,
+        std::chrono::system_clock::time_point time
+    );
+
+    void HandleMetric(
+        std::string_view path,
+        utils::statistics::LabelsSpan labels,
+        const utils::statistics::MetricValue& value
+    ) override;
+
+    /// @returns the requests, that are valid until the arena reset
+    const std::vector<Batch>& GetBatches() const noexcept { return batches_; }
+
+private:
+    using Metric = ::opentelemetry::proto::metrics::v1::Metric;
+
+    void StartRequest();
+
+    Metric& GetMetric(std::string_view path, Metric::DataCase data_case);
+
+    template <typename DataPoint>
+    void FillDataPoint(DataPoint& point, utils::statistics::LabelsSpan labels) const;
+
+    ReusableArena& arena_;
+    const MetricsExporterConfig& config_;
+    const std::uint64_t start_time_unix_nano_;
+    const std::uint64_t time_unix_nano_;
+
+    std::vector<Batch> batches_;
+    ::opentelemetry::proto::metrics::v1::ScopeMetrics* scope_metrics_{nullptr};
+    Metric* last_metric_{nullptr};
+};
+
+/// Periodically exports the metrics of utils::statistics::Storage to an OTLP
+/// collector
+class MetricsExporter final {
+public:
+    using Client = ::opentelemetry::proto::collector::metrics::v1::MetricsServiceClient;
+
+    MetricsExporter(Client client, const utils::statistics::Storage& storage, MetricsExporterConfig&& config);
+
+    /// Exports all the metrics of the storage, the failed requests are dropped
+    void Export();
+
+    const ExportStatistics& GetStatistics() const noexcept { return stats_; }
+
+private:
+    void DoExport(const MetricsRequestBuilder::Request& request, std::size_t data_points);
+
+    Client client_;
+    const utils::statistics::Storage& storage_;
+    const MetricsExporterConfig config_;
+    const std::chrono::system_clock::time_point start_time_;
+    ReusableArena arena_;
+    ExportStatistics stats_;
+};
+
+}  // namespace otlp
+
+USERVER_NAMESPACE_END
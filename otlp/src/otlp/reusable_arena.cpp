@@ -0,0 +1,32 @@
+#include <otlp/reusable_arena.hpp>
+
+#include <algorithm>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace otlp {
+
+ReusableArena::ReusableArena(std::size_t initial_block_size, std::size_t max_block_size)
+    : max_block_size_(std::max(initial_block_size, max_block_size)),
+      block_size_(initial_block_size),
+      block_(std::make_unique<char[]>(block_size_)) {
+    arena_.emplace(block_.get(), block_size_);
+}
+
+void ReusableArena::Reset() {
+    const auto space_allocated = static_cast<std::size_t>(arena_->SpaceAllocated());
+    if (space_allocated <= block_size_ || block_size_ == max_block_size_) {
+        // Frees everything except the preallocated block
+        arena_->Reset();
+        return;
+    }
+
+    arena_.reset();
+    block_size_ = std::min(space_allocated, max_block_size_);
+    block_ = std::make_unique<char[]>(block_size_);
+    arena_.emplace(block_.get(), block_size_);
+}
+
+}  // namespace otlp
+
+USERVER_NAMESPACE_END
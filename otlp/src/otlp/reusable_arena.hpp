@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+
+#include <google/protobuf/arena.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace otlp {
+
+/// google::protobuf::Arena that keeps its memory between the export batches.
+///
+/// The first block of the arena is preallocated and grows up to the size
+/// used by the largest batch, so the steady state batches do not allocate.
+class ReusableArena final {
+public:
+    ReusableArena(std::size_t initial_block_size, std::size_t max_block_size);
+
+    ReusableArena(const ReusableArena&) = delete;
+    ReusableArena& operator=(const ReusableArena&) = delete;
+
+    google::protobuf::Arena& Get() noexcept { return *arena_; }
+
+    template <typename Message>
+    Message* Create() {
+        return google::protobuf::Arena::Create<Message>(&*arena_);
+    }
+
+    /// Destroys all the messages created on the arena
+    void Reset();
+
+    std::size_t GetBlockSize() const noexcept { return block_size_; }
+
+private:
+    const std::size_t max_block_size_;
+    std::size_t block_size_;
+    std::unique_ptr<char[]> block_;
+    std::optional<google::protobuf::Arena> arena_;
+};
+
+}  // namespace otlp
+
+USERVER_NAMESPACE_END
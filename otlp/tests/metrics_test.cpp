@@ -0,0 +1,167 @@
+#include <userver/utest/utest.hpp>
+
+#include <vector>
+
+#include <otlp/metrics/exporter.hpp>
+
+#include <userver/ugrpc/tests/service_fixtures.hpp>
+#include <userver/utils/statistics/histogram.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
+
+#include <opentelemetry/proto/collector/metrics/v1/metrics_service_client.usrv.pb.hpp>
+#include <opentelemetry/proto/collector/metrics/v1/metrics_service_service.usrv.pb.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace metrics = ::opentelemetry::proto::metrics::v1;
+
+constexpr double kBounds[]{5, 10};
+
+class MetricsService final : public opentelemetry::proto::collector::metrics::v1::MetricsServiceBase {
+public:
+    ExportResult Export(
+        CallContext& /*context*/,
+        ::opentelemetry::proto::collector::metrics::v1::ExportMetricsServiceRequest&& request
+    ) override {
+        for (const auto& rm : request.resource_metrics()) {
+            for (const auto& sm : rm.scope_metrics()) {
+                for (const auto& metric : sm.metrics()) {
+                    exported_metrics.push_back(metric);
+                }
+            }
+        }
+        ++requests;
+
+        return ::opentelemetry::proto::collector::metrics::v1::ExportMetricsServiceResponse{};
+    }
+
+    // no sync as there is only a single grpc client
+    std::vector<metrics::Metric> exported_metrics;
+    std::size_t requests{0};
+};
+
+class Metrics {
+public:
+    Metrics() {
+        holder_ = storage_.RegisterWriter("test", [this](utils::statistics::Writer& writer) {
+            writer["gauge"].ValueWithLabels(42, {"shard", "a"});
+            writer["gauge"].ValueWithLabels(43, {"shard", "b"});
+            writer["ratio"] = 0.5;
+            writer["requests"] = requests_;
+            writer["timings"] = histogram_;
+        });
+        requests_ += utils::statistics::Rate{10};
+        histogram_.Account(1);
+        histogram_.Account(7);
+        histogram_.Account(100);
+    }
+
+    const utils::statistics::Storage& GetStorage() const { return storage_; }
+
+private:
+    utils::statistics::Storage storage_;
+    utils::statistics::RateCounter requests_;
+    utils::statistics::Histogram histogram_{kBounds};
+    utils::statistics::Entry holder_;
+};
+
+const metrics::Metric& FindMetric(const std::vector<metrics::Metric>& metrics, std::string_view name) {
+    for (const auto& metric : metrics) {
+        if (metric.name() == name) return metric;
+    }
+    ADD_FAILURE() << "No metric " << name;
+    static const metrics::Metric kEmpty;
+    return kEmpty;
+}
+
+using MetricsExporterTest = ugrpc::tests::ServiceFixture<MetricsService>;
+
+}  // namespace
+
+UTEST(OtlpMetricsRequestBuilder, Values) {
+    const Metrics metrics_storage;
+    otlp::ReusableArena arena{1024, 1024 * 1024};
+    otlp::MetricsExporterConfig config;
+    config.service_name = "test-service";
+
+    const auto now = std::chrono::system_clock::now();
+    otlp::MetricsRequestBuilder builder{arena, config, now - std::chrono::seconds{1}, now};
+    metrics_storage.GetStorage().VisitMetrics(builder);
+
+    ASSERT_EQ(builder.GetBatches().size(), 1);
+    const auto& batch = builder.GetBatches()[0];
+    EXPECT_EQ(batch.data_points, 5);
+
+    const auto& resource_metrics = batch.request->resource_metrics(0);
+    std::vector<metrics::Metric> exported(
+        resource_metrics.scope_metrics(0).metrics().begin(), resource_metrics.scope_metrics(0).metrics().end()
+    );
+    // Both gauge data points share the metric
+    EXPECT_EQ(exported.size(), 4);
+
+    const auto& gauge = FindMetric(exported, "test.gauge").gauge();
+    ASSERT_EQ(gauge.data_points_size(), 2);
+    EXPECT_EQ(gauge.data_points(0).as_int(), 42);
+    EXPECT_EQ(gauge.data_points(0).attributes(0).key(), "shard");
+    EXPECT_EQ(gauge.data_points(0).attributes(0).value().string_value(), "a");
+    EXPECT_EQ(gauge.data_points(1).as_int(), 43);
+
+    EXPECT_EQ(FindMetric(exported, "test.ratio").gauge().data_points(0).as_double(), 0.5);
+
+    const auto& sum = FindMetric(exported, "test.requests").sum();
+    EXPECT_TRUE(sum.is_monotonic());
+    EXPECT_EQ(sum.aggregation_temporality(), metrics::AGGREGATION_TEMPORALITY_CUMULATIVE);
+    EXPECT_EQ(sum.data_points(0).as_int(), 10);
+    EXPECT_LT(sum.data_points(0).start_time_unix_nano(), sum.data_points(0).time_unix_nano());
+
+    const auto& histogram = FindMetric(exported, "test.timings").histogram().data_points(0);
+    EXPECT_EQ(histogram.count(), 3);
+    const std::vector<double> bounds(histogram.explicit_bounds().begin(), histogram.explicit_bounds().end());
+    EXPECT_EQ(bounds, (std::vector<double>{5, 10}));
+    const std::vector<std::uint64_t> buckets(histogram.bucket_counts().begin(), histogram.bucket_counts().end());
+    EXPECT_EQ(buckets, (std::vector<std::uint64_t>{1, 1, 1}));
+}
+
+UTEST(OtlpMetricsRequestBuilder, Batches) {
+    const Metrics metrics_storage;
+    otlp::ReusableArena arena{1024, 1024 * 1024};
+    otlp::MetricsExporterConfig config;
+    config.max_batch_size = 2;
+
+    const auto now = std::chrono::system_clock::now();
+    otlp::MetricsRequestBuilder builder{arena, config, now, now};
+    metrics_storage.GetStorage().VisitMetrics(builder);
+
+    const auto& batches = builder.GetBatches();
+    ASSERT_EQ(batches.size(), 3);
+    EXPECT_EQ(batches[0].data_points, 2);
+    EXPECT_EQ(batches[1].data_points, 2);
+    EXPECT_EQ(batches[2].data_points, 1);
+    for (const auto& batch : batches) {
+        EXPECT_EQ(batch.request->GetArena(), &arena.Get());
+    }
+}
+
+UTEST_F(MetricsExporterTest, Export) {
+    const Metrics metrics_storage;
+    otlp::MetricsExporterConfig config;
+    config.max_batch_size = 1;
+    otlp::MetricsExporter exporter{
+        MakeClient<otlp::MetricsExporter::Client>(), metrics_storage.GetStorage(), std::move(config)};
+
+    exporter.Export();
+    EXPECT_EQ(GetService().requests, 5);
+    EXPECT_EQ(GetService().exported_metrics.size(), 5) << "The gauge is split between the requests";
+
+    exporter.Export();
+    EXPECT_EQ(GetService().requests, 10);
+
+    const auto& stats = exporter.GetStatistics();
+    EXPECT_EQ(stats.exported.Load().value, 10);
+    EXPECT_EQ(stats.requests.Load().value, 10);
+    EXPECT_EQ(stats.errors.Load().value, 0);
+}
+
+USERVER_NAMESPACE_END
@@ -6,15 +6,18 @@
 #include <userver/cache/base_postgres_cache_fwd.hpp>
 
 #include <chrono>
+#include <cstdint>
 #include <map>
 #include <string_view>
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 #include <fmt/format.h>
 
 #include <userver/cache/cache_statistics.hpp>
 #include <userver/cache/caching_component_base.hpp>
+#include <userver/cache/impl/fetch_shards.hpp>
 #include <userver/components/component_config.hpp>
 #include <userver/components/component_context.hpp>
 
@@ -66,6 +69,7 @@ namespace components {
 /// incremental-update-op-timeout | timeout for an incremental update | 1s
 /// update-correction | incremental update window adjustment | - (0 for caches with defined GetLastKnownUpdated)
 /// chunk-size | number of rows to request from PostgreSQL via portals, 0 to fetch all rows in one request without portals | 1000
+/// full-update-shards | number of concurrent queries of a full update, requires kFullUpdateShardKey in the cache policy | 4 for policies with kFullUpdateShardKey, 1 otherwise
 ///
 /// @section pg_cc_cache_policy Cache policy
 ///
@@ -97,6 +101,25 @@ namespace components {
 ///
 /// @snippet cache/postgres_cache_test.cpp Pg Cache Policy Custom Container With Write Notification Example
 ///
+/// Incremental update copies the current cache data before applying the
+/// changes. For large caches with frequent small incremental updates consider
+/// using cache::PersistentHashMap as a CacheContainer, its copies share the
+/// unchanged elements and the copying takes O(1).
+///
+/// @section pg_cc_sharded_full_update Sharded full updates
+///
+/// Full update of a large cache may be split into `full-update-shards` queries
+/// by defining kFullUpdateShardKey in the policy. Each query selects the rows
+/// with `abs(mod(coalesce(kFullUpdateShardKey, 0), full-update-shards))`
+/// equal to the index of the query, the rows with NULL key are fetched by the
+/// first query. The queries are fetched and parsed concurrently on the task
+/// processor of the cache, the rows are merged into the cache container in the
+/// order of the queries. The expression should be cheap for the database, for
+/// example the primary key of an integral type or its hash.
+///
+/// Time of the fetching, parsing and merging of the last update is reported in
+/// the `cache.{full,incremental}.time.last-update-stage-duration-ms` metric.
+///
 /// @section pg_cc_forward_declaration Forward Declaration
 ///
 /// To forward declare a cache you can forward declare a trait and
@@ -160,6 +183,12 @@ using HasWhere = decltype(T::kWhere);
 template <typename T>
 inline constexpr bool kHasWhere = meta::kIsDetected<HasWhere, T>;
 
+// Full update sharding expression
+template <typename T>
+using HasFullUpdateShardKey = decltype(T::kFullUpdateShardKey);
+template <typename T>
+inline constexpr bool kHasFullUpdateShardKey = meta::kIsDetected<HasFullUpdateShardKey, T>;
+
 // Update field
 template <typename T>
 using HasUpdatedField = decltype(T::kUpdatedField);
@@ -370,6 +399,7 @@ inline constexpr std::string_view kFetchStage = "fetch";
 inline constexpr std::string_view kParseStage = "parse";
 
 inline constexpr std::size_t kDefaultChunkSize = 1000;
+inline constexpr std::size_t kDefaultFullUpdateShards = 4;
 }  // namespace pg_cache::detail
 
 /// @ingroup userver_components
@@ -414,6 +444,12 @@ private:
     bool MayReturnNull() const override;
 
     CachedData GetDataSnapshot(cache::UpdateType type, tracing::ScopeTime& scope);
+    void FullUpdateSharded(CachedData& data_cache, cache::UpdateStatisticsScope& stats_scope);
+    std::vector<ValueType> FetchShard(
+        storages::postgres::Cluster& cluster,
+        std::size_t shard,
+        cache::UpdateStatisticsScope& stats_scope
+    ) const;
     void CacheResults(
         storages::postgres::ResultSet res,
         CachedData& data_cache,
@@ -423,8 +459,10 @@ private:
 
     static storages::postgres::Query GetAllQuery();
     static storages::postgres::Query GetDeltaQuery();
+    static storages::postgres::Query GetShardQuery();
 
     std::chrono::milliseconds ParseCorrection(const ComponentConfig& config);
+    static std::size_t ParseFullUpdateShards(const ComponentConfig& config);
 
     std::vector<storages::postgres::ClusterPtr> clusters_;
 
@@ -432,6 +470,7 @@ private:
     const std::chrono::milliseconds full_update_timeout_;
     const std::chrono::milliseconds incremental_update_timeout_;
     const std::size_t chunk_size_;
+    const std::size_t full_update_shards_;
     std::size_t cpu_relax_iterations_parse_{0};
     std::size_t cpu_relax_iterations_copy_{0};
 };
@@ -448,7 +487,8 @@ PostgreCache<PostgreCachePolicy>::PostgreCache(const ComponentConfig& config, co
       incremental_update_timeout_{config["incremental-update-op-timeout"].As<std::chrono::milliseconds>(
           pg_cache::detail::kDefaultIncrementalUpdateTimeout
       )},
-      chunk_size_{config["chunk-size"].As<size_t>(pg_cache::detail::kDefaultChunkSize)} {
+      chunk_size_{config["chunk-size"].As<size_t>(pg_cache::detail::kDefaultChunkSize)},
+      full_update_shards_{ParseFullUpdateShards(config)} {
     UINVARIANT(
         !chunk_size_ || storages::postgres::Portal::IsSupportedByDriver(),
         "Either set 'chunk-size' to 0, or enable PostgreSQL portals by building "
@@ -524,6 +564,45 @@ storages::postgres::Query PostgreCache<PostgreCachePolicy>::GetDeltaQuery() {
     }
 }
 
+template <typename PostgreCachePolicy>
+storages::postgres::Query PostgreCache<PostgreCachePolicy>::GetShardQuery() {
+    if constexpr (pg_cache::detail::kHasFullUpdateShardKey<PostgreCachePolicy>) {
+        storages::postgres::Query query = PolicyCheckerType::GetQuery();
+        const auto shard_condition =
+            fmt::format("abs(mod(coalesce(({})::bigint, 0), $1)) = $2", PostgreCachePolicy::kFullUpdateShardKey);
+
+        if constexpr (pg_cache::detail::kHasWhere<PostgreCachePolicy>) {
+            return {
+                fmt::format("{} where ({}) and {}", query.Statement(), PostgreCachePolicy::kWhere, shard_condition),
+                query.GetName()};
+        } else {
+            return {fmt::format("{} where {}", query.Statement(), shard_condition), query.GetName()};
+        }
+    } else {
+        return GetAllQuery();
+    }
+}
+
+template <typename PostgreCachePolicy>
+std::size_t PostgreCache<PostgreCachePolicy>::ParseFullUpdateShards(const ComponentConfig& config) {
+    if constexpr (pg_cache::detail::kHasFullUpdateShardKey<PostgreCachePolicy>) {
+        const auto shards = config["full-update-shards"].As<std::size_t>(pg_cache::detail::kDefaultFullUpdateShards);
+        if (shards == 0) {
+            throw std::logic_error("'full-update-shards' must be positive in config for '" + config.Name() + "' cache");
+        }
+        return shards;
+    } else {
+        const auto shards = config["full-update-shards"].As<std::size_t>(1);
+        if (shards != 1) {
+            throw std::logic_error(
+                "Sharded full updates are requested in config but no kFullUpdateShardKey is specified in traits of '" +
+                config.Name() + "' cache"
+            );
+        }
+        return shards;
+    }
+}
+
 template <typename PostgreCachePolicy>
 std::chrono::milliseconds PostgreCache<PostgreCachePolicy>::ParseCorrection(const ComponentConfig& config) {
     static constexpr std::string_view kUpdateCorrection = "update-correction";
@@ -562,6 +641,15 @@ void PostgreCache<PostgreCachePolicy>::Update(
     const std::chrono::milliseconds timeout =
         (type == cache::UpdateType::kFull) ? full_update_timeout_ : incremental_update_timeout_;
 
+    if (type == cache::UpdateType::kFull && full_update_shards_ > 1) {
+        auto data_cache = std::make_unique<DataType>();
+        FullUpdateSharded(data_cache, stats_scope);
+        stats_scope.Finish(data_cache->size());
+        pg_cache::detail::OnWritesDone(*data_cache);
+        this->Set(std::move(data_cache));
+        return;
+    }
+
     // COPY current cached data
     auto scope = tracing::Span::CurrentSpan().CreateScopeTime(std::string{pg_cache::detail::kCopyStage});
     auto data_cache = GetDataSnapshot(type, scope);
@@ -612,6 +700,14 @@ void PostgreCache<PostgreCachePolicy>::Update(
 
     scope.Reset();
 
+    const auto add_stage_duration = [&](cache::UpdateStage stage, std::string_view scope_name) {
+        const auto elapsed = scope.ElapsedTotal(std::string{scope_name});
+        stats_scope.AddStageDuration(stage, std::chrono::duration_cast<std::chrono::steady_clock::duration>(elapsed));
+    };
+    add_stage_duration(cache::UpdateStage::kCopy, pg_cache::detail::kCopyStage);
+    add_stage_duration(cache::UpdateStage::kFetch, pg_cache::detail::kFetchStage);
+    add_stage_duration(cache::UpdateStage::kParse, pg_cache::detail::kParseStage);
+
     if constexpr (pg_cache::detail::kIsContainerCopiedByElement<DataType>) {
         if (old_size > 0) {
             const auto elapsed_copy = scope.ElapsedTotal(std::string{pg_cache::detail::kCopyStage});
@@ -676,6 +772,83 @@ void PostgreCache<PostgreCachePolicy>::CacheResults(
     }
 }
 
+template <typename PostgreCachePolicy>
+void PostgreCache<PostgreCachePolicy>::FullUpdateSharded(
+    CachedData& data_cache,
+    cache::UpdateStatisticsScope& stats_scope
+) {
+    const auto fetch_shard = [this, &stats_scope](std::size_t index) {
+        auto& cluster = *clusters_[index / full_update_shards_];
+        return FetchShard(cluster, index % full_update_shards_, stats_scope);
+    };
+
+    cache::impl::FetchShardsAndMerge(
+        clusters_.size() * full_update_shards_,
+        cache::impl::kMaxShardsInFlight,
+        fetch_shard,
+        [&data_cache](ValueType&& value) {
+            using pg_cache::detail::CacheInsertOrAssign;
+            CacheInsertOrAssign(*data_cache, std::move(value), PostgreCachePolicy::kKeyMember);
+        },
+        stats_scope
+    );
+}
+
+template <typename PostgreCachePolicy>
+auto PostgreCache<PostgreCachePolicy>::FetchShard(
+    storages::postgres::Cluster& cluster,
+    std::size_t shard,
+    cache::UpdateStatisticsScope& stats_scope
+) const -> std::vector<ValueType> {
+    namespace pg = storages::postgres;
+    const auto query = GetShardQuery();
+    const pg::CommandControl cc{full_update_timeout_, pg_cache::detail::kStatementTimeoutOff};
+    const auto shard_count = static_cast<std::int64_t>(full_update_shards_);
+    const auto shard_index = static_cast<std::int64_t>(shard);
+
+    std::vector<ValueType> values;
+    const auto parse = [&](const pg::ResultSet& res) {
+        const auto parse_start = std::chrono::steady_clock::now();
+        values.reserve(values.size() + res.Size());
+        auto rows = res.AsSetOf<RawValueType>(pg::kRowTag);
+        utils::StreamingCpuRelax relax{1, nullptr};
+        for (auto p = rows.begin(); p != rows.end(); ++p) {
+            relax.Relax(1);
+            try {
+                values.push_back(pg_cache::detail::ExtractValue<PostgreCachePolicy>(*p));
+            } catch (const std::exception& e) {
+                stats_scope.IncreaseDocumentsParseFailures(1);
+                LOG_ERROR() << "Error parsing data row in cache '" << kName << "' to '"
+                            << compiler::GetTypeName<ValueType>() << "': " << e.what();
+            }
+        }
+        stats_scope.AddStageDuration(cache::UpdateStage::kParse, std::chrono::steady_clock::now() - parse_start);
+    };
+
+    auto fetch_start = std::chrono::steady_clock::now();
+    const auto fetched = [&](const pg::ResultSet& res) {
+        stats_scope.AddStageDuration(cache::UpdateStage::kFetch, std::chrono::steady_clock::now() - fetch_start);
+        stats_scope.IncreaseDocumentsReadCount(res.Size());
+    };
+
+    if (chunk_size_ > 0) {
+        auto trx = cluster.Begin(kClusterHostTypeFlags, pg::Transaction::RO, cc);
+        auto portal = trx.MakePortal(query, shard_count, shard_index);
+        while (portal) {
+            fetch_start = std::chrono::steady_clock::now();
+            auto res = portal.Fetch(chunk_size_);
+            fetched(res);
+            parse(res);
+        }
+        trx.Commit();
+    } else {
+        auto res = cluster.Execute(kClusterHostTypeFlags, cc, query, shard_count, shard_index);
+        fetched(res);
+        parse(res);
+    }
+    return values;
+}
+
 template <typename PostgreCachePolicy>
 typename PostgreCache<PostgreCachePolicy>::CachedData
 PostgreCache<PostgreCachePolicy>::GetDataSnapshot(cache::UpdateType type, tracing::ScopeTime& scope) {
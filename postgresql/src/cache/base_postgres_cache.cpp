@@ -28,6 +28,11 @@ properties:
         type: integer
         description: number of rows to request from PostgreSQL, 0 to fetch all rows in one request
         defaultDescription: 1000
+    full-update-shards:
+        type: integer
+        description: number of concurrent queries of a full update, requires kFullUpdateShardKey in the cache policy
+        defaultDescription: 4 for policies with kFullUpdateShardKey, 1 otherwise
+        minimum: 1
     pgcomponent:
         type: string
         description: PostgreSQL component name
@@ -0,0 +1,120 @@
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include <userver/logging/impl/binary_format.hpp>
+
+#include <userver/utest/using_namespace_userver.hpp>
+
+namespace {
+
+namespace binary = logging::impl::binary;
+
+constexpr std::size_t kReadChunkSize = 1 << 16;
+
+struct Config {
+    std::string format = "tskv";
+    bool follow = false;
+    std::vector<std::string> files;
+};
+
+Config ParseConfig(int argc, char** argv) {
+    namespace po = boost::program_options;
+
+    Config config;
+    po::options_description desc("Converts logs in `binary` format to TSKV or JSON lines.\nAllowed options");
+    desc.add_options()("help,h", "produce help message")(
+        "format,f", po::value(&config.format)->default_value(config.format), "output format (tskv, json)"
+    )("follow", po::bool_switch(&config.follow), "wait for the new records at the end of the input, like `tail -f`")(
+        "files", po::value(&config.files), "input files, stdin is used if none"
+    );
+
+    po::positional_options_description pos_desc;
+    pos_desc.add("files", -1);
+
+    po::variables_map vm;
+    try {
+        po::store(po::command_line_parser(argc, argv).options(desc).positional(pos_desc).run(), vm);
+        po::notify(vm);
+    } catch (const std::exception& ex) {
+        std::cerr << "Cannot parse command line: " << ex.what() << '\n';
+        exit(1);
+    }
+
+    if (vm.count("help")) {
+        std::cout << desc << '\n';
+        exit(0);
+    }
+
+    if (config.format != "tskv" && config.format != "json") {
+        std::cerr << "Unknown output format '" << config.format << "'\n";
+        exit(1);
+    }
+
+    return config;
+}
+
+bool WaitForData(std::istream& input, bool follow) {
+    if (!follow) return false;
+    input.clear();
+    std::this_thread::sleep_for(std::chrono::milliseconds{100});
+    return true;
+}
+
+void Decode(std::istream& input, const Config& config) {
+    const auto append_record = (config.format == "json") ? &binary::AppendJson : &binary::AppendTskv;
+
+    std::string data;
+    std::string output;
+    std::vector<char> chunk(kReadChunkSize);
+    while (true) {
+        input.read(chunk.data(), chunk.size());
+        const auto read_size = input.gcount();
+        if (read_size == 0) {
+            if (input.bad() || !WaitForData(input, config.follow)) break;
+            continue;
+        }
+        data.append(chunk.data(), read_size);
+
+        binary::RecordReader reader{data};
+        while (auto record = reader.Next()) append_record(*record, output);
+        std::cout << output;
+        output.clear();
+        data.erase(0, reader.GetConsumedSize());
+    }
+
+    if (!data.empty() && data.find_first_not_of('\n') != std::string::npos) {
+        std::cerr << "Incomplete record of " << data.size() << " bytes at the end of the input is skipped\n";
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const auto config = ParseConfig(argc, argv);
+
+    try {
+        if (config.files.empty()) {
+            Decode(std::cin, config);
+        }
+        for (const auto& file : config.files) {
+            std::ifstream input{file, std::ios::binary};
+            if (!input) {
+                std::cerr << "Cannot open '" << file << "'\n";
+                return 1;
+            }
+            Decode(input, config);
+        }
+    } catch (const binary::DecodeError& ex) {
+        std::cerr << "Malformed input: " << ex.what() << '\n';
+        return 1;
+    }
+    std::cout.flush();
+    return 0;
+}
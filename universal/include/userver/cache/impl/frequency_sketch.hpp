@@ -0,0 +1,137 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+/// Count-Min sketch with 4-bit counters that estimates how often the keys
+/// were accessed recently.
+///
+/// Each key is counted in 4 rows, the estimate is the minimum of the counters.
+/// Counters saturate at 15. After 10 * capacity increments all the counters
+/// are halved, so the old popularity fades away.
+template <typename T, typename Hash = std::hash<T>>
+class FrequencySketch final {
+public:
+    explicit FrequencySketch(std::size_t capacity, const Hash& hash = Hash());
+
+    void Increment(const T& key);
+
+    std::uint8_t GetFrequency(const T& key) const;
+
+    /// Resizes the table, forgets the frequencies if the size changes
+    void SetCapacity(std::size_t capacity);
+
+    void Clear() noexcept;
+
+private:
+    static constexpr std::size_t kDepth = 4;
+    static constexpr std::uint64_t kMaxCounter = 15;
+    // Clears the most significant bit of each counter after the shift by 1
+    static constexpr std::uint64_t kAgeMask = 0x7777777777777777ULL;
+
+    struct Counter {
+        std::size_t word;
+        std::size_t shift;
+    };
+
+    std::array<Counter, kDepth> GetCounters(const T& key) const;
+    void Age() noexcept;
+
+    std::vector<std::uint64_t> table_;
+    std::size_t sample_size_{0};
+    std::size_t additions_{0};
+    Hash hash_;
+};
+
+template <typename T, typename Hash>
+FrequencySketch<T, Hash>::FrequencySketch(std::size_t capacity, const Hash& hash) : hash_(hash) {
+    SetCapacity(capacity);
+}
+
+template <typename T, typename Hash>
+void FrequencySketch<T, Hash>::Increment(const T& key) {
+    bool incremented = false;
+    for (const auto& counter : GetCounters(key)) {
+        auto& word = table_[counter.word];
+        if (((word >> counter.shift) & kMaxCounter) != kMaxCounter) {
+            word += std::uint64_t{1} << counter.shift;
+            incremented = true;
+        }
+    }
+
+    if (incremented && ++additions_ >= sample_size_) Age();
+}
+
+template <typename T, typename Hash>
+std::uint8_t FrequencySketch<T, Hash>::GetFrequency(const T& key) const {
+    auto frequency = kMaxCounter;
+    for (const auto& counter : GetCounters(key)) {
+        const auto value = (table_[counter.word] >> counter.shift) & kMaxCounter;
+        if (value < frequency) frequency = value;
+    }
+    return static_cast<std::uint8_t>(frequency);
+}
+
+template <typename T, typename Hash>
+void FrequencySketch<T, Hash>::SetCapacity(std::size_t capacity) {
+    // Each word holds 16 counters, 4 for each of the rows
+    std::size_t table_size = 1;
+    while (table_size < capacity) table_size *= 2;
+
+    sample_size_ = 10 * (capacity ? capacity : 1);
+    if (table_.size() == table_size) return;
+
+    table_.assign(table_size, 0);
+    additions_ = 0;
+}
+
+template <typename T, typename Hash>
+void FrequencySketch<T, Hash>::Clear() noexcept {
+    std::fill(table_.begin(), table_.end(), 0);
+    additions_ = 0;
+}
+
+template <typename T, typename Hash>
+auto FrequencySketch<T, Hash>::GetCounters(const T& key) const -> std::array<Counter, kDepth> {
+    constexpr std::array<std::uint64_t, kDepth> kSeeds{
+        0x97cb3127a6c06c8fULL,
+        0xc3a5c85c97cb3127ULL,
+        0xb492b66fbe98f273ULL,
+        0x9ae16a3b2f90404fULL,
+    };
+
+    // murmur3 finalizer, spreads the bits of the weak hashes like std::hash<int>
+    auto h = static_cast<std::uint64_t>(hash_(key));
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+
+    const auto mask = table_.size() - 1;
+    std::array<Counter, kDepth> counters{};
+    for (std::size_t i = 0; i < kDepth; ++i) {
+        const auto row_hash = (h + kSeeds[i]) * kSeeds[i];
+        counters[i].word = static_cast<std::size_t>(row_hash >> 32) & mask;
+        counters[i].shift = ((i << 2) + (row_hash & 3)) << 2;
+    }
+    return counters;
+}
+
+template <typename T, typename Hash>
+void FrequencySketch<T, Hash>::Age() noexcept {
+    for (auto& word : table_) {
+        word = (word >> 1) & kAgeMask;
+    }
+    additions_ /= 2;
+}
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
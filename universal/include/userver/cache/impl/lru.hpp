@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <vector>
 
@@ -22,9 +23,17 @@ using LinkMode = utils::impl::IntrusiveLinkMode;
 using LruListHook = boost::intrusive::list_base_hook<LinkMode>;
 using LruHashSetHook = boost::intrusive::unordered_set_base_hook<LinkMode>;
 
-template <class Key, class Value>
+/// Per-node data of LruBase that is not a part of the value
+struct NoNodeData {};
+
+/// Weight of the element for the caches bounded by bytes
+struct NodeWeight {
+    std::size_t weight{0};
+};
+
+template <class Key, class Value, class Data = NoNodeData>
 // NOLINTNEXTLINE(fuchsia-multiple-inheritance)
-class LruNode final : public LruListHook, public LruHashSetHook {
+class LruNode final : public LruListHook, public LruHashSetHook, public Data {
 public:
     template <typename... Args>
     explicit LruNode(Key&& key, Args&&... args) : key_(std::move(key)), value_(std::forward<Args>(args)...) {}
@@ -45,9 +54,9 @@ private:
     Value value_;
 };
 
-template <class Key>
+template <class Key, class Data>
 // NOLINTNEXTLINE(fuchsia-multiple-inheritance)
-class LruNode<Key, EmptyPlaceholder> final : public LruListHook, public LruHashSetHook {
+class LruNode<Key, EmptyPlaceholder, Data> final : public LruListHook, public LruHashSetHook, public Data {
 public:
     explicit LruNode(Key&& key, EmptyPlaceholder /*value*/) : key_(std::move(key)) {}
 
@@ -66,8 +75,8 @@ private:
     Key key_;
 };
 
-template <class Key, class Value>
-const Key& GetKey(const LruNode<Key, Value>& node) noexcept {
+template <class Key, class Value, class Data>
+const Key& GetKey(const LruNode<Key, Value, Data>& node) noexcept {
     return node.GetKey();
 }
 
@@ -76,10 +85,15 @@ const T& GetKey(const T& key) noexcept {
     return key;
 }
 
-template <typename T, typename U, typename Hash = std::hash<T>, typename Equal = std::equal_to<T>>
+template <
+    typename T,
+    typename U,
+    typename Hash = std::hash<T>,
+    typename Equal = std::equal_to<T>,
+    typename Data = NoNodeData>
 class LruBase final {
 public:
-    using NodeType = std::unique_ptr<LruNode<T, U>>;
+    using NodeType = std::unique_ptr<LruNode<T, U, Data>>;
 
     explicit LruBase(size_t max_size, const Hash& hash, const Equal& equal);
     ~LruBase() { Clear(); }
@@ -129,6 +143,10 @@ public:
     template <typename Function>
     void VisitAll(Function&& func);
 
+    /// Calls `func(node)` for all the nodes, e.g. to update their data
+    template <typename Function>
+    void VisitAllNodes(Function&& func);
+
     size_t GetSize() const;
 
     U& InsertNode(NodeType&& node) noexcept;
@@ -137,7 +155,7 @@ public:
     std::size_t GetCapacity() const;
 
 private:
-    using Node = LruNode<T, U>;
+    using Node = LruNode<T, U, Data>;
     using List = boost::intrusive::list<Node, boost::intrusive::constant_time_size<false>>;
 
     struct LruNodeHash : Hash {
@@ -176,14 +194,14 @@ private:
     List list_;
 };
 
-template <typename T, typename U, typename Hash, typename Equal>
-LruBase<T, U, Hash, Equal>::LruBase(size_t max_size, const Hash& hash, const Equal& eq)
+template <typename T, typename U, typename Hash, typename Equal, typename Data>
+LruBase<T, U, Hash, Equal, Data>::LruBase(size_t max_size, const Hash& hash, const Equal& eq)
     : buckets_(max_size ? max_size : 1), map_(BucketTraits(buckets_.data(), buckets_.size()), hash, eq) {
     UASSERT(max_size > 0);
 }
 
-template <typename T, typename U, typename Hash, typename Eq>
-bool LruBase<T, U, Hash, Eq>::Put(const T& key, U value) {
+template <typename T, typename U, typename Hash, typename Eq, typename Data>
+bool LruBase<T, U, Hash, Eq, Data>::Put(const T& key, U value) {
     auto it = map_.find(key, map_.hash_function(), map_.key_eq());
     if (it != map_.end()) {
         it->SetValue(std::move(value));
@@ -195,9 +213,9 @@ bool LruBase<T, U, Hash, Eq>::Put(const T& key, U value) {
     return true;
 }
 
-template <typename T, typename U, typename Hash, typename Eq>
+template <typename T, typename U, typename Hash, typename Eq, typename Data>
 template <typename... Args>
-U* LruBase<T, U, Hash, Eq>::Emplace(const T& key, Args&&... args) {
+U* LruBase<T, U, Hash, Eq, Data>::Emplace(const T& key, Args&&... args) {
     auto* existing = Get(key);
     if (existing) return existing;
 
@@ -212,41 +230,41 @@ U* LruBase<T, U, Hash, Eq>::Emplace(const T& key, Args&&... args) {
     }
 }
 
-template <typename T, typename U, typename Hash, typename Eq>
-void LruBase<T, U, Hash, Eq>::Erase(const T& key) {
+template <typename T, typename U, typename Hash, typename Eq, typename Data>
+void LruBase<T, U, Hash, Eq, Data>::Erase(const T& key) {
     auto it = map_.find(key, map_.hash_function(), map_.key_eq());
     if (it == map_.end()) return;
     ExtractNode(list_.iterator_to(*it));
 }
 
-template <typename T, typename U, typename Hash, typename Eq>
-U* LruBase<T, U, Hash, Eq>::Get(const T& key) {
+template <typename T, typename U, typename Hash, typename Eq, typename Data>
+U* LruBase<T, U, Hash, Eq, Data>::Get(const T& key) {
     auto it = map_.find(key, map_.hash_function(), map_.key_eq());
     if (it == map_.end()) return nullptr;
     MarkRecentlyUsed(*it);
     return &it->GetValue();
 }
 
-template <typename T, typename U, typename Hash, typename Eq>
-const T* LruBase<T, U, Hash, Eq>::GetLeastUsedKey() const {
+template <typename T, typename U, typename Hash, typename Eq, typename Data>
+const T* LruBase<T, U, Hash, Eq, Data>::GetLeastUsedKey() const {
     if (list_.empty()) return nullptr;
     return &list_.front().GetKey();
 }
 
-template <typename T, typename U, typename Hash, typename Eq>
-U* LruBase<T, U, Hash, Eq>::GetLeastUsedValue() {
+template <typename T, typename U, typename Hash, typename Eq, typename Data>
+U* LruBase<T, U, Hash, Eq, Data>::GetLeastUsedValue() {
     if (list_.empty()) return nullptr;
     return &list_.front().GetValue();
 }
 
-template <typename T, typename U, typename Hash, typename Eq>
-typename LruBase<T, U, Hash, Eq>::NodeType LruBase<T, U, Hash, Eq>::ExtractLeastUsedNode() {
-    if (list_.empty()) return std::unique_ptr<LruNode<T, U>>();
+template <typename T, typename U, typename Hash, typename Eq, typename Data>
+typename LruBase<T, U, Hash, Eq, Data>::NodeType LruBase<T, U, Hash, Eq, Data>::ExtractLeastUsedNode() {
+    if (list_.empty()) return std::unique_ptr<LruNode<T, U, Data>>();
     return ExtractNode(list_.begin());
 }
 
-template <typename T, typename U, typename Hash, typename Eq>
-void LruBase<T, U, Hash, Eq>::SetMaxSize(size_t new_max_size) {
+template <typename T, typename U, typename Hash, typename Eq, typename Data>
+void LruBase<T, U, Hash, Eq, Data>::SetMaxSize(size_t new_max_size) {
     UASSERT(new_max_size > 0);
     if (!new_max_size) ++new_max_size;
 
@@ -263,41 +281,49 @@ void LruBase<T, U, Hash, Eq>::SetMaxSize(size_t new_max_size) {
     buckets_.swap(new_buckets);
 }
 
-template <typename T, typename U, typename Hash, typename Eq>
-void LruBase<T, U, Hash, Eq>::Clear() noexcept {
+template <typename T, typename U, typename Hash, typename Eq, typename Data>
+void LruBase<T, U, Hash, Eq, Data>::Clear() noexcept {
     while (!list_.empty()) {
         ExtractNode(list_.begin());
     }
 }
 
-template <typename T, typename U, typename Hash, typename Eq>
+template <typename T, typename U, typename Hash, typename Eq, typename Data>
 template <typename Function>
-void LruBase<T, U, Hash, Eq>::VisitAll(Function&& func) const {
+void LruBase<T, U, Hash, Eq, Data>::VisitAll(Function&& func) const {
     for (const auto& node : map_) {
         func(node.GetKey(), node.GetValue());
     }
 }
 
-template <typename T, typename U, typename Hash, typename Eq>
+template <typename T, typename U, typename Hash, typename Eq, typename Data>
 template <typename Function>
-void LruBase<T, U, Hash, Eq>::VisitAll(Function&& func) {
+void LruBase<T, U, Hash, Eq, Data>::VisitAll(Function&& func) {
     for (auto& node : map_) {
         func(node.GetKey(), node.GetValue());
     }
 }
 
-template <typename T, typename U, typename Hash, typename Eq>
-size_t LruBase<T, U, Hash, Eq>::GetSize() const {
+template <typename T, typename U, typename Hash, typename Eq, typename Data>
+template <typename Function>
+void LruBase<T, U, Hash, Eq, Data>::VisitAllNodes(Function&& func) {
+    for (auto& node : map_) {
+        func(node);
+    }
+}
+
+template <typename T, typename U, typename Hash, typename Eq, typename Data>
+size_t LruBase<T, U, Hash, Eq, Data>::GetSize() const {
     return map_.size();
 }
 
-template <typename T, typename U, typename Hash, typename Eq>
-std::size_t LruBase<T, U, Hash, Eq>::GetCapacity() const {
+template <typename T, typename U, typename Hash, typename Eq, typename Data>
+std::size_t LruBase<T, U, Hash, Eq, Data>::GetCapacity() const {
     return buckets_.size();
 }
 
-template <typename T, typename U, typename Hash, typename Eq>
-U& LruBase<T, U, Hash, Eq>::Add(const T& key, U value) {
+template <typename T, typename U, typename Hash, typename Eq, typename Data>
+U& LruBase<T, U, Hash, Eq, Data>::Add(const T& key, U value) {
     if (map_.size() < buckets_.size()) {
         auto node = std::make_unique<Node>(T{key}, std::move(value));
         return InsertNode(std::move(node));
@@ -309,13 +335,13 @@ U& LruBase<T, U, Hash, Eq>::Add(const T& key, U value) {
     return InsertNode(std::move(node));
 }
 
-template <typename T, typename U, typename Hash, typename Eq>
-void LruBase<T, U, Hash, Eq>::MarkRecentlyUsed(Node& node) noexcept {
+template <typename T, typename U, typename Hash, typename Eq, typename Data>
+void LruBase<T, U, Hash, Eq, Data>::MarkRecentlyUsed(Node& node) noexcept {
     list_.splice(list_.end(), list_, list_.iterator_to(node));
 }
 
-template <typename T, typename U, typename Hash, typename Eq>
-std::unique_ptr<LruNode<T, U>> LruBase<T, U, Hash, Eq>::ExtractNode(typename List::iterator it) noexcept {
+template <typename T, typename U, typename Hash, typename Eq, typename Data>
+std::unique_ptr<LruNode<T, U, Data>> LruBase<T, U, Hash, Eq, Data>::ExtractNode(typename List::iterator it) noexcept {
     UASSERT(it != list_.end());
 
     std::unique_ptr<Node> ret(&*it);
@@ -324,8 +350,8 @@ std::unique_ptr<LruNode<T, U>> LruBase<T, U, Hash, Eq>::ExtractNode(typename Lis
     return ret;
 }
 
-template <typename T, typename U, typename Hash, typename Eq>
-U& LruBase<T, U, Hash, Eq>::InsertNode(LruBase<T, U, Hash, Eq>::NodeType&& node) noexcept {
+template <typename T, typename U, typename Hash, typename Eq, typename Data>
+U& LruBase<T, U, Hash, Eq, Data>::InsertNode(LruBase<T, U, Hash, Eq, Data>::NodeType&& node) noexcept {
     UASSERT(node);
 
     auto [it, ok] = map_.insert(*node);  // noexcept
@@ -335,8 +361,8 @@ U& LruBase<T, U, Hash, Eq>::InsertNode(LruBase<T, U, Hash, Eq>::NodeType&& node)
     return node.release()->GetValue();
 }
 
-template <typename T, typename U, typename Hash, typename Eq>
-typename LruBase<T, U, Hash, Eq>::NodeType LruBase<T, U, Hash, Eq>::ExtractNode(const T& key) noexcept {
+template <typename T, typename U, typename Hash, typename Eq, typename Data>
+typename LruBase<T, U, Hash, Eq, Data>::NodeType LruBase<T, U, Hash, Eq, Data>::ExtractNode(const T& key) noexcept {
     auto it = map_.find(key, map_.hash_function(), map_.key_eq());
     if (it == map_.end()) {
         return NodeType();
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include <userver/cache/impl/frequency_sketch.hpp>
+#include <userver/cache/impl/lru.hpp>
+#include <userver/cache/impl/slru.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+/// W-TinyLFU cache: new elements go to a small LRU window, the elements
+/// evicted from the window compete for a place in the main SLRU region with
+/// its least recently used element. The one that was accessed more often
+/// according to the FrequencySketch stays. That keeps one-off accesses, such
+/// as scans over many keys, from flushing the frequently used elements.
+///
+/// The window takes 1% of the capacity, the protected part of the main region
+/// takes 80% of the rest.
+template <typename T, typename U, typename Hash = std::hash<T>, typename Equal = std::equal_to<T>>
+class WTinyLfuBase final {
+public:
+    using NodeType = std::unique_ptr<LruNode<T, U>>;
+
+    explicit WTinyLfuBase(std::size_t max_size, const Hash& hash = Hash(), const Equal& equal = Equal());
+
+    WTinyLfuBase(WTinyLfuBase&& other) noexcept = default;
+    WTinyLfuBase& operator=(WTinyLfuBase&& other) noexcept = default;
+
+    WTinyLfuBase(const WTinyLfuBase&) = delete;
+    WTinyLfuBase& operator=(const WTinyLfuBase&) = delete;
+
+    bool Put(const T& key, U value);
+
+    void Erase(const T& key);
+
+    U* Get(const T& key);
+
+    void SetMaxSize(std::size_t new_max_size);
+
+    void Clear() noexcept;
+
+    template <typename Function>
+    void VisitAll(Function&& func) const;
+
+    template <typename Function>
+    void VisitAll(Function&& func);
+
+    std::size_t GetSize() const;
+
+    std::size_t GetCapacity() const;
+
+private:
+    struct Sizes {
+        std::size_t window;
+        std::size_t probation;
+        std::size_t protected_part;
+    };
+
+    static Sizes GetSizes(std::size_t max_size) noexcept;
+
+    // Returns the node of the evicted element, if any
+    NodeType Admit(NodeType&& candidate);
+
+    LruBase<T, U, Hash, Equal> window_;
+    SlruBase<T, U, Hash, Equal> main_;
+    FrequencySketch<T, Hash> sketch_;
+};
+
+template <typename T, typename U, typename Hash, typename Equal>
+WTinyLfuBase<T, U, Hash, Equal>::WTinyLfuBase(std::size_t max_size, const Hash& hash, const Equal& equal)
+    : window_(GetSizes(max_size).window, hash, equal),
+      main_(GetSizes(max_size).probation, GetSizes(max_size).protected_part, hash, equal),
+      sketch_(max_size, hash) {}
+
+template <typename T, typename U, typename Hash, typename Equal>
+bool WTinyLfuBase<T, U, Hash, Equal>::Put(const T& key, U value) {
+    sketch_.Increment(key);
+
+    auto* value_ptr = window_.Get(key);
+    if (!value_ptr) value_ptr = main_.Get(key);
+    if (value_ptr) {
+        *value_ptr = std::move(value);
+        return false;
+    }
+
+    if (window_.GetSize() < window_.GetCapacity()) {
+        window_.InsertNode(std::make_unique<LruNode<T, U>>(T{key}, std::move(value)));
+        return true;
+    }
+
+    // Node of the element that lost the competition is reused for the new one
+    auto node = Admit(window_.ExtractLeastUsedNode());
+    if (node) {
+        node->SetKey(key);
+        node->SetValue(std::move(value));
+    } else {
+        node = std::make_unique<LruNode<T, U>>(T{key}, std::move(value));
+    }
+    window_.InsertNode(std::move(node));
+    return true;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void WTinyLfuBase<T, U, Hash, Equal>::Erase(const T& key) {
+    window_.Erase(key);
+    main_.Erase(key);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+U* WTinyLfuBase<T, U, Hash, Equal>::Get(const T& key) {
+    sketch_.Increment(key);
+
+    auto* value_ptr = window_.Get(key);
+    if (value_ptr) return value_ptr;
+    return main_.Get(key);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void WTinyLfuBase<T, U, Hash, Equal>::SetMaxSize(std::size_t new_max_size) {
+    const auto sizes = GetSizes(new_max_size);
+    window_.SetMaxSize(sizes.window);
+    main_.SetMaxSize(sizes.probation, sizes.protected_part);
+    sketch_.SetCapacity(new_max_size);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void WTinyLfuBase<T, U, Hash, Equal>::Clear() noexcept {
+    window_.Clear();
+    main_.Clear();
+    sketch_.Clear();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename Function>
+void WTinyLfuBase<T, U, Hash, Equal>::VisitAll(Function&& func) const {
+    window_.VisitAll(func);
+    main_.VisitAll(std::forward<Function>(func));
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename Function>
+void WTinyLfuBase<T, U, Hash, Equal>::VisitAll(Function&& func) {
+    window_.VisitAll(func);
+    main_.VisitAll(std::forward<Function>(func));
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+std::size_t WTinyLfuBase<T, U, Hash, Equal>::GetSize() const {
+    return window_.GetSize() + main_.GetSize();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+std::size_t WTinyLfuBase<T, U, Hash, Equal>::GetCapacity() const {
+    return window_.GetCapacity() + main_.GetCapacity();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+auto WTinyLfuBase<T, U, Hash, Equal>::GetSizes(std::size_t max_size) noexcept -> Sizes {
+    // Each of the parts holds at least 1 element, so the tiny caches are
+    // slightly larger than max_size
+    const auto window = std::max(max_size / 100, std::size_t{1});
+    const auto main = max_size > window ? max_size - window : std::size_t{1};
+    const auto protected_part = std::max(main * 4 / 5, std::size_t{1});
+    const auto probation = main > protected_part ? main - protected_part : std::size_t{1};
+    return {window, probation, protected_part};
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+auto WTinyLfuBase<T, U, Hash, Equal>::Admit(NodeType&& candidate) -> NodeType {
+    // While the protected part is not full the probation part may take its place
+    if (main_.GetSize() < main_.GetCapacity()) {
+        main_.InsertNode(std::move(candidate));
+        return {};
+    }
+
+    const auto* victim_key = main_.GetLeastUsedKey();
+    if (!victim_key || sketch_.GetFrequency(candidate->GetKey()) <= sketch_.GetFrequency(*victim_key)) {
+        return std::move(candidate);
+    }
+
+    auto victim = main_.ExtractLeastUsedNode();
+    main_.InsertNode(std::move(candidate));
+    return victim;
+}
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,600 @@
+#pragma once
+
+/// @file userver/cache/persistent_hash_map.hpp
+/// @brief @copybrief cache::PersistentHashMap
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+/// @ingroup userver_universal userver_containers
+///
+/// @brief Hash map with O(1) copying, the copies share the unchanged parts.
+///
+/// The map is a hash array mapped trie with copy-on-write nodes. Copying the
+/// map copies a single pointer, a modification of a copy copies only the nodes
+/// on the path to the modified element (at most log32(size) nodes of at most
+/// 32 pointers). The nodes that are not shared with other copies are modified
+/// in place.
+///
+/// Use it as a data type of components::CachingComponentBase with incremental
+/// updates: a new snapshot is made by copying the current one and applying the
+/// changes to the copy, which takes memory and time proportional to the size of
+/// the changes rather than to the size of the cache. For example:
+///
+/// @code
+/// struct MyPolicy {
+///     // ...
+///     using CacheContainer = cache::PersistentHashMap<Key, Value>;
+/// };
+/// @endcode
+///
+/// Lookups follow a pointer per level of the trie, so they are a few times
+/// slower than the lookups in std::unordered_map for the maps that do not fit
+/// into the CPU caches. Prefer std::unordered_map for the caches that are
+/// rarely updated or updated only with full updates.
+///
+/// Thread safety matches Standard Library thread safety: different copies may
+/// be read and modified concurrently, even if they share the nodes. Each copy
+/// tags the nodes it creates, the nodes with the tags of other copies are
+/// never modified in place.
+///
+/// Differences from std::unordered_map: only constant iterators are provided,
+/// insert functions return only whether the element was inserted, references
+/// to the elements are invalidated by the modifications of the map.
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>>
+class PersistentHashMap final {
+    struct Node;
+
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<const Key, Value>;
+    using size_type = std::size_t;
+    using hasher = Hash;
+    using key_equal = Equal;
+
+    class const_iterator;
+    using iterator = const_iterator;
+
+    explicit PersistentHashMap(const Hash& hash = Hash(), const Equal& equal = Equal()) : hash_(hash), equal_(equal) {}
+
+    PersistentHashMap(const PersistentHashMap& other);
+    PersistentHashMap(PersistentHashMap&& other) noexcept;
+    PersistentHashMap& operator=(const PersistentHashMap& other);
+    PersistentHashMap& operator=(PersistentHashMap&& other) noexcept;
+
+    const_iterator begin() const;
+    const_iterator end() const { return {}; }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    size_type size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    const_iterator find(const Key& key) const;
+    size_type count(const Key& key) const { return FindEntry(key) ? 1 : 0; }
+
+    /// @throws std::out_of_range if there is no such key
+    const Value& at(const Key& key) const;
+
+    /// @returns true if the element was inserted, false if it was assigned
+    template <typename M>
+    bool insert_or_assign(const Key& key, M&& value);
+
+    /// @returns true if the element was inserted, false if the key was present
+    bool insert(value_type value);
+
+    /// Inserts a default constructed value if there is no such key
+    /// @warning The reference is invalidated by the next modification
+    Value& operator[](const Key& key);
+
+    size_type erase(const Key& key);
+
+    void clear() noexcept {
+        root_.reset();
+        size_ = 0;
+    }
+
+private:
+    static constexpr std::size_t kBitsPerLevel = 5;
+    // Levels below use all the bits of the hash, the nodes of this level keep
+    // the colliding elements in a plain list
+    static constexpr std::size_t kCollisionLevel = (64 + kBitsPerLevel - 1) / kBitsPerLevel;
+
+    // Tag of the copy of the map that may modify the node or the entry in place
+    using Owner = std::uint64_t;
+
+    struct Entry final {
+        template <typename... Args>
+        explicit Entry(Owner owner, std::uint64_t hash, Args&&... args)
+            : owner(owner), hash(hash), value(std::forward<Args>(args)...) {}
+
+        const Owner owner;
+        const std::uint64_t hash;
+        value_type value;
+    };
+
+    using EntryPtr = std::shared_ptr<Entry>;
+    using NodePtr = std::shared_ptr<Node>;
+
+    struct Node final {
+        Owner owner{0};
+        // Bits of the entries and of the children among the 32 slots of the
+        // node, both are unused on the kCollisionLevel
+        std::uint32_t entries_map{0};
+        std::uint32_t children_map{0};
+        std::vector<EntryPtr> entries;
+        std::vector<NodePtr> children;
+    };
+
+    static std::uint32_t GetBit(std::uint64_t hash, std::size_t level) noexcept {
+        return std::uint32_t{1} << ((hash >> (level * kBitsPerLevel)) & 31);
+    }
+
+    static std::size_t GetIndex(std::uint32_t map, std::uint32_t bit) noexcept {
+        // Portable popcount, std::bitset::count() is a libgcc call without -mpopcnt
+        auto x = map & (bit - 1);
+        x = x - ((x >> 1) & 0x55555555);
+        x = (x & 0x33333333) + ((x >> 2) & 0x33333333);
+        x = (x + (x >> 4)) & 0x0F0F0F0F;
+        return (x * 0x01010101) >> 24;
+    }
+
+    std::uint64_t GetHash(const Key& key) const { return static_cast<std::uint64_t>(hash_(key)); }
+
+    static Owner MakeOwner() noexcept {
+        static std::atomic<Owner> last_owner{0};
+        return last_owner.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    Owner GetOwner() const noexcept { return owner_.load(std::memory_order_relaxed); }
+
+    NodePtr MakeNode() const;
+
+    // Same as find(), but without building the iterator
+    const Entry* FindEntry(const Key& key) const;
+
+    // Makes the node modifiable by this map only, copying it if it was
+    // created by another copy of the map
+    Node& MakeUnique(NodePtr& node);
+
+    // Finds the entry of the key in a subtree that is not shared
+    EntryPtr& FindInSubtree(Node& node, std::size_t level, std::uint64_t hash, const Key& key) const;
+
+    // Returns the entry of the key, inserting the one made by make_entry if
+    // there is none
+    template <typename MakeEntry>
+    std::pair<EntryPtr*, bool> FindOrInsert(std::uint64_t hash, const Key& key, MakeEntry make_entry);
+
+    NodePtr MakeSubtree(std::size_t level, EntryPtr first, EntryPtr second) const;
+
+    // Returns true if the key was erased
+    bool Erase(Node& node, std::size_t level, std::uint64_t hash, const Key& key);
+
+    NodePtr root_;
+    size_type size_{0};
+    Hash hash_;
+    Equal equal_;
+    // A copy of the map gets new tags for both the copy and the original, as
+    // the nodes of the original are shared from now on. Copying only reads
+    // the nodes, so the copies of the same map may be made concurrently.
+    mutable std::atomic<Owner> owner_{MakeOwner()};
+};
+
+/// Forward iterator over the elements of cache::PersistentHashMap
+template <typename Key, typename Value, typename Hash, typename Equal>
+class PersistentHashMap<Key, Value, Hash, Equal>::const_iterator final {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename PersistentHashMap::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+
+    const_iterator() = default;
+
+    reference operator*() const {
+        UASSERT(current_);
+        return current_->value;
+    }
+
+    pointer operator->() const { return &**this; }
+
+    const_iterator& operator++() {
+        Advance();
+        return *this;
+    }
+
+    const_iterator operator++(int) {
+        auto copy = *this;
+        Advance();
+        return copy;
+    }
+
+    bool operator==(const const_iterator& other) const noexcept { return current_ == other.current_; }
+    bool operator!=(const const_iterator& other) const noexcept { return current_ != other.current_; }
+
+private:
+    friend class PersistentHashMap;
+
+    // The entries of a node go before the entries of its children
+    struct Frame {
+        const Node* node;
+        std::size_t next_entry;
+        std::size_t next_child;
+    };
+
+    void Push(const Node* node, std::size_t next_entry, std::size_t next_child) {
+        UASSERT(depth_ < stack_.size());
+        stack_[depth_++] = Frame{node, next_entry, next_child};
+    }
+
+    void Advance() {
+        while (depth_ > 0) {
+            auto& frame = stack_[depth_ - 1];
+            if (frame.next_entry < frame.node->entries.size()) {
+                current_ = frame.node->entries[frame.next_entry++].get();
+                return;
+            }
+            if (frame.next_child < frame.node->children.size()) {
+                Push(frame.node->children[frame.next_child++].get(), 0, 0);
+                continue;
+            }
+            --depth_;
+        }
+        current_ = nullptr;
+    }
+
+    // Only the first depth_ frames are initialized
+    std::array<Frame, kCollisionLevel + 1> stack_;
+    std::size_t depth_{0};
+    const Entry* current_{nullptr};
+};
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+PersistentHashMap<Key, Value, Hash, Equal>::PersistentHashMap(const PersistentHashMap& other)
+    : root_(other.root_), size_(other.size_), hash_(other.hash_), equal_(other.equal_) {
+    other.owner_.store(MakeOwner(), std::memory_order_relaxed);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+PersistentHashMap<Key, Value, Hash, Equal>::PersistentHashMap(PersistentHashMap&& other) noexcept
+    : root_(std::move(other.root_)),
+      size_(std::exchange(other.size_, 0)),
+      hash_(other.hash_),
+      equal_(other.equal_),
+      owner_(other.GetOwner()) {
+    other.owner_.store(MakeOwner(), std::memory_order_relaxed);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentHashMap<Key, Value, Hash, Equal>::operator=(const PersistentHashMap& other) -> PersistentHashMap& {
+    if (this == &other) return *this;
+
+    root_ = other.root_;
+    size_ = other.size_;
+    hash_ = other.hash_;
+    equal_ = other.equal_;
+    owner_.store(MakeOwner(), std::memory_order_relaxed);
+    other.owner_.store(MakeOwner(), std::memory_order_relaxed);
+    return *this;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentHashMap<Key, Value, Hash, Equal>::operator=(PersistentHashMap&& other) noexcept -> PersistentHashMap& {
+    if (this == &other) return *this;
+
+    root_ = std::move(other.root_);
+    size_ = std::exchange(other.size_, 0);
+    hash_ = other.hash_;
+    equal_ = other.equal_;
+    owner_.store(other.GetOwner(), std::memory_order_relaxed);
+    other.owner_.store(MakeOwner(), std::memory_order_relaxed);
+    return *this;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentHashMap<Key, Value, Hash, Equal>::begin() const -> const_iterator {
+    const_iterator it;
+    if (root_) {
+        it.Push(root_.get(), 0, 0);
+        it.Advance();
+    }
+    return it;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentHashMap<Key, Value, Hash, Equal>::find(const Key& key) const -> const_iterator {
+    const_iterator it;
+    const Node* node = root_.get();
+    const auto hash = GetHash(key);
+
+    for (std::size_t level = 0; node; ++level) {
+        if (level == kCollisionLevel) {
+            for (std::size_t i = 0; i < node->entries.size(); ++i) {
+                if (equal_(node->entries[i]->value.first, key)) {
+                    it.Push(node, i + 1, 0);
+                    it.current_ = node->entries[i].get();
+                    return it;
+                }
+            }
+            return {};
+        }
+
+        const auto bit = GetBit(hash, level);
+        if (node->entries_map & bit) {
+            const auto index = GetIndex(node->entries_map, bit);
+            const auto& entry = *node->entries[index];
+            if (entry.hash != hash || !equal_(entry.value.first, key)) return {};
+
+            it.Push(node, index + 1, 0);
+            it.current_ = &entry;
+            return it;
+        }
+        if (!(node->children_map & bit)) return {};
+
+        // The entries of the node and the children before this one are visited
+        const auto index = GetIndex(node->children_map, bit);
+        it.Push(node, node->entries.size(), index + 1);
+        node = node->children[index].get();
+    }
+    return {};
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+const Value& PersistentHashMap<Key, Value, Hash, Equal>::at(const Key& key) const {
+    const auto* entry = FindEntry(key);
+    if (!entry) throw std::out_of_range("No such key in PersistentHashMap");
+    return entry->value.second;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentHashMap<Key, Value, Hash, Equal>::FindEntry(const Key& key) const -> const Entry* {
+    const Node* node = root_.get();
+    const auto hash = GetHash(key);
+
+    for (std::size_t level = 0; node; ++level) {
+        if (level == kCollisionLevel) {
+            for (const auto& entry : node->entries) {
+                if (equal_(entry->value.first, key)) return entry.get();
+            }
+            return nullptr;
+        }
+
+        const auto bit = GetBit(hash, level);
+        if (node->entries_map & bit) {
+            const auto* entry = node->entries[GetIndex(node->entries_map, bit)].get();
+            return entry->hash == hash && equal_(entry->value.first, key) ? entry : nullptr;
+        }
+        if (!(node->children_map & bit)) return nullptr;
+        node = node->children[GetIndex(node->children_map, bit)].get();
+    }
+    return nullptr;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+template <typename M>
+bool PersistentHashMap<Key, Value, Hash, Equal>::insert_or_assign(const Key& key, M&& value) {
+    const auto hash = GetHash(key);
+    bool made = false;
+    auto [entry, inserted] = FindOrInsert(hash, key, [&] {
+        made = true;
+        return std::make_shared<Entry>(GetOwner(), hash, key, std::forward<M>(value));
+    });
+    if (!made) {
+        // Shared entries are replaced rather than modified
+        if ((*entry)->owner != GetOwner()) {
+            *entry = std::make_shared<Entry>(GetOwner(), hash, key, std::forward<M>(value));
+        } else {
+            (*entry)->value.second = std::forward<M>(value);
+        }
+    }
+    return inserted;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool PersistentHashMap<Key, Value, Hash, Equal>::insert(value_type value) {
+    const auto hash = GetHash(value.first);
+    return FindOrInsert(hash, value.first, [&] {
+               return std::make_shared<Entry>(GetOwner(), hash, std::move(value));
+           }).second;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+Value& PersistentHashMap<Key, Value, Hash, Equal>::operator[](const Key& key) {
+    const auto hash = GetHash(key);
+    auto [entry, inserted] = FindOrInsert(hash, key, [&] {
+        return std::make_shared<Entry>(
+            GetOwner(), hash, std::piecewise_construct, std::forward_as_tuple(key), std::tuple<>()
+        );
+    });
+    if ((*entry)->owner != GetOwner()) *entry = std::make_shared<Entry>(GetOwner(), hash, (*entry)->value);
+    return (*entry)->value.second;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentHashMap<Key, Value, Hash, Equal>::erase(const Key& key) -> size_type {
+    // Check first to not copy the nodes in vain
+    if (!FindEntry(key)) return 0;
+
+    [[maybe_unused]] const bool erased = Erase(MakeUnique(root_), 0, GetHash(key), key);
+    UASSERT(erased);
+
+    --size_;
+    if (size_ == 0) root_.reset();
+    return 1;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentHashMap<Key, Value, Hash, Equal>::MakeNode() const -> NodePtr {
+    auto node = std::make_shared<Node>();
+    node->owner = GetOwner();
+    return node;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentHashMap<Key, Value, Hash, Equal>::MakeUnique(NodePtr& node) -> Node& {
+    if (node->owner != GetOwner()) {
+        auto copy = std::make_shared<Node>(*node);
+        copy->owner = GetOwner();
+        node = std::move(copy);
+    }
+    return *node;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+template <typename MakeEntry>
+auto PersistentHashMap<Key, Value, Hash, Equal>::FindOrInsert(std::uint64_t hash, const Key& key, MakeEntry make_entry)
+    -> std::pair<EntryPtr*, bool> {
+    if (!root_) root_ = MakeNode();
+
+    Node* node = &MakeUnique(root_);
+    for (std::size_t level = 0;; ++level) {
+        if (level == kCollisionLevel) {
+            for (auto& entry : node->entries) {
+                if (equal_(entry->value.first, key)) return {&entry, false};
+            }
+            node->entries.push_back(make_entry());
+            ++size_;
+            return {&node->entries.back(), true};
+        }
+
+        const auto bit = GetBit(hash, level);
+        if (node->entries_map & bit) {
+            const auto index = GetIndex(node->entries_map, bit);
+            auto& entry = node->entries[index];
+            if (entry->hash == hash && equal_(entry->value.first, key)) return {&entry, false};
+
+            // Both entries move to a new child
+            auto child = MakeSubtree(level + 1, std::move(entry), make_entry());
+            node->entries.erase(node->entries.begin() + index);
+            node->entries_map &= ~bit;
+            node->children.insert(node->children.begin() + GetIndex(node->children_map, bit), std::move(child));
+            node->children_map |= bit;
+            ++size_;
+
+            return {&FindInSubtree(*node, level, hash, key), true};
+        }
+
+        if (node->children_map & bit) {
+            node = &MakeUnique(node->children[GetIndex(node->children_map, bit)]);
+            continue;
+        }
+
+        const auto index = GetIndex(node->entries_map, bit);
+        node->entries.insert(node->entries.begin() + index, make_entry());
+        node->entries_map |= bit;
+        ++size_;
+        return {&node->entries[index], true};
+    }
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentHashMap<Key, Value, Hash, Equal>::FindInSubtree(
+    Node& node,
+    std::size_t level,
+    std::uint64_t hash,
+    const Key& key
+) const -> EntryPtr& {
+    Node* current = &node;
+    for (;; ++level) {
+        if (level == kCollisionLevel) {
+            for (auto& entry : current->entries) {
+                if (equal_(entry->value.first, key)) return entry;
+            }
+            UINVARIANT(false, "Key is missing from the subtree");
+        }
+
+        const auto bit = GetBit(hash, level);
+        if (current->entries_map & bit) return current->entries[GetIndex(current->entries_map, bit)];
+
+        UASSERT(current->children_map & bit);
+        current = current->children[GetIndex(current->children_map, bit)].get();
+    }
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentHashMap<Key, Value, Hash, Equal>::MakeSubtree(std::size_t level, EntryPtr first, EntryPtr second) const
+    -> NodePtr {
+    auto node = MakeNode();
+    if (level == kCollisionLevel) {
+        node->entries.push_back(std::move(first));
+        node->entries.push_back(std::move(second));
+        return node;
+    }
+
+    const auto first_bit = GetBit(first->hash, level);
+    const auto second_bit = GetBit(second->hash, level);
+    if (first_bit == second_bit) {
+        node->children.push_back(MakeSubtree(level + 1, std::move(first), std::move(second)));
+        node->children_map = first_bit;
+        return node;
+    }
+
+    if (second_bit < first_bit) std::swap(first, second);
+    node->entries_map = first_bit | second_bit;
+    node->entries.push_back(std::move(first));
+    node->entries.push_back(std::move(second));
+    return node;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool PersistentHashMap<Key, Value, Hash, Equal>::Erase(Node& node, std::size_t level, std::uint64_t hash, const Key& key) {
+    if (level == kCollisionLevel) {
+        for (auto it = node.entries.begin(); it != node.entries.end(); ++it) {
+            if (equal_((*it)->value.first, key)) {
+                node.entries.erase(it);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const auto bit = GetBit(hash, level);
+    if (node.entries_map & bit) {
+        const auto index = GetIndex(node.entries_map, bit);
+        const auto& entry = *node.entries[index];
+        if (entry.hash != hash || !equal_(entry.value.first, key)) return false;
+
+        node.entries.erase(node.entries.begin() + index);
+        node.entries_map &= ~bit;
+        return true;
+    }
+    if (!(node.children_map & bit)) return false;
+
+    const auto child_index = GetIndex(node.children_map, bit);
+    auto& child_ptr = node.children[child_index];
+    if (!Erase(MakeUnique(child_ptr), level + 1, hash, key)) return false;
+
+    // Keep the trie compact: a child with a single entry is inlined
+    const auto& child = *child_ptr;
+    if (child.children.empty() && child.entries.size() <= 1) {
+        auto entry = child.entries.empty() ? nullptr : child.entries.front();
+        node.children.erase(node.children.begin() + child_index);
+        node.children_map &= ~bit;
+        if (entry) {
+            node.entries.insert(node.entries.begin() + GetIndex(node.entries_map, bit), std::move(entry));
+            node.entries_map |= bit;
+        }
+    }
+    return true;
+}
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
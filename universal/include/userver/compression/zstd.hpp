@@ -1,5 +1,6 @@
 #pragma once
 
+#include <string>
 #include <string_view>
 
 #include <userver/compression/error.hpp>
@@ -8,6 +9,15 @@ USERVER_NAMESPACE_BEGIN
 
 namespace compression::zstd {
 
+/// Default zstd compression level, favors speed over the compression ratio
+inline constexpr int kDefaultCompressionLevel = 1;
+
+/// Compresses the string into a single zstd frame. The frame stores
+/// the decompressed size and the checksum of the content, the checksum
+/// is verified by `Decompress`.
+/// @throws CompressionError
+std::string Compress(std::string_view uncompressed, int compression_level = kDefaultCompressionLevel);
+
 /// Decompresses the string.
 /// @throws DecompressionError
 std::string Decompress(std::string_view compressed, size_t max_size);
@@ -10,7 +10,10 @@ USERVER_NAMESPACE_BEGIN
 namespace logging {
 
 /// Log formats
-enum class Format { kTskv, kLtsv, kRaw };
+///
+/// kBinary is a compact unescaped format, see logging::impl::binary for the
+/// layout and the `tools/log_decoder` tool for the conversion into TSKV or JSON.
+enum class Format { kTskv, kLtsv, kRaw, kBinary };
 
 /// Parse Format enum from string
 Format FormatFromString(std::string_view format_str);
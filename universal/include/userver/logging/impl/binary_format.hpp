@@ -0,0 +1,110 @@
+#pragma once
+
+/// @file userver/logging/impl/binary_format.hpp
+/// @brief Encoding details and a decoder of the logging::Format::kBinary logs
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <userver/logging/level.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+/// Binary log format
+///
+/// A log is a sequence of records, each record is
+/// `[kRecordMarker][body size: 4 bytes little-endian][body]`. Newlines between
+/// the records are ignored, so the sinks may separate the records with them.
+///
+/// The body is `[timestamp: varint microseconds since epoch][level: 1 byte]`
+/// followed by the tags. Each tag is a key and a value:
+/// - the key is `varint(id * 2 + 1)` for the keys from the interned keys
+///   table, or `varint(size * 2)` followed by the key bytes for the others;
+/// - the value is `varint(size)` followed by the raw value bytes, the values
+///   are not escaped.
+///
+/// The interned keys table only grows, the new keys are appended to the end,
+/// and the record marker is changed on incompatible changes.
+namespace logging::impl::binary {
+
+inline constexpr char kRecordMarker = '\xB1';
+inline constexpr std::size_t kRecordSizeBytes = 4;
+inline constexpr std::size_t kMaxVarintBytes = 10;
+
+/// Thrown on malformed binary logs
+class DecodeError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/// @returns the id of the interned key, if any
+std::optional<std::size_t> FindInternedKey(std::string_view key) noexcept;
+
+/// @returns the interned key by its id
+/// @throws DecodeError if there is no such key
+std::string_view GetInternedKey(std::size_t id);
+
+/// Writes `value` as a varint to `destination`, which must have at least
+/// kMaxVarintBytes bytes
+/// @returns the number of the written bytes
+std::size_t WriteVarint(char* destination, std::uint64_t value) noexcept;
+
+/// @returns the number of bytes in the varint representation of `value`
+std::size_t GetVarintSize(std::uint64_t value) noexcept;
+
+struct Tag final {
+    std::string_view key;
+    std::string_view value;
+};
+
+/// A decoded record, refers to the data passed to RecordReader
+struct Record final {
+    std::chrono::system_clock::time_point timestamp;
+    Level level{Level::kNone};
+    std::vector<Tag> tags;
+};
+
+/// Decodes the records one by one from the data that may end with an
+/// incomplete record
+class RecordReader final {
+public:
+    explicit RecordReader(std::string_view data) noexcept;
+
+    /// @returns the next record or `std::nullopt` if there is no complete
+    /// record left
+    /// @throws DecodeError on malformed data
+    std::optional<Record> Next();
+
+    /// @returns the size of the data consumed by the returned records
+    std::size_t GetConsumedSize() const noexcept;
+
+private:
+    std::string_view data_;
+    std::size_t position_{0};
+};
+
+/// Appends the record as a TSKV line to `out`
+void AppendTskv(const Record& record, std::string& out);
+
+/// Appends the record as a JSON object line to `out`
+void AppendJson(const Record& record, std::string& out);
+
+/// Appends the record in the binary format to `out`
+void AppendBinary(const Record& record, std::string& out);
+
+/// Converts a record of the logging::Format::kTskv format to the binary
+/// format, e.g. for the records that were logged before the binary logger was
+/// set up
+/// @returns the binary record or `std::nullopt` if `tskv` is not a complete
+/// TSKV record
+std::optional<std::string> ConvertTskvRecord(std::string_view tskv, Level level);
+
+}  // namespace logging::impl::binary
+
+USERVER_NAMESPACE_END
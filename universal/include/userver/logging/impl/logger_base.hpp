@@ -1,6 +1,8 @@
 #pragma once
 
 #include <atomic>
+#include <cstddef>
+#include <string_view>
 
 #include <userver/logging/format.hpp>
 #include <userver/logging/level.hpp>
@@ -38,6 +40,22 @@ public:
     Level GetLevel() const noexcept;
     bool ShouldLog(Level level) const noexcept;
 
+    /// Same as ShouldLog(), but is checked by the LOG_* macros only, so the
+    /// logger may account the rejected records
+    bool ShouldLogRecord(Level level) const noexcept;
+
+    /// Whether the record, that is below the logger level, should be kept in
+    /// the request log buffer of the current task. Checked by the LOG_* macros
+    /// only, ShouldLog() is not affected by the buffering.
+    bool ShouldBuffer(Level level) const noexcept;
+
+    /// Keeps the record in the request log buffer of the current task, to log
+    /// it later if the request fails
+    virtual void Buffer(Level level, std::string_view msg);
+
+    /// Accounts a record dropped by a LOG_LIMITED_* call site
+    virtual void AccountLogLimitedDrop() noexcept;
+
     void SetFlushOn(Level level);
     bool ShouldFlush(Level level) const;
 
@@ -45,6 +63,8 @@ public:
 
 protected:
     virtual bool DoShouldLog(Level level) const noexcept;
+    virtual bool DoShouldLogRecord(Level level) const noexcept;
+    virtual bool DoShouldBuffer(Level level) const noexcept;
 
 private:
     const Format format_;
@@ -54,6 +74,10 @@ private:
 
 bool ShouldLogNoSpan(const LoggerBase& logger, Level level) noexcept;
 
+// The count of the existing request log buffers. Allows to skip looking up
+// the buffer of the current task for the disabled records in the common case.
+extern std::atomic<std::size_t> alive_request_log_buffers;
+
 }  // namespace logging::impl
 
 USERVER_NAMESPACE_END
@@ -6,6 +6,7 @@
 #include <string>
 #include <vector>
 
+#include <userver/logging/impl/binary_format.hpp>
 #include <userver/logging/impl/logger_base.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -41,7 +42,7 @@ public:
     void Log(Level level, std::string_view msg) override {
         std::unique_lock lock(mutex_);
         if (forward_logger_) {
-            forward_logger_->Log(level, msg);
+            Forward(*forward_logger_, level, msg);
             return;
         }
 
@@ -55,7 +56,7 @@ public:
         std::unique_lock lock(mutex_);
         if (logger_to) {
             for (const auto& log : data_) {
-                logger_to->Log(log.level, log.msg);
+                Forward(*logger_to, log.level, log.msg);
             }
             data_.clear();
         }
@@ -66,6 +67,17 @@ protected:
     bool DoShouldLog(Level) const noexcept override { return true; }
 
 private:
+    // The records are formatted as TSKV, the binary logs must not mix them in
+    static void Forward(LoggerBase& logger_to, Level level, std::string_view msg) {
+        if (logger_to.GetFormat() != Format::kBinary) {
+            logger_to.Log(level, msg);
+            return;
+        }
+        if (auto record = binary::ConvertTskvRecord(msg, level)) {
+            logger_to.Log(level, *record);
+        }
+    }
+
     std::mutex mutex_;
     std::vector<Data> data_;
     LoggerBase* forward_logger_{nullptr};
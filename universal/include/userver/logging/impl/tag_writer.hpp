@@ -59,7 +59,7 @@ private:
     void PutKey(TagKey key);
     void PutKey(RuntimeTagKey key);
 
-    void MarkValueEnd() noexcept;
+    void MarkValueEnd();
 
     LogHelper& lh_;
 };
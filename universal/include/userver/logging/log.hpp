@@ -3,6 +3,7 @@
 /// @file userver/logging/log.hpp
 /// @brief Logging helpers
 
+#include <atomic>
 #include <chrono>
 
 #include <userver/compiler/select.hpp>
@@ -10,6 +11,7 @@
 #include <userver/logging/level.hpp>
 #include <userver/logging/log_filepath.hpp>
 #include <userver/logging/log_helper.hpp>
+#include <userver/utils/impl/source_location.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -99,24 +101,56 @@ void LogFlush(LoggerRef logger);
 
 namespace impl {
 
-// Not thread-safe, static lifetime data
+// Thread-safe, static lifetime data of a LOG_LIMITED call site. The counters
+// are shared by all the threads, so that a surge of identical records from
+// many threads is limited as a whole.
 class RateLimitData {
 public:
-    uint64_t count_since_reset = 0;
-    uint64_t dropped_count = 0;
-    std::chrono::steady_clock::time_point last_reset_time{};
+    std::atomic<uint64_t> count_since_reset{0};
+    std::atomic<uint64_t> dropped_count{0};
+    // steady_clock::time_point::time_since_epoch()
+    std::atomic<std::chrono::steady_clock::duration> last_reset_time{std::chrono::steady_clock::duration::zero()};
+
+    // Used to log the summary of the records dropped in an interval, see
+    // LogLimitedSummaries()
+    std::atomic<Level> level{Level::kNone};
+    std::atomic<bool> is_registered{false};
+    utils::impl::SourceLocation location{utils::impl::SourceLocation::Custom(0, {}, {})};
+    RateLimitData* next{nullptr};
 };
 
 // Represents a single rate limit usage
 class RateLimiter {
 public:
-    RateLimiter(RateLimitData& data, Level level) noexcept;
+    // Records that are disabled by the logger level do not affect the limit
+    RateLimiter(
+        RateLimitData& data,
+        LoggerRef logger,
+        bool is_enabled,
+        Level level,
+        const utils::impl::SourceLocation& location = utils::impl::SourceLocation::Current()
+    ) noexcept;
+    RateLimiter(
+        RateLimitData& data,
+        const LoggerPtr& logger,
+        bool is_enabled,
+        Level level,
+        const utils::impl::SourceLocation& location = utils::impl::SourceLocation::Current()
+    ) noexcept;
     bool ShouldLog() const { return should_log_; }
     void SetShouldNotLog() { should_log_ = false; }
     Level GetLevel() const { return level_; }
     friend LogHelper& operator<<(LogHelper& lh, const RateLimiter& rl) noexcept;
 
 private:
+    RateLimiter(
+        RateLimitData& data,
+        LoggerBase* logger,
+        bool is_enabled,
+        Level level,
+        const utils::impl::SourceLocation& location
+    ) noexcept;
+
     const Level level_;
     bool should_log_{true};
     uint64_t dropped_count_{0};
@@ -319,18 +353,21 @@ struct EntryStorage final {
 /// @hideinitializer
 // Note: we have to jump through the hoops to keep lazy evaluation of the logged
 // data AND log the dropped logs count from the correct LogHelper in the face of
-// multithreading and coroutines.
-// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
-#define LOG_LIMITED_TO(logger, lvl)                                                    \
-    for (USERVER_NAMESPACE::logging::impl::RateLimiter log_limited_to_rl{              \
-             []() -> USERVER_NAMESPACE::logging::impl::RateLimitData& {                \
-                 thread_local USERVER_NAMESPACE::logging::impl::RateLimitData rl_data; \
-                 return rl_data;                                                       \
-             }(),                                                                      \
-             (lvl)};                                                                   \
-         log_limited_to_rl.ShouldLog();                                                \
-         log_limited_to_rl.SetShouldNotLog())                                          \
-    LOG_TO((logger), log_limited_to_rl.GetLevel()) << log_limited_to_rl
+// multithreading and coroutines. The level is checked before the rate limit,
+// so that the disabled records do not touch the shared counters.
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define LOG_LIMITED_TO(logger, lvl)                                              \
+    for (USERVER_NAMESPACE::logging::impl::RateLimiter log_limited_to_rl{        \
+             []() -> USERVER_NAMESPACE::logging::impl::RateLimitData& {          \
+                 static USERVER_NAMESPACE::logging::impl::RateLimitData rl_data; \
+                 return rl_data;                                                 \
+             }(),                                                                \
+             (logger),                                                           \
+             !USERVER_IMPL_DYNAMIC_DEBUG_ENTRY().ShouldNotLog((logger), (lvl)),  \
+             (lvl)};                                                             \
+         log_limited_to_rl.ShouldLog();                                          \
+         log_limited_to_rl.SetShouldNotLog())                                    \
+    USERVER_IMPL_LOG_TO((logger), log_limited_to_rl.GetLevel()) << log_limited_to_rl
 
 /// @brief If lvl matches the verbosity then builds a stream and evaluates a
 /// message for the default logger. Ignores log messages that occur too often.
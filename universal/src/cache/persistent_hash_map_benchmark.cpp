@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/cache/persistent_hash_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// Models an incremental cache update: the previous snapshot is copied and
+// a small fraction of the elements is changed
+template <typename Map>
+void IncrementalUpdate(benchmark::State& state) {
+    const auto size = static_cast<std::uint64_t>(state.range(0));
+    const auto changes = static_cast<std::uint64_t>(state.range(1));
+
+    Map map;
+    for (std::uint64_t i = 0; i < size; ++i) map.insert_or_assign(i, std::to_string(i));
+
+    std::uint64_t key = 0;
+    for ([[maybe_unused]] auto _ : state) {
+        auto copy = map;
+        for (std::uint64_t i = 0; i < changes; ++i) {
+            key = (key + 7919) % size;
+            copy.insert_or_assign(key, std::to_string(i));
+        }
+        map = std::move(copy);
+        benchmark::DoNotOptimize(map);
+    }
+}
+
+template <typename Map>
+void Find(benchmark::State& state) {
+    const auto size = static_cast<std::uint64_t>(state.range(0));
+
+    std::vector<std::uint64_t> keys(size);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937{42});
+
+    Map map;
+    for (const auto key : keys) map.insert_or_assign(key, std::to_string(key));
+    std::shuffle(keys.begin(), keys.end(), std::mt19937{4242});
+
+    std::size_t i = 0;
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(map.count(keys[i]));
+        if (++i == keys.size()) i = 0;
+    }
+}
+
+using UnorderedMap = std::unordered_map<std::uint64_t, std::string>;
+using PersistentHashMap = cache::PersistentHashMap<std::uint64_t, std::string>;
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(IncrementalUpdate, UnorderedMap)->Args({100'000, 100})->Args({1'000'000, 100});
+BENCHMARK_TEMPLATE(IncrementalUpdate, PersistentHashMap)->Args({100'000, 100})->Args({1'000'000, 100});
+
+BENCHMARK_TEMPLATE(Find, UnorderedMap)->Arg(1000)->Arg(100'000)->Arg(1'000'000);
+BENCHMARK_TEMPLATE(Find, PersistentHashMap)->Arg(1000)->Arg(100'000)->Arg(1'000'000);
+
+USERVER_NAMESPACE_END
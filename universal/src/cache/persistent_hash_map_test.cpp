@@ -0,0 +1,194 @@
+#include <userver/cache/persistent_hash_map.hpp>
+
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// Makes all the keys collide in the first levels of the trie
+struct BadHash {
+    std::size_t operator()(int value) const noexcept { return value % 4; }
+};
+
+template <typename Map, typename Reference>
+void ExpectSame(const Map& map, const Reference& reference) {
+    EXPECT_EQ(map.size(), reference.size());
+    for (const auto& [key, value] : reference) {
+        const auto it = map.find(key);
+        ASSERT_NE(it, map.end()) << key;
+        EXPECT_EQ(it->second, value);
+    }
+
+    std::size_t visited = 0;
+    for (const auto& [key, value] : map) {
+        ++visited;
+        const auto it = reference.find(key);
+        ASSERT_NE(it, reference.end()) << key;
+        EXPECT_EQ(it->second, value);
+    }
+    EXPECT_EQ(visited, reference.size());
+}
+
+}  // namespace
+
+TEST(PersistentHashMap, Sample) {
+    cache::PersistentHashMap<std::string, int> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.begin(), map.end());
+
+    EXPECT_TRUE(map.insert_or_assign("a", 1));
+    EXPECT_TRUE(map.insert({"b", 2}));
+    EXPECT_FALSE(map.insert({"b", 3}));
+    EXPECT_FALSE(map.insert_or_assign("a", 10));
+    map["c"] = 3;
+
+    EXPECT_EQ(map.size(), 3);
+    EXPECT_EQ(map.at("a"), 10);
+    EXPECT_EQ(map.at("b"), 2);
+    EXPECT_EQ(map.at("c"), 3);
+    EXPECT_EQ(map.count("d"), 0);
+    EXPECT_THROW(map.at("d"), std::out_of_range);
+
+    EXPECT_EQ(map.erase("a"), 1);
+    EXPECT_EQ(map.erase("a"), 0);
+    EXPECT_EQ(map.size(), 2);
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.find("b"), map.end());
+}
+
+TEST(PersistentHashMap, CopiesAreIndependent) {
+    cache::PersistentHashMap<int, int> map;
+    for (int i = 0; i < 1000; ++i) map.insert_or_assign(i, i);
+
+    auto copy = map;
+    copy.insert_or_assign(1, 100);
+    copy[2] = 200;
+    copy.erase(3);
+    copy.insert_or_assign(1000, 1000);
+
+    EXPECT_EQ(map.size(), 1000);
+    EXPECT_EQ(map.at(1), 1);
+    EXPECT_EQ(map.at(2), 2);
+    EXPECT_EQ(map.at(3), 3);
+    EXPECT_EQ(map.count(1000), 0);
+
+    EXPECT_EQ(copy.size(), 1000);
+    EXPECT_EQ(copy.at(1), 100);
+    EXPECT_EQ(copy.at(2), 200);
+    EXPECT_EQ(copy.count(3), 0);
+    EXPECT_EQ(copy.at(1000), 1000);
+}
+
+TEST(PersistentHashMap, OriginalIsModifiedAfterCopy) {
+    cache::PersistentHashMap<int, int> map;
+    for (int i = 0; i < 1000; ++i) map.insert_or_assign(i, i);
+
+    const auto copy = map;
+    map.insert_or_assign(1, 100);
+    map[2] = 200;
+    map.erase(3);
+
+    EXPECT_EQ(copy.at(1), 1);
+    EXPECT_EQ(copy.at(2), 2);
+    EXPECT_EQ(copy.at(3), 3);
+
+    // moved maps keep their nodes, the snapshot stays intact
+    auto moved = std::move(map);
+    moved.insert_or_assign(4, 400);
+    EXPECT_EQ(copy.at(4), 4);
+    EXPECT_EQ(moved.at(1), 100);
+}
+
+TEST(PersistentHashMap, ConcurrentCopies) {
+    constexpr int kSize = 10000;
+    constexpr int kThreads = 4;
+
+    cache::PersistentHashMap<int, int> snapshot;
+    for (int i = 0; i < kSize; ++i) snapshot.insert_or_assign(i, i);
+
+    // Like the incremental updates of the caches: each thread makes a new
+    // snapshot from the shared one while the others read and copy it
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < kThreads; ++thread) {
+        threads.emplace_back([&snapshot, thread] {
+            for (int iteration = 0; iteration < 100; ++iteration) {
+                auto copy = snapshot;
+                for (int i = thread; i < kSize; i += 97) copy.insert_or_assign(i, -i);
+                copy.erase(thread);
+                EXPECT_EQ(copy.size(), kSize - 1);
+                EXPECT_EQ(snapshot.at(thread + 97), thread + 97);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    std::unordered_map<int, int> reference;
+    for (int i = 0; i < kSize; ++i) reference[i] = i;
+    ExpectSame(snapshot, reference);
+}
+
+TEST(PersistentHashMap, Collisions) {
+    cache::PersistentHashMap<int, int, BadHash> map;
+    std::map<int, int> reference;
+    for (int i = 0; i < 100; ++i) {
+        map.insert_or_assign(i, i);
+        reference[i] = i;
+    }
+    ExpectSame(map, reference);
+
+    const auto copy = map;
+    for (int i = 0; i < 100; i += 3) {
+        EXPECT_EQ(map.erase(i), 1);
+        reference.erase(i);
+    }
+    ExpectSame(map, reference);
+    EXPECT_EQ(copy.size(), 100);
+}
+
+TEST(PersistentHashMap, Random) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> key_dist(0, 2000);
+    std::uniform_int_distribution<int> op_dist(0, 3);
+
+    cache::PersistentHashMap<int, int> map;
+    std::unordered_map<int, int> reference;
+
+    // Each round modifies a copy of the previous version like an incremental
+    // cache update, the previous version must stay intact
+    for (int round = 0; round < 20; ++round) {
+        const auto previous = map;
+        const auto previous_reference = reference;
+
+        for (int i = 0; i < 500; ++i) {
+            const auto key = key_dist(gen);
+            switch (op_dist(gen)) {
+                case 0:
+                    EXPECT_EQ(map.erase(key), reference.erase(key));
+                    break;
+                case 1:
+                    map[key] += i;
+                    reference[key] += i;
+                    break;
+                default:
+                    map.insert_or_assign(key, i);
+                    reference.insert_or_assign(key, i);
+                    break;
+            }
+        }
+
+        ExpectSame(map, reference);
+        ExpectSame(previous, previous_reference);
+    }
+}
+
+USERVER_NAMESPACE_END
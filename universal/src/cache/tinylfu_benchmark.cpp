@@ -0,0 +1,109 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <userver/cache/impl/lru.hpp>
+#include <userver/cache/impl/slru.hpp>
+#include <userver/cache/impl/tinylfu.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr unsigned kKeysCount = 100'000;
+constexpr unsigned kTraceLength = 1'000'000;
+constexpr unsigned kScanLength = 20'000;
+
+using Lru = cache::impl::LruBase<unsigned, unsigned>;
+using Slru = cache::impl::SlruBase<unsigned, unsigned>;
+using WTinyLfu = cache::impl::WTinyLfuBase<unsigned, unsigned>;
+
+template <typename Cache>
+Cache MakeCache(unsigned size);
+
+template <>
+Lru MakeCache<Lru>(unsigned size) {
+    return Lru(size, {}, {});
+}
+
+template <>
+Slru MakeCache<Slru>(unsigned size) {
+    // Same proportions as in WTinyLfuBase
+    return Slru(size / 5, size - size / 5);
+}
+
+template <>
+WTinyLfu MakeCache<WTinyLfu>(unsigned size) {
+    return WTinyLfu(size);
+}
+
+// Popularity of the keys follows the Zipf distribution with s = 0.9, a common
+// model for the web and database traces
+std::vector<unsigned> MakeZipfTrace() {
+    std::vector<double> cdf(kKeysCount);
+    double sum = 0;
+    for (unsigned i = 0; i < kKeysCount; ++i) {
+        sum += 1.0 / std::pow(i + 1, 0.9);
+        cdf[i] = sum;
+    }
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(0, sum);
+    std::vector<unsigned> trace(kTraceLength);
+    for (auto& key : trace) {
+        key = std::upper_bound(cdf.begin(), cdf.end(), dist(gen)) - cdf.begin();
+    }
+    return trace;
+}
+
+// Zipf trace interrupted by batch jobs that iterate over never repeated keys
+std::vector<unsigned> MakeZipfWithScansTrace() {
+    auto trace = MakeZipfTrace();
+    unsigned scan_key = kKeysCount;
+    for (std::size_t i = 0; i + kScanLength < trace.size(); i += 5 * kScanLength) {
+        for (std::size_t j = i; j < i + kScanLength; ++j) trace[j] = scan_key++;
+    }
+    return trace;
+}
+
+const std::vector<unsigned>& GetTrace(bool with_scans) {
+    static const auto kZipfTrace = MakeZipfTrace();
+    static const auto kZipfWithScansTrace = MakeZipfWithScansTrace();
+    return with_scans ? kZipfWithScansTrace : kZipfTrace;
+}
+
+}  // namespace
+
+// Arguments are the cache size and whether the trace has scans, the hit_rate
+// counter shows the efficiency of the policy
+template <typename Cache>
+void CacheHitRate(benchmark::State& state) {
+    const auto& trace = GetTrace(state.range(1) != 0);
+    std::size_t hits = 0;
+    std::size_t lookups = 0;
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto cache = MakeCache<Cache>(state.range(0));
+        for (const auto key : trace) {
+            if (cache.Get(key)) {
+                ++hits;
+            } else {
+                cache.Put(key, key);
+            }
+        }
+        lookups += trace.size();
+        benchmark::DoNotOptimize(cache);
+    }
+
+    state.counters["hit_rate"] = static_cast<double>(hits) / lookups;
+    state.SetItemsProcessed(lookups);
+}
+
+BENCHMARK_TEMPLATE(CacheHitRate, Lru)->ArgsProduct({{1000, 10000}, {0, 1}})->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(CacheHitRate, Slru)->ArgsProduct({{1000, 10000}, {0, 1}})->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(CacheHitRate, WTinyLfu)->ArgsProduct({{1000, 10000}, {0, 1}})->Unit(benchmark::kMillisecond);
+
+USERVER_NAMESPACE_END
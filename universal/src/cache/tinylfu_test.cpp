@@ -0,0 +1,106 @@
+#include <userver/cache/impl/tinylfu.hpp>
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(FrequencySketch, Sample) {
+    cache::impl::FrequencySketch<std::size_t> sketch(100);
+
+    for (std::size_t i = 0; i < 5; ++i) sketch.Increment(42);
+    sketch.Increment(1);
+
+    EXPECT_EQ(sketch.GetFrequency(42), 5);
+    EXPECT_EQ(sketch.GetFrequency(1), 1);
+    EXPECT_EQ(sketch.GetFrequency(2), 0);
+
+    sketch.Clear();
+    EXPECT_EQ(sketch.GetFrequency(42), 0);
+}
+
+TEST(FrequencySketch, Saturation) {
+    cache::impl::FrequencySketch<std::size_t> sketch(100);
+
+    for (std::size_t i = 0; i < 100; ++i) sketch.Increment(42);
+    EXPECT_EQ(sketch.GetFrequency(42), 15);
+}
+
+TEST(FrequencySketch, Aging) {
+    constexpr std::size_t kCapacity = 16;
+    cache::impl::FrequencySketch<std::size_t> sketch(kCapacity);
+
+    for (std::size_t i = 0; i < 8; ++i) sketch.Increment(42);
+    EXPECT_EQ(sketch.GetFrequency(42), 8);
+
+    // Other keys trigger the aging after 10 * kCapacity increments
+    for (std::size_t i = 0; i < 10 * kCapacity; ++i) sketch.Increment(1000 + i);
+    EXPECT_LE(sketch.GetFrequency(42), 4);
+}
+
+TEST(WTinyLfuBase, Sample) {
+    cache::impl::WTinyLfuBase<std::string, std::size_t> cache(100);
+
+    cache.Put("a", 1);
+    cache.Put("b", 2);
+    EXPECT_EQ(*cache.Get("a"), 1);
+    EXPECT_EQ(*cache.Get("b"), 2);
+    EXPECT_EQ(cache.Get("c"), nullptr);
+
+    EXPECT_FALSE(cache.Put("a", 10));
+    EXPECT_EQ(*cache.Get("a"), 10);
+
+    cache.Erase("a");
+    EXPECT_EQ(cache.Get("a"), nullptr);
+    EXPECT_EQ(cache.GetSize(), 1);
+
+    cache.Clear();
+    EXPECT_EQ(cache.GetSize(), 0);
+}
+
+TEST(WTinyLfuBase, SizeLimit) {
+    constexpr std::size_t kMaxSize = 200;
+    cache::impl::WTinyLfuBase<std::size_t, std::size_t> cache(kMaxSize);
+
+    for (std::size_t i = 0; i < 10 * kMaxSize; ++i) {
+        cache.Put(i, i);
+        ASSERT_LE(cache.GetSize(), kMaxSize);
+    }
+    EXPECT_EQ(cache.GetCapacity(), kMaxSize);
+
+    std::size_t visited = 0;
+    cache.VisitAll([&visited](std::size_t key, std::size_t value) {
+        EXPECT_EQ(key, value);
+        ++visited;
+    });
+    EXPECT_EQ(visited, cache.GetSize());
+
+    cache.SetMaxSize(kMaxSize / 2);
+    EXPECT_LE(cache.GetSize(), kMaxSize / 2);
+}
+
+TEST(WTinyLfuBase, ScanResistance) {
+    constexpr std::size_t kMaxSize = 100;
+    constexpr std::size_t kHotKeys = 50;
+    cache::impl::WTinyLfuBase<std::size_t, std::size_t> cache(kMaxSize);
+
+    for (std::size_t i = 0; i < 10; ++i) {
+        for (std::size_t key = 0; key < kHotKeys; ++key) {
+            if (!cache.Get(key)) cache.Put(key, key);
+        }
+    }
+
+    // Keys that are accessed once do not flush the frequently used ones
+    for (std::size_t key = 1000; key < 1000 + 3 * kMaxSize; ++key) {
+        if (!cache.Get(key)) cache.Put(key, key);
+    }
+
+    std::size_t hits = 0;
+    for (std::size_t key = 0; key < kHotKeys; ++key) {
+        if (cache.Get(key)) ++hits;
+    }
+    EXPECT_EQ(hits, kHotKeys);
+}
+
+USERVER_NAMESPACE_END
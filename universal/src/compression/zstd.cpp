@@ -2,9 +2,12 @@
 
 #include <memory>
 
+#include <fmt/format.h>
 #include <zstd.h>
 #include <zstd_errors.h>
 
+#include <userver/compiler/thread_local.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace compression::zstd {
@@ -12,8 +15,44 @@ namespace compression::zstd {
 namespace {
 // The same size as in ZSTD_DStreamOutSize();
 const size_t kDecompressBufferSize = ZSTD_DStreamOutSize();
+
+struct CompressionContextDeleter {
+    void operator()(ZSTD_CCtx* context) const noexcept { ZSTD_freeCCtx(context); }
+};
+using CompressionContext = std::unique_ptr<ZSTD_CCtx, CompressionContextDeleter>;
+
+// Creation of a context allocates its buffers, reuse them between the calls
+compiler::ThreadLocal local_compression_context = [] { return CompressionContext{}; };
+
+void CheckCompressionResult(size_t ret) {
+    if (ZSTD_isError(ret)) {
+        throw CompressionError(fmt::format("Compression failed: {}", ZSTD_getErrorName(ret)));
+    }
+}
+
 }  // namespace
 
+std::string Compress(std::string_view uncompressed, int compression_level) {
+    auto context = local_compression_context.Use();
+    if (!*context) {
+        context->reset(ZSTD_createCCtx());
+        if (!*context) throw CompressionError("Couldn't create ZSTD compression context");
+    }
+
+    auto* cctx = context->get();
+    CheckCompressionResult(ZSTD_CCtx_reset(cctx, ZSTD_reset_session_and_parameters));
+    CheckCompressionResult(ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, compression_level));
+    CheckCompressionResult(ZSTD_CCtx_setParameter(cctx, ZSTD_c_checksumFlag, 1));
+
+    std::string compressed(ZSTD_compressBound(uncompressed.size()), '\0');
+    const auto compressed_size =
+        ZSTD_compress2(cctx, compressed.data(), compressed.size(), uncompressed.data(), uncompressed.size());
+    CheckCompressionResult(compressed_size);
+
+    compressed.resize(compressed_size);
+    return compressed;
+}
+
 std::string DecompressStream(std::string_view compressed, size_t max_size) {
     std::string decompressed;
     std::string buf(kDecompressBufferSize, '\0');
@@ -44,4 +44,13 @@ static void ZstdDecompress(benchmark::State& state) {
 }
 BENCHMARK(ZstdDecompress)->RangeMultiplier(2)->Range(1 << 10, 1 << 15);
 
+static void ZstdCompress(benchmark::State& state) {
+    const auto data = GenerateRandomData(state.range(0));
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(compression::zstd::Compress(data));
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(ZstdCompress)->RangeMultiplier(4)->Range(1 << 10, 1 << 22);
+
 USERVER_NAMESPACE_END
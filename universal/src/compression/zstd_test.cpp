@@ -60,4 +60,28 @@ TEST(Zstd, TestOverflow) {
     );
 }
 
+TEST(Zstd, CompressDecompress) {
+    for (const std::string str : {std::string{}, std::string{"abcdefgh"}, std::string(100'000, 'a')}) {
+        const auto compressed = compression::zstd::Compress(str);
+        EXPECT_EQ(ZSTD_getFrameContentSize(compressed.data(), compressed.size()), str.size());
+        EXPECT_EQ(compression::zstd::Decompress(compressed, str.size()), str);
+    }
+}
+
+TEST(Zstd, CompressLevels) {
+    const std::string str(100'000, 'a');
+    for (const int level : {ZSTD_minCLevel(), 1, 3, ZSTD_maxCLevel()}) {
+        EXPECT_EQ(compression::zstd::Decompress(compression::zstd::Compress(str, level), str.size()), str);
+    }
+}
+
+TEST(Zstd, CompressChecksum) {
+    const std::string str("This is a \"Very long\" msg! This is a \"Very long\" msg!");
+    auto compressed = compression::zstd::Compress(str);
+
+    // The checksum is stored in the last 4 bytes of the frame
+    compressed.back() ^= 1;
+    EXPECT_THROW(compression::zstd::Decompress(compressed, str.size()), compression::DecompressionError);
+}
+
 USERVER_NAMESPACE_END
@@ -0,0 +1,283 @@
+#include <userver/logging/impl/binary_format.hpp>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <ctime>
+#include <utility>
+
+#include <fmt/chrono.h>
+#include <fmt/compile.h>
+#include <fmt/format.h>
+
+#include <userver/formats/json/string_builder.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/encoding/tskv.hpp>
+#include <userver/utils/encoding/tskv_parser_read.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl::binary {
+
+namespace {
+
+// Append-only, the ids are stored in the logs
+constexpr std::array<std::string_view, 18> kInternedKeys{
+    "text",
+    "module",
+    "task_id",
+    "thread_id",
+    "trace_id",
+    "span_id",
+    "parent_id",
+    "link",
+    "parent_link",
+    "stopwatch_name",
+    "total_time",
+    "stopwatch_units",
+    "start_timestamp",
+    "span_ref_type",
+    "span_kind",
+    "meta_type",
+    "type",
+    "uri",
+};
+
+class BodyReader final {
+public:
+    explicit BodyReader(std::string_view body) noexcept : body_(body) {}
+
+    bool IsEmpty() const noexcept { return body_.empty(); }
+
+    std::uint64_t ReadVarint() {
+        std::uint64_t result = 0;
+        for (std::size_t i = 0; i < kMaxVarintBytes; ++i) {
+            const auto byte = static_cast<unsigned char>(ReadBytes(1)[0]);
+            result |= std::uint64_t{byte & 0x7Fu} << (7 * i);
+            if ((byte & 0x80u) == 0) return result;
+        }
+        throw DecodeError("Malformed varint in a binary log record");
+    }
+
+    std::string_view ReadBytes(std::uint64_t size) {
+        if (size > body_.size()) {
+            throw DecodeError(fmt::format(
+                "Unexpected end of a binary log record, {} bytes expected, {} bytes left", size, body_.size()
+            ));
+        }
+        const auto result = body_.substr(0, size);
+        body_.remove_prefix(size);
+        return result;
+    }
+
+private:
+    std::string_view body_;
+};
+
+Record DecodeBody(std::string_view body) {
+    BodyReader reader{body};
+    Record record;
+
+    record.timestamp = std::chrono::system_clock::time_point{std::chrono::duration_cast<
+        std::chrono::system_clock::duration>(std::chrono::microseconds{reader.ReadVarint()})};
+
+    const auto level = static_cast<unsigned char>(reader.ReadBytes(1)[0]);
+    if (level > static_cast<unsigned char>(Level::kNone)) {
+        throw DecodeError(fmt::format("Invalid log level {} in a binary log record", level));
+    }
+    record.level = static_cast<Level>(level);
+
+    while (!reader.IsEmpty()) {
+        Tag tag;
+        const auto key_header = reader.ReadVarint();
+        if (key_header % 2 == 1) {
+            tag.key = GetInternedKey(key_header / 2);
+        } else {
+            tag.key = reader.ReadBytes(key_header / 2);
+        }
+        tag.value = reader.ReadBytes(reader.ReadVarint());
+        record.tags.push_back(tag);
+    }
+
+    return record;
+}
+
+auto FractionalMicroseconds(std::chrono::system_clock::time_point time) noexcept {
+    return std::chrono::time_point_cast<std::chrono::microseconds>(time).time_since_epoch().count() % 1'000'000;
+}
+
+// Parses the local time written by AppendTskv and logging::Format::kTskv
+std::optional<std::chrono::system_clock::time_point> ParseTskvTimestamp(const std::string& value) {
+    std::tm tm{};
+    const char* rest = ::strptime(value.c_str(), "%Y-%m-%dT%H:%M:%S", &tm);
+    if (!rest) return std::nullopt;
+
+    std::int64_t microseconds = 0;
+    if (*rest == '.') {
+        const auto* end = value.data() + value.size();
+        if (std::from_chars(rest + 1, end, microseconds).ptr != end) return std::nullopt;
+    } else if (*rest != '\0') {
+        return std::nullopt;
+    }
+
+    tm.tm_isdst = -1;
+    const auto time = std::mktime(&tm);
+    if (time == -1) return std::nullopt;
+    return std::chrono::system_clock::from_time_t(time) +
+           std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::microseconds{microseconds});
+}
+
+}  // namespace
+
+std::optional<std::size_t> FindInternedKey(std::string_view key) noexcept {
+    const auto it = std::find(kInternedKeys.begin(), kInternedKeys.end(), key);
+    if (it == kInternedKeys.end()) return std::nullopt;
+    return it - kInternedKeys.begin();
+}
+
+std::string_view GetInternedKey(std::size_t id) {
+    if (id >= kInternedKeys.size()) {
+        throw DecodeError(fmt::format("Unknown interned key {} in a binary log record", id));
+    }
+    return kInternedKeys[id];
+}
+
+std::size_t WriteVarint(char* destination, std::uint64_t value) noexcept {
+    std::size_t size = 0;
+    while (value >= 0x80) {
+        destination[size++] = static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    destination[size++] = static_cast<char>(value);
+    return size;
+}
+
+std::size_t GetVarintSize(std::uint64_t value) noexcept {
+    std::size_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        ++size;
+    }
+    return size;
+}
+
+RecordReader::RecordReader(std::string_view data) noexcept : data_(data) {}
+
+std::optional<Record> RecordReader::Next() {
+    while (position_ < data_.size() && data_[position_] == '\n') ++position_;
+
+    const auto rest = data_.substr(position_);
+    if (rest.size() < 1 + kRecordSizeBytes) return std::nullopt;
+    if (rest[0] != kRecordMarker) {
+        throw DecodeError(fmt::format("Invalid binary log record marker at offset {}", position_));
+    }
+
+    std::size_t body_size = 0;
+    for (std::size_t i = 0; i < kRecordSizeBytes; ++i) {
+        body_size |= std::size_t{static_cast<unsigned char>(rest[1 + i])} << (8 * i);
+    }
+    if (rest.size() < 1 + kRecordSizeBytes + body_size) return std::nullopt;
+
+    auto record = DecodeBody(rest.substr(1 + kRecordSizeBytes, body_size));
+    position_ += 1 + kRecordSizeBytes + body_size;
+    return record;
+}
+
+std::size_t RecordReader::GetConsumedSize() const noexcept { return position_; }
+
+void AppendTskv(const Record& record, std::string& out) {
+    fmt::format_to(
+        std::back_inserter(out),
+        FMT_COMPILE("tskv\ttimestamp={:%FT%T}.{:06}\tlevel={}"),
+        fmt::localtime(std::chrono::system_clock::to_time_t(record.timestamp)),
+        FractionalMicroseconds(record.timestamp),
+        ToUpperCaseString(record.level)
+    );
+    for (const auto& tag : record.tags) {
+        out.push_back(utils::encoding::kTskvPairsSeparator);
+        utils::encoding::EncodeTskv(out, tag.key, utils::encoding::EncodeTskvMode::kKeyReplacePeriod);
+        out.push_back(utils::encoding::kTskvKeyValueSeparator);
+        utils::encoding::EncodeTskv(out, tag.value, utils::encoding::EncodeTskvMode::kValue);
+    }
+    out.push_back('\n');
+}
+
+void AppendJson(const Record& record, std::string& out) {
+    formats::json::StringBuilder builder;
+    {
+        const formats::json::StringBuilder::ObjectGuard guard{builder};
+        builder.Key("timestamp");
+        builder.WriteString(fmt::format(
+            FMT_COMPILE("{:%FT%T}.{:06}"),
+            fmt::localtime(std::chrono::system_clock::to_time_t(record.timestamp)),
+            FractionalMicroseconds(record.timestamp)
+        ));
+        builder.Key("level");
+        builder.WriteString(ToUpperCaseString(record.level));
+        for (const auto& tag : record.tags) {
+            builder.Key(tag.key);
+            builder.WriteString(tag.value);
+        }
+    }
+    out.append(builder.GetStringView());
+    out.push_back('\n');
+}
+
+void AppendBinary(const Record& record, std::string& out) {
+    const auto record_begin = out.size();
+    out.push_back(kRecordMarker);
+    out.append(kRecordSizeBytes, '\0');
+
+    char varint[kMaxVarintBytes];
+    const auto append_varint = [&out, &varint](std::uint64_t value) { out.append(varint, WriteVarint(varint, value)); };
+
+    append_varint(std::chrono::duration_cast<std::chrono::microseconds>(record.timestamp.time_since_epoch()).count());
+    out.push_back(static_cast<char>(record.level));
+    for (const auto& tag : record.tags) {
+        if (const auto interned_key = FindInternedKey(tag.key)) {
+            append_varint(*interned_key * 2 + 1);
+        } else {
+            append_varint(tag.key.size() * 2);
+            out.append(tag.key);
+        }
+        append_varint(tag.value.size());
+        out.append(tag.value);
+    }
+
+    const auto body_size = out.size() - record_begin - 1 - kRecordSizeBytes;
+    UASSERT(body_size >> (8 * kRecordSizeBytes) == 0);
+    for (std::size_t i = 0; i < kRecordSizeBytes; ++i) {
+        out[record_begin + 1 + i] = static_cast<char>((body_size >> (8 * i)) & 0xFF);
+    }
+}
+
+std::optional<std::string> ConvertTskvRecord(std::string_view tskv, Level level) {
+    utils::encoding::TskvParser parser{tskv};
+    if (!parser.SkipToRecordBegin()) return std::nullopt;
+
+    std::optional<std::chrono::system_clock::time_point> timestamp;
+    std::vector<std::pair<std::string, std::string>> tags;
+    const auto status = utils::encoding::TskvReadRecord(parser, [&](const std::string& key, const std::string& value) {
+        if (key == "timestamp") {
+            timestamp = ParseTskvTimestamp(value);
+        } else if (key != "level") {
+            tags.emplace_back(key, value);
+        }
+        return true;
+    });
+    if (status != utils::encoding::TskvParser::RecordStatus::kReachedEnd) return std::nullopt;
+
+    Record record;
+    record.timestamp = timestamp.value_or(std::chrono::system_clock::now());
+    record.level = level;
+    record.tags.reserve(tags.size());
+    for (const auto& [key, value] : tags) record.tags.push_back({key, value});
+
+    std::string result;
+    AppendBinary(record, result);
+    return result;
+}
+
+}  // namespace logging::impl::binary
+
+USERVER_NAMESPACE_END
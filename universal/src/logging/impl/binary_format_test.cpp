@@ -0,0 +1,174 @@
+#include <userver/logging/impl/binary_format.hpp>
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value.hpp>
+#include <userver/logging/impl/logger_base.hpp>
+#include <userver/logging/impl/mem_logger.hpp>
+#include <userver/logging/impl/tag_writer.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/logging/log_extra.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace binary = logging::impl::binary;
+
+class BinaryCaptureLogger final : public logging::impl::LoggerBase {
+public:
+    BinaryCaptureLogger() noexcept : LoggerBase(logging::Format::kBinary) { SetLevel(logging::Level::kTrace); }
+
+    void Log(logging::Level, std::string_view msg) override { data_.append(msg); }
+
+    void PrependCommonTags(logging::impl::TagWriter writer) const override { writer.PutTag("thread_id", 42); }
+
+    const std::string& GetData() const { return data_; }
+
+private:
+    std::string data_;
+};
+
+std::vector<binary::Record> DecodeAll(std::string_view data) {
+    binary::RecordReader reader{data};
+    std::vector<binary::Record> result;
+    while (auto record = reader.Next()) result.push_back(std::move(*record));
+    EXPECT_EQ(reader.GetConsumedSize(), data.size());
+    return result;
+}
+
+std::string_view FindTag(const binary::Record& record, std::string_view key) {
+    for (const auto& tag : record.tags) {
+        if (tag.key == key) return tag.value;
+    }
+    ADD_FAILURE() << "No tag " << key;
+    return {};
+}
+
+}  // namespace
+
+TEST(LogBinaryFormat, Varint) {
+    for (const std::uint64_t value : {0ULL, 1ULL, 127ULL, 128ULL, 16383ULL, 16384ULL, ~0ULL}) {
+        char buffer[binary::kMaxVarintBytes];
+        const auto size = binary::WriteVarint(buffer, value);
+        EXPECT_EQ(size, binary::GetVarintSize(value));
+    }
+    EXPECT_EQ(binary::GetVarintSize(127), 1);
+    EXPECT_EQ(binary::GetVarintSize(128), 2);
+    EXPECT_EQ(binary::GetVarintSize(~0ULL), binary::kMaxVarintBytes);
+}
+
+TEST(LogBinaryFormat, InternedKeys) {
+    const auto text_id = binary::FindInternedKey("text");
+    ASSERT_TRUE(text_id);
+    EXPECT_EQ(binary::GetInternedKey(*text_id), "text");
+    EXPECT_FALSE(binary::FindInternedKey("some_custom_key"));
+    EXPECT_THROW(binary::GetInternedKey(100500), binary::DecodeError);
+}
+
+TEST(LogBinaryFormat, LogHelperRoundTrip) {
+    auto logger = std::make_shared<BinaryCaptureLogger>();
+
+    const std::string long_value(20'000, 'x');
+    LOG_INFO_TO(*logger) << "first\tline\n" << logging::LogExtra{{"custom=key", "value\twith\ttabs"}};
+    LOG_ERROR_TO(*logger) << "second" << logging::LogExtra{{"long", long_value}, {"number", 42}};
+
+    // Sinks may separate the records with newlines
+    const auto data = logger->GetData() + "\n";
+    const auto records = DecodeAll(data);
+    ASSERT_EQ(records.size(), 2);
+
+    EXPECT_EQ(records[0].level, logging::Level::kInfo);
+    EXPECT_EQ(FindTag(records[0], "text"), "first\tline\n");
+    EXPECT_EQ(FindTag(records[0], "thread_id"), "42");
+    EXPECT_EQ(FindTag(records[0], "custom=key"), "value\twith\ttabs");
+    EXPECT_NE(FindTag(records[0], "module").find("binary_format_test.cpp"), std::string_view::npos);
+
+    EXPECT_EQ(records[1].level, logging::Level::kError);
+    EXPECT_EQ(FindTag(records[1], "text"), "second");
+    EXPECT_EQ(FindTag(records[1], "long"), long_value);
+    EXPECT_EQ(FindTag(records[1], "number"), "42");
+    EXPECT_LE(records[0].timestamp, records[1].timestamp);
+
+    std::string tskv;
+    binary::AppendTskv(records[0], tskv);
+    EXPECT_EQ(tskv.rfind("tskv\ttimestamp=", 0), 0) << tskv;
+    EXPECT_NE(tskv.find("\tlevel=INFO\t"), std::string::npos) << tskv;
+    EXPECT_NE(tskv.find("\ttext=first\\tline\\n"), std::string::npos) << tskv;
+    EXPECT_NE(tskv.find("\tcustom\\=key=value\\twith\\ttabs"), std::string::npos) << tskv;
+    EXPECT_EQ(tskv.back(), '\n');
+
+    std::string json;
+    binary::AppendJson(records[1], json);
+    const auto parsed = formats::json::FromString(json);
+    EXPECT_EQ(parsed["level"].As<std::string>(), "ERROR");
+    EXPECT_EQ(parsed["long"].As<std::string>(), long_value);
+}
+
+TEST(LogBinaryFormat, ConvertTskvRecord) {
+    const auto converted = binary::ConvertTskvRecord(
+        "tskv\ttimestamp=2024-01-02T03:04:05.000006\tlevel=INFO\ttext=with\\ttab\tcustom=value\n",
+        logging::Level::kWarning
+    );
+    ASSERT_TRUE(converted);
+
+    const auto records = DecodeAll(*converted);
+    ASSERT_EQ(records.size(), 1);
+    EXPECT_EQ(records[0].level, logging::Level::kWarning);
+    EXPECT_EQ(FindTag(records[0], "text"), "with\ttab");
+    EXPECT_EQ(FindTag(records[0], "custom"), "value");
+    EXPECT_EQ(records[0].tags.size(), 2);
+
+    std::string tskv;
+    binary::AppendTskv(records[0], tskv);
+    EXPECT_EQ(tskv.rfind("tskv\ttimestamp=2024-01-02T03:04:05.000006\tlevel=WARNING\t", 0), 0) << tskv;
+
+    EXPECT_FALSE(binary::ConvertTskvRecord("not a tskv record\n", logging::Level::kInfo));
+}
+
+TEST(LogBinaryFormat, MemLoggerForwarding) {
+    logging::impl::MemLogger mem_logger;
+    LOG_INFO_TO(mem_logger) << "before forwarding";
+
+    BinaryCaptureLogger logger;
+    mem_logger.ForwardTo(&logger);
+    LOG_ERROR_TO(mem_logger) << "after forwarding";
+    mem_logger.ForwardTo(nullptr);
+
+    const auto records = DecodeAll(logger.GetData());
+    ASSERT_EQ(records.size(), 2);
+    EXPECT_EQ(records[0].level, logging::Level::kInfo);
+    EXPECT_EQ(FindTag(records[0], "text"), "before forwarding");
+    EXPECT_EQ(records[1].level, logging::Level::kError);
+    EXPECT_EQ(FindTag(records[1], "text"), "after forwarding");
+}
+
+TEST(LogBinaryFormat, IncompleteRecord) {
+    auto logger = std::make_shared<BinaryCaptureLogger>();
+    LOG_INFO_TO(*logger) << "message";
+    const auto& data = logger->GetData();
+
+    for (std::size_t size = 0; size < data.size(); ++size) {
+        binary::RecordReader reader{std::string_view{data}.substr(0, size)};
+        EXPECT_FALSE(reader.Next());
+        EXPECT_EQ(reader.GetConsumedSize(), 0);
+    }
+}
+
+TEST(LogBinaryFormat, Malformed) {
+    EXPECT_THROW(binary::RecordReader{"tskv\ttext=not a binary log"}.Next(), binary::DecodeError);
+
+    auto logger = std::make_shared<BinaryCaptureLogger>();
+    LOG_INFO_TO(*logger) << "message";
+    auto data = logger->GetData();
+    // Make the body size larger than the tags
+    data[1] = static_cast<char>(data[1] + 1);
+    data.push_back('\0');
+    EXPECT_THROW(binary::RecordReader{data}.Next(), binary::DecodeError);
+}
+
+USERVER_NAMESPACE_END
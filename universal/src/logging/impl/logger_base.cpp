@@ -24,6 +24,19 @@ Level LoggerBase::GetLevel() const noexcept { return level_; }
 
 bool LoggerBase::ShouldLog(Level level) const noexcept { return ShouldLogNoSpan(*this, level) && DoShouldLog(level); }
 
+bool LoggerBase::ShouldLogRecord(Level level) const noexcept {
+    return ShouldLogNoSpan(*this, level) && DoShouldLogRecord(level);
+}
+
+bool LoggerBase::ShouldBuffer(Level level) const noexcept {
+    return level < GetLevel() && alive_request_log_buffers.load(std::memory_order_relaxed) != 0 &&
+           DoShouldBuffer(level);
+}
+
+void LoggerBase::Buffer(Level /*level*/, std::string_view /*msg*/) {}
+
+void LoggerBase::AccountLogLimitedDrop() noexcept {}
+
 void LoggerBase::SetFlushOn(Level level) { flush_level_ = level; }
 
 bool LoggerBase::ShouldFlush(Level level) const { return flush_level_ <= level; }
@@ -32,10 +45,16 @@ void LoggerBase::ForwardTo(LoggerBase*) {}
 
 bool LoggerBase::DoShouldLog(Level /*level*/) const noexcept { return true; }
 
+bool LoggerBase::DoShouldLogRecord(Level level) const noexcept { return DoShouldLog(level); }
+
+bool LoggerBase::DoShouldBuffer(Level /*level*/) const noexcept { return false; }
+
 bool ShouldLogNoSpan(const LoggerBase& logger, Level level) noexcept {
     return logger.GetLevel() <= level && level != Level::kNone;
 }
 
+std::atomic<std::size_t> alive_request_log_buffers{0};
+
 }  // namespace logging::impl
 
 USERVER_NAMESPACE_END
@@ -41,7 +41,7 @@ void TagWriter::PutKey(TagKey key) { lh_.pimpl_->PutRawKey(key.GetEscapedKey());
 
 void TagWriter::PutKey(RuntimeTagKey key) { lh_.pimpl_->PutKey(key.GetUnescapedKey()); }
 
-void TagWriter::MarkValueEnd() noexcept { lh_.pimpl_->MarkValueEnd(); }
+void TagWriter::MarkValueEnd() { lh_.pimpl_->MarkValueEnd(); }
 
 }  // namespace logging::impl
 
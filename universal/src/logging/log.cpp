@@ -23,6 +23,19 @@ auto& NonOwningDefaultLoggerInternal() noexcept {
 
 constexpr bool IsPowerOf2(uint64_t n) { return (n & (n - 1)) == 0; }
 
+// Intrusive list of the LOG_LIMITED call sites that have dropped records
+std::atomic<impl::RateLimitData*> rate_limit_data_list{nullptr};
+
+void RegisterRateLimitData(impl::RateLimitData& data, const utils::impl::SourceLocation& location) noexcept {
+    data.location = location;
+    auto* head = rate_limit_data_list.load(std::memory_order_relaxed);
+    do {
+        data.next = head;
+    } while (!rate_limit_data_list.compare_exchange_weak(
+        head, &data, std::memory_order_release, std::memory_order_relaxed
+    ));
+}
+
 }  // namespace
 
 namespace impl {
@@ -98,27 +111,69 @@ void LogFlush(LoggerRef logger) { logger.Flush(); }
 
 namespace impl {
 
-RateLimiter::RateLimiter(RateLimitData& data, Level level) noexcept : level_(level) {
+RateLimiter::RateLimiter(
+    RateLimitData& data,
+    LoggerRef logger,
+    bool is_enabled,
+    Level level,
+    const utils::impl::SourceLocation& location
+) noexcept
+    : RateLimiter(data, &logger, is_enabled, level, location) {}
+
+RateLimiter::RateLimiter(
+    RateLimitData& data,
+    const LoggerPtr& logger,
+    bool is_enabled,
+    Level level,
+    const utils::impl::SourceLocation& location
+) noexcept
+    : RateLimiter(data, logger.get(), is_enabled, level, location) {}
+
+RateLimiter::RateLimiter(
+    RateLimitData& data,
+    LoggerBase* logger,
+    bool is_enabled,
+    Level level,
+    const utils::impl::SourceLocation& location
+) noexcept
+    : level_(level) {
+    if (!is_enabled) {
+        should_log_ = false;
+        return;
+    }
+
     try {
         if (!impl::IsLogLimitedEnabled()) {
             return;
         }
 
         const auto reset_interval = impl::GetLogLimitedInterval();
-        const auto now = std::chrono::steady_clock::now();
-
-        if (now - data.last_reset_time >= reset_interval) {
-            data.count_since_reset = 0;
-            data.last_reset_time = now;
+        const auto now = std::chrono::steady_clock::now().time_since_epoch();
+
+        auto last_reset_time = data.last_reset_time.load(std::memory_order_relaxed);
+        if (now - last_reset_time >= reset_interval &&
+            data.last_reset_time.compare_exchange_strong(last_reset_time, now, std::memory_order_relaxed)) {
+            // Concurrent records of the previous interval might be counted
+            // into the new one, that is fine for the rate limiting
+            data.count_since_reset.store(0, std::memory_order_relaxed);
         }
 
-        if (IsPowerOf2(++data.count_since_reset)) {
+        if (IsPowerOf2(data.count_since_reset.fetch_add(1, std::memory_order_relaxed) + 1)) {
             // log the current message together with the dropped count
-            dropped_count_ = std::exchange(data.dropped_count, 0);
+            dropped_count_ = data.dropped_count.exchange(0, std::memory_order_relaxed);
         } else {
             // drop the current message
-            ++data.dropped_count;
+            UASSERT(logger);
+            data.level.store(level, std::memory_order_relaxed);
+            // The summaries are written to the default logger only, the
+            // records dropped by the other loggers are reported by the next
+            // written record of the call site
+            if (logger == &GetDefaultLogger() && !data.is_registered.exchange(true, std::memory_order_relaxed)) {
+                RegisterRateLimitData(data, location);
+            }
+            data.dropped_count.fetch_add(1, std::memory_order_relaxed);
             should_log_ = false;
+            logger->AccountLogLimitedDrop();
         }
     } catch (const std::exception& e) {
         UASSERT_MSG(false, e.what());
@@ -133,6 +188,30 @@ LogHelper& operator<<(LogHelper& lh, const RateLimiter& rl) noexcept {
     return lh;
 }
 
+void LogLimitedSummaries() noexcept {
+    const auto reset_interval = impl::GetLogLimitedInterval();
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+
+    for (auto* data = rate_limit_data_list.load(std::memory_order_acquire); data; data = data->next) {
+        if (data->dropped_count.load(std::memory_order_relaxed) == 0) continue;
+
+        // The records dropped in the current interval are reported by the next
+        // written record of the call site
+        auto last_reset_time = data->last_reset_time.load(std::memory_order_relaxed);
+        if (now - last_reset_time < reset_interval ||
+            !data->last_reset_time.compare_exchange_strong(last_reset_time, now, std::memory_order_relaxed)) {
+            continue;
+        }
+        data->count_since_reset.store(0, std::memory_order_relaxed);
+
+        const auto dropped_count = data->dropped_count.exchange(0, std::memory_order_relaxed);
+        const auto level = data->level.load(std::memory_order_relaxed);
+        if (dropped_count == 0 || !logging::ShouldLog(level)) continue;
+
+        LogHelper(GetDefaultLogger(), level, data->location) << dropped_count << " messages suppressed by LOG_LIMITED";
+    }
+}
+
 // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
 StaticLogEntry::StaticLogEntry(const char* path, int line) noexcept {
     static_assert(sizeof(LogEntryContent) == sizeof(content_));
@@ -146,7 +225,10 @@ bool StaticLogEntry::ShouldNotLog(logging::LoggerRef logger, logging::Level leve
     const auto state = content.state.load();
     const bool force_disabled = level < state.force_disabled_level_plus_one;
     const bool force_enabled = level >= state.force_enabled_level && level != logging::Level::kNone;
-    return (!LoggerShouldLog(logger, level) || force_disabled) && !force_enabled;
+    // The records kept in the request log buffer are not enabled by ShouldLog(), so that the explicit checks, e.g.
+    // the stacktrace capturing, are not affected by the buffering
+    const bool should_log = logger.ShouldLogRecord(level) || logger.ShouldBuffer(level);
+    return (!should_log || force_disabled) && !force_enabled;
 }
 
 bool StaticLogEntry::ShouldNotLog(const logging::LoggerPtr& logger, logging::Level level) const noexcept {
@@ -1,6 +1,7 @@
 #include "log_helper_impl.hpp"
 
 #include <array>
+#include <cstring>
 
 #include <fmt/chrono.h>
 #include <fmt/compile.h>
@@ -8,6 +9,7 @@
 
 #include <userver/compiler/impl/constexpr.hpp>
 #include <userver/compiler/thread_local.hpp>
+#include <userver/logging/impl/binary_format.hpp>
 #include <userver/logging/impl/logger_base.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/encoding/tskv.hpp>
@@ -22,6 +24,7 @@ char GetSeparatorFromLogger(LoggerRef logger) {
     switch (logger.GetFormat()) {
         case Format::kTskv:
         case Format::kRaw:
+        case Format::kBinary:
             return '=';
         case Format::kLtsv:
             return ':';
@@ -80,7 +83,9 @@ std::streamsize LogHelper::Impl::BufferStd::xsputn(const char_type* s, std::stre
 
 LogHelper::Impl::Impl(LoggerRef logger, Level level) noexcept
     : logger_(&logger),
-      level_(std::max(level, logger_->GetLevel())),
+      is_buffered_(logger_->ShouldBuffer(level)),
+      level_(is_buffered_ ? level : std::max(level, logger_->GetLevel())),
+      format_(logger_->GetFormat()),
       key_value_separator_(GetSeparatorFromLogger(*logger_)) {
     static_assert(
         sizeof(LogHelper::Impl) < 4096,
@@ -95,7 +100,7 @@ LogHelper::Impl::Impl(LoggerRef logger, Level level) noexcept
 void LogHelper::Impl::PutMessageBegin() {
     UASSERT(msg_.size() == 0);
 
-    switch (logger_->GetFormat()) {
+    switch (format_) {
         case Format::kTskv: {
             constexpr std::string_view kTemplate = "tskv\ttimestamp=0000-00-00T00:00:00.000000\tlevel=";
             const auto now = TimePoint::clock::now();
@@ -128,14 +133,41 @@ void LogHelper::Impl::PutMessageBegin() {
             msg_.append(std::string_view{"tskv"});
             return;
         }
+        case Format::kBinary: {
+            const auto now = TimePoint::clock::now();
+            const auto timestamp = std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch());
+            msg_.resize(1 + impl::binary::kRecordSizeBytes + impl::binary::kMaxVarintBytes + 1);
+
+            // The record size is written in PutMessageEnd
+            auto* position = msg_.data();
+            *(position++) = impl::binary::kRecordMarker;
+            position += impl::binary::kRecordSizeBytes;
+            position += impl::binary::WriteVarint(position, timestamp.count());
+            *(position++) = static_cast<char>(level_);
+            msg_.resize(position - msg_.data());
+            return;
+        }
     }
     UASSERT_MSG(false, "Invalid value of Format enum");
 }
 
-void LogHelper::Impl::PutMessageEnd() { msg_.push_back('\n'); }
+void LogHelper::Impl::PutMessageEnd() {
+    if (format_ != Format::kBinary) {
+        msg_.push_back('\n');
+        return;
+    }
+
+    const auto body_size = msg_.size() - 1 - impl::binary::kRecordSizeBytes;
+    UASSERT(body_size >> (8 * impl::binary::kRecordSizeBytes) == 0);
+    for (std::size_t i = 0; i < impl::binary::kRecordSizeBytes; ++i) {
+        msg_[1 + i] = static_cast<char>((body_size >> (8 * i)) & 0xFF);
+    }
+}
 
 void LogHelper::Impl::PutKey(std::string_view key) {
-    if (!utils::encoding::ShouldKeyBeEscaped(key)) {
+    if (format_ == Format::kBinary) {
+        PutBinaryKey(key);
+    } else if (!utils::encoding::ShouldKeyBeEscaped(key)) {
         PutRawKey(key);
     } else {
         UASSERT(!std::exchange(is_within_value_, true));
@@ -147,6 +179,11 @@ void LogHelper::Impl::PutKey(std::string_view key) {
 }
 
 void LogHelper::Impl::PutRawKey(std::string_view key) {
+    if (format_ == Format::kBinary) {
+        PutBinaryKey(key);
+        return;
+    }
+
     UASSERT(!std::exchange(is_within_value_, true));
     CheckRepeatedKeys(key);
     const auto old_size = msg_.size();
@@ -159,13 +196,43 @@ void LogHelper::Impl::PutRawKey(std::string_view key) {
     *(position++) = key_value_separator_;
 }
 
+void LogHelper::Impl::PutBinaryKey(std::string_view key) {
+    UASSERT(!std::exchange(is_within_value_, true));
+    CheckRepeatedKeys(key);
+    const auto interned_key = impl::binary::FindInternedKey(key);
+    const auto old_size = msg_.size();
+    msg_.resize(old_size + impl::binary::kMaxVarintBytes + (interned_key ? 0 : key.size()) + 1);
+
+    auto* position = msg_.data() + old_size;
+    if (interned_key) {
+        position += impl::binary::WriteVarint(position, *interned_key * 2 + 1);
+    } else {
+        position += impl::binary::WriteVarint(position, key.size() * 2);
+        key.copy(position, key.size());
+        position += key.size();
+    }
+
+    // A single byte is reserved for the value size, MarkValueEnd moves the
+    // value if its size does not fit
+    value_begin_ = position - msg_.data() + 1;
+    msg_.resize(value_begin_);
+}
+
 void LogHelper::Impl::PutValuePart(std::string_view value) {
     UASSERT(is_within_value_);
+    if (format_ == Format::kBinary) {
+        msg_.append(value);
+        return;
+    }
     utils::encoding::EncodeTskv(msg_, value, utils::encoding::EncodeTskvMode::kValue);
 }
 
 void LogHelper::Impl::PutValuePart(char text_part) {
     UASSERT(is_within_value_);
+    if (format_ == Format::kBinary) {
+        msg_.push_back(text_part);
+        return;
+    }
     utils::encoding::EncodeTskv(fmt::appender(msg_), text_part, utils::encoding::EncodeTskvMode::kValue);
 }
 
@@ -174,7 +241,18 @@ LogBuffer& LogHelper::Impl::GetBufferForRawValuePart() noexcept {
     return msg_;
 }
 
-void LogHelper::Impl::MarkValueEnd() noexcept { UASSERT(std::exchange(is_within_value_, false)); }
+void LogHelper::Impl::MarkValueEnd() {
+    UASSERT(std::exchange(is_within_value_, false));
+    if (format_ != Format::kBinary) return;
+
+    const auto value_size = msg_.size() - value_begin_;
+    const auto size_bytes = impl::binary::GetVarintSize(value_size);
+    if (size_bytes > 1) {
+        msg_.resize(msg_.size() + size_bytes - 1);
+        std::memmove(msg_.data() + value_begin_ - 1 + size_bytes, msg_.data() + value_begin_, value_size);
+    }
+    impl::binary::WriteVarint(msg_.data() + value_begin_ - 1, value_size);
+}
 
 void LogHelper::Impl::MarkAsTrace() noexcept { is_trace_ = true; }
 
@@ -198,7 +276,9 @@ void LogHelper::Impl::LogTheMessage() const {
 
     UASSERT(logger_);
     const std::string_view message(msg_.data(), msg_.size());
-    if (is_trace_)
+    if (is_buffered_)
+        logger_->Buffer(level_, message);
+    else if (is_trace_)
         logger_->Trace(level_, message);
     else
         logger_->Log(level_, message);
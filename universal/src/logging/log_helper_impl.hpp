@@ -6,6 +6,7 @@
 
 #include <fmt/format.h>
 
+#include <userver/logging/format.hpp>
 #include <userver/logging/level.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/logging/log_extra.hpp>
@@ -38,7 +39,7 @@ public:
     LogBuffer& GetBufferForRawValuePart() noexcept;
 
     bool IsWithinValue() const noexcept { return is_within_value_; }
-    void MarkValueEnd() noexcept;
+    void MarkValueEnd();
 
     LogExtra& GetLogExtra() { return extra_; }
 
@@ -78,15 +79,22 @@ private:
 
     LazyInitedStream& GetLazyInitedStream();
 
+    void PutBinaryKey(std::string_view key);
+
     void CheckRepeatedKeys(std::string_view raw_key);
 
     impl::LoggerBase* logger_;
+    // Records below the logger level are kept in the request log buffer
+    const bool is_buffered_;
     const Level level_;
+    const Format format_;
     const char key_value_separator_;
     LogBuffer msg_;
     std::optional<LazyInitedStream> lazy_stream_;
     LogExtra extra_;
     std::size_t initial_length_{0};
+    // The position of the current value in msg_ for Format::kBinary
+    std::size_t value_begin_{0};
     bool is_within_value_{false};
     bool is_trace_{false};
     std::optional<std::unordered_set<std::string>> debug_tag_keys_;
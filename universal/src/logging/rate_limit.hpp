@@ -14,6 +14,10 @@ void SetLogLimitedInterval(std::chrono::steady_clock::duration d) noexcept;
 
 std::chrono::steady_clock::duration GetLogLimitedInterval() noexcept;
 
+// Writes the count of the records that LOG_LIMITED call sites of the default
+// logger dropped in the finished intervals, and starts new intervals for them
+void LogLimitedSummaries() noexcept;
+
 }  // namespace logging::impl
 
 USERVER_NAMESPACE_END